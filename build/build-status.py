@@ -0,0 +1,8 @@
+#! /usr/bin/env python3
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/applications/examples/ns3-dev-three-gpp-http-example-debug', 'build/src/bridge/examples/ns3-dev-csma-bridge-debug', 'build/src/bridge/examples/ns3-dev-csma-bridge-one-hop-debug', 'build/src/buildings/examples/ns3-dev-buildings-pathloss-profiler-debug', 'build/src/buildings/examples/ns3-dev-outdoor-random-walk-example-debug', 'build/src/buildings/examples/ns3-dev-buildings-channel-condition-benchmark-debug', 'build/src/config-store/examples/ns3-dev-config-store-save-debug', 'build/src/core/examples/ns3-dev-main-callback-debug', 'build/src/core/examples/ns3-dev-sample-simulator-debug', 'build/src/core/examples/ns3-dev-main-ptr-debug', 'build/src/core/examples/ns3-dev-main-random-variable-stream-debug', 'build/src/core/examples/ns3-dev-sample-random-variable-debug', 'build/src/core/examples/ns3-dev-sample-random-variable-stream-debug', 'build/src/core/examples/ns3-dev-command-line-example-debug', 'build/src/core/examples/ns3-dev-hash-example-debug', 'build/src/core/examples/ns3-dev-sample-log-time-format-debug', 'build/src/core/examples/ns3-dev-test-string-value-formatting-debug', 'build/src/core/examples/ns3-dev-sample-show-progress-debug', 'build/src/core/examples/ns3-dev-system-path-examples-debug', 'build/src/core/examples/ns3-dev-main-test-sync-debug', 'build/src/csma/examples/ns3-dev-csma-one-subnet-debug', 'build/src/csma/examples/ns3-dev-csma-broadcast-debug', 'build/src/csma/examples/ns3-dev-csma-packet-socket-debug', 'build/src/csma/examples/ns3-dev-csma-multicast-debug', 'build/src/fd-net-device/examples/ns3-dev-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3-dev-realtime-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3-dev-fd-emu-udp-echo-debug', 'build/src/fd-net-device/examples/ns3-dev-fd-emu-onoff-debug', 'build/src/internet/examples/ns3-dev-main-simple-debug', 'build/src/lte/examples/ns3-dev-lena-cqi-threshold-debug', 'build/src/lte/examples/ns3-dev-lena-dual-stripe-debug', 'build/src/lte/examples/ns3-dev-lena-fading-debug', 'build/src/lte/examples/ns3-dev-lena-intercell-interference-debug', 'build/src/lte/examples/ns3-dev-lena-ipv6-addr-conf-debug', 'build/src/lte/examples/ns3-dev-lena-ipv6-ue-rh-debug', 'build/src/lte/examples/ns3-dev-lena-ipv6-ue-ue-debug', 'build/src/lte/examples/ns3-dev-lena-pathloss-traces-debug', 'build/src/lte/examples/ns3-dev-lena-profiling-debug', 'build/src/lte/examples/ns3-dev-lena-rem-debug', 'build/src/lte/examples/ns3-dev-lena-rem-sector-antenna-debug', 'build/src/lte/examples/ns3-dev-lena-rlc-traces-debug', 'build/src/lte/examples/ns3-dev-lena-simple-debug', 'build/src/lte/examples/ns3-dev-lena-simple-epc-debug', 'build/src/lte/examples/ns3-dev-lena-deactivate-bearer-debug', 'build/src/lte/examples/ns3-dev-lena-x2-handover-debug', 'build/src/lte/examples/ns3-dev-lena-x2-handover-measures-debug', 'build/src/lte/examples/ns3-dev-lena-frequency-reuse-debug', 'build/src/lte/examples/ns3-dev-lena-distributed-ffr-debug', 'build/src/lte/examples/ns3-dev-lena-uplink-power-control-debug', 'build/src/lte/examples/ns3-dev-lena-simple-epc-emu-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-example-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-tcp-example-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-simple-epc-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-simple-epc-ipv6-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-epc-tdma-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-tdma-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-simple-building-obstacle-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-tcp-building-example-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-amc-test-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-amc-test2-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-epc-amc-test-debug', 'build/src/mmwave/examples/ns3-dev-mc-twoenbs-debug', 'build/src/mmwave/examples/ns3-dev-mc-twoenbs-ipv6-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-ca-diff-bandwidth-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-ca-same-bandwidth-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-beamforming-codebook-example-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-beam-search-benchmark-debug', 'build/src/mmwave/examples/ns3-dev-mmwave-mac-scheduler-benchmark-debug', 'build/src/mmwave/examples/ns3-dev-qd-channel-full-stack-example-debug', 'build/src/mobility/examples/ns3-dev-main-grid-topology-debug', 'build/src/mobility/examples/ns3-dev-main-random-topology-debug', 'build/src/mobility/examples/ns3-dev-main-random-walk-debug', 'build/src/mobility/examples/ns3-dev-mobility-trace-example-debug', 'build/src/mobility/examples/ns3-dev-ns2-mobility-trace-debug', 'build/src/mobility/examples/ns3-dev-bonnmotion-ns2-example-debug', 'build/src/network/examples/ns3-dev-main-packet-header-debug', 'build/src/network/examples/ns3-dev-main-packet-tag-debug', 'build/src/network/examples/ns3-dev-packet-socket-apps-debug', 'build/src/point-to-point/examples/ns3-dev-main-attribute-value-debug', 'build/src/propagation/examples/ns3-dev-main-propagation-loss-debug', 'build/src/propagation/examples/ns3-dev-jakes-propagation-model-example-debug', 'build/src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-debug', 'build/src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-matrix-propagation-loss-model-debug', 'build/src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-with-microwave-oven-debug', 'build/src/spectrum/examples/ns3-dev-tv-trans-example-debug', 'build/src/spectrum/examples/ns3-dev-tv-trans-regional-example-debug', 'build/src/spectrum/examples/ns3-dev-three-gpp-channel-example-debug', 'build/src/spectrum/examples/ns3-dev-three-gpp-channel-benchmark-debug', 'build/src/stats/examples/ns3-dev-gnuplot-example-debug', 'build/src/stats/examples/ns3-dev-double-probe-example-debug', 'build/src/stats/examples/ns3-dev-time-probe-example-debug', 'build/src/stats/examples/ns3-dev-gnuplot-aggregator-example-debug', 'build/src/stats/examples/ns3-dev-gnuplot-helper-example-debug', 'build/src/stats/examples/ns3-dev-file-aggregator-example-debug', 'build/src/stats/examples/ns3-dev-file-helper-example-debug', 'build/src/traffic-control/examples/ns3-dev-codel-vs-pfifo-basic-test-debug', 'build/src/traffic-control/examples/ns3-dev-codel-vs-pfifo-asymmetric-debug', 'build/src/virtual-net-device/examples/ns3-dev-virtual-net-device-debug', 'build/contrib/qd-channel/examples/ns3-dev-qd-channel-model-example-debug', 'build/examples/tcp/ns3-dev-tcp-large-transfer-debug', 'build/examples/tcp/ns3-dev-tcp-nsc-lfn-debug', 'build/examples/tcp/ns3-dev-tcp-nsc-zoo-debug', 'build/examples/tcp/ns3-dev-tcp-star-server-debug', 'build/examples/tcp/ns3-dev-tcp-bulk-send-debug', 'build/examples/tcp/ns3-dev-tcp-pcap-nanosec-example-debug', 'build/examples/tcp/ns3-dev-dctcp-example-debug', 'build/examples/routing/ns3-dev-dynamic-global-routing-debug', 'build/examples/routing/ns3-dev-static-routing-slash32-debug', 'build/examples/routing/ns3-dev-global-routing-slash32-debug', 'build/examples/routing/ns3-dev-global-injection-slash32-debug', 'build/examples/routing/ns3-dev-simple-alternate-routing-debug', 'build/examples/routing/ns3-dev-mixed-global-routing-debug', 'build/examples/routing/ns3-dev-global-routing-multi-switch-plus-router-debug', 'build/examples/routing/ns3-dev-simple-multicast-flooding-debug', 'build/examples/udp-client-server/ns3-dev-udp-client-server-debug', 'build/examples/udp-client-server/ns3-dev-udp-trace-client-server-debug', 'build/examples/error-model/ns3-dev-simple-error-model-debug', 'build/examples/tutorial/ns3-dev-hello-simulator-debug', 'build/examples/tutorial/ns3-dev-first-debug', 'build/examples/tutorial/ns3-dev-second-debug', 'build/examples/tutorial/ns3-dev-fourth-debug', 'build/examples/tutorial/ns3-dev-fifth-debug', 'build/examples/tutorial/ns3-dev-sixth-debug', 'build/examples/tutorial/ns3-dev-seventh-debug', 'build/examples/udp/ns3-dev-udp-echo-debug', 'build/examples/socket/ns3-dev-socket-bound-static-routing-debug', 'build/examples/socket/ns3-dev-socket-bound-tcp-static-routing-debug', 'build/examples/socket/ns3-dev-socket-options-ipv4-debug', 'build/examples/socket/ns3-dev-socket-options-ipv6-debug', 'build/examples/realtime/ns3-dev-realtime-udp-echo-debug', 'build/examples/naming/ns3-dev-object-names-debug', 'build/examples/ipv6/ns3-dev-test-ipv6-debug', 'build/examples/traffic-control/ns3-dev-tbf-example-debug', 'build/examples/traffic-control/ns3-dev-cobalt-vs-codel-debug', 'build/scratch/ns3-dev-qd-channel-bf-comparison-debug', 'build/scratch/ns3-dev-test-debug', 'build/scratch/ns3-dev-chdump-debug', 'build/scratch/ns3-dev-UPASimulator-debug', 'build/scratch/subdir/ns3-dev-subdir-debug', 'build/scratch/ns3-dev-scratch-simulator-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'first.py', 'second.py', 'realtime-udp-echo.py']
+
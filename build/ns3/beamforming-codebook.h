@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef BEAMFORMING_CODEBOOK_H
+#define BEAMFORMING_CODEBOOK_H
+
+#include "ns3/object.h"
+#include "ns3/phased-array-model.h"
+
+namespace ns3 {
+namespace mmwave {
+
+
+/**
+ *
+ */
+class BeamformingCodebook : public Object
+{
+public:
+  virtual ~BeamformingCodebook () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Read-only view of a codeword stored by a codebook. It does not copy the
+   * codeword, and it is valid as long as the codebook exists.
+   */
+  class CodewordView
+  {
+  public:
+    /**
+     * Constructor
+     * \param data pointer to the first element of the codeword
+     * \param size the number of elements of the codeword
+     */
+    CodewordView (const std::complex<double> *data, std::size_t size)
+      : m_data (data),
+        m_size (size)
+    {
+    }
+
+    /**
+     * \return the number of elements of the codeword
+     */
+    std::size_t size () const
+    {
+      return m_size;
+    }
+
+    /**
+     * \param i the element index
+     * \return the weight of the element i
+     */
+    const std::complex<double>& operator[] (std::size_t i) const
+    {
+      return m_data[i];
+    }
+
+    /**
+     * \return pointer to the first element of the codeword
+     */
+    const std::complex<double>* data () const
+    {
+      return m_data;
+    }
+
+    /**
+     * \return iterator to the first element of the codeword
+     */
+    const std::complex<double>* begin () const
+    {
+      return m_data;
+    }
+
+    /**
+     * \return iterator past the last element of the codeword
+     */
+    const std::complex<double>* end () const
+    {
+      return m_data + m_size;
+    }
+
+    /**
+     * Copies the codeword, e.g., to set it as beamforming vector
+     * \return a copy of the codeword
+     */
+    operator PhasedArrayModel::ComplexVector () const
+    {
+      return PhasedArrayModel::ComplexVector (begin (), end ());
+    }
+
+  private:
+    const std::complex<double> *m_data; //!< the first element of the codeword
+    std::size_t m_size; //!< the number of elements of the codeword
+  };
+
+  /**
+   * Returns a view of a codeword
+   * \param idx the codeword index
+   * \return the view of the codeword
+   */
+  virtual CodewordView GetCodeword (uint32_t idx) const = 0;
+
+  /**
+   *
+   */
+  virtual uint32_t GetCodebookSize (void) const = 0;
+
+protected:
+  virtual void DoInitialize (void);
+
+  Ptr<PhasedArrayModel> m_array;
+};
+
+
+} // namespace mmwave
+} // namespace ns3
+
+#endif /* BEAMFORMING_CODEBOOK_H */
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering, New York
+ * University
+ * Copyright (c) 2019 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BUILDINGS_CHANNEL_CONDITION_MODEL_H
+#define BUILDINGS_CHANNEL_CONDITION_MODEL_H
+
+#include "ns3/channel-condition-model.h"
+#include "ns3/traced-value.h"
+#include "ns3/vector.h"
+#include "ns3/lru-cache.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup buildings
+ *
+ * \brief Determines the channel condition based on the buildings deployed in the
+ * scenario
+ *
+ * The channel between two outdoor nodes is NLOS if the line-segment between
+ * them intersects a building, which is searched with the spatial index of
+ * the BuildingList. The result is cached for each pair of nodes, and reused
+ * until either node moves by more than the LosCacheDistance attribute, or
+ * the buildings change. The least recently used results are evicted when
+ * the cache exceeds the CacheMaxSize attribute.
+ *
+ * Code adapted from MmWave3gppBuildingsPropagationLossModel
+ */
+class BuildingsChannelConditionModel : public ChannelConditionModel
+{
+public:
+  /**
+   * Get the type ID.
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+
+  /**
+   * Constructor for the BuildingsChannelConditionModel class
+   */
+  BuildingsChannelConditionModel ();
+
+  /**
+   * Destructor for the BuildingsChannelConditionModel class
+   */
+  virtual ~BuildingsChannelConditionModel () override;
+
+  /**
+   * Computes the condition of the channel between a and b.
+   *
+   * \param a mobility model
+   * \param b mobility model
+   * \return the condition of the channel between a and b
+   */
+  virtual Ptr<ChannelCondition> GetChannelCondition (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const override;
+
+  /**
+   * If this model uses objects of type RandomVariableStream,
+   * set the stream numbers to the integers starting with the offset
+   * 'stream'. Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream
+   * \return the number of stream indices assigned by this model
+   */
+  virtual int64_t AssignStreams (int64_t stream) override;
+
+protected:
+  virtual void DoDispose () override;
+
+private:
+  /**
+   * \brief Checks if the line of sight between position l1 and position l2 is
+   *        blocked by a building.
+   *
+   * \param l1 position
+   * \param l2 position
+   * \return true if the line of sight is blocked, false otherwise
+   */
+  bool IsLineOfSightBlocked (const Vector &l1, const Vector &l2) const;
+
+  /**
+   * \brief Checks if the line of sight between a and b is blocked by a
+   *        building, using the cached result of the link if it is still valid.
+   *        The result is not cached if a or b is not aggregated to a Node.
+   *
+   * \param a mobility model
+   * \param b mobility model
+   * \return true if the line of sight is blocked, false otherwise
+   */
+  bool IsLineOfSightBlocked (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
+  /**
+   * Set the memory budget of m_losCache, evicting the least recently used
+   * line of sight tests if needed
+   * \param maxSize the maximum size in bytes, 0 for an unbounded cache
+   */
+  void SetCacheMaxSize (uint64_t maxSize);
+
+  /**
+   * Get the memory budget of m_losCache
+   * \return the maximum size in bytes, 0 for an unbounded cache
+   */
+  uint64_t GetCacheMaxSize (void) const;
+
+  /**
+   * Struct to store the result of the line of sight test of a link
+   */
+  struct LosItem
+  {
+    Vector m_positionA; //!< the position of the node with the lower ID
+    Vector m_positionB; //!< the position of the node with the higher ID
+    uint64_t m_buildingsVersion; //!< the version of the BuildingList used for the test
+    bool m_blocked; //!< true if the line of sight is blocked
+  };
+
+  mutable LruCache<uint64_t, LosItem> m_losCache; //!< cache of the line of sight tests, indexed by the IDs of the nodes
+  double m_losCacheDistance; //!< the distance an endpoint can move before the link is tested again
+  mutable TracedValue<uint64_t> m_cacheHits; //!< number of line of sight tests found in m_losCache
+  mutable TracedValue<uint64_t> m_cacheMisses; //!< number of line of sight tests computed
+  mutable TracedValue<uint64_t> m_cacheEvictions; //!< number of line of sight tests evicted from m_losCache
+  mutable TracedValue<uint64_t> m_cacheSize; //!< estimated size of m_losCache in bytes
+};
+
+} // end ns3 namespace
+
+#endif /* BUILDINGS_CHANNEL_CONDITION_MODEL_H */
@@ -0,0 +1,474 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COMPLEX_3D_ARRAY_H
+#define COMPLEX_3D_ARRAY_H
+
+#include <ns3/assert.h>
+#include <ns3/abort.h>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * Allocator returning blocks of memory aligned to Alignment bytes, used to
+ * store the elements of a Complex3DArray so that they can be processed with
+ * vector instructions.
+ */
+template <typename T, std::size_t Alignment>
+class AlignedAllocator
+{
+public:
+  typedef T value_type; //!< type of the allocated elements
+
+  /**
+   * Rebind the allocator to another type
+   */
+  template <typename U>
+  struct rebind
+  {
+    typedef AlignedAllocator<U, Alignment> other; //!< the rebound allocator
+  };
+
+  AlignedAllocator () = default;
+
+  /**
+   * Copy constructor from an allocator of another type
+   */
+  template <typename U>
+  AlignedAllocator (const AlignedAllocator<U, Alignment> &)
+  {
+  }
+
+  /**
+   * Allocate a block of memory aligned to Alignment bytes
+   * \param n the number of elements
+   * \return a pointer to the first element
+   */
+  T* allocate (std::size_t n)
+  {
+    // allocate enough room to align the block and to store the pointer
+    // returned by operator new just before the aligned block
+    std::size_t size = n * sizeof (T) + Alignment + sizeof (void*);
+    char *raw = static_cast<char*> (::operator new (size));
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t> (raw + sizeof (void*));
+    char *aligned = raw + sizeof (void*) + ((Alignment - address % Alignment) % Alignment);
+    reinterpret_cast<void**> (aligned)[-1] = raw;
+    return reinterpret_cast<T*> (aligned);
+  }
+
+  /**
+   * Release a block of memory obtained with allocate
+   * \param p the pointer returned by allocate
+   */
+  void deallocate (T *p, std::size_t)
+  {
+    ::operator delete (reinterpret_cast<void**> (p)[-1]);
+  }
+};
+
+/**
+ * Two AlignedAllocator objects are always interchangeable
+ * \return true
+ */
+template <typename T, typename U, std::size_t Alignment>
+bool operator== (const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+  return true;
+}
+
+/**
+ * Two AlignedAllocator objects are always interchangeable
+ * \return false
+ */
+template <typename T, typename U, std::size_t Alignment>
+bool operator!= (const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &)
+{
+  return false;
+}
+
+
+/**
+ * \ingroup spectrum
+ *
+ * Dense three-dimensional array of complex values, used to store the
+ * channel coefficients H[u][s][n] of a MatrixBasedChannelModel, where u is
+ * the index of the receive antenna element, s the index of the transmit
+ * antenna element and n the cluster index.
+ *
+ * All the coefficients are stored in a single block of memory aligned to
+ * ALIGNMENT bytes. Two layouts are supported:
+ * - ANTENNA_MAJOR: the coefficients of all the clusters of an antenna pair
+ *   are contiguous, i.e., the element (u, s, n) is stored at position
+ *   (u * S + s) * N + n. This is the order in which the 3GPP channel model
+ *   generates the coefficients.
+ * - CLUSTER_MAJOR: the U x S matrix of each cluster is contiguous and stored
+ *   in row-major order, i.e., the element (u, s, n) is stored at position
+ *   (n * U + u) * S + s.
+ *
+ * The elements should be accessed through operator() or directly through
+ * the pointer returned by GetData, using the strides provided by the
+ * object. For backward compatibility, the array can also be built from a
+ * nested vector and indexed as a nested vector, i.e., H[u][s][n], with
+ * size () and at () methods for each dimension.
+ */
+class Complex3DArray
+{
+public:
+  /**
+   * Order in which the elements are stored in memory
+   */
+  enum Layout
+  {
+    ANTENNA_MAJOR, //!< the clusters of each antenna pair are contiguous
+    CLUSTER_MAJOR //!< the antenna pairs of each cluster are contiguous
+  };
+
+  static const std::size_t ALIGNMENT = 64; //!< alignment of the storage in bytes
+
+  typedef std::vector<std::complex<double> > ComplexVector; //!< type definition for complex vectors
+  typedef std::vector<std::vector<ComplexVector> > NestedVector; //!< type definition for nested 3D vectors, indexed as [u][s][n]
+
+  /**
+   * Proxy to the clusters of an antenna pair, which can be used as a
+   * vector of complex values
+   */
+  template <typename A, typename R>
+  class ClusterView
+  {
+  public:
+    /**
+     * Constructor
+     * \param array the array
+     * \param u the index of the receive antenna element
+     * \param s the index of the transmit antenna element
+     */
+    ClusterView (A *array, std::size_t u, std::size_t s)
+      : m_array (array),
+        m_u (u),
+        m_s (s)
+    {
+    }
+
+    /**
+     * \return the number of clusters
+     */
+    std::size_t size () const
+    {
+      return m_array->GetNumClusters ();
+    }
+
+    /**
+     * \param n the cluster index
+     * \return the coefficient of the cluster n
+     */
+    R operator[] (std::size_t n) const
+    {
+      return (*m_array) (m_u, m_s, n);
+    }
+
+    /**
+     * \param n the cluster index
+     * \return the coefficient of the cluster n, after checking the index
+     */
+    R at (std::size_t n) const
+    {
+      NS_ABORT_MSG_IF (n >= size (), "Cluster index " << n << " out of range");
+      return (*m_array) (m_u, m_s, n);
+    }
+
+  private:
+    A *m_array; //!< the array
+    std::size_t m_u; //!< the index of the receive antenna element
+    std::size_t m_s; //!< the index of the transmit antenna element
+  };
+
+  /**
+   * Proxy to the coefficients of a receive antenna element, which can be
+   * used as a vector of ClusterView objects
+   */
+  template <typename A, typename R>
+  class TxView
+  {
+  public:
+    /**
+     * Constructor
+     * \param array the array
+     * \param u the index of the receive antenna element
+     */
+    TxView (A *array, std::size_t u)
+      : m_array (array),
+        m_u (u)
+    {
+    }
+
+    /**
+     * \return the number of transmit antenna elements
+     */
+    std::size_t size () const
+    {
+      return m_array->GetNumTxElements ();
+    }
+
+    /**
+     * \param s the index of the transmit antenna element
+     * \return the clusters of the antenna pair (u, s)
+     */
+    ClusterView<A, R> operator[] (std::size_t s) const
+    {
+      return ClusterView<A, R> (m_array, m_u, s);
+    }
+
+    /**
+     * \param s the index of the transmit antenna element
+     * \return the clusters of the antenna pair (u, s), after checking the index
+     */
+    ClusterView<A, R> at (std::size_t s) const
+    {
+      NS_ABORT_MSG_IF (s >= size (), "Tx element index " << s << " out of range");
+      return ClusterView<A, R> (m_array, m_u, s);
+    }
+
+  private:
+    A *m_array; //!< the array
+    std::size_t m_u; //!< the index of the receive antenna element
+  };
+
+  /**
+   * Create an empty array
+   */
+  Complex3DArray ();
+
+  /**
+   * Create an array with all the elements equal to zero
+   * \param numRxElements the number of receive antenna elements
+   * \param numTxElements the number of transmit antenna elements
+   * \param numClusters the number of clusters
+   * \param layout the layout of the array
+   */
+  Complex3DArray (std::size_t numRxElements, std::size_t numTxElements, std::size_t numClusters,
+                  Layout layout = ANTENNA_MAJOR);
+
+  /**
+   * Create an array from a nested vector indexed as [u][s][n]. All the
+   * inner vectors must have the same size.
+   * \param nested the nested vector
+   * \param layout the layout of the array
+   */
+  Complex3DArray (const NestedVector &nested, Layout layout = ANTENNA_MAJOR);
+
+  /**
+   * Create a copy of an array using a different layout
+   * \param other the array to copy
+   * \param layout the layout of the new array
+   */
+  Complex3DArray (const Complex3DArray &other, Layout layout);
+
+  Complex3DArray (const Complex3DArray &other) = default;
+  Complex3DArray (Complex3DArray &&other) = default;
+  Complex3DArray& operator= (const Complex3DArray &other) = default;
+  Complex3DArray& operator= (Complex3DArray &&other) = default;
+
+  /**
+   * \return the number of receive antenna elements
+   */
+  std::size_t GetNumRxElements () const
+  {
+    return m_numRxElements;
+  }
+
+  /**
+   * \return the number of transmit antenna elements
+   */
+  std::size_t GetNumTxElements () const
+  {
+    return m_numTxElements;
+  }
+
+  /**
+   * \return the number of clusters
+   */
+  std::size_t GetNumClusters () const
+  {
+    return m_numClusters;
+  }
+
+  /**
+   * \return the layout of the array
+   */
+  Layout GetLayout () const
+  {
+    return m_layout;
+  }
+
+  /**
+   * \return the distance in memory between the elements (u, s, n) and (u + 1, s, n)
+   */
+  std::size_t GetRxStride () const
+  {
+    return m_rxStride;
+  }
+
+  /**
+   * \return the distance in memory between the elements (u, s, n) and (u, s + 1, n)
+   */
+  std::size_t GetTxStride () const
+  {
+    return m_txStride;
+  }
+
+  /**
+   * \return the distance in memory between the elements (u, s, n) and (u, s, n + 1)
+   */
+  std::size_t GetClusterStride () const
+  {
+    return m_clusterStride;
+  }
+
+  /**
+   * \param u the index of the receive antenna element
+   * \param s the index of the transmit antenna element
+   * \param n the cluster index
+   * \return the position of the element (u, s, n) in memory
+   */
+  std::size_t GetIndex (std::size_t u, std::size_t s, std::size_t n) const
+  {
+    NS_ASSERT_MSG (u < m_numRxElements && s < m_numTxElements && n < m_numClusters,
+                   "Index (" << u << ", " << s << ", " << n << ") out of range");
+    return u * m_rxStride + s * m_txStride + n * m_clusterStride;
+  }
+
+  /**
+   * \param u the index of the receive antenna element
+   * \param s the index of the transmit antenna element
+   * \param n the cluster index
+   * \return a reference to the element (u, s, n)
+   */
+  std::complex<double>& operator() (std::size_t u, std::size_t s, std::size_t n)
+  {
+    return m_values[GetIndex (u, s, n)];
+  }
+
+  /**
+   * \param u the index of the receive antenna element
+   * \param s the index of the transmit antenna element
+   * \param n the cluster index
+   * \return a const reference to the element (u, s, n)
+   */
+  const std::complex<double>& operator() (std::size_t u, std::size_t s, std::size_t n) const
+  {
+    return m_values[GetIndex (u, s, n)];
+  }
+
+  /**
+   * \return a pointer to the first element of the array
+   */
+  std::complex<double>* GetData ()
+  {
+    return m_values.data ();
+  }
+
+  /**
+   * \return a const pointer to the first element of the array
+   */
+  const std::complex<double>* GetData () const
+  {
+    return m_values.data ();
+  }
+
+  /**
+   * \return the total number of elements
+   */
+  std::size_t GetNumElements () const
+  {
+    return m_values.size ();
+  }
+
+  /**
+   * Convert the array to a nested vector indexed as [u][s][n]
+   * \return the nested vector
+   */
+  NestedVector ToNestedVector () const;
+
+  /**
+   * Nested vector adapter
+   * \return the number of receive antenna elements
+   */
+  std::size_t size () const
+  {
+    return m_numRxElements;
+  }
+
+  /**
+   * Nested vector adapter
+   * \param u the index of the receive antenna element
+   * \return a proxy to the coefficients of the receive antenna element u
+   */
+  TxView<Complex3DArray, std::complex<double>&> operator[] (std::size_t u)
+  {
+    return TxView<Complex3DArray, std::complex<double>&> (this, u);
+  }
+
+  /**
+   * Nested vector adapter
+   * \param u the index of the receive antenna element
+   * \return a proxy to the coefficients of the receive antenna element u
+   */
+  TxView<const Complex3DArray, const std::complex<double>&> operator[] (std::size_t u) const
+  {
+    return TxView<const Complex3DArray, const std::complex<double>&> (this, u);
+  }
+
+  /**
+   * Nested vector adapter
+   * \param u the index of the receive antenna element
+   * \return a proxy to the coefficients of the receive antenna element u,
+   *         after checking the index
+   */
+  TxView<const Complex3DArray, const std::complex<double>&> at (std::size_t u) const
+  {
+    NS_ABORT_MSG_IF (u >= size (), "Rx element index " << u << " out of range");
+    return TxView<const Complex3DArray, const std::complex<double>&> (this, u);
+  }
+
+private:
+  /**
+   * Compute the strides for the current dimensions and layout
+   */
+  void ComputeStrides ();
+
+  std::size_t m_numRxElements; //!< number of receive antenna elements
+  std::size_t m_numTxElements; //!< number of transmit antenna elements
+  std::size_t m_numClusters; //!< number of clusters
+  Layout m_layout; //!< layout of the array
+  std::size_t m_rxStride; //!< distance between two consecutive receive antenna elements
+  std::size_t m_txStride; //!< distance between two consecutive transmit antenna elements
+  std::size_t m_clusterStride; //!< distance between two consecutive clusters
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>, ALIGNMENT> > m_values; //!< the elements
+};
+
+} // namespace ns3
+
+#endif // COMPLEX_3D_ARRAY_H
@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COMPLEX_VECTOR_KERNELS_H
+#define COMPLEX_VECTOR_KERNELS_H
+
+#include <complex>
+#include <cstddef>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * Vectorized kernels operating on complex vectors, used by the
+ * ThreeGppSpectrumPropagationLossModel to compute the long term component
+ * and the beamforming gain.
+ *
+ * Each kernel has a portable implementation and, on x86-64 platforms
+ * compiled with GCC or Clang, AVX2 and AVX-512 implementations. The fastest
+ * implementation supported by the CPU is selected at runtime, the first time
+ * a kernel is used. SetInstructionSet can be used to force a specific
+ * implementation, e.g., to compare the results of different implementations.
+ *
+ * Since the implementations sum the terms in a different order, their
+ * results may differ by a few ULPs.
+ */
+class ComplexVectorKernels
+{
+public:
+  /**
+   * The instruction sets used by the kernels
+   */
+  enum InstructionSet
+  {
+    PORTABLE, //!< portable C++ implementation
+    AVX2, //!< AVX2 and FMA implementation
+    AVX512 //!< AVX-512F implementation
+  };
+
+  /**
+   * \return the instruction set currently used by the kernels
+   */
+  static InstructionSet GetInstructionSet (void);
+
+  /**
+   * Force the kernels to use the given instruction set
+   * \param isa the instruction set, which must be supported by the CPU
+   */
+  static void SetInstructionSet (InstructionSet isa);
+
+  /**
+   * \param isa the instruction set
+   * \return true if the kernels can use the given instruction set on this
+   *         CPU and with this build
+   */
+  static bool IsSupported (InstructionSet isa);
+
+  /**
+   * \param isa the instruction set
+   * \return the name of the instruction set
+   */
+  static std::string GetName (InstructionSet isa);
+
+  /**
+   * Adds to y the rows of the matrix x weighted by w, i.e., computes
+   * y[i] += sum_r w[r] * x[r * rowSize + i], for i = 0, ..., rowSize - 1
+   * \param numRows the number of rows of x
+   * \param rowSize the number of columns of x and the size of y
+   * \param w the weights, of size numRows
+   * \param x the matrix, stored in row-major order
+   * \param y the output vector
+   */
+  static void WeightedSum (std::size_t numRows, std::size_t rowSize, const std::complex<double> *w,
+                           const std::complex<double> *x, std::complex<double> *y)
+  {
+    GetKernels ().weightedSum (numRows, rowSize, w, x, y);
+  }
+
+  /**
+   * Computes the sum of w[i] * x[i], for i = 0, ..., n - 1
+   * \param n the size of the vectors
+   * \param w the first vector
+   * \param x the second vector
+   * \return the sum
+   */
+  static std::complex<double> Dot (std::size_t n, const std::complex<double> *w, const std::complex<double> *x)
+  {
+    return GetKernels ().dot (n, w, x);
+  }
+
+  /**
+   * Computes the squared magnitude of the sum of n phasors for numSteps
+   * consecutive steps, where the phasor i at step k is a[i] * s[i]^k:
+   * gain[k] = |sum_i a[i] * s[i]^k|^2, for k = 0, ..., numSteps - 1.
+   * The real and imaginary parts are stored in separate arrays. At the end
+   * a[i] contains a[i] * s[i]^numSteps.
+   * \param n the number of phasors
+   * \param numSteps the number of steps
+   * \param aRe the real part of the initial phasors
+   * \param aIm the imaginary part of the initial phasors
+   * \param sRe the real part of the steps
+   * \param sIm the imaginary part of the steps
+   * \param gain the output vector, of size numSteps
+   */
+  static void PhasorSum (std::size_t n, std::size_t numSteps, double *aRe, double *aIm,
+                         const double *sRe, const double *sIm, double *gain)
+  {
+    GetKernels ().phasorSum (n, numSteps, aRe, aIm, sRe, sIm, gain);
+  }
+
+private:
+  /**
+   * The implementations of the kernels for a given instruction set
+   */
+  struct Kernels
+  {
+    InstructionSet isa; //!< the instruction set
+    void (*weightedSum) (std::size_t, std::size_t, const std::complex<double>*, const std::complex<double>*, std::complex<double>*); //!< the WeightedSum implementation
+    std::complex<double> (*dot) (std::size_t, const std::complex<double>*, const std::complex<double>*); //!< the Dot implementation
+    void (*phasorSum) (std::size_t, std::size_t, double*, double*, const double*, const double*, double*); //!< the PhasorSum implementation
+  };
+
+  /**
+   * \return the kernels currently in use, selecting them if needed
+   */
+  static Kernels& GetKernels (void);
+
+  /**
+   * \param isa the instruction set
+   * \return the implementations for the given instruction set
+   */
+  static Kernels MakeKernels (InstructionSet isa);
+};
+
+} // namespace ns3
+
+#endif // COMPLEX_VECTOR_KERNELS_H
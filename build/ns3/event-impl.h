@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef EVENT_IMPL_H
+#define EVENT_IMPL_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "simple-ref-count.h"
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventImpl declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief A simulation event.
+ *
+ * Each subclass of this base class represents a simulation event. The
+ * Invoke() method will be called by the simulation engine
+ * when it reaches the time associated to this event. Most subclasses
+ * are usually created by one of the many Simulator::Schedule
+ * methods.
+ *
+ * The events are allocated from per-thread pools of fixed-size blocks,
+ * one free list per size class, since most simulations create and
+ * delete millions of small events of a few distinct sizes.  Each block
+ * records its pool, so that an event deleted by another thread than the
+ * one which created it goes back to the pool of the latter.  The pool of
+ * an exited thread is reused by the next thread which allocates an
+ * event.  The pools can be disabled with the GlobalValue
+ * EventImplPoolEnabled, which is read when the first event is allocated.
+ */
+class EventImpl : public SimpleRefCount<EventImpl>
+{
+public:
+  /** Default constructor. */
+  EventImpl ();
+  /** Destructor. */
+  virtual ~EventImpl () = 0;
+  /**
+   * Called by the simulation engine to notify the event that it is time
+   * to execute.
+   */
+  void Invoke (void);
+  /**
+   * Marks the event as 'canceled'. The event is not removed from
+   * the event list but the simulation engine will check its canceled status
+   * before calling Invoke().
+   */
+  void Cancel (void);
+  /**
+   * \returns true if the event has been canceled.
+   *
+   * Checked by the simulation engine before calling Invoke().
+   */
+  bool IsCancelled (void);
+
+  /**
+   * Allocate the memory of an event from the pool of the calling thread.
+   *
+   * \param [in] size The size of the event, in bytes.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Return the memory of an event to the pool which allocated it.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event, in bytes.
+   */
+  static void operator delete (void *p, std::size_t size);
+
+  /** Statistics of the event allocator of a thread. */
+  struct AllocatorStats
+  {
+    uint64_t allocations;   //!< Number of events allocated.
+    uint64_t deallocations; //!< Number of events deleted.
+    uint64_t remote;        //!< Number of blocks deleted by other threads and returned to the pool.
+    uint64_t reused;        //!< Number of allocations served from a free list.
+    uint64_t unpooled;      //!< Number of allocations too large for the pools, or with the pools disabled.
+    uint64_t chunks;        //!< Number of memory chunks carved into blocks.
+    uint64_t bytes;         //!< Total size of the chunks, in bytes.
+  };
+  /**
+   * Get the statistics of the event allocator of the calling thread.
+   *
+   * They include the events of the previous owners of its pool.
+   *
+   * \returns The allocator statistics.
+   */
+  static AllocatorStats GetAllocatorStats (void);
+  /**
+   * Check whether the events are allocated from the pools.
+   *
+   * \returns \c true if the pools are enabled.
+   */
+  static bool IsPoolEnabled (void);
+
+protected:
+  /**
+   * Implementation for Invoke().
+   *
+   * This typically calls a method or function pointer with the
+   * arguments bound by a call to one of the MakeEvent() functions.
+   */
+  virtual void Notify (void) = 0;
+
+private:
+  bool m_cancel;  /**< Has this event been cancelled. */
+};
+
+} // namespace ns3
+
+#endif /* EVENT_IMPL_H */
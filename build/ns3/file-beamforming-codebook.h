@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FILE_BEAMFORMING_CODEBOOK_H
+#define FILE_BEAMFORMING_CODEBOOK_H
+
+#include "ns3/object.h"
+#include "ns3/beamforming-codebook.h"
+#include "ns3/complex-3d-array.h"
+#include <map>
+
+namespace ns3 {
+namespace mmwave {
+
+
+/**
+ * Codebook imported from a file. The codewords are stored in a process-wide
+ * registry, indexed by file and array geometry, so that all the codebooks
+ * created from the same file for arrays with the same geometry share the
+ * same storage and the file is parsed only once.
+ */
+class FileBeamformingCodebook : public BeamformingCodebook
+{
+public:
+  FileBeamformingCodebook ();
+  virtual ~FileBeamformingCodebook () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   *
+   */
+  CodewordView GetCodeword (uint32_t idx) const override;
+
+  /**
+   *
+   */
+  uint32_t GetCodebookSize (void) const override;
+
+  /**
+   * \return the number of codebooks stored in the registry
+   */
+  static std::size_t GetNumRegisteredCodebooks (void);
+
+  /**
+   * \return the memory used by the codewords stored in the registry, in bytes
+   */
+  static std::size_t GetRegisteredCodewordsSize (void);
+
+protected:
+  virtual void DoDispose (void) override;
+
+private:
+  /**
+   * Immutable codewords shared by all the codebooks created from the same
+   * file for arrays with the same geometry
+   */
+  struct Codewords : public SimpleRefCount<Codewords>
+  {
+    uint32_t m_codebookSize {0}; //!< the number of codewords
+    uint32_t m_codewordSize {0}; //!< the number of elements of each codeword
+    std::vector<std::complex<double>, AlignedAllocator<std::complex<double>, Complex3DArray::ALIGNMENT> > m_values; //!< the codewords, stored contiguously
+  };
+
+  /**
+   * \return the registry of the imported codewords, indexed by the key
+   *         returned by GetRegistryKey
+   */
+  static std::map<std::string, Ptr<const Codewords> >& GetRegistry (void);
+
+  /**
+   * \return the key identifying the codebook file and the geometry of the array
+   */
+  std::string GetRegistryKey (void) const;
+
+  /**
+   * Releases the codewords, and removes them from the registry if no other
+   * codebook uses them
+   */
+  void ReleaseCodewords (void);
+
+  /**
+   *
+   */
+  virtual void DoInitialize (void) override;
+
+  /**
+   * Parses the codebook file
+   * \return the imported codewords
+   */
+  Ptr<Codewords> ImportCodebookFromFile (void) const;
+
+  /**
+   *
+   */
+  void ValidateAntenna (std::ifstream &cbFile) const;
+
+  /**
+   *
+   */
+  static PhasedArrayModel::ComplexVector ParseCodeword (const std::string& line, uint32_t cwSize);
+
+  std::string m_codebookFilename;
+  std::string m_registryKey; //!< the key of the codewords in the registry
+  Ptr<const Codewords> m_codewords; //!< the codewords
+};
+
+
+} // namespace mmwave
+} // namespace ns3
+
+#endif /* FILE_BEAMFORMING_CODEBOOK_H */
@@ -0,0 +1,130 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_MMWAVE_SINR_TABLE_H
+#define LTE_MMWAVE_SINR_TABLE_H
+
+#include <stdint.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief The SINRs of the UEs reported by the mmWave cells to the LTE
+ * coordinator, with the cell with the maximum SINR of each UE
+ *
+ * The SINRs of a UE are stored in a dense array indexed by a compact index
+ * of the cells, assigned when a cell reports for the first time, and the
+ * cell with the maximum SINR is updated with each SINR reported. Its SINR
+ * is compared with the SINRs of the other cells only when it decreases.
+ *
+ * A SINR which was not reported is 0, and the cell with the maximum SINR
+ * is the one with the lowest cell ID among the cells with the maximum
+ * positive SINR, or 0 if no cell reported a positive SINR for the UE.
+ */
+class LteMmWaveSinrTable
+{
+public:
+  /// The SINRs of a UE
+  struct UeSinrs
+  {
+    std::vector<double> sinr; ///< the SINR of each cell, by cell index
+    uint16_t maxSinrCellId; ///< the cell with the maximum SINR, 0 if none
+    double maxSinr; ///< the maximum SINR, 0 if none
+  };
+
+  /// Iterator on the UEs, in increasing order of IMSI
+  typedef std::map<uint64_t, UeSinrs>::const_iterator ConstIterator;
+
+  LteMmWaveSinrTable ();
+
+  /**
+   * Store the SINRs reported by a cell
+   * \param cellId the cell
+   * \param imsiSinrMap the SINR of each UE reported by the cell
+   */
+  void Update (uint16_t cellId, const std::map<uint64_t, double> &imsiSinrMap);
+
+  /**
+   * Store a SINR reported by a cell
+   * \param cellId the cell
+   * \param imsi the UE
+   * \param sinr the SINR
+   */
+  void Update (uint16_t cellId, uint64_t imsi, double sinr);
+
+  /**
+   * \param imsi the UE
+   * \param cellId the cell
+   * \return the SINR reported by the cell for the UE, 0 if not reported
+   */
+  double GetSinr (uint64_t imsi, uint16_t cellId) const;
+
+  /**
+   * \param it the UE
+   * \param cellId the cell
+   * \return the SINR reported by the cell for the UE, 0 if not reported
+   */
+  double GetSinr (ConstIterator it, uint16_t cellId) const;
+
+  /// \return the number of UEs with a reported SINR
+  std::size_t GetNUes (void) const;
+
+  /// \return the number of cells which reported a SINR
+  std::size_t GetNCells (void) const;
+
+  /// \return an iterator to the first UE
+  ConstIterator Begin (void) const;
+
+  /// \return an iterator past the last UE
+  ConstIterator End (void) const;
+
+  /// Remove all the SINRs and cells
+  void Clear (void);
+
+private:
+  /**
+   * \param cellId the cell
+   * \return the index of the cell, assigned if the cell is new
+   */
+  uint32_t GetCellIndex (uint16_t cellId);
+
+  /**
+   * Store a SINR of a UE
+   * \param ue the SINRs of the UE
+   * \param cellIndex the index of the cell
+   * \param sinr the SINR
+   */
+  void Update (UeSinrs &ue, uint32_t cellIndex, double sinr);
+
+  /**
+   * Find the cell with the maximum SINR comparing all the cells
+   * \param ue the SINRs of the UE
+   */
+  void FindMaxSinrCell (UeSinrs &ue) const;
+
+  std::unordered_map<uint16_t, uint32_t> m_cellIndices; ///< the index of each cell
+  std::vector<uint16_t> m_cellIds; ///< the cell of each index
+  std::map<uint64_t, UeSinrs> m_ues; ///< the SINRs of each UE
+};
+
+} // namespace ns3
+
+#endif /* LTE_MMWAVE_SINR_TABLE_H */
@@ -0,0 +1,98 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+*   Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering, New York University
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*   Author: Marco Miozzo <marco.miozzo@cttc.es>
+*           Nicola Baldo  <nbaldo@cttc.es>
+*
+*   Modified by: Marco Mezzavilla < mezzavilla@nyu.edu>
+*                         Sourjya Dutta <sdutta@nyu.edu>
+*                         Russell Ford <russell.ford@nyu.edu>
+*                         Menglei Zhang <menglei@nyu.edu>
+*/
+
+
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_AMC_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_AMC_H_
+#include <ns3/object.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/mmwave-phy-mac-common.h>
+
+namespace ns3 {
+
+namespace mmwave {
+
+class MmWaveAmc : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  MmWaveAmc ();
+  MmWaveAmc (Ptr<MmWavePhyMacCommon> ConfigParams);
+  virtual ~MmWaveAmc ();
+  enum AmcModel
+  {
+    PiroEW2010,
+    MiErrorModel             // model based on 10% of BER according to LteMiErrorModel
+  };
+
+  int GetMcsFromCqi (int cqi);
+  int GetTbSizeFromMcs (unsigned mcs, unsigned nprb);
+  int GetTbSizeFromMcsSymbols (unsigned mcs, unsigned nsym);        // for TDMA
+  int GetNumSymbolsFromTbsMcs (unsigned tbSize, unsigned mcs);
+  std::vector<int> CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize);
+  std::vector<int> CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym);
+  int CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, uint32_t tbs, int &mcsWb);
+  int GetCqiFromSpectralEfficiency (double s);
+  int GetMcsFromSpectralEfficiency (double s);
+
+  static const unsigned int m_crcLen = 24;
+
+private:
+  /**
+   * \brief find, with the MI error model, the highest MCS whose TB error rate
+   * does not exceed 10%
+   *
+   * The mmib of the RBs is computed once per modulation. Since the TB error
+   * rate increases with the MCS for a given modulation, the first MCS
+   * exceeding 10% is found with a binary search over the MCSs of each
+   * modulation, unless m_binaryMcsSearch is false. Both searches select the
+   * same MCS as testing all the MCSs in increasing order.
+   *
+   * \param sinr the perceived sinrs in the whole bandwidth
+   * \param map the RBs of the TB
+   * \param tbSizes the size in bytes of the TB for each MCS in [0..28]
+   * \param tbler the TB error rate of the first MCS exceeding 10%, or of
+   *        MCS 28 if none does
+   * \return the MCS, 0 if no MCS achieves 10%
+   */
+  uint8_t GetMcsFromMiErrorModel (const SpectrumValue& sinr, const std::vector<int>& map,
+                                  const std::vector<uint32_t>& tbSizes, double &tbler);
+
+  double m_ber;
+  AmcModel m_amcModel;
+  bool m_binaryMcsSearch; //!< whether the MCS is found with a binary search
+
+  Ptr<MmWavePhyMacCommon> m_phyMacConfig;
+  Ptr<SpectrumModel> m_lteRbModel;
+};
+
+} // end namespace mmwave
+
+} // end namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_AMC_H_ */
@@ -0,0 +1,566 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_RANKED_MAC_SCHEDULER_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_RANKED_MAC_SCHEDULER_H_
+
+#include "mmwave-mac-sched-sap.h"
+#include "mmwave-mac-csched-sap.h"
+#include "mmwave-mac-scheduler.h"
+#include "mmwave-amc.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <algorithm>
+
+namespace ns3 {
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief The state of a UE in MmWaveFlexTtiRankedMacScheduler
+ *
+ * The state used by the scheduler in each slot (buffers, CQIs and HARQ
+ * processes) is kept in a single structure per UE, so that a slot is
+ * scheduled without looking up the UEs in maps.
+ */
+struct MmWaveFlexTtiRankedUeInfo
+{
+  /// The buffer of a DL logical channel or of an UL logical channel group
+  struct FlowStats
+  {
+    /**
+     * Constructor
+     * \param lcid the LCID (DL) or LCG ID (UL)
+     */
+    FlowStats (uint8_t lcid)
+      : m_lcid (lcid),
+        m_qci (0),
+        m_txQueueHolDelay (0),
+        m_deadlineUs (0),
+        m_totalBufSize (0)
+    {
+    }
+
+    uint8_t m_lcid; //!< the LCID (DL) or LCG ID (UL)
+    uint8_t m_qci; //!< the QCI of the bearer
+    double m_txQueueHolDelay; //!< the delay of the head-of-line packet, in microseconds
+    double m_deadlineUs; //!< the delay budget of the packets, in microseconds
+    uint32_t m_totalBufSize; //!< the bytes buffered
+    std::deque<uint32_t> m_txPacketSizes; //!< the sizes of the packets buffered
+    std::deque<double> m_txPacketDelays; //!< the delays of the packets buffered, in microseconds
+  };
+
+  /**
+   * Constructor
+   * \param rnti the RNTI
+   */
+  MmWaveFlexTtiRankedUeInfo (uint16_t rnti);
+
+  /**
+   * Reset the buffers and the metrics of the UE, as for a new UE
+   */
+  void ResetSchedInfo (void);
+
+  uint16_t m_rnti; //!< the RNTI
+  bool m_configured; //!< true if the UE is configured, false if only its CQIs are known
+  bool m_allocated; //!< true if the UE got resources in the current slot
+
+  // allocation of the current slot
+  uint8_t m_dlMcs; //!< the DL MCS
+  uint8_t m_ulMcs; //!< the UL MCS
+  uint8_t m_dlSymbols; //!< the DL symbols allocated to new data
+  uint8_t m_ulSymbols; //!< the UL symbols allocated to new data
+  uint8_t m_dlSymbolsRetx; //!< the DL symbols allocated to HARQ retransmissions
+  uint8_t m_ulSymbolsRetx; //!< the UL symbols allocated to HARQ retransmissions
+  uint32_t m_dlTbSize; //!< the DL TB size, in bytes
+  uint32_t m_ulTbSize; //!< the UL TB size, in bytes
+  uint32_t m_totBufDl; //!< the DL bytes to schedule
+  uint32_t m_totBufUl; //!< the UL bytes to schedule
+  bool m_dlAllocDone; //!< true if no more DL symbols are needed
+  bool m_ulAllocDone; //!< true if no more UL symbols are needed
+  bool m_allocUlLast; //!< true if the last symbol was allocated to the UL
+  std::vector<RlcPduInfo> m_rlcPduInfo; //!< the DL RLC PDUs of the slot
+
+  // metrics available to the ranking policies
+  double m_currTputDl; //!< the DL throughput of the allocation
+  double m_currTputUl; //!< the UL throughput of the allocation
+  double m_avgTputDl; //!< the average DL throughput
+  double m_avgTputUl; //!< the average UL throughput
+  double m_lastAvgTputDl; //!< the average DL throughput when the DL buffer was last served
+  double m_lastAvgTputUl; //!< the average UL throughput when the UL buffer was last served
+
+  std::vector<FlowStats> m_flowStatsDl; //!< the DL logical channels, by LCID
+  std::vector<FlowStats> m_flowStatsUl; //!< the UL logical channel groups, by LCG ID
+
+  // channel quality
+  bool m_dlCqiValid; //!< true if a DL CQI was received and has not expired
+  uint8_t m_dlCqi; //!< the wideband DL CQI
+  uint8_t m_dlCqiMcs; //!< the DL MCS of m_dlCqi
+  uint32_t m_dlCqiTimer; //!< the TTIs before the DL CQI expires
+  bool m_ulCqiValid; //!< true if an UL SINR was received and has not expired
+  bool m_ulCqiChanged; //!< true if the UL SINR changed since the UL CQI was computed
+  std::vector<double> m_ulSinr; //!< the UL SINR of each chunk
+  uint8_t m_ulSinrNumSym; //!< the symbols of the TB of the UL SINR
+  uint32_t m_ulSinrTbSize; //!< the size of the TB of the UL SINR
+  uint32_t m_ulCqiTimer; //!< the TTIs before the UL SINR expires
+  int m_ulCqi; //!< the wideband UL CQI of the UL SINR
+  int m_ulCqiMcs; //!< the UL MCS of the UL SINR
+
+  // HARQ processes, by process ID, empty if the UE is not configured
+  std::vector<uint8_t> m_dlHarqStatus; //!< 0 if the DL process is available, else its transmission count
+  std::vector<uint8_t> m_dlHarqTimer; //!< the TTIs since the DL process was used
+  std::vector<DciInfoElementTdma> m_dlHarqDci; //!< the DCI of each DL process
+  std::vector<std::vector<RlcPduInfo> > m_dlHarqRlcPdu; //!< the RLC PDUs of each DL process
+  std::vector<uint8_t> m_ulHarqStatus; //!< 0 if the UL process is available, else its transmission count
+  std::vector<uint8_t> m_ulHarqTimer; //!< the TTIs since the UL process was used
+  std::vector<DciInfoElementTdma> m_ulHarqDci; //!< the DCI of each UL process
+};
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief How MmWaveFlexTtiRankedMacScheduler allocates the symbols left
+ * after the HARQ retransmissions
+ */
+enum MmWaveFlexTtiRanking
+{
+  RANK_UES, ///< one symbol at a time to the UE with the highest Policy::GetMetric
+  RANK_MCS, ///< one symbol at a time to the UEs in decreasing order of MCS
+  RANK_DEADLINES ///< the head-of-line packets of the flows, earliest deadline first
+};
+
+template <class Policy>
+class MmWaveFlexTtiRankedMacSchedSapProvider;
+template <class Policy>
+class MmWaveFlexTtiRankedMacCschedSapProvider;
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief Flex-TTI MAC scheduler which allocates the OFDM symbols of a slot
+ * in the order given by a policy
+ *
+ * The SAPs, the CQIs, the buffers and the HARQ retransmissions are handled
+ * once for all the policies, with the state of the UEs in contiguous
+ * storage. The policies implement MmWaveFlexTtiPfMacScheduler,
+ * MmWaveFlexTtiMaxRateMacScheduler and MmWaveFlexTtiMaxWeightMacScheduler,
+ * with the allocations of their former standalone implementations.
+ *
+ * The Policy class provides
+ * - static const char* GetTypeName (void), returning the name of the TypeId
+ *   of the scheduler;
+ * - static const MmWaveFlexTtiRanking RANKING, the allocation of the symbols;
+ * - static const bool ADD_HEADERS, true to add the RLC and MAC headers to
+ *   the DL RLC PDUs and to the UL buffers;
+ * - static const bool RELEASE_UE_INFO, true to reset the buffers and the
+ *   metrics of a UE when it is released;
+ * - with RANK_UES, static double GetMetric (const MmWaveFlexTtiRankedUeInfo &ue),
+ *   returning the metric of a UE, the UEs with the highest metric being
+ *   ranked first.
+ *
+ * The scheduler is instantiated for each policy in
+ * mmwave-flex-tti-ranked-mac-scheduler.cc.
+ */
+template <class Policy>
+class MmWaveFlexTtiRankedMacScheduler : public MmWaveMacScheduler
+{
+public:
+  /// The order of the flows with RANK_DEADLINES
+  enum Algorithm
+  {
+    EDF, ///< earliest deadline first
+    DELIVERY_DEBT ///< not implemented, no new data is scheduled
+  };
+
+  MmWaveFlexTtiRankedMacScheduler ();
+  virtual ~MmWaveFlexTtiRankedMacScheduler ();
+  virtual void DoDispose (void) override;
+  static TypeId GetTypeId (void);
+
+  virtual void SetMacSchedSapUser (MmWaveMacSchedSapUser* sap) override;
+  virtual void SetMacCschedSapUser (MmWaveMacCschedSapUser* sap) override;
+
+  virtual MmWaveMacSchedSapProvider* GetMacSchedSapProvider () override;
+  virtual MmWaveMacCschedSapProvider* GetMacCschedSapProvider () override;
+
+  virtual void ConfigureCommonParameters (Ptr<MmWavePhyMacCommon> config) override;
+
+  friend class MmWaveFlexTtiRankedMacSchedSapProvider<Policy>;
+  friend class MmWaveFlexTtiRankedMacCschedSapProvider<Policy>;
+
+private:
+  /// Tag selecting the allocation of a MmWaveFlexTtiRanking
+  template <MmWaveFlexTtiRanking R>
+  struct RankingTag
+  {
+  };
+
+  /// A DL or UL flow of a UE, ordered by deadline with RANK_DEADLINES
+  struct FlowRef
+  {
+    /**
+     * Constructor
+     * \param ue the index of the UE in m_ues
+     * \param uplink true for an UL flow
+     * \param lcid the LCID (DL) or LCG ID (UL)
+     */
+    FlowRef (uint32_t ue, bool uplink, uint8_t lcid)
+      : m_ue (ue),
+        m_uplink (uplink),
+        m_lcid (lcid)
+    {
+    }
+
+    uint32_t m_ue; //!< the index of the UE in m_ues
+    bool m_uplink; //!< true for an UL flow
+    uint8_t m_lcid; //!< the LCID (DL) or LCG ID (UL)
+  };
+
+  /// The UEs allocated in an UL TTI, used to map the UL SINRs to the UEs
+  struct AllocMapElem
+  {
+    AllocMapElem (std::vector<uint16_t> rntiPerChunk, uint8_t nSym, uint32_t tbs)
+      : m_rntiPerChunk (rntiPerChunk),
+        m_numSym (nSym),
+        m_tbSize (tbs)
+    {
+    }
+
+    std::vector<uint16_t> m_rntiPerChunk; //!< the RNTI of each chunk
+    uint8_t m_numSym; //!< the symbols of the TB
+    uint32_t m_tbSize; //!< the size of the TB
+  };
+
+  /**
+   * \param rnti the RNTI
+   * \return the index of the UE in m_ues, or m_ues.size () if unknown
+   */
+  uint32_t FindUe (uint16_t rnti) const;
+
+  /**
+   * \param rnti the RNTI
+   * \return the index of the UE in m_ues, added if unknown
+   */
+  uint32_t FindOrAddUe (uint16_t rnti);
+
+  /**
+   * \param flow the flow
+   * \return the buffer of the flow
+   */
+  MmWaveFlexTtiRankedUeInfo::FlowStats& GetFlowStats (const FlowRef &flow);
+
+  /**
+   * \param lflow the first flow
+   * \param rflow the second flow
+   * \return true if the relative deadline of lflow is earlier than the one
+   * of rflow
+   */
+  bool CompareFlowDeadlines (const FlowRef &lflow, const FlowRef &rflow);
+
+  /**
+   * \param val the BSR index
+   * \return the buffer size of the BSR index
+   */
+  uint32_t BsrId2BufferSize (uint8_t val) const;
+
+  /**
+   * Decrease the timers of the CQIs and remove the CQIs expired
+   */
+  void RefreshCqis (void);
+
+  /**
+   * Refresh the HARQ processes according to the timers
+   */
+  void RefreshHarqProcesses (void);
+
+  /**
+   * Compute the UL CQI and MCS of a UE from the last UL SINR
+   * \param ue the UE
+   * \param mcs the UL MCS
+   * \return the wideband UL CQI
+   */
+  int GetUlCqi (MmWaveFlexTtiRankedUeInfo &ue, int &mcs);
+
+  /**
+   * \param ue the UE
+   * \return the DL HARQ process ID of a new TB, the number of processes if
+   * none is available
+   */
+  uint8_t UpdateDlHarqProcessId (MmWaveFlexTtiRankedUeInfo &ue);
+
+  /**
+   * \param ue the UE
+   * \return the UL HARQ process ID of a new TB, the number of processes if
+   * none is available
+   */
+  uint8_t UpdateUlHarqProcessId (MmWaveFlexTtiRankedUeInfo &ue);
+
+  /**
+   * Add a UE to the UEs allocated in the current slot
+   * \param ueIdx the index of the UE in m_ues
+   */
+  void AddAllocatedUe (uint32_t ueIdx);
+
+  /**
+   * Schedule the DL and UL HARQ retransmissions
+   * \param ret the allocation of the slot
+   * \param symAvail the symbols available
+   * \param symIdx the index of the next symbol
+   * \param ttiIdx the index of the next TTI
+   */
+  void ScheduleHarqRetx (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret,
+                         int &symAvail, uint8_t &symIdx, uint8_t &ttiIdx);
+
+  /**
+   * Compute the MCSs, the buffers and the throughputs of the UEs with
+   * RANK_UES and RANK_MCS
+   */
+  void UpdateCandidates (void);
+
+  /**
+   * Allocate a symbol to the DL or the UL of a UE, if needed
+   * \param ue the UE
+   * \param symAvail the symbols available
+   * \return true if a symbol was allocated
+   */
+  bool AllocateSymbol (MmWaveFlexTtiRankedUeInfo &ue, int &symAvail);
+
+  /**
+   * Allocate the symbols to the UEs ranked first by the policy
+   * \param symAvail the symbols available
+   */
+  void AllocateSymbols (int &symAvail, RankingTag<RANK_UES>);
+
+  /**
+   * Allocate the symbols to the UEs in decreasing order of MCS
+   * \param symAvail the symbols available
+   */
+  void AllocateSymbols (int &symAvail, RankingTag<RANK_MCS>);
+
+  /**
+   * Allocate the symbols to the head-of-line packets of the flows, earliest
+   * deadline first
+   * \param symAvail the symbols available
+   */
+  void AllocateSymbols (int &symAvail, RankingTag<RANK_DEADLINES>);
+
+  /**
+   * Allocate the symbols needed by the head-of-line packet of a flow
+   * \param flow the flow
+   * \param ue the UE of the flow
+   * \param uplink true for an UL flow
+   * \param symAvail the symbols available
+   */
+  void AllocatePacket (MmWaveFlexTtiRankedUeInfo::FlowStats &flow, MmWaveFlexTtiRankedUeInfo &ue,
+                       bool uplink, int &symAvail);
+
+  /**
+   * Split the TB of a DL DCI among the RLC PDUs of the UE
+   * \param ue the UE
+   * \param dci the DL DCI
+   * \param ttiInfo the TTI of the DCI
+   */
+  void AddRlcPdus (MmWaveFlexTtiRankedUeInfo &ue, const DciInfoElementTdma &dci, TtiAllocInfo &ttiInfo);
+
+  /**
+   * Create the DCIs of the DL and UL symbols allocated to new data
+   * \param ret the allocation of the slot
+   * \param symIdx the index of the next symbol
+   * \param ttiIdx the index of the next TTI
+   */
+  void CreateDcis (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret, uint8_t symIdx, uint8_t ttiIdx);
+
+  /**
+   * Reset the allocation of the UEs allocated in the slot
+   */
+  void ResetAllocation (void);
+
+  /**
+   * Add the UL control TTI and send the allocation of the slot
+   * \param ret the allocation of the slot
+   */
+  void SendAllocation (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret);
+
+  /**
+   * \param tid the TypeId of the scheduler
+   * \return the TypeId, with the attributes of the policy
+   */
+  static TypeId AddPolicyAttributes (TypeId tid);
+
+  //
+  // Implementation of the CSCHED API primitives
+  // (See 4.1 for description of the primitives)
+  //
+
+  void DoCschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params);
+
+  void DoCschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params);
+
+  void DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params);
+
+  void DoCschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+
+  void DoCschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+
+  //
+  // Implementation of the SCHED API primitives
+  // (See 4.2 for description of the primitives)
+  //
+
+  void DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+
+  void DoSchedDlCqiInfoReq (const MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+
+  void DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+
+  void DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+
+  void DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params);
+
+  void DoSchedSetMcs (int mcs);
+
+  Ptr<MmWaveAmc> m_amc; //!< the AMC
+
+  /// The UEs, in the order they were first known. The indices are stable.
+  std::vector<MmWaveFlexTtiRankedUeInfo> m_ues;
+  /// The indices of the UEs in m_ues, in increasing RNTI order
+  std::vector<uint32_t> m_ueOrder;
+  /// The UEs allocated in the current slot, as indices in m_ues
+  std::vector<uint32_t> m_allocated;
+  /// The UEs ranked with RANK_UES, as indices in m_ues
+  std::vector<uint32_t> m_ueStatHeap;
+  /// The metrics of the UEs with RANK_UES, by index in m_ues
+  std::vector<double> m_ueMetrics;
+  /// The UEs of each MCS with RANK_MCS, as indices in m_ues
+  std::vector<std::vector<uint32_t> > m_ueMcsList;
+  /// The flows ranked with RANK_DEADLINES
+  std::vector<FlowRef> m_flowHeap;
+
+  uint32_t m_cqiTimersThreshold; //!< the TTIs for which a CQI is valid
+  uint8_t m_tbUid; //!< the process ID of the next TB, without HARQ
+  uint8_t m_dlNoCqiMcs; //!< the DL MCS of the UEs without DL CQI
+
+  MmWaveMacSchedSapProvider* m_macSchedSapProvider; //!< the SCHED SAP provider
+  MmWaveMacSchedSapUser* m_macSchedSapUser; //!< the SCHED SAP user
+  MmWaveMacCschedSapUser* m_macCschedSapUser; //!< the CSCHED SAP user
+  MmWaveMacCschedSapProvider* m_macCschedSapProvider; //!< the CSCHED SAP provider
+
+  MmWaveMacCschedSapProvider::CschedCellConfigReqParameters m_cschedCellConfig; //!< the cell configuration
+
+  /// The previous UL allocations, by SfnSf of the first symbol
+  std::map<uint32_t, struct AllocMapElem> m_ulAllocationMap;
+
+  bool m_harqOn; //!< false to disable the HARQ
+  std::vector<DlHarqInfo> m_dlHarqInfoList; //!< the DL HARQ feedback not served yet
+  std::vector<UlHarqInfo> m_ulHarqInfoList; //!< the UL HARQ feedback not served yet
+
+  static const unsigned m_subHdrSize; //!< the size of the MAC subheader
+  static const unsigned m_rlcHdrSize; //!< the size of the RLC header
+
+  bool m_fixedMcsDl; //!< unused, kept for the compatibility of the attributes
+  bool m_fixedMcsUl; //!< unused, kept for the compatibility of the attributes
+  uint8_t m_mcsDefaultDl; //!< unused, kept for the compatibility of the attributes
+  uint8_t m_mcsDefaultUl; //!< unused, kept for the compatibility of the attributes
+  bool m_dlOnly; //!< unused, kept for the compatibility of the attributes
+  bool m_ulOnly; //!< unused, kept for the compatibility of the attributes
+  bool m_fixedTti; //!< true to allocate m_symPerSlot symbols at a time with RANK_DEADLINES
+  uint8_t m_symPerSlot; //!< the symbols per TTI with fixed TTIs
+  double m_timeWindow; //!< the time window of the average throughputs, in slots
+  Algorithm m_algorithm; //!< the order of the flows with RANK_DEADLINES
+};
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief Proportional fair policy of MmWaveFlexTtiRankedMacScheduler
+ */
+struct MmWaveFlexTtiPfPolicy
+{
+  static const MmWaveFlexTtiRanking RANKING = RANK_UES; //!< the UEs are ranked by PF metric
+  static const bool ADD_HEADERS = true; //!< the headers are added to the buffers
+  static const bool RELEASE_UE_INFO = false; //!< the UEs released keep their state
+
+  /// \return the name of the TypeId of the scheduler
+  static const char* GetTypeName (void)
+  {
+    return "ns3::MmWaveFlexTtiPfMacScheduler";
+  }
+
+  /**
+   * The average throughput is the DL one counted twice, as in the former
+   * implementation of MmWaveFlexTtiPfMacScheduler.
+   *
+   * \param ue the UE
+   * \return the PF metric of the UE
+   */
+  static double GetMetric (const MmWaveFlexTtiRankedUeInfo &ue)
+  {
+    return std::max (ue.m_currTputDl,ue.m_currTputUl) / std::max (1E-9,(ue.m_avgTputDl + ue.m_avgTputDl));
+  }
+};
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief Maximum rate policy of MmWaveFlexTtiRankedMacScheduler
+ */
+struct MmWaveFlexTtiMaxRatePolicy
+{
+  static const MmWaveFlexTtiRanking RANKING = RANK_MCS; //!< the UEs are served by decreasing MCS
+  static const bool ADD_HEADERS = false; //!< the buffers are scheduled without headers
+  static const bool RELEASE_UE_INFO = true; //!< the state of the UEs released is reset
+
+  /// \return the name of the TypeId of the scheduler
+  static const char* GetTypeName (void)
+  {
+    return "ns3::MmWaveFlexTtiMaxRateMacScheduler";
+  }
+};
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief Maximum weight policy of MmWaveFlexTtiRankedMacScheduler
+ */
+struct MmWaveFlexTtiMaxWeightPolicy
+{
+  static const MmWaveFlexTtiRanking RANKING = RANK_DEADLINES; //!< the flows are served earliest deadline first
+  static const bool ADD_HEADERS = false; //!< unused, the headers are added to each packet
+  static const bool RELEASE_UE_INFO = false; //!< the UEs released keep their state
+
+  /// \return the name of the TypeId of the scheduler
+  static const char* GetTypeName (void)
+  {
+    return "ns3::MmWaveFlexTtiMaxWeightMacScheduler";
+  }
+};
+
+/// Flex-TTI proportional fair MAC scheduler
+typedef MmWaveFlexTtiRankedMacScheduler<MmWaveFlexTtiPfPolicy> MmWaveFlexTtiPfMacScheduler;
+/// Flex-TTI maximum rate MAC scheduler
+typedef MmWaveFlexTtiRankedMacScheduler<MmWaveFlexTtiMaxRatePolicy> MmWaveFlexTtiMaxRateMacScheduler;
+/// Flex-TTI maximum weight MAC scheduler
+typedef MmWaveFlexTtiRankedMacScheduler<MmWaveFlexTtiMaxWeightPolicy> MmWaveFlexTtiMaxWeightMacScheduler;
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_FLEX_TTI_RANKED_MAC_SCHEDULER_H_ */
@@ -0,0 +1,82 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MMWAVE_SPECTRUM_TRANSMIT_FILTER_H
+#define MMWAVE_SPECTRUM_TRANSMIT_FILTER_H
+
+#include "ns3/spectrum-transmit-filter.h"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ *
+ * Transmit filter discarding the signals directed to a MmWaveSpectrumPhy
+ * which would anyway be neglected by MmWaveSpectrumPhy::StartRx, i.e.:
+ * - BS to BS and UE to UE signals,
+ * - DL CTRL frames directed to UEs which are not synchronized with the
+ *   transmitting cell. Since the interference is not considered for the
+ *   CTRL frames, these frames are only delivered to the UEs of the cell.
+ * Installing this filter on the channel avoids computing the propagation
+ * loss, and generating the channel matrix, for these pairs of devices.
+ * The number of signals filtered out for each reason is exported through the
+ * BsToBsFiltered, UeToUeFiltered and DlCtrlFiltered trace sources.
+ */
+class MmWaveSpectrumTransmitFilter : public SpectrumTransmitFilter
+{
+public:
+  MmWaveSpectrumTransmitFilter ();
+  virtual ~MmWaveSpectrumTransmitFilter ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \return the number of BS to BS signals filtered out
+   */
+  uint64_t GetBsToBsFiltered (void) const;
+
+  /**
+   * \return the number of UE to UE signals filtered out
+   */
+  uint64_t GetUeToUeFiltered (void) const;
+
+  /**
+   * \return the number of DL CTRL frames filtered out because the receiver
+   *         does not belong to the transmitting cell
+   */
+  uint64_t GetDlCtrlFiltered (void) const;
+
+private:
+  // inherited from SpectrumTransmitFilter
+  bool DoFilter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) override;
+
+  TracedValue<uint64_t> m_bsToBsFiltered; //!< number of BS to BS signals filtered out
+  TracedValue<uint64_t> m_ueToUeFiltered; //!< number of UE to UE signals filtered out
+  TracedValue<uint64_t> m_dlCtrlFiltered; //!< number of DL CTRL frames directed to UEs of other cells filtered out
+};
+
+} // namespace mmwave
+} // namespace ns3
+
+#endif /* MMWAVE_SPECTRUM_TRANSMIT_FILTER_H */
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PHILOX_RNG_H
+#define PHILOX_RNG_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::PhiloxRng declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup rngimpl
+ *
+ * \brief Counter-based random number generator Philox4x32-10
+ *
+ * The generator is a keyed bijection of a 128-bit counter, described in
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel random
+ * numbers: as easy as 1, 2, 3", SC'11.
+ *
+ * Unlike RngStream, whose output depends on all the values previously drawn
+ * from the stream, the output of this generator only depends on the key and
+ * on the counter. Hence, a model can create an independent sequence for each
+ * of its entities, e.g., the links between pairs of nodes, by using an
+ * identifier of the entity as the most significant bits of the counter, and
+ * draw the values of each entity in any order.
+ */
+class PhiloxRng
+{
+public:
+  /**
+   * Construct a generator with a null key and counter.
+   */
+  PhiloxRng ();
+
+  /**
+   * Construct a generator whose sequence is identified by the key and by
+   * the 96 most significant bits of the counter. The least significant 32
+   * bits of the counter are incremented as the values are drawn, hence each
+   * sequence contains 2^33 values.
+   *
+   * \param [in] key The key.
+   * \param [in] counterHigh The 64 most significant bits of the counter.
+   * \param [in] counterMid The following 32 bits of the counter.
+   */
+  PhiloxRng (uint64_t key, uint64_t counterHigh, uint32_t counterMid);
+
+  /**
+   * Generate the next random number of the sequence.
+   * Uniformly distributed between 0 and 1, both excluded.
+   *
+   * \returns The next random.
+   */
+  double RandU01 (void);
+
+  /**
+   * Apply the Philox4x32-10 bijection.
+   *
+   * \param [in] key The key.
+   * \param [in] counter The counter.
+   * \param [out] result The result.
+   */
+  static void Generate (const uint32_t key[2], const uint32_t counter[4], uint32_t result[4]);
+
+private:
+  uint32_t m_key[2];     //!< The key.
+  uint32_t m_counter[4]; //!< The counter of the next block.
+  uint32_t m_block[4];   //!< The last generated block.
+  uint8_t m_next;        //!< The index of the next unused word of m_block.
+};
+
+} // namespace ns3
+
+#endif /* PHILOX_RNG_H */
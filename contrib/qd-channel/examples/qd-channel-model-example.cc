@@ -110,9 +110,9 @@ ComputeSvdBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix>
   double svdThresh = 1e-8;
 
   //generate transmitter side spatial correlation matrix
-  uint16_t aSize = params->m_channel.size ();
-  uint16_t bSize = params->m_channel[0].size ();
-  uint16_t clusterSize = params->m_channel[0][0].size ();
+  uint16_t aSize = params->m_channel.GetNumRxElements ();
+  uint16_t bSize = params->m_channel.GetNumTxElements ();
+  uint16_t clusterSize = params->m_channel.GetNumClusters ();
 
   // compute narrowband channel by summing over the cluster index
   MatrixBasedChannelModel::Complex2DVector narrowbandChannel;
@@ -130,7 +130,7 @@ ComputeSvdBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix>
           std::complex<double> cSum (0, 0);
           for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
             {
-              cSum += params->m_channel[aIndex][bIndex][cIndex];
+              cSum += params->m_channel (aIndex, bIndex, cIndex);
             }
           narrowbandChannel[aIndex][bIndex] = cSum;
         }
@@ -242,7 +242,7 @@ QdChannelModel::ReadQdFiles (QdChannelModel::RtIdToNs3IdMap_t rtIdToNs3IdMap)
       NS_LOG_LOGIC (id_tx);
       NS_LOG_LOGIC (id_rx);
 
-      uint32_t key = GetKey (nodeIdTx, nodeIdRx);
+      uint64_t key = GetKey (nodeIdTx, nodeIdRx);
       // std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel>> idPair {std::make_pair(tx_mm, rx_mm)};
 
       std::ifstream qdFile{fileName.c_str ()};
@@ -472,7 +472,7 @@ QdChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
   uint32_t aId = aMob->GetObject<Node> ()->GetId ();
   uint32_t bId = bMob->GetObject<Node> ()->GetId ();
 
-  uint32_t channelId = GetKey (aId, bId);
+  uint64_t channelId = GetKey (aId, bId);
 
 
   NS_LOG_DEBUG ("channelId " << channelId <<
@@ -526,7 +526,7 @@ QdChannelModel::GetNewChannel (Ptr<const MobilityModel> aMob,
   uint32_t timestep = GetTimestep ();
   uint32_t aId = aMob->GetObject<Node> ()->GetId ();
   uint32_t bId = bMob->GetObject<Node> ()->GetId ();
-  uint32_t channelId = GetKey (aId, bId);
+  uint64_t channelId = GetKey (aId, bId);
 
   QdInfo qdInfo = m_qdInfoMap.at (channelId)[timestep];
 
@@ -535,24 +535,7 @@ QdChannelModel::GetNewChannel (Ptr<const MobilityModel> aMob,
 
   // channel coffecient H[u][s][n];
   // considering only 1 cluster for retrocompatibility -> n=1
-  MatrixBasedChannelModel::Complex3DVector H;
-
-  H.resize (bSize);
-  for (uint64_t bIndex = 0; bIndex < bSize; bIndex++)
-    {
-      H[bIndex].resize (aSize);
-      for (uint64_t aIndex = 0; aIndex < aSize; aIndex++)
-        {
-          if (qdInfo.numMpcs > 0)
-            {
-              H[bIndex][aIndex].resize (1, std::complex<double> (0,0));
-            }
-          else
-            {
-              H[bIndex][aIndex].resize (0, std::complex<double> (0,0));
-            }
-        }
-    }
+  Complex3DArray H (bSize, aSize, qdInfo.numMpcs > 0 ? 1 : 0);
 
   for (uint64_t mpcIndex = 0; mpcIndex < qdInfo.numMpcs; ++mpcIndex)
     {
@@ -586,12 +569,12 @@ QdChannelModel::GetNewChannel (Ptr<const MobilityModel> aMob,
           for (uint64_t aIndex = 0; aIndex < aSize; ++aIndex)
             {
               std::complex<double> ray =  complexRay * std::conj (bSv[bIndex]) * std::conj(aSv[aIndex]);
-              H[bIndex][aIndex][0] += ray;
+              H (bIndex, aIndex, 0) += ray;
             }
         }
     }
 
-  channelParams->m_channel = H;
+  channelParams->m_channel = std::move (H);
   channelParams->m_delay = qdInfo.delay_s;
 
   channelParams->m_angle.clear ();
@@ -224,14 +224,14 @@ private:
     std::vector<double> azAoa_rad;
   };
 
-  std::map<uint32_t, Ptr<const MatrixBasedChannelModel::ChannelMatrix> > m_channelMap; //!< map containing the channel realizations indexed by channel key
+  std::map<uint64_t, Ptr<const MatrixBasedChannelModel::ChannelMatrix> > m_channelMap; //!< map containing the channel realizations indexed by channel key
   Time m_updatePeriod; //!< the channel update period
   uint32_t m_totTimesteps; //!< total number of timesteps for the simulation
   Time m_totalTimeDuration; //!< duration of the simulation
   double m_frequency; //!< the operating frequency [Hz]
   std::vector<Vector3D> m_nodePositionList; //!< initial position of each node
 
-  std::map<uint32_t, std::vector<QdInfo> > m_qdInfoMap; //!< map containing QD-related information for each node pair
+  std::map<uint64_t, std::vector<QdInfo> > m_qdInfoMap; //!< map containing QD-related information for each node pair
   Ns3IdToRtIdMap_t m_ns3IdToRtIdMap; //!< map containing a conversion from ns-3 node id to qd-realization node id
 
   std::string m_path; //!< folder path containing the scenario of interest
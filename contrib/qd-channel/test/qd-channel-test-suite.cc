@@ -6,6 +6,15 @@
 // An essential include is test.h
 #include "ns3/test.h"
 
+#include "ns3/node-container.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/uniform-planar-array.h"
+#include "ns3/simulator.h"
+#include "ns3/system-path.h"
+#include "ns3/uinteger.h"
+#include <fstream>
+#include <unistd.h>
+
 // Do not put your test classes in namespace ns3.  You may find it useful
 // to use the using directive to access the ns3 namespace directly
 using namespace ns3;
@@ -46,6 +55,142 @@ QdChannelTestCase1::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+/**
+ * Test case for the QdChannelModel class.
+ * It builds a scenario with three nodes, in which node 0 and node 1 both
+ * transmit to node 2, and checks that each link gets the ray
+ * parameters of its own QdFile, i.e., that the links sharing the rx node
+ * are indexed by different channel keys.
+ */
+class QdChannelSharedRxTestCase : public TestCase
+{
+public:
+  QdChannelSharedRxTestCase ();
+  virtual ~QdChannelSharedRxTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write a QdFile with a single timestep and a single ray
+   * \param fileName the name of the QdFile
+   * \param pathGainDb the path gain of the ray in dB
+   */
+  void WriteQdFile (std::string fileName, double pathGainDb) const;
+};
+
+QdChannelSharedRxTestCase::QdChannelSharedRxTestCase ()
+  : TestCase ("Check the channels of two links sharing the rx node")
+{
+}
+
+QdChannelSharedRxTestCase::~QdChannelSharedRxTestCase ()
+{
+}
+
+void
+QdChannelSharedRxTestCase::WriteQdFile (std::string fileName, double pathGainDb) const
+{
+  std::ofstream qdFile (fileName.c_str ());
+  qdFile << "1" << std::endl; // number of rays
+  qdFile << "1e-08" << std::endl; // delays
+  qdFile << pathGainDb << std::endl; // path gains
+  qdFile << "0" << std::endl; // phases
+  qdFile << "90" << std::endl; // elevation AoDs
+  qdFile << "0" << std::endl; // azimuth AoDs
+  qdFile << "90" << std::endl; // elevation AoAs
+  qdFile << "180" << std::endl; // azimuth AoAs
+}
+
+void
+QdChannelSharedRxTestCase::DoRun (void)
+{
+  // QdChannelModel strips the leading '/' of the path, hence the scenario
+  // is written in the temporary directory and accessed through a path
+  // relative to the current working directory
+  std::string tempDir = CreateTempDirFilename ("qd-channel-shared-rx");
+  std::string path = tempDir;
+  if (tempDir[0] == '/')
+    {
+      char cwd[4096];
+      NS_ABORT_MSG_IF (getcwd (cwd, sizeof (cwd)) == 0, "Unable to get the current working directory");
+      path = tempDir.substr (1);
+      for (const auto& dir : SystemPath::Split (cwd))
+        {
+          if (!dir.empty ())
+            {
+              path = "../" + path;
+            }
+        }
+    }
+  std::string scenario = "Scenario";
+  std::string scenarioDir = SystemPath::Append (tempDir, scenario);
+
+  SystemPath::MakeDirectories (SystemPath::Append (scenarioDir, "Input"));
+  std::ofstream paraCfgFile (SystemPath::Append (scenarioDir, "Input/paraCfgCurrent.txt").c_str ());
+  paraCfgFile << "ParameterName\tParameterValue" << std::endl;
+  paraCfgFile << "numberOfTimeDivisions\t1" << std::endl;
+  paraCfgFile << "totalTimeDuration\t1" << std::endl;
+  paraCfgFile << "carrierFrequency\t60e9" << std::endl;
+  paraCfgFile.close ();
+
+  std::vector<Vector> positions {Vector (0, 0, 1.5), Vector (10, 0, 1.5), Vector (5, 5, 1.5)};
+  SystemPath::MakeDirectories (SystemPath::Append (scenarioDir, "Output/Ns3/NodesPosition"));
+  std::ofstream posFile (SystemPath::Append (scenarioDir, "Output/Ns3/NodesPosition/NodesPosition.csv").c_str ());
+  for (const auto& pos : positions)
+    {
+      posFile << pos.x << "," << pos.y << "," << pos.z << std::endl;
+    }
+  posFile.close ();
+
+  // node 0 and node 1 transmit to node 2, with different path gains
+  std::string qdFilesDir = SystemPath::Append (scenarioDir, "Output/Ns3/QdFiles");
+  SystemPath::MakeDirectories (qdFilesDir);
+  double pathGainDb0 = -70.0;
+  double pathGainDb1 = -90.0;
+  WriteQdFile (SystemPath::Append (qdFilesDir, "Tx0Rx2.txt"), pathGainDb0);
+  WriteQdFile (SystemPath::Append (qdFilesDir, "Tx1Rx2.txt"), pathGainDb1);
+
+  // the positions are matched with the ones of the nodes, hence the
+  // mobility models have to be installed before the channel is created
+  NodeContainer nodes;
+  nodes.Create (3);
+  std::vector<Ptr<MobilityModel> > mobility;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+      mm->SetPosition (positions[i]);
+      nodes.Get (i)->AggregateObject (mm);
+      mobility.push_back (mm);
+    }
+
+  Ptr<QdChannelModel> qdChannel = CreateObject<QdChannelModel> (path, scenario);
+
+  Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (1),
+                                                                                    "NumRows", UintegerValue (1));
+  Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (1),
+                                                                                    "NumRows", UintegerValue (1));
+
+  // with single-element isotropic arrays, the amplitude of the channel
+  // coefficient is the amplitude of the path gain
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel0 = qdChannel->GetChannel (mobility[0], mobility[2], txAntenna, rxAntenna);
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel1 = qdChannel->GetChannel (mobility[1], mobility[2], txAntenna, rxAntenna);
+
+  NS_TEST_ASSERT_MSG_EQ ((channel0 != channel1), true, "The two links share the same channel matrix");
+  NS_TEST_ASSERT_MSG_EQ_TOL (std::abs (channel0->m_channel (0, 0, 0)), std::pow (10, pathGainDb0 / 20), 1e-9,
+                             "Wrong channel for the link between node 0 and node 2");
+  NS_TEST_ASSERT_MSG_EQ_TOL (std::abs (channel1->m_channel (0, 0, 0)), std::pow (10, pathGainDb1 / 20), 1e-9,
+                             "Wrong channel for the link between node 1 and node 2");
+
+  // the cached channels are returned again for the same links
+  NS_TEST_ASSERT_MSG_EQ ((qdChannel->GetChannel (mobility[0], mobility[2], txAntenna, rxAntenna) == channel0), true,
+                         "The channel of the link between node 0 and node 2 has not been cached");
+  NS_TEST_ASSERT_MSG_EQ ((qdChannel->GetChannel (mobility[1], mobility[2], txAntenna, rxAntenna) == channel1), true,
+                         "The channel of the link between node 1 and node 2 has not been cached");
+
+  Simulator::Destroy ();
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -61,6 +206,7 @@ QdChannelTestSuite::QdChannelTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new QdChannelTestCase1, TestCase::QUICK);
+  AddTestCase (new QdChannelSharedRxTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,35 @@
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/three-gpp-channel-model.h"
+#include "ns3/channel-condition-model.h"
+#include "ns3/uniform-planar-array.h"
+#include <fstream>
+#include <iomanip>
+using namespace ns3;
+int main (int argc, char *argv[])
+{
+  std::string out = "/tmp/h.txt";
+  CommandLine cmd; cmd.AddValue ("out", "", out); cmd.Parse (argc, argv);
+  RngSeedManager::SetSeed (1); RngSeedManager::SetRun (1);
+  std::ofstream f (out);
+  f << std::setprecision (17);
+  for (int los = 0; los < 2; los++)
+  {
+  Ptr<ChannelConditionModel> cond = los ? Ptr<ChannelConditionModel> (CreateObject<AlwaysLosChannelConditionModel> ()) : Ptr<ChannelConditionModel> (CreateObject<NeverLosChannelConditionModel> ());
+  Ptr<ThreeGppChannelModel> ch = CreateObject<ThreeGppChannelModel> ();
+  ch->SetAttribute ("Frequency", DoubleValue (28e9));
+  ch->SetAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  ch->SetAttribute ("ChannelConditionModel", PointerValue (cond));
+  NodeContainer n; n.Create (2);
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> (); a->SetPosition (Vector (0,0,10)); n.Get (0)->AggregateObject (a);
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> (); b->SetPosition (Vector (30,40,1.5)); n.Get (1)->AggregateObject (b);
+  Ptr<PhasedArrayModel> aa = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (4), "NumRows", UintegerValue (4));
+  Ptr<PhasedArrayModel> ba = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2), "NumRows", UintegerValue (2));
+  auto m = ch->GetChannel (a, b, aa, ba);
+  for (size_t u = 0; u < m->m_channel.GetNumRxElements (); u++)
+    for (size_t s = 0; s < m->m_channel.GetNumTxElements (); s++)
+      for (size_t c = 0; c < m->m_channel.GetNumClusters (); c++)
+        f << m->m_channel (u, s, c).real () << " " << m->m_channel (u, s, c).imag () << "\n";
+  }
+}
@@ -32,6 +32,7 @@ NS_OBJECT_ENSURE_REGISTERED (PhasedArrayModel);
 
 
 PhasedArrayModel::PhasedArrayModel ()
+  : m_beamformingVectorGeneration (GetNextGeneration ())
 {
 }
 
@@ -65,6 +66,7 @@ PhasedArrayModel::SetBeamformingVector (const ComplexVector &beamformingVector)
   NS_ASSERT_MSG (beamformingVector.size () == GetNumberOfElements (),
                  beamformingVector.size () << " != " << GetNumberOfElements ());
   m_beamformingVector = beamformingVector;
+  m_beamformingVectorGeneration = GetNextGeneration ();
 }
 
 
@@ -76,6 +78,37 @@ PhasedArrayModel::GetBeamformingVector () const
 }
 
 
+const PhasedArrayModel::ComplexVector&
+PhasedArrayModel::GetBeamformingVectorRef () const
+{
+  return m_beamformingVector;
+}
+
+
+uint64_t
+PhasedArrayModel::GetBeamformingVectorGeneration () const
+{
+  return m_beamformingVectorGeneration;
+}
+
+
+void
+PhasedArrayModel::ResetBeamformingVector ()
+{
+  NS_LOG_FUNCTION (this);
+  m_beamformingVector = ComplexVector (GetNumberOfElements (), std::complex<double> (0, 0));
+  m_beamformingVectorGeneration = GetNextGeneration ();
+}
+
+
+uint64_t
+PhasedArrayModel::GetNextGeneration ()
+{
+  static uint64_t generation = 0;
+  return ++generation;
+}
+
+
 double
 PhasedArrayModel::ComputeNorm (const ComplexVector &vector)
 {
@@ -95,6 +95,25 @@ public:
   ComplexVector GetBeamformingVector (void) const;
 
 
+  /**
+   * Returns a const reference to the beamforming vector that is currently
+   * being used, which avoids copying the vector
+   * \return the current beamforming vector
+   */
+  const ComplexVector& GetBeamformingVectorRef (void) const;
+
+
+  /**
+   * Returns the generation of the beamforming vector that is currently
+   * being used. A new generation, greater than all the previous ones of any
+   * PhasedArrayModel instance, is assigned every time the beamforming vector
+   * is changed. Two calls returning the same value mean that the beamforming
+   * vector has not been changed in between.
+   * \return the generation of the current beamforming vector
+   */
+  uint64_t GetBeamformingVectorGeneration (void) const;
+
+
   /**
    * Returns the beamforming vector that points towards the specified position
    * \param a the beamforming angle
@@ -127,9 +146,23 @@ public:
 protected:
   static double ComputeNorm (const ComplexVector &vector);
 
+  /**
+   * Sets all the elements of the beamforming vector to zero, e.g., after a
+   * change in the number of antenna elements
+   */
+  void ResetBeamformingVector (void);
+
   ComplexVector m_beamformingVector; //!< the beamforming vector in use
   Ptr<AntennaModel> m_antennaElement; //!< the model of the antenna element in use
 
+private:
+  /**
+   * \return a new beamforming vector generation
+   */
+  static uint64_t GetNextGeneration (void);
+
+  uint64_t m_beamformingVectorGeneration; //!< the generation of the beamforming vector in use
+
 };
 
 } /* namespace ns3 */
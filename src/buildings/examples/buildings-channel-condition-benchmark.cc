@@ -0,0 +1,242 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/buildings-module.h"
+#include "ns3/node.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+using namespace ns3;
+
+/*
+ * This example measures the cost of the line of sight tests of the
+ * BuildingsChannelConditionModel in a Manhattan grid of buildings.
+ * The UEs walk along the streets, and at each step the condition of the
+ * link between every UE and every BS is computed:
+ *  - "linear": by testing every building of the BuildingList, as done
+ *    before the spatial index of the BuildingList;
+ *  - "index": by the BuildingsChannelConditionModel, with the spatial index
+ *    and the LOS cache limited to links whose endpoints did not move;
+ *  - "cached": by the BuildingsChannelConditionModel, with the LOS results
+ *    kept until an endpoint moves by more than --cacheDistance.
+ * The conditions of "index" must match those of "linear", while "cached"
+ * reports the number of conditions which differ because of the cache.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("BuildingsChannelConditionBenchmark");
+
+/** Size of the side of a building [m] */
+static const double g_blockSize = 40.0;
+/** Width of the streets [m] */
+static const double g_streetWidth = 20.0;
+
+/**
+ * Get a random position in the streets of the grid.
+ *
+ * \param uniform the random variable
+ * \param gridSide the number of buildings along each axis
+ * \param z the height of the position
+ * \param alongX set to true if the street is parallel to the x axis
+ * \return the position
+ */
+static Vector
+GetStreetPosition (Ptr<UniformRandomVariable> uniform, uint32_t gridSide, double z, bool &alongX)
+{
+  double pitch = g_blockSize + g_streetWidth;
+  double street = uniform->GetInteger (0, gridSide) * pitch - g_streetWidth / 2
+    + uniform->GetValue (-0.4, 0.4) * g_streetWidth;
+  double along = uniform->GetValue (0, gridSide * pitch);
+  alongX = uniform->GetValue () < 0.5;
+  return alongX ? Vector (along, street, z) : Vector (street, along, z);
+}
+
+static void
+RunBenchmark (uint32_t numBuildings, uint32_t numUes, uint32_t numBs, uint32_t numSteps,
+              double stepLength, double cacheDistance)
+{
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+
+  uint32_t gridSide = std::ceil (std::sqrt (numBuildings));
+  double pitch = g_blockSize + g_streetWidth;
+  for (uint32_t i = 0; i < numBuildings; i++)
+    {
+      double x = (i % gridSide) * pitch;
+      double y = (i / gridSide) * pitch;
+      Ptr<Building> building = CreateObject<Building> ();
+      building->SetBoundaries (Box (x, x + g_blockSize, y, y + g_blockSize, 0.0, uniform->GetValue (10, 50)));
+    }
+
+  std::vector<Ptr<MobilityModel> > ues;
+  std::vector<bool> uesAlongX;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      bool alongX;
+      Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+      mm->SetPosition (GetStreetPosition (uniform, gridSide, 1.5, alongX));
+      mm->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+      CreateObject<Node> ()->AggregateObject (mm);
+      ues.push_back (mm);
+      uesAlongX.push_back (alongX);
+    }
+  std::vector<Ptr<MobilityModel> > bss;
+  for (uint32_t i = 0; i < numBs; i++)
+    {
+      bool alongX;
+      Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+      mm->SetPosition (GetStreetPosition (uniform, gridSide, 25.0, alongX));
+      mm->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+      CreateObject<Node> ()->AggregateObject (mm);
+      bss.push_back (mm);
+    }
+
+  Ptr<BuildingsChannelConditionModel> indexModel = CreateObject<BuildingsChannelConditionModel> ();
+  indexModel->SetAttribute ("LosCacheDistance", DoubleValue (0.0));
+  Ptr<BuildingsChannelConditionModel> cachedModel = CreateObject<BuildingsChannelConditionModel> ();
+  cachedModel->SetAttribute ("LosCacheDistance", DoubleValue (cacheDistance));
+
+  double linearTime = 0.0;
+  double indexTime = 0.0;
+  double cachedTime = 0.0;
+  uint64_t numLinks = 0;
+  uint64_t numNlos = 0;
+  uint64_t numIndexErrors = 0;
+  uint64_t numCachedErrors = 0;
+  std::vector<bool> linear (numUes * numBs);
+  std::vector<bool> index (numUes * numBs);
+  for (uint32_t step = 0; step < numSteps; step++)
+    {
+      auto start = std::chrono::steady_clock::now ();
+      for (uint32_t u = 0; u < numUes; u++)
+        {
+          for (uint32_t b = 0; b < numBs; b++)
+            {
+              bool blocked = false;
+              for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+                {
+                  if ((*bit)->IsIntersect (ues[u]->GetPosition (), bss[b]->GetPosition ()))
+                    {
+                      blocked = true;
+                      break;
+                    }
+                }
+              linear[u * numBs + b] = blocked;
+            }
+        }
+      linearTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      start = std::chrono::steady_clock::now ();
+      for (uint32_t u = 0; u < numUes; u++)
+        {
+          for (uint32_t b = 0; b < numBs; b++)
+            {
+              index[u * numBs + b] = indexModel->GetChannelCondition (ues[u], bss[b])->GetLosCondition () == ChannelCondition::NLOS;
+            }
+        }
+      indexTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      start = std::chrono::steady_clock::now ();
+      for (uint32_t u = 0; u < numUes; u++)
+        {
+          for (uint32_t b = 0; b < numBs; b++)
+            {
+              bool nlos = cachedModel->GetChannelCondition (ues[u], bss[b])->GetLosCondition () == ChannelCondition::NLOS;
+              numCachedErrors += (nlos != linear[u * numBs + b]);
+            }
+        }
+      cachedTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      for (uint32_t i = 0; i < linear.size (); i++)
+        {
+          numIndexErrors += (index[i] != linear[i]);
+          numNlos += linear[i];
+        }
+      numLinks += linear.size ();
+
+      // the UEs walk along their streets
+      for (uint32_t u = 0; u < numUes; u++)
+        {
+          Vector pos = ues[u]->GetPosition ();
+          (uesAlongX[u] ? pos.x : pos.y) += stepLength;
+          ues[u]->SetPosition (pos);
+        }
+    }
+  NS_ABORT_MSG_IF (numIndexErrors > 0, numIndexErrors << " conditions of the spatial index differ from the linear search");
+
+  std::cout << std::left << std::setw (11) << numBuildings
+            << std::setw (10) << numLinks
+            << std::setw (13) << linearTime / numLinks * 1e6
+            << std::setw (13) << indexTime / numLinks * 1e6
+            << std::setw (13) << cachedTime / numLinks * 1e6
+            << std::setw (10) << (indexTime > 0 ? linearTime / indexTime : 0)
+            << std::setw (8) << 100.0 * numNlos / numLinks
+            << std::setw (10) << numCachedErrors << std::endl;
+
+  Simulator::Destroy ();
+}
+
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream stream (list);
+  std::string value;
+  while (std::getline (stream, value, ','))
+    {
+      values.push_back (std::stoul (value));
+    }
+  return values;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string numBuildingsList = "100,1000,10000";
+  uint32_t numUes = 50;
+  uint32_t numBs = 10;
+  uint32_t numSteps = 8;
+  double stepLength = 0.5;
+  double cacheDistance = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("numBuildings", "Comma-separated numbers of buildings", numBuildingsList);
+  cmd.AddValue ("numUes", "Number of UEs", numUes);
+  cmd.AddValue ("numBs", "Number of BSs", numBs);
+  cmd.AddValue ("numSteps", "Number of steps of the UEs", numSteps);
+  cmd.AddValue ("stepLength", "Distance between two consecutive steps [m]", stepLength);
+  cmd.AddValue ("cacheDistance", "LosCacheDistance of the cached model [m]", cacheDistance);
+  cmd.Parse (argc, argv);
+
+  std::cout << numUes << " UEs, " << numBs << " BSs, " << numSteps << " steps of " << stepLength
+            << " m, cache distance " << cacheDistance << " m" << std::endl;
+  std::cout << std::left << std::setw (11) << "Buildings"
+            << std::setw (10) << "Links"
+            << std::setw (13) << "Linear [us]"
+            << std::setw (13) << "Index [us]"
+            << std::setw (13) << "Cached [us]"
+            << std::setw (10) << "Speedup"
+            << std::setw (8) << "NLOS %"
+            << std::setw (10) << "Cache err" << std::endl;
+  std::vector<uint32_t> numBuildings = ParseList (numBuildingsList);
+  for (unsigned i = 0; i < numBuildings.size (); i++)
+    {
+      RunBenchmark (numBuildings[i], numUes, numBs, numSteps, stepLength, cacheDistance);
+    }
+  return 0;
+}
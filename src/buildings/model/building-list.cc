@@ -27,11 +27,20 @@
 #include "ns3/assert.h"
 #include "building-list.h"
 #include "building.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("BuildingList");
 
+/**
+ * Version of the buildings, incremented each time a building is added or
+ * its boundaries change. It is not reset with the list, so that results
+ * cached in a previous simulation are never mistaken for current ones.
+ */
+static uint64_t g_buildingsVersion = 0;
+
 /**
  * \brief private implementation detail of the BuildingList API.
  */
@@ -47,6 +56,9 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  Ptr<Building> FindIntersectingBuilding (const Vector &l1, const Vector &l2);
+  std::vector<Ptr<Building> > GetBuildingsAt (const Vector &position);
+  void NotifyBoundariesChanged (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
@@ -54,7 +66,39 @@ private:
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  /**
+   * Build the uniform grid over the footprints of the buildings.
+   */
+  void BuildIndex (void);
+  /**
+   * \param x a x coordinate
+   * \returns the column of the grid of x, clamped to the grid
+   */
+  uint32_t GetColumn (double x) const;
+  /**
+   * \param y a y coordinate
+   * \returns the row of the grid of y, clamped to the grid
+   */
+  uint32_t GetRow (double y) const;
   std::vector<Ptr<Building> > m_buildings;
+
+  bool m_indexValid; //!< true if the grid matches the buildings
+  double m_xMin; //!< the minimum x coordinate of the grid
+  double m_xMax; //!< the maximum x coordinate of the footprints
+  double m_yMin; //!< the minimum y coordinate of the grid
+  double m_yMax; //!< the maximum y coordinate of the footprints
+  double m_cellSize; //!< the side of the square cells of the grid
+  uint32_t m_nColumns; //!< the number of columns of the grid
+  uint32_t m_nRows; //!< the number of rows of the grid
+  /**
+   * The indices in m_cellBuildings of the buildings of each cell, row by
+   * row: cell i holds the buildings from m_cellStart[i] to
+   * m_cellStart[i + 1]
+   */
+  std::vector<uint32_t> m_cellStart;
+  std::vector<uint32_t> m_cellBuildings; //!< the indices of the buildings of the cells
+  std::vector<uint32_t> m_queryMark; //!< the last query which tested each building
+  uint32_t m_queryId; //!< the id of the current query
 };
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
@@ -100,6 +144,15 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_indexValid (false),
+    m_xMin (0),
+    m_xMax (0),
+    m_yMin (0),
+    m_yMax (0),
+    m_cellSize (1),
+    m_nColumns (0),
+    m_nRows (0),
+    m_queryId (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +171,10 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  m_indexValid = false;
+  m_cellStart.clear ();
+  m_cellBuildings.clear ();
+  m_queryMark.clear ();
   Object::DoDispose ();
 }
 
@@ -127,6 +184,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  NotifyBoundariesChanged ();
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +213,199 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+void
+BuildingListPriv::NotifyBoundariesChanged (void)
+{
+  m_indexValid = false;
+  g_buildingsVersion++;
+}
+
+void
+BuildingListPriv::BuildIndex (void)
+{
+  NS_LOG_FUNCTION (this << m_buildings.size ());
+  m_indexValid = true;
+  m_queryMark.assign (m_buildings.size (), 0);
+  m_queryId = 0;
+  if (m_buildings.empty ())
+    {
+      m_nColumns = 0;
+      m_nRows = 0;
+      m_cellStart.clear ();
+      m_cellBuildings.clear ();
+      return;
+    }
+
+  std::vector<Box> boxes;
+  boxes.reserve (m_buildings.size ());
+  for (std::vector<Ptr<Building> >::const_iterator i = m_buildings.begin (); i != m_buildings.end (); ++i)
+    {
+      boxes.push_back ((*i)->GetBoundaries ());
+    }
+  m_xMin = m_xMax = boxes[0].xMin;
+  m_yMin = m_yMax = boxes[0].yMin;
+  for (std::vector<Box>::const_iterator b = boxes.begin (); b != boxes.end (); ++b)
+    {
+      m_xMin = std::min (m_xMin, b->xMin);
+      m_xMax = std::max (m_xMax, b->xMax);
+      m_yMin = std::min (m_yMin, b->yMin);
+      m_yMax = std::max (m_yMax, b->yMax);
+    }
+
+  // about one cell per building, with at most 1024 cells along each axis
+  double width = m_xMax - m_xMin;
+  double height = m_yMax - m_yMin;
+  m_cellSize = std::sqrt (width * height / m_buildings.size ());
+  m_cellSize = std::max (m_cellSize, std::max (width, height) / 1024);
+  if (!(m_cellSize > 0))
+    {
+      m_cellSize = 1;
+    }
+  m_nColumns = std::min<uint32_t> (std::floor (width / m_cellSize) + 1, 1025);
+  m_nRows = std::min<uint32_t> (std::floor (height / m_cellSize) + 1, 1025);
+
+  // count the buildings of each cell, then fill the cells
+  m_cellStart.assign (m_nColumns * m_nRows + 1, 0);
+  for (std::vector<Box>::const_iterator b = boxes.begin (); b != boxes.end (); ++b)
+    {
+      for (uint32_t row = GetRow (b->yMin); row <= GetRow (b->yMax); row++)
+        {
+          for (uint32_t col = GetColumn (b->xMin); col <= GetColumn (b->xMax); col++)
+            {
+              m_cellStart[row * m_nColumns + col + 1]++;
+            }
+        }
+    }
+  for (uint32_t i = 0; i < m_nColumns * m_nRows; i++)
+    {
+      m_cellStart[i + 1] += m_cellStart[i];
+    }
+  m_cellBuildings.resize (m_cellStart.back ());
+  std::vector<uint32_t> next (m_cellStart.begin (), m_cellStart.end () - 1);
+  for (uint32_t n = 0; n < boxes.size (); n++)
+    {
+      for (uint32_t row = GetRow (boxes[n].yMin); row <= GetRow (boxes[n].yMax); row++)
+        {
+          for (uint32_t col = GetColumn (boxes[n].xMin); col <= GetColumn (boxes[n].xMax); col++)
+            {
+              m_cellBuildings[next[row * m_nColumns + col]++] = n;
+            }
+        }
+    }
+  NS_LOG_LOGIC ("grid of " << m_nColumns << "x" << m_nRows << " cells of " << m_cellSize
+                << " m, with " << m_cellBuildings.size () << " entries");
+}
+
+uint32_t
+BuildingListPriv::GetColumn (double x) const
+{
+  double col = std::floor ((x - m_xMin) / m_cellSize);
+  return col <= 0 ? 0 : std::min<uint32_t> (col, m_nColumns - 1);
+}
+
+uint32_t
+BuildingListPriv::GetRow (double y) const
+{
+  double row = std::floor ((y - m_yMin) / m_cellSize);
+  return row <= 0 ? 0 : std::min<uint32_t> (row, m_nRows - 1);
+}
+
+Ptr<Building>
+BuildingListPriv::FindIntersectingBuilding (const Vector &l1, const Vector &l2)
+{
+  if (!m_indexValid)
+    {
+      BuildIndex ();
+    }
+  double xLow = std::min (l1.x, l2.x);
+  double xHigh = std::max (l1.x, l2.x);
+  double yLow = std::min (l1.y, l2.y);
+  double yHigh = std::max (l1.y, l2.y);
+  if (m_buildings.empty () || xHigh < m_xMin || xLow > m_xMax || yHigh < m_yMin || yLow > m_yMax)
+    {
+      return 0;
+    }
+  if (++m_queryId == 0)
+    {
+      std::fill (m_queryMark.begin (), m_queryMark.end (), 0);
+      m_queryId = 1;
+    }
+
+  // visit the columns crossed by the line-segment, and in each column the
+  // rows crossed by the part of the line-segment within the column,
+  // slightly widened against rounding errors
+  double margin = 1e-6 * m_cellSize;
+  double dx = l2.x - l1.x;
+  double dy = l2.y - l1.y;
+  uint32_t firstCol = GetColumn (xLow);
+  uint32_t lastCol = GetColumn (xHigh);
+  for (uint32_t col = firstCol; col <= lastCol; col++)
+    {
+      double y1 = yLow;
+      double y2 = yHigh;
+      if (firstCol != lastCol && dx != 0)
+        {
+          double x1 = (col == firstCol) ? xLow : m_xMin + col * m_cellSize;
+          double x2 = (col == lastCol) ? xHigh : m_xMin + (col + 1) * m_cellSize;
+          y1 = l1.y + (x1 - l1.x) * dy / dx;
+          y2 = l1.y + (x2 - l1.x) * dy / dx;
+          if (y1 > y2)
+            {
+              std::swap (y1, y2);
+            }
+          y1 = std::max (y1 - margin, yLow);
+          y2 = std::min (y2 + margin, yHigh);
+        }
+      if (y2 < m_yMin || y1 > m_yMax)
+        {
+          continue;
+        }
+      for (uint32_t row = GetRow (y1); row <= GetRow (y2); row++)
+        {
+          uint32_t cell = row * m_nColumns + col;
+          for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+            {
+              uint32_t n = m_cellBuildings[i];
+              if (m_queryMark[n] == m_queryId)
+                {
+                  continue;
+                }
+              m_queryMark[n] = m_queryId;
+              if (m_buildings[n]->IsIntersect (l1, l2))
+                {
+                  return m_buildings[n];
+                }
+            }
+        }
+    }
+  return 0;
+}
+
+std::vector<Ptr<Building> >
+BuildingListPriv::GetBuildingsAt (const Vector &position)
+{
+  if (!m_indexValid)
+    {
+      BuildIndex ();
+    }
+  std::vector<Ptr<Building> > buildings;
+  if (m_buildings.empty () || position.x < m_xMin || position.x > m_xMax
+      || position.y < m_yMin || position.y > m_yMax)
+    {
+      return buildings;
+    }
+  uint32_t cell = GetRow (position.y) * m_nColumns + GetColumn (position.x);
+  for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+    {
+      Ptr<Building> building = m_buildings[m_cellBuildings[i]];
+      if (building->IsInside (position))
+        {
+          buildings.push_back (building);
+        }
+    }
+  return buildings;
+}
+
 }
 
 /**
@@ -189,5 +440,25 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+Ptr<Building>
+BuildingList::FindIntersectingBuilding (const Vector &l1, const Vector &l2)
+{
+  return BuildingListPriv::Get ()->FindIntersectingBuilding (l1, l2);
+}
+std::vector<Ptr<Building> >
+BuildingList::GetBuildingsAt (const Vector &position)
+{
+  return BuildingListPriv::Get ()->GetBuildingsAt (position);
+}
+void
+BuildingList::NotifyBoundariesChanged (void)
+{
+  BuildingListPriv::Get ()->NotifyBoundariesChanged ();
+}
+uint64_t
+BuildingList::GetVersion (void)
+{
+  return g_buildingsVersion;
+}
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,37 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+  /**
+   * \param l1 the first end of the line-segment
+   * \param l2 the second end of the line-segment
+   * \returns a building intersected by the line-segment between l1
+   *          and l2, or 0 if there is none.
+   *
+   * The footprints of the buildings are indexed in a uniform grid, so
+   * that only the buildings overlapping the cells crossed by the
+   * projection of the line-segment on the xy plane are tested with
+   * Building::IsIntersect.
+   */
+  static Ptr<Building> FindIntersectingBuilding (const Vector &l1, const Vector &l2);
+  /**
+   * \param position a position
+   * \returns the buildings which contain the position, in the order
+   *          of the list.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsAt (const Vector &position);
+  /**
+   * Notify the list that the boundaries of a building changed, so that
+   * the spatial index of the buildings is rebuilt at the next query.
+   *
+   * This method is called automatically from Building::SetBoundaries.
+   */
+  static void NotifyBoundariesChanged (void);
+  /**
+   * \returns a number which changes each time a building is added or
+   *          its boundaries change, e.g., to invalidate results which
+   *          depend on the buildings.
+   */
+  static uint64_t GetVersion (void);
 };
 
 } // namespace ns3
@@ -23,6 +23,10 @@
 #include "ns3/mobility-model.h"
 #include "ns3/mobility-building-info.h"
 #include "ns3/building-list.h"
+#include "ns3/building.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/node.h"
 #include "ns3/log.h"
 
 namespace ns3 {
@@ -38,12 +42,48 @@ BuildingsChannelConditionModel::GetTypeId (void)
     .SetParent<ChannelConditionModel> ()
     .SetGroupName ("Buildings")
     .AddConstructor<BuildingsChannelConditionModel> ()
+    .AddAttribute ("LosCacheDistance",
+                   "The distance in meters that either node of a link can move before "
+                   "the line of sight of the link is tested again. 0 means that the "
+                   "test is reused only while both nodes stay in the same position",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&BuildingsChannelConditionModel::m_losCacheDistance),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("CacheMaxSize",
+                   "The memory budget in bytes of the cache of the line of sight tests. "
+                   "When the estimated size of the cache exceeds it, the least recently "
+                   "used tests are evicted. 0 means unbounded",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&BuildingsChannelConditionModel::SetCacheMaxSize,
+                                         &BuildingsChannelConditionModel::GetCacheMaxSize),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddTraceSource ("CacheHits",
+                     "The number of times a valid line of sight test was found in the cache",
+                     MakeTraceSourceAccessor (&BuildingsChannelConditionModel::m_cacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheMisses",
+                     "The number of times a line of sight test had to be computed",
+                     MakeTraceSourceAccessor (&BuildingsChannelConditionModel::m_cacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheEvictions",
+                     "The number of line of sight tests evicted from the cache",
+                     MakeTraceSourceAccessor (&BuildingsChannelConditionModel::m_cacheEvictions),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheSize",
+                     "The estimated size in bytes of the cache of the line of sight tests",
+                     MakeTraceSourceAccessor (&BuildingsChannelConditionModel::m_cacheSize),
+                     "ns3::TracedValueCallback::Uint64")
   ;
   return tid;
 }
 
 BuildingsChannelConditionModel::BuildingsChannelConditionModel ()
-  : ChannelConditionModel ()
+  : ChannelConditionModel (),
+    m_losCacheDistance (0.0),
+    m_cacheHits (0),
+    m_cacheMisses (0),
+    m_cacheEvictions (0),
+    m_cacheSize (0)
 {
 }
 
@@ -51,6 +91,14 @@ BuildingsChannelConditionModel::~BuildingsChannelConditionModel ()
 {
 }
 
+void
+BuildingsChannelConditionModel::DoDispose ()
+{
+  m_losCache.Clear ();
+  m_cacheSize = 0;
+  ChannelConditionModel::DoDispose ();
+}
+
 Ptr<ChannelCondition>
 BuildingsChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
                                                      Ptr<const MobilityModel> b) const
@@ -71,7 +119,7 @@ BuildingsChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
       // The outdoor case, determine LOS/NLOS
       // The channel condition should be LOS if the line of sight is not blocked,
       // otherwise NLOS
-      bool blocked = IsLineOfSightBlocked (a->GetPosition (), b->GetPosition ());
+      bool blocked = IsLineOfSightBlocked (a, b);
       if (!blocked)
         {
           cond->SetLosCondition (ChannelCondition::LosConditionValue::LOS);
@@ -106,19 +154,84 @@ BuildingsChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
 bool
 BuildingsChannelConditionModel::IsLineOfSightBlocked (const ns3::Vector &l1, const ns3::Vector &l2) const
 {
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  // The line of sight should be blocked if the line-segment between
+  // l1 and l2 intersects one of the buildings.
+  return BuildingList::FindIntersectingBuilding (l1, l2) != nullptr;
+}
+
+bool
+BuildingsChannelConditionModel::IsLineOfSightBlocked (Ptr<const MobilityModel> a,
+                                                      Ptr<const MobilityModel> b) const
+{
+  Ptr<Node> nodeA = a->GetObject<Node> ();
+  Ptr<Node> nodeB = b->GetObject<Node> ();
+  if (nodeA == nullptr || nodeB == nullptr)
+    {
+      // without a node there is no stable key for the link, do not cache
+      NS_LOG_DEBUG ("mobility model not aggregated to a node, the line of sight test is not cached");
+      return IsLineOfSightBlocked (a->GetPosition (), b->GetPosition ());
+    }
+
+  // use the IDs of the nodes, sorted so that the key and the item are reciprocal
+  uint32_t idA = nodeA->GetId ();
+  uint32_t idB = nodeB->GetId ();
+  if (idB < idA)
+    {
+      std::swap (a, b);
+      std::swap (idA, idB);
+    }
+  Vector positionA = a->GetPosition ();
+  Vector positionB = b->GetPosition ();
+  uint64_t version = BuildingList::GetVersion ();
+
+  uint64_t key = (static_cast<uint64_t> (idA) << 32) | idB;
+  LosItem *item = m_losCache.Find (key);
+  if (item != nullptr
+      && item->m_buildingsVersion == version
+      && CalculateDistance (positionA, item->m_positionA) <= m_losCacheDistance
+      && CalculateDistance (positionB, item->m_positionB) <= m_losCacheDistance)
+    {
+      NS_LOG_DEBUG ("found the line of sight test in the cache");
+      m_cacheHits++;
+      return item->m_blocked;
+    }
+
+  LosItem newItem;
+  newItem.m_positionA = positionA;
+  newItem.m_positionB = positionB;
+  newItem.m_buildingsVersion = version;
+  newItem.m_blocked = IsLineOfSightBlocked (positionA, positionB);
+  m_cacheMisses++;
+  if (item != nullptr)
+    {
+      *item = newItem;
+    }
+  else
     {
-      if ((*bit)->IsIntersect (l1, l2))
+      m_losCache.Insert (key, newItem);
+      uint32_t numEvicted = m_losCache.SetEntrySize (key, sizeof (LosItem));
+      if (numEvicted > 0)
         {
-          // The line of sight should be blocked if the line-segment between
-          // l1 and l2 intersects one of the buildings.
-          return true;
+          NS_LOG_DEBUG ("Evicted " << numEvicted << " line of sight tests");
+          m_cacheEvictions += numEvicted;
         }
+      m_cacheSize = m_losCache.GetSize ();
     }
+  return newItem.m_blocked;
+}
 
-  // The line of sight should not be blocked if the line-segment between
-  // l1 and l2 did not intersect any building.
-  return false;
+void
+BuildingsChannelConditionModel::SetCacheMaxSize (uint64_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_cacheEvictions += m_losCache.SetMaxSize (maxSize);
+  m_cacheSize = m_losCache.GetSize ();
+}
+
+uint64_t
+BuildingsChannelConditionModel::GetCacheMaxSize (void) const
+{
+  return m_losCache.GetMaxSize ();
 }
 
 int64_t
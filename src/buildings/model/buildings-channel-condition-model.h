@@ -23,6 +23,9 @@
 #define BUILDINGS_CHANNEL_CONDITION_MODEL_H
 
 #include "ns3/channel-condition-model.h"
+#include "ns3/traced-value.h"
+#include "ns3/vector.h"
+#include "ns3/lru-cache.h"
 
 namespace ns3 {
 
@@ -34,6 +37,13 @@ class MobilityModel;
  * \brief Determines the channel condition based on the buildings deployed in the
  * scenario
  *
+ * The channel between two outdoor nodes is NLOS if the line-segment between
+ * them intersects a building, which is searched with the spatial index of
+ * the BuildingList. The result is cached for each pair of nodes, and reused
+ * until either node moves by more than the LosCacheDistance attribute, or
+ * the buildings change. The least recently used results are evicted when
+ * the cache exceeds the CacheMaxSize attribute.
+ *
  * Code adapted from MmWave3gppBuildingsPropagationLossModel
  */
 class BuildingsChannelConditionModel : public ChannelConditionModel
@@ -77,6 +87,9 @@ public:
    */
   virtual int64_t AssignStreams (int64_t stream) override;
 
+protected:
+  virtual void DoDispose () override;
+
 private:
   /**
    * \brief Checks if the line of sight between position l1 and position l2 is
@@ -87,6 +100,48 @@ private:
    * \return true if the line of sight is blocked, false otherwise
    */
   bool IsLineOfSightBlocked (const Vector &l1, const Vector &l2) const;
+
+  /**
+   * \brief Checks if the line of sight between a and b is blocked by a
+   *        building, using the cached result of the link if it is still valid.
+   *        The result is not cached if a or b is not aggregated to a Node.
+   *
+   * \param a mobility model
+   * \param b mobility model
+   * \return true if the line of sight is blocked, false otherwise
+   */
+  bool IsLineOfSightBlocked (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
+  /**
+   * Set the memory budget of m_losCache, evicting the least recently used
+   * line of sight tests if needed
+   * \param maxSize the maximum size in bytes, 0 for an unbounded cache
+   */
+  void SetCacheMaxSize (uint64_t maxSize);
+
+  /**
+   * Get the memory budget of m_losCache
+   * \return the maximum size in bytes, 0 for an unbounded cache
+   */
+  uint64_t GetCacheMaxSize (void) const;
+
+  /**
+   * Struct to store the result of the line of sight test of a link
+   */
+  struct LosItem
+  {
+    Vector m_positionA; //!< the position of the node with the lower ID
+    Vector m_positionB; //!< the position of the node with the higher ID
+    uint64_t m_buildingsVersion; //!< the version of the BuildingList used for the test
+    bool m_blocked; //!< true if the line of sight is blocked
+  };
+
+  mutable LruCache<uint64_t, LosItem> m_losCache; //!< cache of the line of sight tests, indexed by the IDs of the nodes
+  double m_losCacheDistance; //!< the distance an endpoint can move before the link is tested again
+  mutable TracedValue<uint64_t> m_cacheHits; //!< number of line of sight tests found in m_losCache
+  mutable TracedValue<uint64_t> m_cacheMisses; //!< number of line of sight tests computed
+  mutable TracedValue<uint64_t> m_cacheEvictions; //!< number of line of sight tests evicted from m_losCache
+  mutable TracedValue<uint64_t> m_cacheSize; //!< estimated size of m_losCache in bytes
 };
 
 } // end ns3 namespace
@@ -179,7 +179,8 @@ MobilityBuildingInfo::MakeConsistent (Ptr<MobilityModel> mm)
 {
   bool found = false;
   Vector pos = mm->GetPosition ();
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsAt (pos);
+  for (std::vector<Ptr<Building> >::const_iterator bit = buildings.begin (); bit != buildings.end (); ++bit)
     {
       NS_LOG_LOGIC ("checking building " << (*bit)->GetId () << " with boundaries " << (*bit)->GetBoundaries ());
       if ((*bit)->IsInside (pos))
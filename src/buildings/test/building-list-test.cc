@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/building.h"
+#include "ns3/building-list.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BuildingListTest");
+
+/**
+ * Test case for the spatial index of the BuildingList. It checks that the
+ * buildings found through the index are those found by testing every
+ * building, for random buildings, line-segments and positions.
+ */
+class BuildingListIndexTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  BuildingListIndexTestCase ();
+
+private:
+  /**
+   * Builds the buildings and perform the tests
+   */
+  virtual void DoRun (void);
+
+  /**
+   * \param l1 position
+   * \param l2 position
+   * \return true if a building intersects the line-segment between l1 and l2,
+   *         testing every building
+   */
+  static bool IsIntersectLinear (const Vector &l1, const Vector &l2);
+};
+
+BuildingListIndexTestCase::BuildingListIndexTestCase ()
+  : TestCase ("Test case for the spatial index of the BuildingList")
+{
+}
+
+bool
+BuildingListIndexTestCase::IsIntersectLinear (const Vector &l1, const Vector &l2)
+{
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsIntersect (l1, l2))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+BuildingListIndexTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+
+  NS_TEST_ASSERT_MSG_EQ ((BuildingList::FindIntersectingBuilding (Vector (0, 0, 0), Vector (10, 10, 0)) == nullptr),
+                         true, "No building should be found in an empty list");
+
+  // buildings of various sizes and heights, some of them overlapping
+  for (uint32_t i = 0; i < 300; i++)
+    {
+      double x = uniform->GetValue (0, 1000);
+      double y = uniform->GetValue (0, 1000);
+      Ptr<Building> building = CreateObject<Building> ();
+      building->SetBoundaries (Box (x, x + uniform->GetValue (1, 60), y, y + uniform->GetValue (1, 60),
+                                    0.0, uniform->GetValue (5, 40)));
+    }
+
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      // random, long, axis-aligned, vertical and outside line-segments
+      Vector l1 (uniform->GetValue (-100, 1100), uniform->GetValue (-100, 1100), uniform->GetValue (0, 50));
+      Vector l2 (uniform->GetValue (-100, 1100), uniform->GetValue (-100, 1100), uniform->GetValue (0, 50));
+      switch (i % 5)
+        {
+        case 1:
+          l2 = Vector (l1.x + uniform->GetValue (-30, 30), l1.y + uniform->GetValue (-30, 30), l2.z);
+          break;
+        case 2:
+          l2.x = l1.x;
+          break;
+        case 3:
+          l2.y = l1.y;
+          break;
+        case 4:
+          l2 = Vector (l1.x, l1.y, l2.z);
+          break;
+        default:
+          break;
+        }
+      Ptr<Building> found = BuildingList::FindIntersectingBuilding (l1, l2);
+      NS_TEST_ASSERT_MSG_EQ ((found != nullptr), IsIntersectLinear (l1, l2),
+                             "Wrong intersection between " << l1 << " and " << l2);
+      if (found != nullptr)
+        {
+          NS_TEST_ASSERT_MSG_EQ (found->IsIntersect (l1, l2), true, "The building found does not intersect the line-segment");
+        }
+
+      std::vector<Ptr<Building> > inside = BuildingList::GetBuildingsAt (l1);
+      std::vector<Ptr<Building> > insideLinear;
+      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+        {
+          if ((*bit)->IsInside (l1))
+            {
+              insideLinear.push_back (*bit);
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ ((inside == insideLinear), true, "Wrong buildings at " << l1);
+    }
+
+  // the index follows the changes of the boundaries
+  Vector l1 (-50, -50, 1.5);
+  Vector l2 (-10, -50, 1.5);
+  NS_TEST_ASSERT_MSG_EQ ((BuildingList::FindIntersectingBuilding (l1, l2) == nullptr), true, "No building should be found");
+  uint64_t version = BuildingList::GetVersion ();
+  Ptr<Building> building = BuildingList::GetBuilding (0);
+  building->SetBoundaries (Box (-40, -20, -60, -40, 0, 10));
+  NS_TEST_ASSERT_MSG_NE (BuildingList::GetVersion (), version, "The version should change with the boundaries");
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::FindIntersectingBuilding (l1, l2), building, "The moved building should be found");
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::GetBuildingsAt (Vector (-30, -50, 5)).size (), 1u, "The moved building should be found");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite for the BuildingList
+ */
+class BuildingListTestSuite : public TestSuite
+{
+public:
+  BuildingListTestSuite ();
+};
+
+BuildingListTestSuite::BuildingListTestSuite ()
+  : TestSuite ("building-list", UNIT)
+{
+  AddTestCase (new BuildingListIndexTestCase, TestCase::QUICK);
+}
+
+static BuildingListTestSuite g_buildingListTestSuite;
@@ -25,6 +25,8 @@
 #include "ns3/buildings-module.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -139,6 +141,139 @@ BuildingsChannelConditionModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Test case for the cache of the line of sight tests of the class
+ * BuildingsChannelConditionModel. It checks that the condition of a link is
+ * computed again when a node moves by more than the LosCacheDistance, or when
+ * the buildings change, and that the cache keeps only the most recently used
+ * links within its CacheMaxSize
+ */
+class BuildingsChannelConditionModelCacheTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  BuildingsChannelConditionModelCacheTestCase ();
+
+private:
+  /**
+   * Builds the simulation scenario and perform the tests
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Stores the number of line of sight tests computed
+   * \param oldValue the previous number of tests
+   * \param newValue the new number of tests
+   */
+  void CacheMisses (uint64_t oldValue, uint64_t newValue);
+
+  uint64_t m_cacheMisses; //!< the number of line of sight tests computed
+};
+
+BuildingsChannelConditionModelCacheTestCase::BuildingsChannelConditionModelCacheTestCase ()
+  : TestCase ("Test case for the cache of the BuildingsChannelConditionModel"),
+    m_cacheMisses (0)
+{
+}
+
+void
+BuildingsChannelConditionModelCacheTestCase::CacheMisses (uint64_t oldValue, uint64_t newValue)
+{
+  m_cacheMisses = newValue;
+}
+
+void
+BuildingsChannelConditionModelCacheTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  nodes.Get (0)->AggregateObject (a);
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  nodes.Get (1)->AggregateObject (b);
+  Ptr<MobilityModel> c = CreateObject<ConstantPositionMobilityModel> ();
+  nodes.Get (2)->AggregateObject (c);
+
+  Ptr<Building> building = CreateObject<Building> ();
+  building->SetBoundaries (Box (45.0, 55.0, 2.0, 12.0, 0.0, 10.0));
+  BuildingsHelper::Install (nodes);
+
+  // the line of sight is blocked when b moves by 8 m
+  Vector positionB (100.0, 0.0, 1.5);
+  Vector movedPositionB (100.0, 8.0, 1.5);
+  double cacheDistances[] = {0.0, 5.0, 10.0};
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<BuildingsChannelConditionModel> condModel = CreateObject<BuildingsChannelConditionModel> ();
+      condModel->SetAttribute ("LosCacheDistance", DoubleValue (cacheDistances[i]));
+      a->SetPosition (Vector (0.0, 0.0, 1.5));
+      b->SetPosition (positionB);
+
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, b)->GetLosCondition (), ChannelCondition::LOS,
+                             "Got unexpected channel condition");
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (b, a)->GetLosCondition (), ChannelCondition::LOS,
+                             "Got unexpected channel condition for the reverse link");
+
+      b->SetPosition (movedPositionB);
+      ChannelCondition::LosConditionValue expected = cacheDistances[i] < 8.0 ? ChannelCondition::NLOS : ChannelCondition::LOS;
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, b)->GetLosCondition (), expected,
+                             "Got unexpected channel condition after a move with LosCacheDistance " << cacheDistances[i]);
+
+      // a new building invalidates the cache
+      Ptr<Building> wall = CreateObject<Building> ();
+      wall->SetBoundaries (Box (20.0, 21.0, -20.0, 20.0, 0.0, 10.0));
+      NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, b)->GetLosCondition (), ChannelCondition::NLOS,
+                             "Got unexpected channel condition after a new building");
+      wall->SetBoundaries (Box (-21.0, -20.0, -20.0, 20.0, 0.0, 10.0));
+    }
+
+  // with a budget smaller than an entry, only the last link stays cached
+  c->SetPosition (Vector (0.0, 100.0, 1.5));
+  uint64_t cacheMaxSizes[] = {0, 1};
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<BuildingsChannelConditionModel> condModel = CreateObject<BuildingsChannelConditionModel> ();
+      condModel->SetAttribute ("CacheMaxSize", UintegerValue (cacheMaxSizes[i]));
+      condModel->TraceConnectWithoutContext ("CacheMisses", MakeCallback (&BuildingsChannelConditionModelCacheTestCase::CacheMisses, this));
+      m_cacheMisses = 0;
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, b)->GetLosCondition (), ChannelCondition::NLOS,
+                                 "Got unexpected channel condition with CacheMaxSize " << cacheMaxSizes[i]);
+          NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (c, a)->GetLosCondition (), ChannelCondition::LOS,
+                                 "Got unexpected channel condition with CacheMaxSize " << cacheMaxSizes[i]);
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_cacheMisses, (cacheMaxSizes[i] == 0 ? 2u : 6u),
+                             "Wrong number of line of sight tests with CacheMaxSize " << cacheMaxSizes[i]);
+    }
+
+  // mobility models without a node are tested every time, without caching
+  Ptr<MobilityModel> d = CreateObject<ConstantPositionMobilityModel> ();
+  d->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+  d->SetPosition (Vector (100.0, 8.0, 1.5));
+  Ptr<MobilityModel> e = CreateObject<ConstantPositionMobilityModel> ();
+  e->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+  e->SetPosition (Vector (100.0, 0.0, 1.5));
+  Ptr<BuildingsChannelConditionModel> condModel = CreateObject<BuildingsChannelConditionModel> ();
+  condModel->SetAttribute ("LosCacheDistance", DoubleValue (10.0));
+  condModel->TraceConnectWithoutContext ("CacheMisses", MakeCallback (&BuildingsChannelConditionModelCacheTestCase::CacheMisses, this));
+  m_cacheMisses = 0;
+  NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (d, c)->GetLosCondition (), ChannelCondition::LOS,
+                         "Got unexpected channel condition for a mobility model without a node");
+  NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, d)->GetLosCondition (), ChannelCondition::NLOS,
+                         "Got unexpected channel condition for a mobility model without a node");
+  NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (e, d)->GetLosCondition (), ChannelCondition::LOS,
+                         "Got unexpected channel condition between mobility models without a node");
+  d->SetPosition (Vector (100.0, 0.0, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (condModel->GetChannelCondition (a, d)->GetLosCondition (), ChannelCondition::LOS,
+                         "The condition of a mobility model without a node was cached");
+  NS_TEST_ASSERT_MSG_EQ (m_cacheMisses, 0u, "The line of sight tests of mobility models without a node were cached");
+
+  Simulator::Destroy ();
+}
+
 /**
  * Test suite for the buildings channel condition model
  */
@@ -152,6 +287,7 @@ BuildingsChannelConditionModelsTestSuite::BuildingsChannelConditionModelsTestSui
   : TestSuite ("buildings-channel-condition-model", UNIT)
 {
   AddTestCase (new BuildingsChannelConditionModelTestCase, TestCase::QUICK);
+  AddTestCase (new BuildingsChannelConditionModelCacheTestCase, TestCase::QUICK);
 }
 
 static BuildingsChannelConditionModelsTestSuite BuildingsChannelConditionModelsTestSuite;
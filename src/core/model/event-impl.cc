@@ -19,7 +19,12 @@
  */
 
 #include "event-impl.h"
+#include "global-value.h"
+#include "boolean.h"
 #include "log.h"
+#include <atomic>
+#include <mutex>
+#include <new>
 
 /**
  * \file
@@ -31,6 +36,272 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+/**
+ * \ingroup events
+ * \anchor GlobalValueEventImplPoolEnabled
+ * Allocate the events from per-thread pools.
+ */
+static GlobalValue g_eventImplPoolEnabled = GlobalValue ("EventImplPoolEnabled",
+                                                         "Allocate the events from per-thread pools of "
+                                                         "fixed-size blocks, read when the first event "
+                                                         "is allocated",
+                                                         BooleanValue (true),
+                                                         MakeBooleanChecker ());
+
+namespace {
+
+/** Size of the smallest size class, and step between size classes, in bytes. */
+const std::size_t POOL_BLOCK_STEP = 16;
+/** Number of size classes. Larger events are allocated with ::operator new. */
+const std::size_t POOL_SIZE_CLASSES = 16;
+/** Size of the chunks carved into blocks, in bytes. */
+const std::size_t POOL_CHUNK_SIZE = 64 * 1024;
+
+struct EventPool;
+
+/**
+ * The header in front of every event, which identifies its allocator.
+ *
+ * It is aligned as strictly as the memory returned by ::operator new,
+ * so that the event behind it keeps the same alignment.
+ */
+struct alignas (std::max_align_t) BlockHeader
+{
+  EventPool *owner;      //!< The pool of the block, or 0 if allocated with ::operator new.
+  std::size_t sizeClass; //!< The size class of the block.
+};
+
+/** A free block, linked in a free list of its pool. */
+struct FreeBlock
+{
+  FreeBlock *next; //!< The next free block of the list.
+};
+
+/**
+ * The event allocator of a thread.
+ *
+ * A pool is owned by one thread at a time, which is the only one to
+ * touch its free lists.  The blocks deleted by other threads are pushed
+ * on the lock-free list remoteFrees, and moved to the free lists by the
+ * owner when it runs out of blocks.  When its thread exits, the pool is
+ * abandoned, and adopted by the next thread which allocates an event, so
+ * that the number of pools is bounded by the number of threads alive at
+ * the same time.
+ */
+struct EventPool
+{
+  EventPool ()
+    : freeLists (),
+      chunkCur (0),
+      chunkEnd (0),
+      remoteFrees (0),
+      nextAbandoned (0),
+      stats ()
+  {}
+  FreeBlock *freeLists[POOL_SIZE_CLASSES]; //!< The free blocks of each size class.
+  char *chunkCur;                          //!< The next unused byte of the current chunk.
+  char *chunkEnd;                          //!< The end of the current chunk.
+  std::atomic<FreeBlock *> remoteFrees;    //!< The blocks deleted by other threads.
+  EventPool *nextAbandoned;                //!< The next pool in the list of abandoned pools.
+  EventImpl::AllocatorStats stats;         //!< The allocator statistics.
+};
+
+/** Abandons the pool of a thread when the thread exits. */
+struct EventPoolOwner
+{
+  ~EventPoolOwner ();
+  EventPool *pool; //!< The pool owned by the thread.
+};
+
+/** The pool of the calling thread, if any. */
+thread_local EventPool *g_eventPool = 0;
+/** Whether the calling thread has abandoned its pool. */
+thread_local bool g_eventPoolAbandoned = false;
+
+/** The pools of the exited threads. */
+EventPool *g_abandonedPools = 0;
+/** Protects g_abandonedPools. */
+std::mutex g_abandonedPoolsMutex;
+
+EventPoolOwner::~EventPoolOwner ()
+{
+  // The events deleted by this thread from now on are handled as
+  // remote frees, and the ones it allocates are not pooled.
+  g_eventPool = 0;
+  g_eventPoolAbandoned = true;
+  std::lock_guard<std::mutex> lock (g_abandonedPoolsMutex);
+  pool->nextAbandoned = g_abandonedPools;
+  g_abandonedPools = pool;
+}
+
+/**
+ * Get the pool of the calling thread, adopting an abandoned pool or
+ * creating a new one on the first call.
+ *
+ * \returns The pool of the calling thread, or 0 if the thread is exiting.
+ */
+EventPool *
+GetEventPool (void)
+{
+  EventPool *pool = g_eventPool;
+  if (pool != 0 || g_eventPoolAbandoned)
+    {
+      return pool;
+    }
+  {
+    std::lock_guard<std::mutex> lock (g_abandonedPoolsMutex);
+    pool = g_abandonedPools;
+    if (pool != 0)
+      {
+        g_abandonedPools = pool->nextAbandoned;
+        pool->nextAbandoned = 0;
+      }
+  }
+  if (pool == 0)
+    {
+      pool = new EventPool ();
+    }
+  static thread_local EventPoolOwner owner;
+  owner.pool = pool;
+  g_eventPool = pool;
+  return pool;
+}
+
+/**
+ * Move the blocks deleted by other threads to the free lists.
+ *
+ * \param [in] pool The pool of the calling thread.
+ */
+void
+DrainRemoteFrees (EventPool *pool)
+{
+  FreeBlock *block = pool->remoteFrees.exchange (0, std::memory_order_acquire);
+  while (block != 0)
+    {
+      FreeBlock *next = block->next;
+      std::size_t sizeClass = (reinterpret_cast<BlockHeader *> (block) - 1)->sizeClass;
+      block->next = pool->freeLists[sizeClass];
+      pool->freeLists[sizeClass] = block;
+      pool->stats.remote++;
+      block = next;
+    }
+}
+
+} // unnamed namespace
+
+bool
+EventImpl::IsPoolEnabled (void)
+{
+  // Read by name, since an event might be allocated during the static
+  // initialization, before g_eventImplPoolEnabled is constructed.
+  static const bool enabled = []
+    {
+      BooleanValue value (true);
+      GlobalValue::GetValueByNameFailSafe ("EventImplPoolEnabled", value);
+      return value.Get ();
+    } ();
+  return enabled;
+}
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventPool *pool = GetEventPool ();
+  if (pool != 0)
+    {
+      pool->stats.allocations++;
+    }
+  if (pool == 0 || size == 0 || size > POOL_BLOCK_STEP * POOL_SIZE_CLASSES || !IsPoolEnabled ())
+    {
+      if (pool != 0)
+        {
+          pool->stats.unpooled++;
+        }
+      BlockHeader *header = static_cast<BlockHeader *> (::operator new (sizeof (BlockHeader) + size));
+      header->owner = 0;
+      header->sizeClass = 0;
+      return header + 1;
+    }
+  std::size_t sizeClass = (size - 1) / POOL_BLOCK_STEP;
+  FreeBlock *block = pool->freeLists[sizeClass];
+  if (block == 0 && pool->remoteFrees.load (std::memory_order_relaxed) != 0)
+    {
+      DrainRemoteFrees (pool);
+      block = pool->freeLists[sizeClass];
+    }
+  if (block != 0)
+    {
+      pool->freeLists[sizeClass] = block->next;
+      pool->stats.reused++;
+      return block;
+    }
+  std::size_t blockSize = sizeof (BlockHeader) + (sizeClass + 1) * POOL_BLOCK_STEP;
+  if (pool->chunkCur == 0 || static_cast<std::size_t> (pool->chunkEnd - pool->chunkCur) < blockSize)
+    {
+      // The tail of the previous chunk, if any, is left unused.
+      pool->chunkCur = static_cast<char *> (::operator new (POOL_CHUNK_SIZE));
+      pool->chunkEnd = pool->chunkCur + POOL_CHUNK_SIZE;
+      pool->stats.chunks++;
+      pool->stats.bytes += POOL_CHUNK_SIZE;
+    }
+  BlockHeader *header = reinterpret_cast<BlockHeader *> (pool->chunkCur);
+  pool->chunkCur += blockSize;
+  header->owner = pool;
+  header->sizeClass = sizeClass;
+  return header + 1;
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  BlockHeader *header = static_cast<BlockHeader *> (p) - 1;
+  EventPool *owner = header->owner;
+  EventPool *pool = g_eventPool;
+  if (pool != 0)
+    {
+      pool->stats.deallocations++;
+    }
+  if (owner == 0)
+    {
+      ::operator delete (header);
+      return;
+    }
+  NS_ASSERT_MSG ((size - 1) / POOL_BLOCK_STEP == header->sizeClass, "Corrupted event block header");
+  FreeBlock *block = static_cast<FreeBlock *> (p);
+  if (owner == pool)
+    {
+      block->next = pool->freeLists[header->sizeClass];
+      pool->freeLists[header->sizeClass] = block;
+      return;
+    }
+  // The block belongs to the pool of another thread, or to an abandoned
+  // pool: hand it back to its pool.
+  FreeBlock *head = owner->remoteFrees.load (std::memory_order_relaxed);
+  do
+    {
+      block->next = head;
+    }
+  while (!owner->remoteFrees.compare_exchange_weak (head, block,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+}
+
+EventImpl::AllocatorStats
+EventImpl::GetAllocatorStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EventPool *pool = GetEventPool ();
+  if (pool == 0)
+    {
+      return AllocatorStats ();
+    }
+  return pool->stats;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
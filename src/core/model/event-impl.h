@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,15 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from per-thread pools of fixed-size blocks,
+ * one free list per size class, since most simulations create and
+ * delete millions of small events of a few distinct sizes.  Each block
+ * records its pool, so that an event deleted by another thread than the
+ * one which created it goes back to the pool of the latter.  The pool of
+ * an exited thread is reused by the next thread which allocates an
+ * event.  The pools can be disabled with the GlobalValue
+ * EventImplPoolEnabled, which is read when the first event is allocated.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +76,47 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate the memory of an event from the pool of the calling thread.
+   *
+   * \param [in] size The size of the event, in bytes.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Return the memory of an event to the pool which allocated it.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event, in bytes.
+   */
+  static void operator delete (void *p, std::size_t size);
+
+  /** Statistics of the event allocator of a thread. */
+  struct AllocatorStats
+  {
+    uint64_t allocations;   //!< Number of events allocated.
+    uint64_t deallocations; //!< Number of events deleted.
+    uint64_t remote;        //!< Number of blocks deleted by other threads and returned to the pool.
+    uint64_t reused;        //!< Number of allocations served from a free list.
+    uint64_t unpooled;      //!< Number of allocations too large for the pools, or with the pools disabled.
+    uint64_t chunks;        //!< Number of memory chunks carved into blocks.
+    uint64_t bytes;         //!< Total size of the chunks, in bytes.
+  };
+  /**
+   * Get the statistics of the event allocator of the calling thread.
+   *
+   * They include the events of the previous owners of its pool.
+   *
+   * \returns The allocator statistics.
+   */
+  static AllocatorStats GetAllocatorStats (void);
+  /**
+   * Check whether the events are allocated from the pools.
+   *
+   * \returns \c true if the pools are enabled.
+   */
+  static bool IsPoolEnabled (void);
+
 protected:
   /**
    * Implementation for Invoke().
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::LruCache template class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ *
+ * \brief A map with a memory budget and least recently used eviction
+ *
+ * Each entry has a size, e.g., an estimate of the memory it uses, set with
+ * SetEntrySize. When the total size of the entries exceeds the maximum size,
+ * the least recently used entries are evicted, except the most recently
+ * used one. Find and Insert mark an entry as the most recently used.
+ * A maximum size of 0 means that the cache is unbounded.
+ *
+ * Find, Insert, SetEntrySize and Erase take constant time on average.
+ *
+ * \tparam Key \explicit The type of the keys, which must be hashable.
+ * \tparam Value \explicit The type of the values.
+ */
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+  /** Constructor of an unbounded cache. */
+  LruCache ()
+    : m_maxSize (0),
+      m_size (0)
+  {
+  }
+
+  /**
+   * Set the maximum total size of the entries, and evict the least recently
+   * used entries if needed.
+   * \param [in] maxSize The maximum size, 0 for an unbounded cache.
+   * \returns The number of entries evicted.
+   */
+  uint32_t SetMaxSize (uint64_t maxSize)
+  {
+    m_maxSize = maxSize;
+    return Evict ();
+  }
+
+  /** \returns The maximum total size of the entries, 0 if unbounded. */
+  uint64_t GetMaxSize (void) const
+  {
+    return m_maxSize;
+  }
+
+  /** \returns The total size of the entries. */
+  uint64_t GetSize (void) const
+  {
+    return m_size;
+  }
+
+  /** \returns The number of entries. */
+  std::size_t GetNEntries (void) const
+  {
+    return m_map.size ();
+  }
+
+  /**
+   * Look for an entry, and mark it as the most recently used.
+   * \param [in] key The key.
+   * \returns A pointer to the value, or 0 if not found.
+   */
+  Value * Find (const Key &key)
+  {
+    auto it = m_map.find (key);
+    if (it == m_map.end ())
+      {
+        return 0;
+      }
+    m_entries.splice (m_entries.begin (), m_entries, it->second);
+    return &it->second->m_value;
+  }
+
+  /**
+   * Insert an entry with size 0, or replace the value of an existing entry
+   * keeping its size, and mark it as the most recently used.
+   * \param [in] key The key.
+   * \param [in] value The value.
+   * \returns A reference to the stored value.
+   */
+  Value & Insert (const Key &key, const Value &value)
+  {
+    Value *stored = Find (key);
+    if (stored != 0)
+      {
+        *stored = value;
+        return *stored;
+      }
+    m_entries.push_front (Entry (key, value));
+    m_map.insert (std::make_pair (key, m_entries.begin ()));
+    return m_entries.front ().m_value;
+  }
+
+  /**
+   * Set the size of an entry, and evict the least recently used entries if
+   * the maximum size is exceeded. The entry is not evicted if it is the most
+   * recently used one.
+   * \param [in] key The key, which must be in the cache.
+   * \param [in] size The size of the entry.
+   * \returns The number of entries evicted.
+   */
+  uint32_t SetEntrySize (const Key &key, uint64_t size)
+  {
+    auto it = m_map.find (key);
+    if (it != m_map.end ())
+      {
+        m_size += size - it->second->m_size;
+        it->second->m_size = size;
+      }
+    return Evict ();
+  }
+
+  /**
+   * Remove an entry, if present.
+   * \param [in] key The key.
+   */
+  void Erase (const Key &key)
+  {
+    auto it = m_map.find (key);
+    if (it != m_map.end ())
+      {
+        m_size -= it->second->m_size;
+        m_entries.erase (it->second);
+        m_map.erase (it);
+      }
+  }
+
+  /** Remove all the entries. */
+  void Clear (void)
+  {
+    m_map.clear ();
+    m_entries.clear ();
+    m_size = 0;
+  }
+
+private:
+  /** An entry of the cache. */
+  struct Entry
+  {
+    /**
+     * Constructor.
+     * \param [in] key The key.
+     * \param [in] value The value.
+     */
+    Entry (const Key &key, const Value &value)
+      : m_key (key),
+        m_value (value),
+        m_size (0)
+    {
+    }
+    Key m_key;       //!< The key.
+    Value m_value;   //!< The value.
+    uint64_t m_size; //!< The size of the entry.
+  };
+
+  /**
+   * Evict the least recently used entries until the total size does not
+   * exceed the maximum size, or only one entry is left.
+   * \returns The number of entries evicted.
+   */
+  uint32_t Evict (void)
+  {
+    uint32_t numEvicted = 0;
+    while (m_maxSize != 0 && m_size > m_maxSize && m_entries.size () > 1)
+      {
+        Entry &last = m_entries.back ();
+        m_size -= last.m_size;
+        m_map.erase (last.m_key);
+        m_entries.pop_back ();
+        numEvicted++;
+      }
+    return numEvicted;
+  }
+
+  /** The entries, from the most to the least recently used. */
+  std::list<Entry> m_entries;
+  /** The position of each entry in m_entries. */
+  std::unordered_map<Key, typename std::list<Entry>::iterator> m_map;
+  uint64_t m_maxSize; //!< The maximum total size, 0 if unbounded.
+  uint64_t m_size;    //!< The total size of the entries.
+};
+
+} // namespace ns3
+
+#endif /* LRU_CACHE_H */
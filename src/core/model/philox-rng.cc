@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "philox-rng.h"
+
+/**
+ * \file
+ * \ingroup rngimpl
+ * ns3::PhiloxRng implementation.
+ */
+
+namespace {
+
+/** The multiplier of the first and second words. */
+const uint32_t PHILOX_M0 = 0xD2511F53;
+/** The multiplier of the third and fourth words. */
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+/** The increment of the first word of the key (golden ratio). */
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+/** The increment of the second word of the key (sqrt(3) - 1). */
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+/** The number of rounds. */
+const int PHILOX_ROUNDS = 10;
+
+} // unnamed namespace
+
+namespace ns3 {
+
+PhiloxRng::PhiloxRng ()
+  : PhiloxRng (0, 0, 0)
+{
+}
+
+PhiloxRng::PhiloxRng (uint64_t key, uint64_t counterHigh, uint32_t counterMid)
+  : m_next (4)
+{
+  m_key[0] = static_cast<uint32_t> (key);
+  m_key[1] = static_cast<uint32_t> (key >> 32);
+  m_counter[0] = 0;
+  m_counter[1] = counterMid;
+  m_counter[2] = static_cast<uint32_t> (counterHigh);
+  m_counter[3] = static_cast<uint32_t> (counterHigh >> 32);
+}
+
+void
+PhiloxRng::Generate (const uint32_t key[2], const uint32_t counter[4], uint32_t result[4])
+{
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  for (int round = 0; round < PHILOX_ROUNDS; round++)
+    {
+      if (round > 0)
+        {
+          k0 += PHILOX_W0;
+          k1 += PHILOX_W1;
+        }
+      uint64_t p0 = static_cast<uint64_t> (PHILOX_M0) * c0;
+      uint64_t p1 = static_cast<uint64_t> (PHILOX_M1) * c2;
+      uint32_t hi0 = static_cast<uint32_t> (p0 >> 32);
+      uint32_t lo0 = static_cast<uint32_t> (p0);
+      uint32_t hi1 = static_cast<uint32_t> (p1 >> 32);
+      uint32_t lo1 = static_cast<uint32_t> (p1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+    }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
+
+double
+PhiloxRng::RandU01 (void)
+{
+  if (m_next == 4)
+    {
+      Generate (m_key, m_counter, m_block);
+      m_counter[0]++;
+      m_next = 0;
+    }
+  // build a 53-bit mantissa from two words, and shift the result by half a
+  // step so that neither 0 nor 1 can be returned
+  uint64_t a = m_block[m_next] >> 5;
+  uint64_t b = m_block[m_next + 1] >> 6;
+  m_next += 2;
+  return ((a << 26) + b + 0.5) / 9007199254740992.0; // 2^53
+}
+
+} // namespace ns3
@@ -133,6 +133,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 24 bytes </td>
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
+ * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> TimingWheelScheduler </td>
+ *      <td class="markdownTableBodyLeft"> `<std::vector> []` and heap on `std::vector` </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> 32 bytes per bucket </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
  * </table>
  *
  * It is possible to change the Scheduler choice during a simulation,
@@ -0,0 +1,327 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "timing-wheel-scheduler.h"
+#include "event-impl.h"
+#include "type-id.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler class implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (TimingWheelScheduler);
+
+namespace {
+
+/**
+ * \ingroup scheduler
+ * Get the index of the least significant bit set in a word.
+ *
+ * \param [in] word The word, which must not be 0.
+ * \returns The index of the bit.
+ */
+inline uint32_t
+LowestBitSet (uint64_t word)
+{
+#if defined (__GNUC__)
+  return __builtin_ctzll (word);
+#else
+  uint32_t index = 0;
+  while ((word & 1) == 0)
+    {
+      word >>= 1;
+      index++;
+    }
+  return index;
+#endif
+}
+
+} // unnamed namespace
+
+TypeId
+TimingWheelScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimingWheelScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<TimingWheelScheduler> ()
+    .AddAttribute ("Granularity",
+                   "The duration of a bucket, e.g., the symbol period of a slotted model",
+                   TypeId::ATTR_CONSTRUCT,
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&TimingWheelScheduler::SetGranularity,
+                                     &TimingWheelScheduler::GetGranularity),
+                   MakeTimeChecker (TimeStep (1), Time::Max ()))
+    .AddAttribute ("NumBuckets",
+                   "The number of buckets of the wheel, rounded up to a power of 2. "
+                   "The events beyond NumBuckets x Granularity from the last event "
+                   "are kept in an overflow heap.",
+                   TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (16384),
+                   MakeUintegerAccessor (&TimingWheelScheduler::SetNumBuckets,
+                                         &TimingWheelScheduler::GetNumBuckets),
+                   MakeUintegerChecker<uint32_t> (1, 1u << 24))
+  ;
+  return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler ()
+  : m_nBuckets (0),
+    m_granularity (1),
+    m_currentSlot (0),
+    m_wheelSize (0)
+{
+  NS_LOG_FUNCTION (this);
+  SetNumBuckets (1);
+}
+
+TimingWheelScheduler::~TimingWheelScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TimingWheelScheduler::SetGranularity (Time granularity)
+{
+  NS_LOG_FUNCTION (this << granularity);
+  NS_ASSERT_MSG (IsEmpty (), "The granularity can only be changed when the scheduler is empty");
+  NS_ASSERT (granularity.GetTimeStep () > 0);
+  m_granularity = granularity.GetTimeStep ();
+  m_currentSlot = 0;
+}
+
+Time
+TimingWheelScheduler::GetGranularity (void) const
+{
+  return TimeStep (m_granularity);
+}
+
+void
+TimingWheelScheduler::SetNumBuckets (uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << nBuckets);
+  NS_ASSERT_MSG (IsEmpty (), "The number of buckets can only be changed when the scheduler is empty");
+  m_nBuckets = 1;
+  while (m_nBuckets < nBuckets)
+    {
+      m_nBuckets <<= 1;
+    }
+  m_buckets.clear ();
+  m_buckets.resize (m_nBuckets);
+  m_bitmap.assign ((m_nBuckets + 63) / 64, 0);
+  m_currentSlot = 0;
+}
+
+uint32_t
+TimingWheelScheduler::GetNumBuckets (void) const
+{
+  return m_nBuckets;
+}
+
+void
+TimingWheelScheduler::SetBucketBit (uint32_t bucket, bool nonEmpty)
+{
+  uint64_t mask = uint64_t (1) << (bucket & 63);
+  if (nonEmpty)
+    {
+      m_bitmap[bucket >> 6] |= mask;
+    }
+  else
+    {
+      m_bitmap[bucket >> 6] &= ~mask;
+    }
+}
+
+bool
+TimingWheelScheduler::InsertInWheel (const Event &ev)
+{
+  uint64_t slot = ev.key.m_ts / m_granularity;
+  if (slot < m_currentSlot || slot - m_currentSlot >= m_nBuckets)
+    {
+      return false;
+    }
+  uint32_t bucket = slot & (m_nBuckets - 1);
+  std::vector<Scheduler::Event> &events = m_buckets[bucket].events;
+  if (events.empty () || events.back () < ev)
+    {
+      events.push_back (ev);
+    }
+  else
+    {
+      events.insert (std::upper_bound (events.begin () + m_buckets[bucket].head, events.end (), ev), ev);
+    }
+  if (events.size () - m_buckets[bucket].head == 1)
+    {
+      SetBucketBit (bucket, true);
+    }
+  m_wheelSize++;
+  return true;
+}
+
+void
+TimingWheelScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (!InsertInWheel (ev))
+    {
+      NS_LOG_LOGIC ("insert in the overflow heap");
+      m_overflow.push_back (ev);
+      std::push_heap (m_overflow.begin (), m_overflow.end (), std::greater<Scheduler::Event> ());
+    }
+}
+
+bool
+TimingWheelScheduler::IsEmpty (void) const
+{
+  return m_wheelSize == 0 && m_overflow.empty ();
+}
+
+uint32_t
+TimingWheelScheduler::FindNextBucket (void) const
+{
+  if (m_wheelSize == 0)
+    {
+      return m_nBuckets;
+    }
+  // scan the bitmap from the current bucket, wrapping around once
+  uint32_t start = m_currentSlot & (m_nBuckets - 1);
+  uint32_t nWords = m_bitmap.size ();
+  uint32_t w = start >> 6;
+  uint64_t word = m_bitmap[w] & (~uint64_t (0) << (start & 63));
+  for (uint32_t i = 0; i <= nWords; i++)
+    {
+      if (word != 0)
+        {
+          return (w << 6) + LowestBitSet (word);
+        }
+      w = (w + 1) % nWords;
+      word = m_bitmap[w];
+    }
+  NS_ASSERT_MSG (false, "The wheel is not empty but no bucket has events");
+  return m_nBuckets;
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  uint32_t bucket = FindNextBucket ();
+  if (bucket == m_nBuckets
+      || (!m_overflow.empty () && m_overflow.front () < m_buckets[bucket].events[m_buckets[bucket].head]))
+    {
+      return m_overflow.front ();
+    }
+  return m_buckets[bucket].events[m_buckets[bucket].head];
+}
+
+void
+TimingWheelScheduler::Advance (uint64_t slot)
+{
+  if (slot <= m_currentSlot)
+    {
+      return;
+    }
+  m_currentSlot = slot;
+  // the events of the overflow heap which are now within the horizon
+  while (!m_overflow.empty () && InsertInWheel (m_overflow.front ()))
+    {
+      std::pop_heap (m_overflow.begin (), m_overflow.end (), std::greater<Scheduler::Event> ());
+      m_overflow.pop_back ();
+    }
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  uint32_t bucket = FindNextBucket ();
+  Scheduler::Event next;
+  if (bucket == m_nBuckets
+      || (!m_overflow.empty () && m_overflow.front () < m_buckets[bucket].events[m_buckets[bucket].head]))
+    {
+      std::pop_heap (m_overflow.begin (), m_overflow.end (), std::greater<Scheduler::Event> ());
+      next = m_overflow.back ();
+      m_overflow.pop_back ();
+    }
+  else
+    {
+      Bucket &b = m_buckets[bucket];
+      next = b.events[b.head++];
+      if (b.head == b.events.size ())
+        {
+          b.events.clear ();
+          b.head = 0;
+          SetBucketBit (bucket, false);
+        }
+      m_wheelSize--;
+    }
+  NS_LOG_LOGIC ("remove ts=" << next.key.m_ts << ", uid=" << next.key.m_uid);
+  Advance (next.key.m_ts / m_granularity);
+  return next;
+}
+
+void
+TimingWheelScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t slot = ev.key.m_ts / m_granularity;
+  if (slot >= m_currentSlot && slot - m_currentSlot < m_nBuckets)
+    {
+      uint32_t bucket = slot & (m_nBuckets - 1);
+      Bucket &b = m_buckets[bucket];
+      std::vector<Scheduler::Event>::iterator it = std::lower_bound (b.events.begin () + b.head, b.events.end (), ev);
+      if (it != b.events.end () && it->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (it->impl == ev.impl);
+          b.events.erase (it);
+          if (b.head == b.events.size ())
+            {
+              b.events.clear ();
+              b.head = 0;
+              SetBucketBit (bucket, false);
+            }
+          m_wheelSize--;
+          return;
+        }
+    }
+  for (std::vector<Scheduler::Event>::iterator it = m_overflow.begin (); it != m_overflow.end (); ++it)
+    {
+      if (it->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (it->impl == ev.impl);
+          m_overflow.erase (it);
+          std::make_heap (m_overflow.begin (), m_overflow.end (), std::greater<Scheduler::Event> ());
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+} // namespace ns3
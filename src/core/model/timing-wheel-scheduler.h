@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+#include "nstime.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler class declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a timing wheel event scheduler
+ *
+ * This event scheduler is meant for models whose events mostly fall
+ * a short and regular time after the current time, such as the symbol,
+ * slot and subframe boundaries of a slotted PHY and MAC.
+ *
+ * Time is divided in slots of a fixed granularity, set with the
+ * Granularity attribute, e.g., to the symbol period.  The wheel is a ring
+ * of NumBuckets buckets, and bucket `(ts / granularity) % NumBuckets` holds
+ * the events which fall in the slot of timestamp `ts`, as long as the slot
+ * is within NumBuckets slots from the slot of the last event removed.
+ * The events beyond this horizon are kept in an overflow heap, and are
+ * moved to the wheel when the wheel reaches them.  A bitmap of the
+ * non-empty buckets is used to find the next event.
+ *
+ * Each bucket is a `std::vector` sorted by increasing timestamp, with the
+ * index of its next event.  New events are usually later than the others
+ * of their bucket, and are appended, while the next event is removed by
+ * moving the index forward.  The vectors are cleared when all their events
+ * are removed, but keep their capacity, so that inserting an event usually
+ * does not allocate memory.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Ordering within bucket, or heap push for far events
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | ~Constant       | Bitmap search of the next bucket
+ * Remove()     | ~Constant       | Search within bucket, or linear for far events
+ * RemoveNext() | ~Constant       | Bitmap search of the next bucket
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                                  | Reason
+ * :-------- | :-------------------------------------- | :-----
+ * Overhead  | NumBuckets x (4 x `sizeof (*)` + 1 bit) | `std::vector` and index per bucket, bitmap
+ * Per Event | 0                                       | Events stored in `std::vector` directly
+ */
+class TimingWheelScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  TimingWheelScheduler ();
+  /** Destructor. */
+  virtual ~TimingWheelScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /**
+   * Set the duration of a bucket.
+   *
+   * This can only be used when the scheduler is empty, as invoked by the
+   * Attribute Granularity.
+   *
+   * \param [in] granularity The duration of a bucket.
+   */
+  void SetGranularity (Time granularity);
+  /**
+   * Get the duration of a bucket.
+   *
+   * \returns The duration of a bucket.
+   */
+  Time GetGranularity (void) const;
+  /**
+   * Set the number of buckets, rounded up to a power of 2.
+   *
+   * This can only be used when the scheduler is empty, as invoked by the
+   * Attribute NumBuckets.
+   *
+   * \param [in] nBuckets The number of buckets.
+   */
+  void SetNumBuckets (uint32_t nBuckets);
+  /**
+   * Get the number of buckets.
+   *
+   * \returns The number of buckets.
+   */
+  uint32_t GetNumBuckets (void) const;
+  /**
+   * Insert an event in the wheel, if its slot is within the horizon.
+   *
+   * \param [in] ev The event.
+   * \returns \c true if the event was inserted.
+   */
+  bool InsertInWheel (const Scheduler::Event &ev);
+  /**
+   * Find the first non-empty bucket from the current one.
+   *
+   * \returns The index of the bucket, or m_nBuckets if the wheel is empty.
+   */
+  uint32_t FindNextBucket (void) const;
+  /**
+   * Move the current slot forward, and move the overflow events within
+   * the new horizon to the wheel.
+   *
+   * \param [in] slot The new current slot.
+   */
+  void Advance (uint64_t slot);
+  /**
+   * Mark a bucket as empty or non-empty.
+   *
+   * \param [in] bucket The index of the bucket.
+   * \param [in] nonEmpty \c true if the bucket has events.
+   */
+  void SetBucketBit (uint32_t bucket, bool nonEmpty);
+
+  /** Bucket type: events sorted by increasing timestamp. */
+  struct Bucket
+  {
+    Bucket () : head (0) {}
+    std::vector<Scheduler::Event> events; //!< The events, including those already removed.
+    std::size_t head;                     //!< The index of the next event.
+  };
+
+  /** Ring of buckets. */
+  std::vector<Bucket> m_buckets;
+  /** One bit per bucket, set if the bucket has events. */
+  std::vector<uint64_t> m_bitmap;
+  /** Number of buckets, a power of 2. */
+  uint32_t m_nBuckets;
+  /** Duration of a bucket, in dimensionless time units. */
+  uint64_t m_granularity;
+  /** Slot of the last event removed, which is the slot of the current bucket. */
+  uint64_t m_currentSlot;
+  /** Number of events in the wheel. */
+  uint32_t m_wheelSize;
+  /** Heap of the events beyond the horizon of the wheel, with the next one at the front. */
+  std::vector<Scheduler::Event> m_overflow;
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/lru-cache.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup lru-cache-tests
+ * LruCache test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup lru-cache-tests LruCache test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup lru-cache-tests
+ * Check the lookups, the size accounting and the eviction order of LruCache.
+ */
+class LruCacheTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LruCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LruCacheTestCase::LruCacheTestCase ()
+  : TestCase ("Check the lookups and the eviction of LruCache")
+{
+}
+
+void
+LruCacheTestCase::DoRun (void)
+{
+  LruCache<uint64_t, int> cache;
+
+  // unbounded cache
+  for (uint64_t key = 0; key < 4; key++)
+    {
+      cache.Insert (key, key * 10);
+      NS_TEST_ASSERT_MSG_EQ (cache.SetEntrySize (key, 100), 0, "An unbounded cache should not evict");
+    }
+  NS_TEST_ASSERT_MSG_EQ (cache.GetNEntries (), 4, "Wrong number of entries");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 400, "Wrong total size");
+  NS_TEST_ASSERT_MSG_EQ (*cache.Find (2), 20, "Wrong value");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (4) == 0), true, "The key should not be found");
+
+  // replacing a value keeps the size of the entry
+  cache.Insert (3, 31);
+  NS_TEST_ASSERT_MSG_EQ (*cache.Find (3), 31, "The value should be replaced");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 400, "Replacing a value should keep its size");
+
+  // the usage order is now 3, 2, 1, 0: reducing the maximum size evicts 0 and 1
+  NS_TEST_ASSERT_MSG_EQ (cache.SetMaxSize (250), 2, "Two entries should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetNEntries (), 2, "Wrong number of entries");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 200, "Wrong total size");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (0) == 0), true, "The least recently used entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (1) == 0), true, "The least recently used entry should be evicted");
+
+  // after using 2, 3 is the least recently used entry and growing it evicts it
+  cache.Find (2);
+  NS_TEST_ASSERT_MSG_EQ (cache.SetEntrySize (3, 150), 0, "The entries still fit");
+  NS_TEST_ASSERT_MSG_EQ (cache.SetEntrySize (3, 200), 1, "The least recently used entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (3) == 0), true, "The least recently used entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 100, "Wrong total size");
+
+  // the most recently used entry is kept even if it exceeds the maximum size
+  cache.Insert (5, 50);
+  NS_TEST_ASSERT_MSG_EQ (cache.SetEntrySize (5, 1000), 1, "Only the other entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (*cache.Find (5), 50, "The most recently used entry should be kept");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (2) == 0), true, "The least recently used entry should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 1000, "Wrong total size");
+
+  cache.Erase (5);
+  NS_TEST_ASSERT_MSG_EQ (cache.GetNEntries (), 0, "The cache should be empty");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 0, "The cache should be empty");
+}
+
+
+/**
+ * \ingroup lru-cache-tests
+ * LruCache test suite.
+ */
+class LruCacheTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  LruCacheTestSuite ();
+};
+
+LruCacheTestSuite::LruCacheTestSuite ()
+  : TestSuite ("lru-cache", UNIT)
+{
+  AddTestCase (new LruCacheTestCase, TestCase::QUICK);
+}
+
+/**
+ * \ingroup lru-cache-tests
+ * LruCacheTestSuite instance variable.
+ */
+static LruCacheTestSuite g_lruCacheTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
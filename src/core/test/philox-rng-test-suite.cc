@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/philox-rng.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup philox-tests
+ * PhiloxRng test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \defgroup philox-tests PhiloxRng test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup philox-tests
+ * Check the Philox4x32-10 bijection against the known answer vectors of
+ * the reference implementation.
+ */
+class PhiloxKnownAnswerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PhiloxKnownAnswerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PhiloxKnownAnswerTestCase::PhiloxKnownAnswerTestCase ()
+  : TestCase ("Check the Philox4x32-10 bijection against the known answer vectors")
+{
+}
+
+void
+PhiloxKnownAnswerTestCase::DoRun (void)
+{
+  struct Vector
+  {
+    uint32_t counter[4];
+    uint32_t key[2];
+    uint32_t expected[4];
+  };
+  const Vector vectors[] = {
+    {{0x00000000, 0x00000000, 0x00000000, 0x00000000}, {0x00000000, 0x00000000},
+     {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+    {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff},
+     {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+    {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0},
+     {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+  };
+
+  for (const Vector &v : vectors)
+    {
+      uint32_t result[4];
+      PhiloxRng::Generate (v.key, v.counter, result);
+      for (int i = 0; i < 4; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (result[i], v.expected[i], "Wrong word " << i << " of the Philox4x32-10 output");
+        }
+    }
+}
+
+
+/**
+ * \ingroup philox-tests
+ * Check the properties of the sequences of PhiloxRng: the values are in
+ * (0, 1), the sequences are reproducible, and different keys or counters
+ * give different sequences.
+ */
+class PhiloxSequenceTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  PhiloxSequenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PhiloxSequenceTestCase::PhiloxSequenceTestCase ()
+  : TestCase ("Check the sequences generated by PhiloxRng")
+{
+}
+
+void
+PhiloxSequenceTestCase::DoRun (void)
+{
+  const uint32_t n = 10000;
+  PhiloxRng rng (12345, 678, 9);
+  PhiloxRng same (12345, 678, 9);
+  PhiloxRng otherKey (12346, 678, 9);
+  PhiloxRng otherHigh (12345, 679, 9);
+  PhiloxRng otherMid (12345, 678, 10);
+
+  double sum = 0;
+  uint32_t numDifferentKey = 0;
+  uint32_t numDifferentHigh = 0;
+  uint32_t numDifferentMid = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double value = rng.RandU01 ();
+      NS_TEST_ASSERT_MSG_GT (value, 0.0, "The values should be greater than 0");
+      NS_TEST_ASSERT_MSG_LT (value, 1.0, "The values should be lower than 1");
+      NS_TEST_ASSERT_MSG_EQ (value, same.RandU01 (), "The same key and counter should give the same sequence");
+      numDifferentKey += (value != otherKey.RandU01 ());
+      numDifferentHigh += (value != otherHigh.RandU01 ());
+      numDifferentMid += (value != otherMid.RandU01 ());
+      sum += value;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (numDifferentKey, n, "A different key should give a different sequence");
+  NS_TEST_ASSERT_MSG_EQ (numDifferentHigh, n, "A different counter should give a different sequence");
+  NS_TEST_ASSERT_MSG_EQ (numDifferentMid, n, "A different counter should give a different sequence");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sum / n, 0.5, 0.01, "The mean should be close to 0.5");
+}
+
+
+/**
+ * \ingroup philox-tests
+ * PhiloxRng test suite.
+ */
+class PhiloxRngTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  PhiloxRngTestSuite ();
+};
+
+PhiloxRngTestSuite::PhiloxRngTestSuite ()
+  : TestSuite ("philox-rng", UNIT)
+{
+  AddTestCase (new PhiloxKnownAnswerTestCase, TestCase::QUICK);
+  AddTestCase (new PhiloxSequenceTestCase, TestCase::QUICK);
+}
+
+/**
+ * \ingroup philox-tests
+ * PhiloxRngTestSuite instance variable.
+ */
+static PhiloxRngTestSuite g_philoxRngTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
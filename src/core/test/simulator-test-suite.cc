@@ -24,6 +24,11 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/timing-wheel-scheduler.h"
+#include "ns3/uinteger.h"
+#include "ns3/event-impl.h"
+#include "ns3/random-variable-stream.h"
+#include <set>
 
 using namespace ns3;
 
@@ -465,6 +470,166 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory, std::string description);
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory, std::string description)
+  : TestCase ("Check the order of the events and their removal with " +
+              schedulerFactory.GetTypeId ().GetName () + description),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+
+  // the reference event list
+  std::set<Scheduler::EventKey> keys;
+  uint32_t uid = 0;
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      double action = uniform->GetValue ();
+      if (action < 0.5 || keys.empty ())
+        {
+          // mostly near events, often at the same time, and some far ones
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key.m_ts = now + (uniform->GetValue () < 0.9 ? uniform->GetInteger (0, 100) : uniform->GetInteger (0, 100000));
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          scheduler->Insert (ev);
+          keys.insert (ev.key);
+        }
+      else if (action < 0.6)
+        {
+          std::set<Scheduler::EventKey>::iterator it = keys.begin ();
+          std::advance (it, uniform->GetInteger (0, keys.size () - 1));
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key = *it;
+          scheduler->Remove (ev);
+          keys.erase (it);
+        }
+      else
+        {
+          Scheduler::Event next = scheduler->PeekNext ();
+          NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, keys.begin ()->m_uid, "Wrong next event");
+          next = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, keys.begin ()->m_uid, "Wrong event removed");
+          now = next.key.m_ts;
+          keys.erase (keys.begin ());
+        }
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), keys.empty (), "Wrong number of events");
+    }
+  while (!keys.empty ())
+    {
+      Scheduler::Event next = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, keys.begin ()->m_uid, "Wrong event removed");
+      keys.erase (keys.begin ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "The scheduler should be empty");
+}
+
+class EventImplPoolTestCase : public TestCase
+{
+public:
+  EventImplPoolTestCase ();
+  virtual void DoRun (void);
+  void Small (uint32_t a);
+  void Medium (uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e);
+  /** An argument too large for the pools. */
+  struct Large
+  {
+    uint64_t data[64];
+  };
+  void Big (Large a);
+  uint64_t m_sum;
+  uint32_t m_count;
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase ()
+  : TestCase ("Check the allocation of the events from the pools")
+{}
+
+void
+EventImplPoolTestCase::Small (uint32_t a)
+{
+  m_sum += a;
+  m_count++;
+}
+
+void
+EventImplPoolTestCase::Medium (uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e)
+{
+  m_sum += a + b + c + d + e;
+  m_count++;
+}
+
+void
+EventImplPoolTestCase::Big (Large a)
+{
+  m_sum += a.data[0] + a.data[63];
+  m_count++;
+}
+
+void
+EventImplPoolTestCase::DoRun (void)
+{
+  m_sum = 0;
+  m_count = 0;
+  Large large;
+  EventImpl::AllocatorStats before = EventImpl::GetAllocatorStats ();
+  uint64_t expected = 0;
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      // the events of the second round reuse the blocks of the first
+      for (uint32_t i = 0; i < 1000; i++)
+        {
+          Simulator::Schedule (NanoSeconds (i), &EventImplPoolTestCase::Small, this, i);
+          Simulator::Schedule (NanoSeconds (i), &EventImplPoolTestCase::Medium, this, i, i, i, i, i);
+          expected += 6 * i;
+        }
+      for (uint32_t i = 0; i < 10; i++)
+        {
+          large.data[0] = i;
+          large.data[63] = i;
+          Simulator::Schedule (NanoSeconds (i), &EventImplPoolTestCase::Big, this, large);
+          expected += 2 * i;
+        }
+      Simulator::Run ();
+    }
+  Simulator::Destroy ();
+  EventImpl::AllocatorStats after = EventImpl::GetAllocatorStats ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_count, 4020u, "Wrong number of events run");
+  NS_TEST_ASSERT_MSG_EQ (m_sum, expected, "Wrong event arguments");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (after.allocations - before.allocations, 4020u, "Missing event allocations");
+  NS_TEST_ASSERT_MSG_EQ (after.allocations - before.allocations,
+                         after.deallocations - before.deallocations,
+                         "All the events should have been deleted");
+  if (EventImpl::IsPoolEnabled ())
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (after.unpooled - before.unpooled, 20u, "The large events should not be pooled");
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (after.reused - before.reused, 2000u, "The blocks of the first round should be reused");
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (after.reused, after.allocations - after.unpooled, "Too many reused blocks");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (after.unpooled - before.unpooled,
+                             after.allocations - before.allocations,
+                             "No event should be pooled");
+    }
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +648,16 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (TimingWheelScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    AddTestCase (new SchedulerOrderTestCase (ObjectFactory ("ns3::MapScheduler"), ""), TestCase::QUICK);
+    AddTestCase (new SchedulerOrderTestCase (factory, ""), TestCase::QUICK);
+    // a short wheel, to keep many events in the overflow heap
+    factory.Set ("Granularity", TimeValue (NanoSeconds (10)));
+    factory.Set ("NumBuckets", UintegerValue (8));
+    AddTestCase (new SchedulerOrderTestCase (factory, " and 8 buckets"), TestCase::QUICK);
+
+    AddTestCase (new EventImplPoolTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -26,12 +26,14 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/make-event.h"
 
 #include <chrono>  // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread>  // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -225,6 +227,97 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+class EventImplCrossThreadTestCase : public TestCase
+{
+public:
+  EventImplCrossThreadTestCase ();
+  static void DoNothing (uint32_t a);
+  /** Allocate the events, recording the allocator statistics around. */
+  void Allocate (void);
+  /** Delete the events. */
+  void Release (void);
+  /** Run a function in a new thread and wait for its end. */
+  void RunInThread (void (EventImplCrossThreadTestCase::*f)(void));
+  std::vector<EventImpl *> m_events;
+  EventImpl::AllocatorStats m_before;
+  EventImpl::AllocatorStats m_after;
+
+private:
+  virtual void DoRun (void);
+};
+
+EventImplCrossThreadTestCase::EventImplCrossThreadTestCase ()
+  : TestCase ("Check the events allocated by a thread and deleted by another")
+{}
+
+void
+EventImplCrossThreadTestCase::DoNothing (uint32_t a)
+{}
+
+void
+EventImplCrossThreadTestCase::Allocate (void)
+{
+  m_before = EventImpl::GetAllocatorStats ();
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      m_events.push_back (MakeEvent (&EventImplCrossThreadTestCase::DoNothing, i));
+    }
+  m_after = EventImpl::GetAllocatorStats ();
+}
+
+void
+EventImplCrossThreadTestCase::Release (void)
+{
+  for (std::vector<EventImpl *>::iterator it = m_events.begin (); it != m_events.end (); ++it)
+    {
+      (*it)->Unref ();
+    }
+  m_events.clear ();
+}
+
+void
+EventImplCrossThreadTestCase::RunInThread (void (EventImplCrossThreadTestCase::*f)(void))
+{
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (f, this));
+  thread->Start ();
+  thread->Join ();
+}
+
+void
+EventImplCrossThreadTestCase::DoRun (void)
+{
+  // The events of an exited thread are deleted by this thread, and
+  // reused by the next thread, which adopts the pool of the first one.
+  RunInThread (&EventImplCrossThreadTestCase::Allocate);
+  Release ();
+  RunInThread (&EventImplCrossThreadTestCase::Allocate);
+  NS_TEST_ASSERT_MSG_EQ (m_after.allocations - m_before.allocations, 1000u, "Wrong number of allocations");
+  if (EventImpl::IsPoolEnabled ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_after.remote - m_before.remote, 1000u, "The deleted events should be back in their pool");
+      NS_TEST_ASSERT_MSG_EQ (m_after.reused - m_before.reused, 1000u, "The blocks of the exited thread should be reused");
+      NS_TEST_ASSERT_MSG_EQ (m_after.chunks, m_before.chunks, "The pool should not grow");
+    }
+  Release ();
+
+  // The events of this thread are deleted by another thread, and go
+  // back to the pool of this thread.
+  Allocate ();
+  EventImpl::AllocatorStats first = m_after;
+  RunInThread (&EventImplCrossThreadTestCase::Release);
+  Allocate ();
+  NS_TEST_ASSERT_MSG_EQ (m_after.allocations - m_before.allocations, 1000u, "Wrong number of allocations");
+  if (EventImpl::IsPoolEnabled ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_after.remote - m_before.remote, 1000u, "The deleted events should be back in their pool");
+      NS_TEST_ASSERT_MSG_EQ (m_after.reused - m_before.reused, 1000u, "The blocks deleted by the other thread should be reused");
+      NS_TEST_ASSERT_MSG_EQ (m_after.chunks, first.chunks, "The pool should not grow");
+    }
+  Release ();
+  m_after = EventImpl::GetAllocatorStats ();
+  NS_TEST_ASSERT_MSG_EQ (m_after.deallocations - m_before.deallocations, 1000u, "Wrong number of deallocations");
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -241,7 +334,8 @@ public:
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
       "ns3::MapScheduler",
-      "ns3::CalendarScheduler"
+      "ns3::CalendarScheduler",
+      "ns3::TimingWheelScheduler"
     };
     unsigned int threadcounts[] = {
       0,
@@ -262,5 +356,6 @@ public:
               }
           }
       }
+    AddTestCase (new EventImplCrossThreadTestCase (), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
@@ -2461,7 +2461,11 @@ NS_OBJECT_ENSURE_REGISTERED (EpcX2UeImsiSinrUpdateHeader);
 
 EpcX2UeImsiSinrUpdateHeader::EpcX2UeImsiSinrUpdateHeader ()
   : m_numberOfIes (1 + 1),
-    m_headerLength (2 + 2)
+    m_headerLength (2 + 2),
+    m_numbered (false),
+    m_delta (false),
+    m_sourceCellId (0),
+    m_sequenceNumber (0)
 {
   m_map.clear ();
 }
@@ -2471,6 +2475,7 @@ EpcX2UeImsiSinrUpdateHeader::~EpcX2UeImsiSinrUpdateHeader ()
   m_numberOfIes = 0;
   m_headerLength = 0;
   m_map.clear ();
+  m_removedImsis.clear ();
 }
 
 TypeId
@@ -2502,6 +2507,11 @@ EpcX2UeImsiSinrUpdateHeader::Serialize (Buffer::Iterator start) const
   Buffer::Iterator i = start;
 
   i.WriteHtonU16 (m_sourceCellId);
+  if (m_numbered)
+    {
+      i.WriteHtonU16 (m_sequenceNumber);
+      i.WriteU8 (m_delta ? 1 : 0);
+    }
 
   std::map <uint64_t, double>::size_type sz = m_map.size ();
   i.WriteHtonU16 (sz);              // number of elements in the map
@@ -2511,6 +2521,15 @@ EpcX2UeImsiSinrUpdateHeader::Serialize (Buffer::Iterator start) const
       i.WriteHtonU64 (iter->first); // imsi
       i.WriteHtonU64 (pack754(iter->second)); // sinr
     }
+
+  if (m_delta)
+    {
+      i.WriteHtonU16 (m_removedImsis.size ()); // number of IMSIs removed
+      for (std::vector<uint64_t>::const_iterator iter = m_removedImsis.begin (); iter != m_removedImsis.end (); ++iter)
+        {
+          i.WriteHtonU64 (*iter);
+        }
+    }
 }
 
 uint32_t
@@ -2523,6 +2542,14 @@ EpcX2UeImsiSinrUpdateHeader::Deserialize (Buffer::Iterator start)
   m_sourceCellId = i.ReadNtohU16();
   m_headerLength += 2;
   m_numberOfIes = 1;
+  m_removedImsis.clear ();
+  if (m_numbered)
+    {
+      m_sequenceNumber = i.ReadNtohU16 ();
+      m_delta = (i.ReadU8 () != 0);
+      m_headerLength += 2 + 1;
+      m_numberOfIes += 1 + 1;
+    }
 
   int sz = i.ReadNtohU16 ();
   for (int j = 0; j < sz; j++)
@@ -2535,6 +2562,17 @@ EpcX2UeImsiSinrUpdateHeader::Deserialize (Buffer::Iterator start)
   m_headerLength += 2 + sz * 16;
   m_numberOfIes += 1 + sz;
 
+  if (m_delta)
+    {
+      int numRemoved = i.ReadNtohU16 ();
+      for (int j = 0; j < numRemoved; j++)
+        {
+          m_removedImsis.push_back (i.ReadNtohU64 ());
+        }
+      m_headerLength += 2 + numRemoved * 8;
+      m_numberOfIes += 1 + numRemoved;
+    }
+
   return GetSerializedSize ();
 }
 
@@ -2542,10 +2580,19 @@ void
 EpcX2UeImsiSinrUpdateHeader::Print (std::ostream &os) const
 {
   os << "SourceCellId " << m_sourceCellId;
+  if (m_numbered)
+    {
+      os << " SequenceNumber " << m_sequenceNumber;
+      os << " Delta " << m_delta;
+    }
   for(std::map<uint64_t, double>::const_iterator iter = m_map.begin(); iter != m_map.end(); ++iter)
   {
     os << " Imsi " << iter->first << " sinr " << 10*std::log10(iter->second);
   }
+  for (std::vector<uint64_t>::const_iterator iter = m_removedImsis.begin (); iter != m_removedImsis.end (); ++iter)
+    {
+      os << " removed Imsi " << *iter;
+    }
 }
 
 uint16_t 
@@ -2576,6 +2623,74 @@ EpcX2UeImsiSinrUpdateHeader::SetUeImsiSinrMap (std::map <uint64_t, double> map)
   m_numberOfIes += sz;
 }
 
+void
+EpcX2UeImsiSinrUpdateHeader::SetNumbered (bool numbered)
+{
+  NS_ASSERT_MSG (!m_delta, "A delta report is always numbered");
+  if (numbered != m_numbered)
+    {
+      // the sequence number and the delta flag are serialized only in a numbered report
+      int sign = numbered ? 1 : -1;
+      m_headerLength += sign * (2 + 1);
+      m_numberOfIes += sign * (1 + 1);
+    }
+  m_numbered = numbered;
+}
+
+bool
+EpcX2UeImsiSinrUpdateHeader::IsNumbered () const
+{
+  return m_numbered;
+}
+
+void
+EpcX2UeImsiSinrUpdateHeader::SetDelta (bool delta)
+{
+  NS_ASSERT_MSG (m_numbered, "Only a numbered report can be a delta report");
+  if (delta != m_delta)
+    {
+      // the number of IMSIs removed is serialized only in a delta report
+      int sign = delta ? 1 : -1;
+      m_headerLength += sign * (2 + m_removedImsis.size () * 8);
+      m_numberOfIes += sign * (1 + m_removedImsis.size ());
+    }
+  m_delta = delta;
+}
+
+bool
+EpcX2UeImsiSinrUpdateHeader::IsDelta () const
+{
+  return m_delta;
+}
+
+std::vector <uint64_t>
+EpcX2UeImsiSinrUpdateHeader::GetRemovedImsis () const
+{
+  return m_removedImsis;
+}
+
+void
+EpcX2UeImsiSinrUpdateHeader::SetRemovedImsis (std::vector <uint64_t> removedImsis)
+{
+  NS_ASSERT_MSG (m_delta, "The removed IMSIs are carried only by a delta report");
+  m_headerLength += (removedImsis.size () - m_removedImsis.size ()) * 8;
+  m_numberOfIes += removedImsis.size () - m_removedImsis.size ();
+  m_removedImsis = removedImsis;
+}
+
+uint16_t
+EpcX2UeImsiSinrUpdateHeader::GetSequenceNumber () const
+{
+  return m_sequenceNumber;
+}
+
+void
+EpcX2UeImsiSinrUpdateHeader::SetSequenceNumber (uint16_t sequenceNumber)
+{
+  NS_ASSERT_MSG (m_numbered, "Only a numbered report carries a sequence number");
+  m_sequenceNumber = sequenceNumber;
+}
+
 uint32_t
 EpcX2UeImsiSinrUpdateHeader::GetLengthOfIes () const
 {
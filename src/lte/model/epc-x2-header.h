@@ -101,7 +101,8 @@ public:
     NotifyMmWaveLteHandover = 16,
     NotifyCoordinatorHandoverFailed = 17,
     SwitchConnection        = 18,
-    SecondaryCellHandoverCompleted = 19
+    SecondaryCellHandoverCompleted = 19,
+    UpdateUeSinrNumbered    = 20
 
   };
 
@@ -889,6 +890,49 @@ public:
   std::map <uint64_t, double> GetUeImsiSinrMap () const;
   void SetUeImsiSinrMap (std::map<uint64_t, double> map);
 
+  /**
+   * Set if the header carries a numbered report, i.e., a report that also
+   * serializes its sequence number and the delta flag. Numbered reports are
+   * sent with the UpdateUeSinrNumbered procedure code, the other ones keep
+   * the format of UpdateUeSinr. The flag itself is not serialized, and must
+   * be set before deserializing a numbered report.
+   * \param numbered true for a numbered report
+   */
+  void SetNumbered (bool numbered);
+  /**
+   * \return true if the header carries a numbered report
+   */
+  bool IsNumbered () const;
+
+  /**
+   * Set if the numbered report is a delta report, i.e., only the SINRs
+   * changed since the previous report and the IMSIs removed from it.
+   * \param delta true for a delta report
+   */
+  void SetDelta (bool delta);
+  /**
+   * \return true if the header carries a delta report
+   */
+  bool IsDelta () const;
+
+  /**
+   * \return the IMSIs removed since the previous report, for a delta report
+   */
+  std::vector <uint64_t> GetRemovedImsis () const;
+  /**
+   * \param removedImsis the IMSIs removed since the previous report
+   */
+  void SetRemovedImsis (std::vector <uint64_t> removedImsis);
+
+  /**
+   * \return the sequence number of the numbered report, counted per target cell
+   */
+  uint16_t GetSequenceNumber () const;
+  /**
+   * \param sequenceNumber the sequence number of the report
+   */
+  void SetSequenceNumber (uint16_t sequenceNumber);
+
   uint16_t GetSourceCellId () const;
   void SetSourceCellId (uint16_t sourceCellId);
 
@@ -905,7 +949,11 @@ private:
   static long double unpack754(uint64_t i);
 
   std::map <uint64_t, double> m_map;
+  bool m_numbered;
+  bool m_delta;
+  std::vector <uint64_t> m_removedImsis;
   uint16_t m_sourceCellId;
+  uint16_t m_sequenceNumber;
 };
 
 class EpcX2ConnectionSwitchHeader : public Header
@@ -26,6 +26,11 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/ipv4.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 #include "ns3/epc-gtpu-header.h"
 #include "ns3/epc-x2-tag.h"
 #include "ns3/lte-pdcp-tag.h"
@@ -87,9 +92,19 @@ X2CellInfo::operator= (const X2CellInfo& value)
 
 NS_OBJECT_ENSURE_REGISTERED (EpcX2);
 
+EpcX2::UeSinrReportState::UeSinrReportState ()
+  : sequenceNumber (0),
+    reportsSinceFull (0),
+    valid (false)
+{
+}
+
 EpcX2::EpcX2 ()
   : m_x2cUdpPort (4444),
-    m_x2uUdpPort (2152)
+    m_x2uUdpPort (2152),
+    m_idealUeSinrUpdate (false),
+    m_ueSinrUpdateDeltaEncoding (false),
+    m_ueSinrUpdateFullReportPeriod (10)
 {
   NS_LOG_FUNCTION (this);
 
@@ -112,6 +127,9 @@ EpcX2::DoDispose (void)
   m_x2InterfaceCellIds.clear ();
   m_x2RlcUserMap.clear ();
   m_x2PdcpUserMap.clear ();
+  m_txUeSinrReports.clear ();
+  m_rxUeSinrReports.clear ();
+  m_idealUeSinrUpdatePeers.clear ();
   delete m_x2SapProvider;
   delete m_x2RlcProvider;
   delete m_x2PdcpProvider;
@@ -126,7 +144,35 @@ EpcX2::GetTypeId (void)
     .AddTraceSource ("RxPDU",
                      "PDU received.",
                      MakeTraceSourceAccessor (&EpcX2::m_rxPdu),
-                     "ns3::EpcX2::ReceiveTracedCallback");
+                     "ns3::EpcX2::ReceiveTracedCallback")
+    .AddAttribute ("IdealUeSinrUpdate",
+                   "If true, the UE SINR reports are delivered to the target eNB "
+                   "with a direct call after IdealUeSinrUpdateDelay, "
+                   "without sending X2 packets",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&EpcX2::m_idealUeSinrUpdate),
+                   MakeBooleanChecker ())
+    .AddAttribute ("IdealUeSinrUpdateDelay",
+                   "The delay of the UE SINR reports if IdealUeSinrUpdate is true",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&EpcX2::m_idealUeSinrUpdateDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("UeSinrUpdateDeltaEncoding",
+                   "If true, the UE SINR reports sent over X2 are numbered, "
+                   "and carry only the SINRs changed since the previous report "
+                   "to the same eNB. Otherwise, the reports keep the format "
+                   "of the UpdateUeSinr procedure",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&EpcX2::m_ueSinrUpdateDeltaEncoding),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UeSinrUpdateFullReportPeriod",
+                   "With UeSinrUpdateDeltaEncoding, one report every this many "
+                   "carries all the SINRs, so that a target eNB which lost "
+                   "a report can decode the following ones again",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&EpcX2::m_ueSinrUpdateFullReportPeriod),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
   return tid;
 }
 
@@ -498,11 +544,58 @@ EpcX2::RecvFromX2cSocket (Ptr<Socket> socket)
       NS_LOG_INFO ("X2 SinrUpdateHeader header: " << x2ueSinrUpdateHeader);
 
       EpcX2SapUser::UeImsiSinrParams params;
-      params.ueImsiSinrMap = x2ueSinrUpdateHeader.GetUeImsiSinrMap();
-      params.sourceCellId = x2ueSinrUpdateHeader.GetSourceCellId();
+      params.ueImsiSinrMap = x2ueSinrUpdateHeader.GetUeImsiSinrMap ();
+      params.sourceCellId = x2ueSinrUpdateHeader.GetSourceCellId ();
 
       m_x2SapUser->RecvUeSinrUpdate(params);  
     }
+  else if (procedureCode == EpcX2Header::UpdateUeSinrNumbered)
+    {
+      NS_LOG_LOGIC ("Recv X2 message: UPDATE UE SINR NUMBERED");
+
+      EpcX2UeImsiSinrUpdateHeader x2ueSinrUpdateHeader;
+      x2ueSinrUpdateHeader.SetNumbered (true);
+      packet->RemoveHeader (x2ueSinrUpdateHeader);
+
+      NS_LOG_INFO ("X2 SinrUpdateHeader header: " << x2ueSinrUpdateHeader);
+
+      uint16_t sourceCellId = x2ueSinrUpdateHeader.GetSourceCellId ();
+      uint16_t sequenceNumber = x2ueSinrUpdateHeader.GetSequenceNumber ();
+      UeSinrReportState &state = m_rxUeSinrReports[sourceCellId];
+      if (x2ueSinrUpdateHeader.IsDelta ())
+        {
+          // a delta applies only to the report right before it
+          if (!state.valid || sequenceNumber != (uint16_t)(state.sequenceNumber + 1))
+            {
+              NS_LOG_WARN ("Discard the delta SINR report " << sequenceNumber << " from cell " << sourceCellId
+                           << ", the previous report was lost");
+              state.valid = false;
+              return;
+            }
+          std::map<uint64_t, double> changedSinrs = x2ueSinrUpdateHeader.GetUeImsiSinrMap ();
+          for (std::map<uint64_t, double>::iterator it = changedSinrs.begin (); it != changedSinrs.end (); ++it)
+            {
+              state.ueImsiSinrMap[it->first] = it->second;
+            }
+          std::vector<uint64_t> removedImsis = x2ueSinrUpdateHeader.GetRemovedImsis ();
+          for (std::vector<uint64_t>::iterator it = removedImsis.begin (); it != removedImsis.end (); ++it)
+            {
+              state.ueImsiSinrMap.erase (*it);
+            }
+        }
+      else
+        {
+          state.ueImsiSinrMap = x2ueSinrUpdateHeader.GetUeImsiSinrMap ();
+          state.valid = true;
+        }
+      state.sequenceNumber = sequenceNumber;
+
+      EpcX2SapUser::UeImsiSinrParams params;
+      params.ueImsiSinrMap = state.ueImsiSinrMap;
+      params.sourceCellId = sourceCellId;
+
+      m_x2SapUser->RecvUeSinrUpdate (params);
+    }
   else if (procedureCode == EpcX2Header::RequestMcHandover)
     {
       NS_LOG_LOGIC ("Recv X2 message: REQUEST MC HANDOVER");
@@ -1287,6 +1380,14 @@ EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
 
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Missing infos for targetCellId = " << params.targetCellId);
+
+  if (m_idealUeSinrUpdate)
+    {
+      Simulator::Schedule (m_idealUeSinrUpdateDelay, &EpcX2::DoRecvUeSinrUpdateIdeal,
+                           GetIdealUeSinrUpdatePeer (params.targetCellId), params);
+      return;
+    }
+
   Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
   Ptr<Socket> sourceSocket = socketInfo->m_localUserPlaneSocket;
   Ipv4Address targetIpAddr = socketInfo->m_remoteIpAddr;
@@ -1296,12 +1397,67 @@ EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
 
   // Build the X2 message
   EpcX2UeImsiSinrUpdateHeader x2imsiSinrHeader;
-  x2imsiSinrHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
   x2imsiSinrHeader.SetSourceCellId (params.sourceCellId);
-
   EpcX2Header x2Header;
   x2Header.SetMessageType (EpcX2Header::InitiatingMessage);
-  x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinr);
+  if (!m_ueSinrUpdateDeltaEncoding)
+    {
+      x2imsiSinrHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
+      x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinr);
+    }
+  else
+    {
+      UeSinrReportState &state = m_txUeSinrReports[params.targetCellId];
+      x2imsiSinrHeader.SetNumbered (true);
+      x2imsiSinrHeader.SetSequenceNumber (++state.sequenceNumber);
+      if (state.valid && state.reportsSinceFull + 1 < m_ueSinrUpdateFullReportPeriod)
+        {
+          // compare the report with the previous one sent to the same cell
+          std::map<uint64_t, double> &previousMap = state.ueImsiSinrMap;
+          std::map<uint64_t, double> changedSinrs;
+          std::vector<uint64_t> removedImsis;
+          std::map<uint64_t, double>::const_iterator previous = previousMap.begin ();
+          for (std::map<uint64_t, double>::const_iterator current = params.ueImsiSinrMap.begin ();
+               current != params.ueImsiSinrMap.end (); ++current)
+            {
+              while (previous != previousMap.end () && previous->first < current->first)
+                {
+                  removedImsis.push_back (previous->first);
+                  ++previous;
+                }
+              if (previous != previousMap.end () && previous->first == current->first)
+                {
+                  if (previous->second != current->second)
+                    {
+                      changedSinrs.insert (changedSinrs.end (), *current);
+                    }
+                  ++previous;
+                }
+              else
+                {
+                  changedSinrs.insert (changedSinrs.end (), *current);
+                }
+            }
+          for (; previous != previousMap.end (); ++previous)
+            {
+              removedImsis.push_back (previous->first);
+            }
+          state.reportsSinceFull++;
+
+          NS_LOG_LOGIC ("changed SINRs = " << changedSinrs.size () << " removed IMSIs = " << removedImsis.size ());
+          x2imsiSinrHeader.SetDelta (true);
+          x2imsiSinrHeader.SetUeImsiSinrMap (changedSinrs);
+          x2imsiSinrHeader.SetRemovedImsis (removedImsis);
+        }
+      else
+        {
+          x2imsiSinrHeader.SetUeImsiSinrMap (params.ueImsiSinrMap);
+          state.reportsSinceFull = 0;
+          state.valid = true;
+        }
+      state.ueImsiSinrMap = params.ueImsiSinrMap;
+      x2Header.SetProcedureCode (EpcX2Header::UpdateUeSinrNumbered);
+    }
   x2Header.SetLengthOfIes (x2imsiSinrHeader.GetLengthOfIes ());
   x2Header.SetNumberOfIes (x2imsiSinrHeader.GetNumberOfIes ());
 
@@ -1318,7 +1474,50 @@ EpcX2::DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params)
   packet->AddPacketTag (tag);
 
   // Send the X2 message through the socket
-  sourceSocket->SendTo (packet, 0, InetSocketAddress (targetIpAddr, m_x2cUdpPort));
+  if (sourceSocket->SendTo (packet, 0, InetSocketAddress (targetIpAddr, m_x2cUdpPort)) < 0
+      && m_ueSinrUpdateDeltaEncoding)
+    {
+      // the target cannot apply a delta to a report it did not receive
+      NS_LOG_WARN ("The SINR report " << x2imsiSinrHeader.GetSequenceNumber () << " to cell " << params.targetCellId << " was not sent");
+      m_txUeSinrReports[params.targetCellId].valid = false;
+    }
+}
+
+Ptr<EpcX2>
+EpcX2::GetIdealUeSinrUpdatePeer (uint16_t targetCellId)
+{
+  NS_LOG_FUNCTION (this << targetCellId);
+
+  std::map<uint16_t, Ptr<EpcX2> >::iterator peer = m_idealUeSinrUpdatePeers.find (targetCellId);
+  if (peer != m_idealUeSinrUpdatePeers.end ())
+    {
+      return peer->second;
+    }
+
+  // the peer is the EPC X2 entity of the node at the other end of the X2 interface
+  Ipv4Address targetIpAddr = m_x2InterfaceSockets [targetCellId]->m_remoteIpAddr;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      Ptr<Ipv4> ipv4 = (*i)->GetObject<Ipv4> ();
+      if (ipv4 != 0 && ipv4->GetInterfaceForAddress (targetIpAddr) >= 0)
+        {
+          Ptr<EpcX2> epcX2 = (*i)->GetObject<EpcX2> ();
+          NS_ASSERT_MSG (epcX2 != 0, "Missing EPC X2 entity of targetCellId = " << targetCellId);
+          m_idealUeSinrUpdatePeers [targetCellId] = epcX2;
+          return epcX2;
+        }
+    }
+  NS_FATAL_ERROR ("Missing node of targetCellId = " << targetCellId);
+  return 0;
+}
+
+void
+EpcX2::DoRecvUeSinrUpdateIdeal (EpcX2Sap::UeImsiSinrParams params)
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_LOGIC ("Recv ideal UE SINR update from cell " << params.sourceCellId);
+
+  m_x2SapUser->RecvUeSinrUpdate (params);
 }
 
 
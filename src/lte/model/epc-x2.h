@@ -31,6 +31,7 @@
 #include "ns3/object.h"
  #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/nstime.h"
 
 #include "ns3/epc-x2-sap.h"
 
@@ -247,6 +248,17 @@ protected:
   virtual void DoSendMcPdcpPdu (EpcX2SapProvider::UeDataParams params);
   virtual void DoReceiveMcPdcpSdu (EpcX2SapProvider::UeDataParams params);
   virtual void DoSendUeSinrUpdate(EpcX2Sap::UeImsiSinrParams params);
+  /**
+   * Deliver a SINR report sent by another EPC X2 entity in the ideal mode
+   * \param params the SINR report
+   */
+  void DoRecvUeSinrUpdateIdeal (EpcX2Sap::UeImsiSinrParams params);
+  /**
+   * Find the EPC X2 entity which receives the ideal SINR reports of a cell
+   * \param targetCellId the target cell
+   * \return the EPC X2 entity of the node at the other end of the X2 interface
+   */
+  Ptr<EpcX2> GetIdealUeSinrUpdatePeer (uint16_t targetCellId);
   virtual void DoSendMcHandoverRequest (EpcX2SapProvider::SecondaryHandoverParams params);
   virtual void DoNotifyLteMmWaveHandoverCompleted (EpcX2SapProvider::SecondaryHandoverParams params);
   virtual void DoNotifyCoordinatorHandoverFailed(EpcX2SapProvider::HandoverFailedParams params);
@@ -301,6 +313,55 @@ private:
    */
   std::map <uint32_t, uint16_t> m_teidToBeForwardedMap;
 
+  /**
+   * Deliver the SINR reports to the target EPC X2 entity with a direct call,
+   * without building and sending X2 packets
+   */
+  bool m_idealUeSinrUpdate;
+
+  /**
+   * The delay of the SINR reports in the ideal mode
+   */
+  Time m_idealUeSinrUpdateDelay;
+
+  /**
+   * Map the targetCellId to the EPC X2 entity receiving the ideal SINR reports
+   */
+  std::map <uint16_t, Ptr<EpcX2> > m_idealUeSinrUpdatePeers;
+
+  /**
+   * Send over X2 only the SINRs changed since the previous report
+   */
+  bool m_ueSinrUpdateDeltaEncoding;
+
+  /**
+   * With delta encoding, the number of reports between two full reports
+   */
+  uint32_t m_ueSinrUpdateFullReportPeriod;
+
+  /**
+   * The SINR reports exchanged with a cell
+   */
+  struct UeSinrReportState
+  {
+    UeSinrReportState ();
+
+    std::map <uint64_t, double> ueImsiSinrMap; ///< the last report, if a delta can refer to it
+    uint16_t sequenceNumber; ///< the sequence number of the last report
+    uint32_t reportsSinceFull; ///< the delta reports after the last full report
+    bool valid; ///< true if the next report can be a delta of ueImsiSinrMap
+  };
+
+  /**
+   * Map the targetCellId to the numbered SINR reports sent to it
+   */
+  std::map <uint16_t, UeSinrReportState> m_txUeSinrReports;
+
+  /**
+   * Map the sourceCellId to the numbered SINR reports received from it
+   */
+  std::map <uint16_t, UeSinrReportState> m_rxUeSinrReports;
+
 };
 
 } //namespace ns3
@@ -2448,7 +2448,7 @@ UeManager::SwitchToState (State newState)
             {
               uint16_t maxSinrCellId = m_rrc->m_bestMmWaveCellForImsiMap.at(m_imsi);
               // get the SINR
-              double maxSinrDb = 10*std::log10(m_rrc->m_imsiCellSinrMap.find(m_imsi)->second.find(maxSinrCellId)->second);
+              double maxSinrDb = 10*std::log10(m_rrc->m_imsiCellSinrTable.GetSinr(m_imsi, maxSinrCellId));
               if(maxSinrDb > m_rrc->m_outageThreshold)
               {
                 // there is a MmWave cell to which the UE can connect
@@ -2693,7 +2693,7 @@ LteEnbRrc::LteEnbRrc ()
   m_s1SapUser = new MemberEpcEnbS1SapUser<LteEnbRrc> (this);
   m_cphySapUser.push_back (new MemberLteEnbCphySapUser<LteEnbRrc> (this));
 
-  m_imsiCellSinrMap.clear();
+  m_imsiCellSinrTable.Clear();
   m_x2_received_cnt = 0;
   m_switchEnabled = true;
   m_lteCellId = 0;
@@ -3466,7 +3466,7 @@ LteEnbRrc::ConfigureCell (std::map<uint8_t, Ptr<ComponentCarrierEnb>> ccPhyConf)
    * SystemInformationPeriodicity attribute to configure this).
    */
   Simulator::Schedule (MilliSeconds (16), &LteEnbRrc::SendSystemInformation, this);
-  m_imsiCellSinrMap.clear();
+  m_imsiCellSinrTable.Clear();
   m_firstReport = true;
   m_configured = true;
 
@@ -3557,7 +3557,7 @@ LteEnbRrc::ConfigureCell (std::map<uint8_t, MmWaveComponentCarrierConf> ccPhyCon
    */
    // mmWave module: Changed scheduling of initial system information to +2ms
   Simulator::Schedule (MilliSeconds (m_firstSibTime), &LteEnbRrc::SendSystemInformation, this);
-  m_imsiCellSinrMap.clear();
+  m_imsiCellSinrTable.Clear();
   m_firstReport = true;
   m_configured = true;
 
@@ -3665,16 +3665,7 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
   NS_LOG_FUNCTION(this);
   NS_LOG_LOGIC("Recv Ue SINR Update from cell " << params.sourceCellId);
   uint16_t mmWaveCellId = params.sourceCellId;
-  if(m_cellSinrMap.find(mmWaveCellId) != m_cellSinrMap.end())
-  {     // update the entry
-    m_cellSinrMap[mmWaveCellId] = params.ueImsiSinrMap;
-    m_numNewSinrReports++;
-  }
-  else  // add the entry
-  {
-    m_cellSinrMap.insert(std::pair<uint16_t, ImsiSinrMap> (mmWaveCellId, params.ueImsiSinrMap));
-    m_numNewSinrReports++;
-  }
+  m_numNewSinrReports++;
   // cycle on all the Imsi whose SINR is known in cell mmWaveCellId
   for(std::map<uint64_t, double>::iterator imsiIter = params.ueImsiSinrMap.begin(); imsiIter != params.ueImsiSinrMap.end(); ++imsiIter)
   {
@@ -3684,36 +3675,9 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
     m_notifyMmWaveSinrTrace(imsi, mmWaveCellId, sinr);
 
     NS_LOG_LOGIC("Imsi " << imsi << " sinr " << sinr);
-
-    if(m_imsiCellSinrMap.find(imsi) != m_imsiCellSinrMap.end())
-    {
-      if(m_imsiCellSinrMap[imsi].find(mmWaveCellId) != m_imsiCellSinrMap[imsi].end())
-      {
-        // update the SINR measure
-        m_imsiCellSinrMap[imsi].find(mmWaveCellId)->second = sinr;
-      }
-      else // new cell for this Imsi
-      {
-        // insert a new SINR measure
-        m_imsiCellSinrMap[imsi].insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-      }
-    }
-    else // new imsi
-    {
-      CellSinrMap map;
-      map.insert(std::pair<uint16_t, double>(mmWaveCellId, sinr));
-      m_imsiCellSinrMap.insert(std::pair<uint64_t, CellSinrMap> (imsi, map));
-    }
-  }
-
-  for(std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin(); imsiIter != m_imsiCellSinrMap.end(); ++imsiIter)
-  {
-    NS_LOG_LOGIC("Imsi " << imsiIter->first);
-    for(CellSinrMap::iterator cellIter = imsiIter->second.begin(); cellIter != imsiIter->second.end(); ++cellIter)
-    {
-      NS_LOG_LOGIC("mmWaveCell " << cellIter->first << " sinr " <<  cellIter->second);
-    }
   }
+  // update the SINR measures, and the best cell of each Imsi
+  m_imsiCellSinrTable.Update(mmWaveCellId, params.ueImsiSinrMap);
 
   if(!m_ismmWave && !m_interRatHoMode && m_firstReport)
   {
@@ -3735,7 +3699,7 @@ LteEnbRrc::DoRecvUeSinrUpdate(EpcX2SapUser::UeImsiSinrParams params)
 }
 
 void
-LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
+LteEnbRrc::TttBasedHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
 {
   uint64_t imsi = imsiIter->first;
   bool alreadyAssociatedImsi = false;
@@ -3762,7 +3726,7 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
   double currentSinrDb = 0;
   if(alreadyAssociatedImsi && m_lastMmWaveCell.find(imsi) != m_lastMmWaveCell.end())
   {
-    currentSinrDb = 10*std::log10(m_imsiCellSinrMap.find(imsi)->second[m_lastMmWaveCell[imsi]]);
+    currentSinrDb = 10*std::log10(m_imsiCellSinrTable.GetSinr(imsiIter, m_lastMmWaveCell[imsi]));
     NS_LOG_DEBUG("Current SINR " << currentSinrDb);
   }
 
@@ -3853,7 +3817,7 @@ LteEnbRrc::TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter,
         uint16_t targetCellId = handoverEvent->second.targetCellId;
         NS_LOG_INFO("------ Handover was scheduled for " << handoverEvent->second.targetCellId << " but now maxSinrCellId is " << maxSinrCellId);
         //  get the SINR for the scheduled targetCellId: if the diff is smaller than 3 dB handover anyway
-        double originalTargetSinrDb = 10*std::log10(m_imsiCellSinrMap.find(imsi)->second[targetCellId]);
+        double originalTargetSinrDb = 10*std::log10(m_imsiCellSinrTable.GetSinr(imsiIter, targetCellId));
         if(maxSinrDb - originalTargetSinrDb > m_sinrThresholdDifference) // this parameter is the same as the one for ThresholdBasedSecondaryCellHandover
         {
           // delete this event
@@ -4018,7 +3982,7 @@ LteEnbRrc::PerformHandover(uint64_t imsi)
 }
 
 void
-LteEnbRrc::ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
+LteEnbRrc::ThresholdBasedSecondaryCellHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
 {
   uint64_t imsi = imsiIter->first;
   bool alreadyAssociatedImsi = false;
@@ -4132,9 +4096,9 @@ LteEnbRrc::ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::
 void
 LteEnbRrc::TriggerUeAssociationUpdate()
 {
-  if(m_imsiCellSinrMap.size() > 0) // there are some entries
+  if(m_imsiCellSinrTable.GetNUes() > 0) // there are some entries
   {
-    for(std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin(); imsiIter != m_imsiCellSinrMap.end(); ++imsiIter)
+    for(LteMmWaveSinrTable::ConstIterator imsiIter = m_imsiCellSinrTable.Begin(); imsiIter != m_imsiCellSinrTable.End(); ++imsiIter)
     {
       uint64_t imsi = imsiIter->first;
       long double maxSinr = 0;
@@ -4161,19 +4125,11 @@ LteEnbRrc::TriggerUeAssociationUpdate()
       }
       NS_LOG_INFO("alreadyAssociatedImsi " << alreadyAssociatedImsi << " onHandoverImsi " << onHandoverImsi);
 
-      for(CellSinrMap::iterator cellIter = imsiIter->second.begin(); cellIter != imsiIter->second.end(); ++cellIter)
-      {
-        NS_LOG_INFO("Cell " << cellIter->first << " reports " << 10*std::log10(cellIter->second));
-        if(cellIter->second > maxSinr)
-        {
-          maxSinr = cellIter->second;
-          maxSinrCellId = cellIter->first;
-        }
-        if(m_lastMmWaveCell[imsi] == cellIter->first)
-        {
-          currentSinr = cellIter->second;
-        }
-      }
+      // the best cell is maintained by m_imsiCellSinrTable, the SINR of a
+      // cell which did not report is 0
+      maxSinr = imsiIter->second.maxSinr;
+      maxSinrCellId = imsiIter->second.maxSinrCellId;
+      currentSinr = m_imsiCellSinrTable.GetSinr(imsiIter, m_lastMmWaveCell[imsi]);
       long double sinrDifference = std::abs(10*(std::log10((long double)maxSinr) - std::log10((long double)currentSinr)));
       long double maxSinrDb = 10*std::log10((long double)maxSinr);
       long double currentSinrDb = 10*std::log10((long double)currentSinr);
@@ -4234,7 +4190,7 @@ LteEnbRrc::TriggerUeAssociationUpdate()
 }
 
 void
-LteEnbRrc::ThresholdBasedInterRatHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
+LteEnbRrc::ThresholdBasedInterRatHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb)
 {
   uint64_t imsi = imsiIter->first;
   bool alreadyAssociatedImsi = false;
@@ -4320,9 +4276,9 @@ void
 LteEnbRrc::UpdateUeHandoverAssociation()
 {
   // TODO rules for possible ho of each UE
-  if(m_imsiCellSinrMap.size() > 0) // there are some entries
+  if(m_imsiCellSinrTable.GetNUes() > 0) // there are some entries
   {
-    for(std::map<uint64_t, CellSinrMap>::iterator imsiIter = m_imsiCellSinrMap.begin(); imsiIter != m_imsiCellSinrMap.end(); ++imsiIter)
+    for(LteMmWaveSinrTable::ConstIterator imsiIter = m_imsiCellSinrTable.Begin(); imsiIter != m_imsiCellSinrTable.End(); ++imsiIter)
     {
       uint64_t imsi = imsiIter->first;
       long double maxSinr = 0;
@@ -4347,19 +4303,11 @@ LteEnbRrc::UpdateUeHandoverAssociation()
       }
       NS_LOG_INFO("alreadyAssociatedImsi " << alreadyAssociatedImsi << " onHandoverImsi " << onHandoverImsi);
 
-      for(CellSinrMap::iterator cellIter = imsiIter->second.begin(); cellIter != imsiIter->second.end(); ++cellIter)
-      {
-        NS_LOG_INFO("Cell " << cellIter->first << " reports " << 10*std::log10(cellIter->second));
-        if(cellIter->second > maxSinr)
-        {
-          maxSinr = cellIter->second;
-          maxSinrCellId = cellIter->first;
-        }
-        if(m_lastMmWaveCell[imsi] == cellIter->first)
-        {
-          currentSinr = cellIter->second;
-        }
-      }
+      // the best cell is maintained by m_imsiCellSinrTable, the SINR of a
+      // cell which did not report is 0
+      maxSinr = imsiIter->second.maxSinr;
+      maxSinrCellId = imsiIter->second.maxSinrCellId;
+      currentSinr = m_imsiCellSinrTable.GetSinr(imsiIter, m_lastMmWaveCell[imsi]);
 
       long double sinrDifference = std::abs(10*(std::log10((long double)maxSinr) - std::log10((long double)currentSinr)));
       long double maxSinrDb = 10*std::log10((long double)maxSinr);
@@ -58,6 +58,7 @@
 #include <map>
 #include <set>
 #include <ns3/component-carrier-enb.h>
+#include <ns3/lte-mmwave-sinr-table.h>
 #include <vector>
 
 #define MIN_NO_CC 1
@@ -1629,21 +1630,21 @@ private:
 
   /**
    * Trigger an handover according to certain conditions on the SINR
-   * @params the iterator on m_imsiCellSinrMap
+   * @params the iterator on m_imsiCellSinrTable
    * @params the sinrDifference between the current and the maxSinr cell
    * @params the CellId of the maximum SINR cell
    * @params the value of the SINR for this cell
    */
-  void ThresholdBasedSecondaryCellHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
+  void ThresholdBasedSecondaryCellHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
 
     /**
    * Trigger an handover according to certain conditions on the SINR and the TTT
-   * @params the iterator on m_imsiCellSinrMap
+   * @params the iterator on m_imsiCellSinrTable
    * @params the sinrDifference between the current and the maxSinr cell
    * @params the CellId of the maximum SINR cell
    * @params the value of the SINR for this cell
    */
-  void TttBasedHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
+  void TttBasedHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
 
   /**
    * Compute the TTT according to the sinrDifference and the dynamic handover algorithm
@@ -1664,12 +1665,12 @@ private:
 
   /**
    * Trigger an handover according to certain conditions on the SINR (for single-connectivity devices)
-   * @params the iterator on m_imsiCellSinrMap
+   * @params the iterator on m_imsiCellSinrTable
    * @params the sinrDifference between the current and the maxSinr cell
    * @params the CellId of the maximum SINR cell
    * @params the value of the SINR for this cell
    */
-  void ThresholdBasedInterRatHandover(std::map<uint64_t, CellSinrMap>::iterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
+  void ThresholdBasedInterRatHandover(LteMmWaveSinrTable::ConstIterator imsiIter, double sinrDifference, uint16_t maxSinrCellId, double maxSinrDb);
 
   Callback <void, Ptr<Packet> > m_forwardUpCallback;  ///< forward up callback function
 
@@ -1907,13 +1908,12 @@ private:
   bool m_reportAllUeMeas; // if true, the MmWave eNB reports to the coordinator all the received UE measures, i.e. one per CC
 
   // for LTE eNBs
-  std::map<uint16_t, ImsiSinrMap> m_cellSinrMap;
   uint16_t m_numNewSinrReports;
   std::map<uint64_t, uint16_t> m_bestMmWaveCellForImsiMap;
   std::map<uint64_t, uint16_t> m_lastMmWaveCell;
   std::map<uint64_t, bool> m_mmWaveCellSetupCompleted;
   std::map<uint64_t, bool> m_imsiUsingLte;
-  std::map<uint64_t, CellSinrMap> m_imsiCellSinrMap;
+  LteMmWaveSinrTable m_imsiCellSinrTable; // the SINR of each UE in each mmWave cell, with the best cell
   std::map<uint64_t, uint16_t> m_imsiRntiMap;
   std::map<uint16_t, uint64_t> m_rntiImsiMap;
 
@@ -0,0 +1,172 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-mmwave-sinr-table.h"
+
+#include <ns3/log.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteMmWaveSinrTable");
+
+LteMmWaveSinrTable::LteMmWaveSinrTable ()
+{
+}
+
+uint32_t
+LteMmWaveSinrTable::GetCellIndex (uint16_t cellId)
+{
+  std::unordered_map<uint16_t, uint32_t>::iterator it = m_cellIndices.find (cellId);
+  if (it != m_cellIndices.end ())
+    {
+      return it->second;
+    }
+  uint32_t cellIndex = m_cellIds.size ();
+  NS_LOG_LOGIC ("Cell " << cellId << " has index " << cellIndex);
+  m_cellIndices.insert (std::make_pair (cellId, cellIndex));
+  m_cellIds.push_back (cellId);
+  return cellIndex;
+}
+
+void
+LteMmWaveSinrTable::Update (uint16_t cellId, const std::map<uint64_t, double> &imsiSinrMap)
+{
+  NS_LOG_FUNCTION (this << cellId << imsiSinrMap.size ());
+  uint32_t cellIndex = GetCellIndex (cellId);
+  // both the report and m_ues are sorted by IMSI, thus the UE following
+  // the previous one is usually the next UE of the report
+  std::map<uint64_t, UeSinrs>::iterator ue = m_ues.end ();
+  for (std::map<uint64_t, double>::const_iterator it = imsiSinrMap.begin (); it != imsiSinrMap.end (); ++it)
+    {
+      if (ue == m_ues.end () || ue->first != it->first)
+        {
+          ue = m_ues.lower_bound (it->first);
+        }
+      if (ue == m_ues.end () || ue->first != it->first)
+        {
+          UeSinrs newUe;
+          newUe.maxSinrCellId = 0;
+          newUe.maxSinr = 0;
+          ue = m_ues.insert (ue, std::make_pair (it->first, newUe));
+        }
+      Update (ue->second, cellIndex, it->second);
+      ++ue;
+    }
+}
+
+void
+LteMmWaveSinrTable::Update (uint16_t cellId, uint64_t imsi, double sinr)
+{
+  NS_LOG_FUNCTION (this << cellId << imsi << sinr);
+  std::map<uint64_t, double> imsiSinrMap;
+  imsiSinrMap[imsi] = sinr;
+  Update (cellId, imsiSinrMap);
+}
+
+void
+LteMmWaveSinrTable::Update (UeSinrs &ue, uint32_t cellIndex, double sinr)
+{
+  if (ue.sinr.size () <= cellIndex)
+    {
+      ue.sinr.resize (cellIndex + 1, 0.0);
+    }
+  ue.sinr[cellIndex] = sinr;
+
+  uint16_t cellId = m_cellIds[cellIndex];
+  if (sinr > ue.maxSinr || (sinr == ue.maxSinr && sinr > 0 && cellId < ue.maxSinrCellId))
+    {
+      ue.maxSinrCellId = cellId;
+      ue.maxSinr = sinr;
+    }
+  else if (cellId == ue.maxSinrCellId && sinr != ue.maxSinr)
+    {
+      // the maximum SINR decreased, and another cell may have a higher SINR
+      FindMaxSinrCell (ue);
+    }
+}
+
+void
+LteMmWaveSinrTable::FindMaxSinrCell (UeSinrs &ue) const
+{
+  ue.maxSinrCellId = 0;
+  ue.maxSinr = 0;
+  for (uint32_t cellIndex = 0; cellIndex < ue.sinr.size (); cellIndex++)
+    {
+      double sinr = ue.sinr[cellIndex];
+      uint16_t cellId = m_cellIds[cellIndex];
+      if (sinr > ue.maxSinr || (sinr == ue.maxSinr && sinr > 0 && cellId < ue.maxSinrCellId))
+        {
+          ue.maxSinrCellId = cellId;
+          ue.maxSinr = sinr;
+        }
+    }
+}
+
+double
+LteMmWaveSinrTable::GetSinr (uint64_t imsi, uint16_t cellId) const
+{
+  return GetSinr (m_ues.find (imsi), cellId);
+}
+
+double
+LteMmWaveSinrTable::GetSinr (ConstIterator it, uint16_t cellId) const
+{
+  if (it == m_ues.end ())
+    {
+      return 0;
+    }
+  std::unordered_map<uint16_t, uint32_t>::const_iterator cell = m_cellIndices.find (cellId);
+  if (cell == m_cellIndices.end () || cell->second >= it->second.sinr.size ())
+    {
+      return 0;
+    }
+  return it->second.sinr[cell->second];
+}
+
+std::size_t
+LteMmWaveSinrTable::GetNUes (void) const
+{
+  return m_ues.size ();
+}
+
+std::size_t
+LteMmWaveSinrTable::GetNCells (void) const
+{
+  return m_cellIds.size ();
+}
+
+LteMmWaveSinrTable::ConstIterator
+LteMmWaveSinrTable::Begin (void) const
+{
+  return m_ues.begin ();
+}
+
+LteMmWaveSinrTable::ConstIterator
+LteMmWaveSinrTable::End (void) const
+{
+  return m_ues.end ();
+}
+
+void
+LteMmWaveSinrTable::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cellIndices.clear ();
+  m_cellIds.clear ();
+  m_ues.clear ();
+}
+
+} // namespace ns3
@@ -762,7 +762,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  m_txonBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -816,16 +816,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               //LL HO Mark the first SDU is txonBuffer is fragmented. This maybe not needed.
               is_fragmented = 1;
 
-              // m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-
-              if(m_txonBuffer.empty())
-              {
-                m_txonBuffer.push_back(firstSegment);
-              }
-              else
-              {
-                m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-              }
+              m_txonBuffer.push_front (firstSegment);
 
               m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
 
@@ -957,7 +948,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           entireSdu = (*(m_txonBuffer.begin ()))->Copy ();
 
           m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
+          m_txonBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
         }
     }
@@ -34,6 +34,7 @@
 #include <ns3/lte-pdcp-header.h>
 
 #include <vector>
+#include <deque>
 #include <map>
 #include <fstream>
 #include <string>
@@ -176,7 +177,7 @@ private:
   void BufferSizeTrace();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
 
     struct RetxSegPdu
     {
@@ -0,0 +1,332 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/data-rate.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/error-model.h"
+#include "ns3/uinteger.h"
+#include "ns3/pointer.h"
+#include "ns3/epc-x2.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("EpcX2UeSinrUpdateTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief EPC X2 SAP user which records the UE SINR reports received
+ */
+class EpcX2UeSinrUpdateTestSapUser : public EpcX2SapUser
+{
+public:
+  /// A UE SINR report received
+  struct Report
+  {
+    Time time; ///< the reception time
+    UeImsiSinrParams params; ///< the report
+  };
+
+  virtual void RecvHandoverRequest (HandoverRequestParams params) {}
+  virtual void RecvHandoverRequestAck (HandoverRequestAckParams params) {}
+  virtual void RecvHandoverPreparationFailure (HandoverPreparationFailureParams params) {}
+  virtual void RecvSnStatusTransfer (SnStatusTransferParams params) {}
+  virtual void RecvUeContextRelease (UeContextReleaseParams params) {}
+  virtual void RecvLoadInformation (LoadInformationParams params) {}
+  virtual void RecvResourceStatusUpdate (ResourceStatusUpdateParams params) {}
+  virtual void RecvRlcSetupRequest (RlcSetupRequest params) {}
+  virtual void RecvRlcSetupCompleted (UeDataParams params) {}
+  virtual void RecvUeData (UeDataParams params) {}
+  virtual void RecvUeSinrUpdate (UeImsiSinrParams params)
+  {
+    Report report;
+    report.time = Simulator::Now ();
+    report.params = params;
+    m_reports.push_back (report);
+  }
+  virtual void RecvMcHandoverRequest (SecondaryHandoverParams params) {}
+  virtual void RecvLteMmWaveHandoverCompleted (SecondaryHandoverParams params) {}
+  virtual void RecvConnectionSwitchToMmWave (SwitchConnectionParams params) {}
+  virtual void RecvSecondaryCellHandoverCompleted (SecondaryHandoverCompletedParams params) {}
+
+  std::vector<Report> m_reports; ///< the reports received
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Send a sequence of UE SINR reports from a cell to another over X2,
+ * and check that the target cell receives the same reports, for the X2
+ * packets with the full reports or with the delta encoding, and for the
+ * ideal delivery. With the delta encoding, a lost X2 packet makes the target
+ * discard the delta reports until the next full report
+ */
+class EpcX2UeSinrUpdateTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the name of the test case
+   * \param ideal true to deliver the reports without X2 packets
+   * \param deltaEncoding true to send only the SINRs changed
+   * \param fullReportPeriod the period of the full reports with delta encoding
+   * \param lostReport the index of the X2 packet lost, or -1 for none
+   */
+  EpcX2UeSinrUpdateTestCase (std::string name, bool ideal, bool deltaEncoding, uint32_t fullReportPeriod, int32_t lostReport);
+  virtual ~EpcX2UeSinrUpdateTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Count the bytes of the X2 packets received
+   *
+   * \param sourceCellId the source cell
+   * \param targetCellId the target cell
+   * \param bytes the size of the packet
+   * \param delay the delay of the packet
+   * \param data true for a data packet
+   */
+  void RxPdu (uint16_t sourceCellId, uint16_t targetCellId, uint32_t bytes, uint64_t delay, bool data);
+
+  bool m_ideal; ///< true to deliver the reports without X2 packets
+  bool m_deltaEncoding; ///< true to send only the SINRs changed
+  uint32_t m_fullReportPeriod; ///< the period of the full reports with delta encoding
+  int32_t m_lostReport; ///< the index of the X2 packet lost, or -1 for none
+  uint32_t m_rxBytes; ///< the bytes of the X2 packets received
+};
+
+EpcX2UeSinrUpdateTestCase::EpcX2UeSinrUpdateTestCase (std::string name, bool ideal, bool deltaEncoding, uint32_t fullReportPeriod, int32_t lostReport)
+  : TestCase (name),
+    m_ideal (ideal),
+    m_deltaEncoding (deltaEncoding),
+    m_fullReportPeriod (fullReportPeriod),
+    m_lostReport (lostReport),
+    m_rxBytes (0)
+{
+}
+
+EpcX2UeSinrUpdateTestCase::~EpcX2UeSinrUpdateTestCase ()
+{
+}
+
+void
+EpcX2UeSinrUpdateTestCase::RxPdu (uint16_t sourceCellId, uint16_t targetCellId, uint32_t bytes, uint64_t delay, bool data)
+{
+  m_rxBytes += bytes;
+}
+
+void
+EpcX2UeSinrUpdateTestCase::DoRun (void)
+{
+  uint16_t sourceCellId = 1;
+  uint16_t targetCellId = 2;
+  Time idealDelay = MicroSeconds (250);
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  InternetStackHelper internet;
+  internet.Install (enbNodes);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("10Gb/s")));
+  p2p.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (1)));
+  NetDeviceContainer devices = p2p.Install (enbNodes);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+  if (m_lostReport >= 0)
+    {
+      Ptr<ReceiveListErrorModel> errorModel = CreateObject<ReceiveListErrorModel> ();
+      errorModel->SetList (std::list<uint32_t> (1, m_lostReport));
+      devices.Get (1)->SetAttribute ("ReceiveErrorModel", PointerValue (errorModel));
+    }
+
+  Ptr<EpcX2> sourceX2 = CreateObject<EpcX2> ();
+  sourceX2->SetAttribute ("IdealUeSinrUpdate", BooleanValue (m_ideal));
+  sourceX2->SetAttribute ("IdealUeSinrUpdateDelay", TimeValue (idealDelay));
+  sourceX2->SetAttribute ("UeSinrUpdateDeltaEncoding", BooleanValue (m_deltaEncoding));
+  sourceX2->SetAttribute ("UeSinrUpdateFullReportPeriod", UintegerValue (m_fullReportPeriod));
+  enbNodes.Get (0)->AggregateObject (sourceX2);
+  Ptr<EpcX2> targetX2 = CreateObject<EpcX2> ();
+  enbNodes.Get (1)->AggregateObject (targetX2);
+  sourceX2->AddX2Interface (sourceCellId, interfaces.GetAddress (0), targetCellId, interfaces.GetAddress (1));
+  targetX2->AddX2Interface (targetCellId, interfaces.GetAddress (1), sourceCellId, interfaces.GetAddress (0));
+  targetX2->TraceConnectWithoutContext ("RxPDU", MakeCallback (&EpcX2UeSinrUpdateTestCase::RxPdu, this));
+
+  EpcX2UeSinrUpdateTestSapUser sourceSapUser;
+  EpcX2UeSinrUpdateTestSapUser targetSapUser;
+  sourceX2->SetEpcX2SapUser (&sourceSapUser);
+  targetX2->SetEpcX2SapUser (&targetSapUser);
+
+  // reports with changed, added and removed UEs, an empty report,
+  // and two equal reports
+  std::vector<std::map<uint64_t, double> > reports (7);
+  for (uint64_t imsi = 1; imsi <= 50; imsi++)
+    {
+      reports[0][imsi] = 10.0 * imsi;
+    }
+  reports[1] = reports[0];
+  reports[1][7] = 3.5;
+  reports[1][33] = 1e-3;
+  reports[2] = reports[1];
+  reports[2].erase (1);
+  reports[2].erase (20);
+  reports[2].erase (50);
+  reports[2][51] = 42.0;
+  reports[2][10] = 0.0;
+  reports[4][3] = 1.0;
+  reports[5] = reports[2];
+  reports[6] = reports[2];
+
+  Time period = MilliSeconds (10);
+  for (uint32_t i = 0; i < reports.size (); i++)
+    {
+      EpcX2SapProvider::UeImsiSinrParams params;
+      params.sourceCellId = sourceCellId;
+      params.targetCellId = targetCellId;
+      params.ueImsiSinrMap = reports[i];
+      Simulator::Schedule (period * (i + 1), &EpcX2SapProvider::SendUeSinrUpdate, sourceX2->GetEpcX2SapProvider (), params);
+    }
+
+  Simulator::Stop (period * (reports.size () + 1));
+  Simulator::Run ();
+
+  // the reports delivered: a lost report breaks the chain of the delta
+  // reports until the next full report
+  std::vector<uint32_t> delivered;
+  bool chainValid = false;
+  for (uint32_t i = 0; i < reports.size (); i++)
+    {
+      bool full = !m_deltaEncoding || i % m_fullReportPeriod == 0;
+      if ((int32_t) i == m_lostReport)
+        {
+          chainValid = false;
+        }
+      else if (full || chainValid)
+        {
+          delivered.push_back (i);
+          chainValid = true;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (targetSapUser.m_reports.size (), delivered.size (), "Wrong number of reports received");
+  NS_TEST_ASSERT_MSG_EQ (sourceSapUser.m_reports.size (), 0u, "No report should be received by the source cell");
+  for (uint32_t j = 0; j < targetSapUser.m_reports.size (); j++)
+    {
+      const EpcX2UeSinrUpdateTestSapUser::Report &report = targetSapUser.m_reports[j];
+      uint32_t i = delivered[j];
+      NS_TEST_ASSERT_MSG_EQ (report.params.sourceCellId, sourceCellId, "Wrong source cell");
+      NS_TEST_ASSERT_MSG_EQ ((report.params.ueImsiSinrMap == reports[i]), true, "Wrong SINRs in report " << i);
+      if (m_ideal)
+        {
+          NS_TEST_ASSERT_MSG_EQ (report.time, period * (i + 1) + idealDelay, "Wrong delay of the ideal report " << i);
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_GT (report.time, period * (i + 1), "Wrong delay of report " << i);
+          NS_TEST_ASSERT_MSG_LT (report.time, period * (i + 2), "Wrong delay of report " << i);
+        }
+    }
+
+  if (m_ideal)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_rxBytes, 0u, "No X2 packet should be sent in the ideal mode");
+    }
+  else
+    {
+      // the X2 header (7 bytes) and the source cell (2 bytes), then the
+      // number of UEs (2 bytes) and 16 bytes per UE. The numbered reports
+      // add the sequence number (2 bytes) and the delta flag (1 byte), and
+      // the delta reports the number of removed IMSIs (2 bytes) and 8 bytes
+      // per removed IMSI
+      uint32_t expectedBytes = 0;
+      for (uint32_t i = 0; i < reports.size (); i++)
+        {
+          if ((int32_t) i == m_lostReport)
+            {
+              continue;
+            }
+          expectedBytes += 7 + 2 + 2;
+          if (!m_deltaEncoding)
+            {
+              expectedBytes += reports[i].size () * 16;
+              continue;
+            }
+          expectedBytes += 2 + 1;
+          if (i % m_fullReportPeriod == 0)
+            {
+              expectedBytes += reports[i].size () * 16;
+              continue;
+            }
+          expectedBytes += 2;
+          for (std::map<uint64_t, double>::const_iterator it = reports[i].begin (); it != reports[i].end (); ++it)
+            {
+              std::map<uint64_t, double>::const_iterator previous = reports[i - 1].find (it->first);
+              if (previous == reports[i - 1].end () || previous->second != it->second)
+                {
+                  expectedBytes += 16;
+                }
+            }
+          for (std::map<uint64_t, double>::const_iterator it = reports[i - 1].begin (); it != reports[i - 1].end (); ++it)
+            {
+              if (reports[i].find (it->first) == reports[i].end ())
+                {
+                  expectedBytes += 8;
+                }
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_rxBytes, expectedBytes, "Wrong size of the X2 packets received");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the UE SINR reports over X2
+ */
+class EpcX2UeSinrUpdateTestSuite : public TestSuite
+{
+public:
+  EpcX2UeSinrUpdateTestSuite ();
+};
+
+EpcX2UeSinrUpdateTestSuite::EpcX2UeSinrUpdateTestSuite ()
+  : TestSuite ("epc-x2-ue-sinr-update", SYSTEM)
+{
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Full reports over X2", false, false, 10, -1), TestCase::QUICK);
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Delta reports over X2", false, true, 10, -1), TestCase::QUICK);
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Delta reports over X2, full report every 3", false, true, 3, -1), TestCase::QUICK);
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Delta reports over X2, report 1 lost", false, true, 3, 1), TestCase::QUICK);
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Full reports over X2, report 1 lost", false, false, 10, 1), TestCase::QUICK);
+  AddTestCase (new EpcX2UeSinrUpdateTestCase ("Ideal reports", true, false, 10, -1), TestCase::QUICK);
+}
+
+static EpcX2UeSinrUpdateTestSuite epcX2UeSinrUpdateTestSuite;
@@ -0,0 +1,312 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/lte-mmwave-sinr-table.h"
+
+#include <cmath>
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteMmWaveSinrTableTest");
+
+/**
+ * The SINRs of each UE in each cell, stored in nested maps, with the best
+ * cell found comparing all the cells, as done by the LTE coordinator before
+ * LteMmWaveSinrTable
+ */
+class ReferenceSinrTable
+{
+public:
+  /**
+   * Store the SINRs reported by a cell
+   * \param cellId the cell
+   * \param imsiSinrMap the SINR of each UE reported by the cell
+   */
+  void Update (uint16_t cellId, const std::map<uint64_t, double> &imsiSinrMap)
+  {
+    for (std::map<uint64_t, double>::const_iterator it = imsiSinrMap.begin (); it != imsiSinrMap.end (); ++it)
+      {
+        m_sinrs[it->first][cellId] = it->second;
+      }
+  }
+
+  /**
+   * Find the cell with the maximum SINR of a UE
+   * \param imsi the UE
+   * \param [out] maxSinr the maximum SINR
+   * \return the cell with the maximum SINR
+   */
+  uint16_t GetMaxSinrCellId (uint64_t imsi, double &maxSinr) const
+  {
+    maxSinr = 0;
+    uint16_t maxSinrCellId = 0;
+    const std::map<uint16_t, double> &cells = m_sinrs.at (imsi);
+    for (std::map<uint16_t, double>::const_iterator it = cells.begin (); it != cells.end (); ++it)
+      {
+        if (it->second > maxSinr)
+          {
+            maxSinr = it->second;
+            maxSinrCellId = it->first;
+          }
+      }
+    return maxSinrCellId;
+  }
+
+  std::map<uint64_t, std::map<uint16_t, double> > m_sinrs; ///< the SINR of each UE in each cell
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check the best cell and the SINRs of LteMmWaveSinrTable, with ties,
+ * decreasing SINRs, SINRs equal to 0, and cells which did not report
+ */
+class LteMmWaveSinrTableTestCase : public TestCase
+{
+public:
+  LteMmWaveSinrTableTestCase ();
+  virtual ~LteMmWaveSinrTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMmWaveSinrTableTestCase::LteMmWaveSinrTableTestCase ()
+  : TestCase ("Check the best cell and the SINRs of LteMmWaveSinrTable")
+{
+}
+
+LteMmWaveSinrTableTestCase::~LteMmWaveSinrTableTestCase ()
+{
+}
+
+void
+LteMmWaveSinrTableTestCase::DoRun (void)
+{
+  LteMmWaveSinrTable table;
+  uint64_t imsi = 7;
+
+  // no positive SINR
+  table.Update (5, imsi, 0.0);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 0, "No cell should be the best with a SINR equal to 0");
+  NS_TEST_ASSERT_MSG_EQ (table.GetSinr (imsi, 5), 0.0, "Wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ (table.GetSinr (imsi, 6), 0.0, "The SINR of a cell which did not report should be 0");
+  NS_TEST_ASSERT_MSG_EQ (table.GetSinr (imsi + 1, 5), 0.0, "The SINR of a UE without reports should be 0");
+
+  // the cells are indexed in order of report, the ties go to the lowest cell ID
+  table.Update (5, imsi, 2.0);
+  table.Update (3, imsi, 2.0);
+  table.Update (4, imsi, 1.0);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 3, "The tie should go to the lowest cell ID");
+  table.Update (3, imsi, 3.0);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 3, "Wrong best cell");
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinr, 3.0, "Wrong maximum SINR");
+
+  // the best SINR decreases
+  table.Update (3, imsi, 1.5);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 5, "Wrong best cell after the SINR decreased");
+  table.Update (5, imsi, 0.5);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 3, "Wrong best cell after the SINR decreased");
+  table.Update (3, imsi, 1.0);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 3, "The tie should go to the lowest cell ID");
+  table.Update (3, imsi, 0.0);
+  table.Update (4, imsi, 0.0);
+  table.Update (5, imsi, 0.0);
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinrCellId, 0, "No cell should be the best with SINRs equal to 0");
+  NS_TEST_ASSERT_MSG_EQ (table.Begin ()->second.maxSinr, 0.0, "Wrong maximum SINR");
+
+  // reports with several UEs, in and out of order of IMSI
+  std::map<uint64_t, double> report;
+  report[1] = 4.0;
+  report[imsi] = 8.0;
+  report[9] = 1.0;
+  table.Update (6, report);
+  report.clear ();
+  report[2] = 2.0;
+  report[9] = 3.0;
+  table.Update (3, report);
+  NS_TEST_ASSERT_MSG_EQ (table.GetNUes (), 4, "Wrong number of UEs");
+  NS_TEST_ASSERT_MSG_EQ (table.GetNCells (), 4, "Wrong number of cells");
+  uint64_t expectedImsis[] = {1, 2, imsi, 9};
+  uint16_t expectedCells[] = {6, 3, 6, 3};
+  uint32_t i = 0;
+  for (LteMmWaveSinrTable::ConstIterator it = table.Begin (); it != table.End (); ++it, ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (it->first, expectedImsis[i], "The UEs should be sorted by IMSI");
+      NS_TEST_ASSERT_MSG_EQ (it->second.maxSinrCellId, expectedCells[i], "Wrong best cell for IMSI " << it->first);
+    }
+  NS_TEST_ASSERT_MSG_EQ (table.GetSinr (9, 6), 1.0, "Wrong SINR");
+  NS_TEST_ASSERT_MSG_EQ (table.GetSinr (9, 3), 3.0, "Wrong SINR");
+
+  table.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (table.GetNUes (), 0, "The table should be empty");
+  NS_TEST_ASSERT_MSG_EQ (table.GetNCells (), 0, "The table should be empty");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of LteMmWaveSinrTable
+ */
+class LteMmWaveSinrTableTestSuite : public TestSuite
+{
+public:
+  LteMmWaveSinrTableTestSuite ();
+};
+
+LteMmWaveSinrTableTestSuite::LteMmWaveSinrTableTestSuite ()
+  : TestSuite ("lte-mmwave-sinr-table", UNIT)
+{
+  AddTestCase (new LteMmWaveSinrTableTestCase, TestCase::QUICK);
+}
+
+static LteMmWaveSinrTableTestSuite lteMmWaveSinrTableTestSuite;
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Measure the time taken to store the periodic reports of many cells
+ * and to find the best cell of each UE after each period, with
+ * LteMmWaveSinrTable and with nested maps, and check that they give the
+ * same best cells
+ */
+class LteMmWaveSinrTablePerfTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param numCells the number of cells
+   * \param numUes the number of UEs
+   * \param numPeriods the number of report periods
+   */
+  LteMmWaveSinrTablePerfTestCase (uint16_t numCells, uint32_t numUes, uint32_t numPeriods);
+  virtual ~LteMmWaveSinrTablePerfTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_numCells; ///< the number of cells
+  uint32_t m_numUes; ///< the number of UEs
+  uint32_t m_numPeriods; ///< the number of report periods
+};
+
+LteMmWaveSinrTablePerfTestCase::LteMmWaveSinrTablePerfTestCase (uint16_t numCells, uint32_t numUes, uint32_t numPeriods)
+  : TestCase ("Best cell of " + std::to_string (numUes) + " UEs among " + std::to_string (numCells) + " cells"),
+    m_numCells (numCells),
+    m_numUes (numUes),
+    m_numPeriods (numPeriods)
+{
+}
+
+LteMmWaveSinrTablePerfTestCase::~LteMmWaveSinrTablePerfTestCase ()
+{
+}
+
+void
+LteMmWaveSinrTablePerfTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetAttribute ("Min", DoubleValue (-20.0));
+  sinrDb->SetAttribute ("Max", DoubleValue (30.0));
+  sinrDb->SetStream (1);
+
+  LteMmWaveSinrTable table;
+  ReferenceSinrTable reference;
+  int64_t tableMs = 0;
+  int64_t referenceMs = 0;
+  uint32_t numBestCells = 0;
+  for (uint32_t period = 0; period < m_numPeriods; period++)
+    {
+      // each cell reports the SINRs of all the UEs, as the mmWave eNBs do
+      std::vector<std::map<uint64_t, double> > reports (m_numCells);
+      for (uint16_t cell = 0; cell < m_numCells; cell++)
+        {
+          for (uint64_t imsi = 1; imsi <= m_numUes; imsi++)
+            {
+              reports[cell][imsi] = std::pow (10.0, sinrDb->GetValue () / 10.0);
+            }
+        }
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      for (uint16_t cell = 0; cell < m_numCells; cell++)
+        {
+          table.Update (cell + 1, reports[cell]);
+        }
+      std::vector<uint16_t> tableBestCells;
+      tableBestCells.reserve (m_numUes);
+      for (LteMmWaveSinrTable::ConstIterator it = table.Begin (); it != table.End (); ++it)
+        {
+          tableBestCells.push_back (it->second.maxSinrCellId);
+        }
+      tableMs += clock.End ();
+
+      clock.Start ();
+      for (uint16_t cell = 0; cell < m_numCells; cell++)
+        {
+          reference.Update (cell + 1, reports[cell]);
+        }
+      std::vector<uint16_t> referenceBestCells;
+      referenceBestCells.reserve (m_numUes);
+      for (std::map<uint64_t, std::map<uint16_t, double> >::const_iterator it = reference.m_sinrs.begin ();
+           it != reference.m_sinrs.end (); ++it)
+        {
+          double maxSinr;
+          referenceBestCells.push_back (reference.GetMaxSinrCellId (it->first, maxSinr));
+        }
+      referenceMs += clock.End ();
+
+      NS_TEST_ASSERT_MSG_EQ ((tableBestCells == referenceBestCells), true, "Different best cells in period " << period);
+      numBestCells += tableBestCells.size ();
+    }
+
+  std::cout << m_numCells << " cells, " << m_numUes << " UEs: "
+            << (double) tableMs / m_numPeriods << " ms/period"
+            << " (nested maps: " << (double) referenceMs / m_numPeriods << " ms/period)" << std::endl;
+  NS_TEST_ASSERT_MSG_EQ (numBestCells, m_numUes * m_numPeriods, "Wrong number of best cells");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Performance test suite of LteMmWaveSinrTable
+ */
+class LteMmWaveSinrTablePerfTestSuite : public TestSuite
+{
+public:
+  LteMmWaveSinrTablePerfTestSuite ();
+};
+
+LteMmWaveSinrTablePerfTestSuite::LteMmWaveSinrTablePerfTestSuite ()
+  : TestSuite ("lte-mmwave-sinr-table-perf", PERFORMANCE)
+{
+  AddTestCase (new LteMmWaveSinrTablePerfTestCase (10, 500, 10), TestCase::QUICK);
+  AddTestCase (new LteMmWaveSinrTablePerfTestCase (100, 5000, 3), TestCase::QUICK);
+}
+
+static LteMmWaveSinrTablePerfTestSuite lteMmWaveSinrTablePerfTestSuite;
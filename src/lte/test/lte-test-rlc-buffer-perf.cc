@@ -0,0 +1,120 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/lte-rlc.h"
+
+#include "lte-test-rlc-buffer-perf.h"
+#include "lte-test-entities.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRlcBufferPerfTest");
+
+LteRlcBufferPerfTestSuite::LteRlcBufferPerfTestSuite ()
+  : TestSuite ("lte-rlc-buffer-perf", PERFORMANCE)
+{
+  const uint32_t numSdus[] = {1000, 10000, 100000};
+  for (uint32_t n : numSdus)
+    {
+      AddTestCase (new LteRlcBufferPerfTestCase ("ns3::LteRlcUmLowLat", n), TestCase::QUICK);
+      AddTestCase (new LteRlcBufferPerfTestCase ("ns3::LteRlcAm", n), TestCase::QUICK);
+    }
+}
+
+static LteRlcBufferPerfTestSuite lteRlcBufferPerfTestSuite;
+
+
+LteRlcBufferPerfTestCase::LteRlcBufferPerfTestCase (std::string rlcTypeId, uint32_t numSdus)
+  : TestCase (rlcTypeId + " with " + std::to_string (numSdus) + " SDUs buffered"),
+    m_rlcTypeId (rlcTypeId),
+    m_numSdus (numSdus)
+{
+}
+
+LteRlcBufferPerfTestCase::~LteRlcBufferPerfTestCase ()
+{
+}
+
+void
+LteRlcBufferPerfTestCase::DoRun (void)
+{
+  uint16_t rnti = 1111;
+  uint8_t lcid = 222;
+  uint32_t sduSize = 100;
+  // less PDUs than the SDUs buffered, and than the transmitting window of
+  // the AM entity, so that no status PDU is needed
+  bool isAm = (m_rlcTypeId == "ns3::LteRlcAm");
+  uint32_t numPdus = 500;
+
+  // Create the PDCP (Tx) <-> RLC (Tx) <-> MAC (Tx) chain
+  Ptr<LteTestPdcp> txPdcp = CreateObject<LteTestPdcp> ();
+
+  ObjectFactory rlcFactory;
+  rlcFactory.SetTypeId (m_rlcTypeId);
+  rlcFactory.Set ("MaxTxBufferSize", UintegerValue ((m_numSdus + 1) * sduSize));
+  Ptr<LteRlc> txRlc = rlcFactory.Create<LteRlc> ();
+  txRlc->SetRnti (rnti);
+  txRlc->SetLcId (lcid);
+
+  Ptr<LteTestMac> txMac = CreateObject<LteTestMac> ();
+  txMac->SetRlcHeaderType (isAm ? LteTestMac::AM_RLC_HEADER : LteTestMac::UM_RLC_HEADER);
+
+  txPdcp->SetLteRlcSapProvider (txRlc->GetLteRlcSapProvider ());
+  txRlc->SetLteRlcSapUser (txPdcp->GetLteRlcSapUser ());
+  txRlc->SetLteMacSapProvider (txMac->GetLteMacSapProvider ());
+  txMac->SetLteMacSapUser (txRlc->GetLteMacSapUser ());
+
+  for (uint32_t i = 0; i < m_numSdus; i++)
+    {
+      LteRlcSapProvider::TransmitPdcpPduParameters p;
+      p.rnti = rnti;
+      p.lcid = lcid;
+      p.pdcpPdu = Create<Packet> (sduSize);
+      txRlc->GetLteRlcSapProvider ()->TransmitPdcpPdu (p);
+    }
+
+  // each PDU carries the rest of an SDU and half of the following one
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < numPdus; i++)
+    {
+      LteMacSapUser::TxOpportunityParameters txOpParams;
+      txOpParams.bytes = sduSize + 10;
+      txOpParams.layer = 0;
+      txOpParams.harqId = 0;
+      txOpParams.componentCarrierId = 0;
+      txOpParams.rnti = rnti;
+      txOpParams.lcid = lcid;
+      txRlc->GetLteMacSapUser ()->NotifyTxOpportunity (txOpParams);
+    }
+  int64_t elapsedMs = clock.End ();
+
+  std::cout << m_rlcTypeId << ", " << m_numSdus << " SDUs buffered: "
+            << elapsedMs << " ms for " << numPdus << " PDUs ("
+            << 1e3 * elapsedMs / numPdus << " us/PDU)" << std::endl;
+
+  NS_TEST_ASSERT_MSG_EQ (txMac->GetTxPdus (), numPdus, "Wrong number of PDUs sent");
+
+  Simulator::Destroy ();
+}
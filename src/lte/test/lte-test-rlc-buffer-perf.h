@@ -0,0 +1,65 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_TEST_RLC_BUFFER_PERF_H
+#define LTE_TEST_RLC_BUFFER_PERF_H
+
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Stress test of the transmission buffer of the RLC entities: the
+ * cost of each PDU sent should not depend on the number of SDUs buffered.
+ */
+class LteRlcBufferPerfTestSuite : public TestSuite
+{
+  public:
+    LteRlcBufferPerfTestSuite ();
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Fill the transmission buffer of a RLC entity with SDUs, and measure
+ * the time taken to send a number of PDUs, each one with a segment of an SDU
+ * and the following SDU, so that the remaining segment is given back to the
+ * front of the buffer.
+ */
+class LteRlcBufferPerfTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param rlcTypeId the TypeId of the RLC entity
+     * \param numSdus the number of SDUs buffered
+     */
+    LteRlcBufferPerfTestCase (std::string rlcTypeId, uint32_t numSdus);
+    virtual ~LteRlcBufferPerfTestCase ();
+
+  private:
+    virtual void DoRun (void);
+
+    std::string m_rlcTypeId; ///< the TypeId of the RLC entity
+    uint32_t m_numSdus; ///< the number of SDUs buffered
+};
+
+#endif // LTE_TEST_RLC_BUFFER_PERF_H
@@ -0,0 +1,256 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/three-gpp-channel-model.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/channel-condition-model.h"
+#include "ns3/uniform-planar-array.h"
+#include "ns3/isotropic-antenna-model.h"
+#include "ns3/file-beamforming-codebook.h"
+#include "ns3/mmwave-beam-search.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/mmwave-spectrum-value-helper.h"
+#include <chrono>
+#include <iomanip>
+
+using namespace ns3;
+using namespace mmwave;
+
+/*
+ * This example compares the beam search strategies available for the
+ * MmWaveCodebookBeamforming model against the exhaustive search.
+ * A UE moves along a short random trajectory around a BS, and at each step
+ * the channel is regenerated, the gain of every pair of codewords is computed
+ * through the ThreeGppSpectrumPropagationLossModel, and each strategy selects
+ * a pair. For each strategy, the example reports the average and maximum SNR
+ * loss with respect to the exhaustive search, the average number of evaluated
+ * pairs, and the corresponding beam training time, estimated from the cost of
+ * a single evaluation.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveBeamSearchBenchmark");
+
+struct StrategyStats
+{
+  std::string name;
+  Ptr<MmWaveBeamSearch> search;
+  std::vector<MmWaveBeamSearch::BeamPair> previous;
+  double sumLossDb = 0.0;
+  double maxLossDb = 0.0;
+  uint64_t sumEvaluations = 0;
+  uint32_t numOptimal = 0;
+};
+
+static Ptr<MobilityModel> g_bsMob;
+static Ptr<MobilityModel> g_ueMob;
+static Ptr<PhasedArrayModel> g_bsAntenna;
+static Ptr<PhasedArrayModel> g_ueAntenna;
+static Ptr<BeamformingCodebook> g_bsCodebook;
+static Ptr<BeamformingCodebook> g_ueCodebook;
+static Ptr<ThreeGppSpectrumPropagationLossModel> g_splm;
+static Ptr<SpectrumValue> g_txPsd;
+static std::vector<StrategyStats> g_strategies;
+static uint32_t g_numSearches = 0;
+static double g_evaluationTime = 0.0; // total time spent to evaluate pairs, in seconds
+static uint64_t g_numEvaluations = 0;
+
+static void
+DoStep (Vector uePos, bool newLink)
+{
+  g_ueMob->SetPosition (uePos);
+
+  // compute the gain of every pair of codewords
+  uint32_t bsSize = g_bsCodebook->GetCodebookSize ();
+  uint32_t ueSize = g_ueCodebook->GetCodebookSize ();
+  std::vector<double> gains (bsSize * ueSize);
+
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t bsIdx = 0; bsIdx < bsSize; bsIdx++)
+    {
+      g_bsAntenna->SetBeamformingVector (g_bsCodebook->GetCodeword (bsIdx));
+      for (uint32_t ueIdx = 0; ueIdx < ueSize; ueIdx++)
+        {
+          g_ueAntenna->SetBeamformingVector (g_ueCodebook->GetCodeword (ueIdx));
+          Ptr<SpectrumValue> rxPsd = g_splm->CalcRxPowerSpectralDensity (g_txPsd, g_bsMob, g_ueMob);
+          gains[bsIdx * ueSize + ueIdx] = Sum (*rxPsd) / (rxPsd->GetSpectrumModel ()->GetNumBands ());
+        }
+    }
+  g_evaluationTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+  g_numEvaluations += bsSize * ueSize;
+
+  double maxGain = *std::max_element (gains.begin (), gains.end ());
+
+  MmWaveBeamSearch::GainFunction gainFunction = [&gains, ueSize] (uint32_t bsIdx, uint32_t ueIdx)
+    {
+      return gains[bsIdx * ueSize + ueIdx];
+    };
+
+  for (auto &s : g_strategies)
+    {
+      if (newLink)
+        {
+          s.previous.clear ();
+        }
+      s.previous = s.search->Search (g_bsCodebook, g_ueCodebook, gainFunction, s.previous);
+
+      double lossDb = 10 * std::log10 (maxGain / s.previous[0].gain);
+      s.sumLossDb += lossDb;
+      s.maxLossDb = std::max (s.maxLossDb, lossDb);
+      s.sumEvaluations += s.search->GetNumEvaluations ();
+      s.numOptimal += (s.previous[0].gain == maxGain);
+    }
+  g_numSearches++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numDrops = 10; // number of UE trajectories
+  uint32_t numSteps = 10; // number of steps of each trajectory
+  double stepLength = 1.0; // distance between two consecutive steps, in m
+  std::string bsCodebookFile = "src/mmwave/model/Codebooks/8x8.txt";
+  std::string ueCodebookFile = "src/mmwave/model/Codebooks/4x4.txt";
+  uint32_t bsSize = 8; // number of rows and columns of the BS array
+  uint32_t ueSize = 4; // number of rows and columns of the UE array
+
+  CommandLine cmd;
+  cmd.AddValue ("numDrops", "Number of UE trajectories", numDrops);
+  cmd.AddValue ("numSteps", "Number of steps of each trajectory", numSteps);
+  cmd.AddValue ("stepLength", "Distance between two consecutive steps [m]", stepLength);
+  cmd.AddValue ("bsCodebookFile", "Codebook file for the BS", bsCodebookFile);
+  cmd.AddValue ("ueCodebookFile", "Codebook file for the UE", ueCodebookFile);
+  cmd.AddValue ("bsSize", "Number of rows and columns of the BS array", bsSize);
+  cmd.AddValue ("ueSize", "Number of rows and columns of the UE array", ueSize);
+  cmd.Parse (argc, argv);
+
+  // create the nodes
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  g_bsMob = nodes.Get (0)->GetObject<MobilityModel> ();
+  g_bsMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  g_ueMob = nodes.Get (1)->GetObject<MobilityModel> ();
+
+  Ptr<SimpleNetDevice> bsDev = CreateObject<SimpleNetDevice> ();
+  nodes.Get (0)->AddDevice (bsDev);
+  Ptr<SimpleNetDevice> ueDev = CreateObject<SimpleNetDevice> ();
+  nodes.Get (1)->AddDevice (ueDev);
+
+  // create the antennas and the codebooks
+  g_bsAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (bsSize),
+                                                                "NumColumns", UintegerValue (bsSize),
+                                                                "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  g_ueAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (ueSize),
+                                                                "NumColumns", UintegerValue (ueSize),
+                                                                "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  g_bsCodebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue (bsCodebookFile),
+                                                                      "Array", PointerValue (g_bsAntenna));
+  g_bsCodebook->Initialize ();
+  g_ueCodebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue (ueCodebookFile),
+                                                                      "Array", PointerValue (g_ueAntenna));
+  g_ueCodebook->Initialize ();
+
+  // create the channel, regenerated at every step
+  Ptr<MmWavePhyMacCommon> phyMacConfig = CreateObject<MmWavePhyMacCommon> ();
+
+  Ptr<ChannelConditionModel> condModel = CreateObjectWithAttributes<ThreeGppUmiStreetCanyonChannelConditionModel> ("UpdatePeriod", TimeValue (MilliSeconds (1)));
+  g_splm = CreateObject<ThreeGppSpectrumPropagationLossModel> ();
+  g_splm->SetChannelModelAttribute ("Frequency", DoubleValue (phyMacConfig->GetCenterFrequency ()));
+  g_splm->SetChannelModelAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  g_splm->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (condModel));
+  g_splm->SetChannelModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (1)));
+  g_splm->AddDevice (bsDev, g_bsAntenna);
+  g_splm->AddDevice (ueDev, g_ueAntenna);
+
+  std::vector <int> activeRbs;
+  for (uint32_t i = 0; i < phyMacConfig->GetNumChunks (); i++)
+    {
+      activeRbs.push_back (i);
+    }
+  g_txPsd = MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (phyMacConfig, 30.0, activeRbs);
+
+  // create the strategies to compare
+  g_strategies.resize (4);
+  g_strategies[0].name = "Exhaustive";
+  g_strategies[0].search = CreateObject<MmWaveExhaustiveBeamSearch> ();
+  g_strategies[1].name = "Hierarchical";
+  g_strategies[1].search = CreateObject<MmWaveHierarchicalBeamSearch> ();
+  g_strategies[2].name = "Iterative";
+  g_strategies[2].search = CreateObject<MmWaveIterativeBeamSearch> ();
+  g_strategies[3].name = "TopK";
+  g_strategies[3].search = CreateObject<MmWaveTopKBeamSearch> ();
+
+  // schedule the UE trajectories
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  Time stepInterval = MilliSeconds (10);
+  for (uint32_t drop = 0; drop < numDrops; drop++)
+    {
+      double distance = uniform->GetValue (20.0, 100.0);
+      double angle = uniform->GetValue (0.0, 2 * M_PI);
+      double direction = uniform->GetValue (0.0, 2 * M_PI);
+      Vector pos (distance * std::cos (angle), distance * std::sin (angle), 1.5);
+      for (uint32_t step = 0; step < numSteps; step++)
+        {
+          Simulator::Schedule (stepInterval * (drop * numSteps + step + 1), &DoStep, pos, step == 0);
+          pos.x += stepLength * std::cos (direction);
+          pos.y += stepLength * std::sin (direction);
+        }
+    }
+
+  Simulator::Run ();
+
+  double timePerEvaluation = g_evaluationTime / g_numEvaluations;
+  std::cout << "Codebook sizes: " << g_bsCodebook->GetCodebookSize () << " x " << g_ueCodebook->GetCodebookSize ()
+            << ", " << g_numSearches << " searches, " << timePerEvaluation * 1e6 << " us per evaluation" << std::endl;
+  std::cout << std::left << std::setw (14) << "Strategy"
+            << std::setw (14) << "AvgLoss[dB]"
+            << std::setw (14) << "MaxLoss[dB]"
+            << std::setw (12) << "Optimal[%]"
+            << std::setw (14) << "AvgEvals"
+            << std::setw (14) << "AvgTime[ms]" << std::endl;
+  for (const auto &s : g_strategies)
+    {
+      double avgEvaluations = double (s.sumEvaluations) / g_numSearches;
+      std::cout << std::left << std::setw (14) << s.name
+                << std::setw (14) << s.sumLossDb / g_numSearches
+                << std::setw (14) << s.maxLossDb
+                << std::setw (12) << 100.0 * s.numOptimal / g_numSearches
+                << std::setw (14) << avgEvaluations
+                << std::setw (14) << avgEvaluations * timePerEvaluation * 1e3 << std::endl;
+    }
+
+  g_strategies.clear ();
+  g_bsMob = 0;
+  g_ueMob = 0;
+  g_bsAntenna = 0;
+  g_ueAntenna = 0;
+  g_bsCodebook = 0;
+  g_ueCodebook = 0;
+  g_splm = 0;
+  g_txPsd = 0;
+  Simulator::Destroy ();
+  return 0;
+}
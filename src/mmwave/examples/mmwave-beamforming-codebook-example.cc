@@ -25,6 +25,8 @@
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include <ns3/buildings-module.h>
+#include "ns3/file-beamforming-codebook.h"
+#include <chrono>
 
 using namespace ns3;
 using namespace mmwave;
@@ -32,13 +34,23 @@ using namespace mmwave;
 /*
  * This example shows how to cofigure the beamforming model to use a codebook. 
  * The scenario is the same as in mmwave-simple-building-obstacle.cc.
+ * With numUes > 1, additional UEs moving in parallel to the first one are
+ * added, and the program reports the time needed to set up the devices and
+ * the memory used by the codebooks, which are shared by all the antennas.
 */
 int
 main (int argc, char *argv[])
 {
+  uint32_t numUes = 1;
+  double simTime = 1.0;
+
   CommandLine cmd;
+  cmd.AddValue ("numUes", "Number of UEs", numUes);
+  cmd.AddValue ("simTime", "Simulation time [s]", simTime);
   cmd.Parse (argc, argv);
 
+  auto start = std::chrono::steady_clock::now ();
+
   Ptr<MmWaveHelper> ptr_mmWave = CreateObject<MmWaveHelper> ();
   ptr_mmWave->SetChannelConditionModelType ("ns3::BuildingsChannelConditionModel");
   
@@ -62,7 +74,7 @@ main (int argc, char *argv[])
   NodeContainer enbNodes;
   NodeContainer ueNodes;
   enbNodes.Create (1);
-  ueNodes.Create (1);
+  ueNodes.Create (numUes);
 
   Ptr < Building > building;
   building = Create<Building> ();
@@ -86,8 +98,11 @@ main (int argc, char *argv[])
   MobilityHelper uemobility;
   uemobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
   uemobility.Install (ueNodes);
-  ueNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (60, -20, 0));
-  ueNodes.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (0, 100, 0));
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      ueNodes.Get (i)->GetObject<MobilityModel> ()->SetPosition (Vector (60 + i, -20, 0));
+      ueNodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (0, 100, 0));
+    }
 
   BuildingsHelper::Install (ueNodes);
 
@@ -103,7 +118,15 @@ main (int argc, char *argv[])
   EpsBearer bearer (q);
   ptr_mmWave->ActivateDataRadioBearer (ueNetDev, bearer);
 
-  Simulator::Stop (Seconds (1));
+  // the codebooks are imported when the devices are initialized, at the
+  // beginning of the simulation
+  Simulator::Stop (Seconds (0));
+  Simulator::Run ();
+  double setupTime = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+  std::cout << "setup time: " << setupTime << " s, codebooks: " << FileBeamformingCodebook::GetNumRegisteredCodebooks ()
+            << ", codewords memory: " << FileBeamformingCodebook::GetRegisteredCodewordsSize () / 1024.0 << " kB" << std::endl;
+
+  Simulator::Stop (Seconds (simTime));
   Simulator::Run ();
   Simulator::Destroy ();
   return 0;
@@ -0,0 +1,685 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/mmwave-mac-scheduler.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/lte-common.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+
+using namespace ns3;
+using namespace mmwave;
+
+/*
+ * This example measures the processing cost of a MmWaveMacScheduler without
+ * the PHY, the channel and the EPC. The scheduler is instantiated from its
+ * TypeId and driven through its CSCHED and SCHED SAPs by synthetic UEs, as
+ * the eNB MAC would do:
+ * - each UE has a number of logical channels, with Poisson packet arrivals
+ *   in DL and UL, reported through SchedDlRlcBufferReq and periodic BSRs;
+ * - the wideband DL CQIs are reported periodically and follow a random walk,
+ *   while a PUSCH UL CQI is reported for every UL allocation;
+ * - the HARQ feedback of every allocation is reported a few slots later,
+ *   with a NACK probability given by the target BLER.
+ * The allocations drain the synthetic RLC queues, and the buffers are
+ * reported again after each transmission.
+ * The example runs every combination of the given numbers of UEs and of
+ * logical channels per UE, and reports the percentiles of the processing
+ * time of SchedTriggerReq, the number of allocations per second of
+ * processing time, and the traffic served in the simulated time.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveMacSchedulerBenchmark");
+
+/**
+ * The synthetic traffic and channel of a benchmark run
+ */
+struct BenchmarkParams
+{
+  std::string schedulerType;
+  bool harqEnabled;
+  uint32_t numSlots; // number of measured slots
+  uint32_t numWarmupSlots; // number of slots run before the measurements
+  double dlArrivalRate; // packets per second of each DL logical channel
+  double ulArrivalRate; // packets per second of each UL logical channel
+  uint32_t packetSize; // in bytes
+  uint32_t cqiPeriod; // DL CQI period, in slots
+  uint32_t bsrPeriod; // BSR period, in slots
+  uint32_t feedbackDelay; // delay of the HARQ feedback and of the UL CQIs, in slots
+  double bler; // probability of a NACK
+  uint8_t minCqi;
+  uint8_t maxCqi;
+};
+
+/**
+ * A packet queued in a synthetic RLC buffer
+ */
+struct BenchmarkPacket
+{
+  uint32_t size; // remaining bytes
+  Time arrival;
+};
+
+/**
+ * A synthetic logical channel
+ */
+struct BenchmarkLc
+{
+  uint8_t lcid;
+  uint8_t lcg;
+  std::deque<BenchmarkPacket> dlQueue;
+  uint32_t dlQueueSize;
+  Time nextDlArrival;
+  Time nextUlArrival;
+};
+
+/**
+ * A synthetic UE
+ */
+struct BenchmarkUe
+{
+  uint16_t rnti;
+  uint8_t cqi;
+  double ulSinr; // linear
+  std::vector<BenchmarkLc> lcs;
+  std::vector<uint32_t> ulBuffer; // per LCG
+};
+
+/**
+ * A report due in a later slot
+ */
+struct BenchmarkFeedback
+{
+  uint32_t slot;
+  std::vector<DlHarqInfo> dlHarq;
+  std::vector<UlHarqInfo> ulHarq;
+  std::vector<MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters> ulCqi;
+};
+
+class MacSchedulerBenchmark;
+
+/**
+ * SCHED SAP user which forwards the allocations to the benchmark
+ */
+class BenchmarkSchedSapUser : public MmWaveMacSchedSapUser
+{
+public:
+  BenchmarkSchedSapUser (MacSchedulerBenchmark *benchmark) : m_benchmark (benchmark) {}
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params);
+private:
+  MacSchedulerBenchmark *m_benchmark;
+};
+
+/**
+ * CSCHED SAP user which ignores the confirmations of the scheduler
+ */
+class BenchmarkCschedSapUser : public MmWaveMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params) {}
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params) {}
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params) {}
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params) {}
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params) {}
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params) {}
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params) {}
+};
+
+/**
+ * Drives a scheduler with a synthetic UE population, one slot at a time
+ */
+class MacSchedulerBenchmark
+{
+public:
+  MacSchedulerBenchmark (const BenchmarkParams &params, uint32_t numUes, uint32_t numLcs);
+  ~MacSchedulerBenchmark ();
+
+  /**
+   * Run the slots and print a line of results
+   */
+  void Run (void);
+
+  /**
+   * Store the allocation of the slot being scheduled
+   */
+  void ReceiveAllocation (const SlotAllocInfo &slotAllocInfo);
+
+  /**
+   * Print the header of the lines of results
+   */
+  static void PrintHeader (void);
+
+private:
+  void DoSlot (void);
+  void GenerateTraffic (void);
+  void ReportDlBuffer (BenchmarkLc &lc, uint16_t rnti);
+  void ReportBsrs (void);
+  void ReportDlCqis (void);
+  void ProcessAllocation (void);
+  BenchmarkFeedback &GetFeedback (uint32_t slot);
+
+  BenchmarkParams m_params;
+  uint32_t m_numLcs;
+  Ptr<MmWavePhyMacCommon> m_config;
+  Ptr<MmWaveMacScheduler> m_scheduler;
+  BenchmarkSchedSapUser m_schedSapUser;
+  BenchmarkCschedSapUser m_cschedSapUser;
+  MmWaveMacSchedSapProvider *m_sched;
+  MmWaveMacCschedSapProvider *m_csched;
+
+  std::vector<BenchmarkUe> m_ues;
+  std::deque<BenchmarkFeedback> m_feedback; // sorted by slot
+  uint32_t m_slot;
+  SlotAllocInfo m_slotAllocInfo;
+
+  Ptr<ExponentialRandomVariable> m_dlInterArrival;
+  Ptr<ExponentialRandomVariable> m_ulInterArrival;
+  Ptr<UniformRandomVariable> m_uniform;
+
+  std::vector<double> m_triggerTimes; // processing time of each measured SchedTriggerReq, in seconds
+  double m_reportTime; // processing time of the other SAP calls of the measured slots, in seconds
+  uint64_t m_numAllocations;
+  uint64_t m_numRetx;
+  uint64_t m_dlBytes;
+  uint64_t m_ulBytes;
+};
+
+void
+BenchmarkSchedSapUser::SchedConfigInd (const struct SchedConfigIndParameters& params)
+{
+  m_benchmark->ReceiveAllocation (params.m_slotAllocInfo);
+}
+
+MacSchedulerBenchmark::MacSchedulerBenchmark (const BenchmarkParams &params, uint32_t numUes, uint32_t numLcs)
+  : m_params (params),
+    m_numLcs (numLcs),
+    m_schedSapUser (this),
+    m_slot (0),
+    m_reportTime (0),
+    m_numAllocations (0),
+    m_numRetx (0),
+    m_dlBytes (0),
+    m_ulBytes (0)
+{
+  m_config = CreateObject<MmWavePhyMacCommon> ();
+  m_config->SetNumReferenceSymbols (1);
+
+  ObjectFactory factory;
+  factory.SetTypeId (params.schedulerType);
+  factory.Set ("HarqEnabled", BooleanValue (params.harqEnabled));
+  m_scheduler = factory.Create<MmWaveMacScheduler> ();
+  m_scheduler->SetMacSchedSapUser (&m_schedSapUser);
+  m_scheduler->SetMacCschedSapUser (&m_cschedSapUser);
+  m_scheduler->ConfigureCommonParameters (m_config);
+  m_sched = m_scheduler->GetMacSchedSapProvider ();
+  m_csched = m_scheduler->GetMacCschedSapProvider ();
+
+  m_dlInterArrival = CreateObject<ExponentialRandomVariable> ();
+  m_dlInterArrival->SetAttribute ("Mean", DoubleValue (params.dlArrivalRate > 0 ? 1 / params.dlArrivalRate : 0));
+  m_ulInterArrival = CreateObject<ExponentialRandomVariable> ();
+  m_ulInterArrival->SetAttribute ("Mean", DoubleValue (params.ulArrivalRate > 0 ? 1 / params.ulArrivalRate : 0));
+  m_uniform = CreateObject<UniformRandomVariable> ();
+
+  for (uint16_t rnti = 1; rnti <= numUes; rnti++)
+    {
+      BenchmarkUe ue;
+      ue.rnti = rnti;
+      ue.cqi = m_uniform->GetInteger (params.minCqi, params.maxCqi);
+      ue.ulSinr = std::pow (10.0, m_uniform->GetValue (0.0, 25.0) / 10);
+      ue.ulBuffer.resize (4, 0);
+
+      MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueParams;
+      ueParams.m_rnti = rnti;
+      ueParams.m_transmissionMode = 0;
+      m_csched->CschedUeConfigReq (ueParams);
+
+      // the data radio bearers use the LCIDs from 3, and the LCGs from 1 to 3
+      MmWaveMacCschedSapProvider::CschedLcConfigReqParameters lcParams;
+      lcParams.m_rnti = rnti;
+      lcParams.m_reconfigureFlag = false;
+      for (uint32_t i = 0; i < numLcs; i++)
+        {
+          BenchmarkLc lc;
+          lc.lcid = 3 + i;
+          lc.lcg = 1 + i % 3;
+          lc.dlQueueSize = 0;
+          lc.nextDlArrival = params.dlArrivalRate > 0 ? Seconds (m_dlInterArrival->GetValue ()) : Time::Max ();
+          lc.nextUlArrival = params.ulArrivalRate > 0 ? Seconds (m_ulInterArrival->GetValue ()) : Time::Max ();
+          ue.lcs.push_back (lc);
+
+          LogicalChannelConfigListElement_s lcConfig;
+          lcConfig.m_logicalChannelIdentity = lc.lcid;
+          lcConfig.m_logicalChannelGroup = lc.lcg;
+          lcConfig.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+          lcConfig.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+          lcConfig.m_qci = 9;
+          lcConfig.m_eRabMaximulBitrateUl = 0;
+          lcConfig.m_eRabMaximulBitrateDl = 0;
+          lcConfig.m_eRabGuaranteedBitrateUl = 0;
+          lcConfig.m_eRabGuaranteedBitrateDl = 0;
+          lcParams.m_logicalChannelConfigList.push_back (lcConfig);
+        }
+      m_csched->CschedLcConfigReq (lcParams);
+      m_ues.push_back (ue);
+    }
+}
+
+MacSchedulerBenchmark::~MacSchedulerBenchmark ()
+{
+  m_scheduler->Dispose ();
+}
+
+void
+MacSchedulerBenchmark::ReceiveAllocation (const SlotAllocInfo &slotAllocInfo)
+{
+  m_slotAllocInfo = slotAllocInfo;
+}
+
+BenchmarkFeedback &
+MacSchedulerBenchmark::GetFeedback (uint32_t slot)
+{
+  std::deque<BenchmarkFeedback>::iterator it = m_feedback.begin ();
+  while (it != m_feedback.end () && it->slot < slot)
+    {
+      ++it;
+    }
+  if (it == m_feedback.end () || it->slot != slot)
+    {
+      BenchmarkFeedback feedback;
+      feedback.slot = slot;
+      it = m_feedback.insert (it, feedback);
+    }
+  return *it;
+}
+
+void
+MacSchedulerBenchmark::ReportDlBuffer (BenchmarkLc &lc, uint16_t rnti)
+{
+  // same report as LteRlcUmLowLat
+  MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+  params.m_rnti = rnti;
+  params.m_logicalChannelIdentity = lc.lcid;
+  params.m_rlcTransmissionQueueSize = lc.dlQueueSize > 0 ? lc.dlQueueSize + 2 * lc.dlQueue.size () : 0;
+  params.m_rlcTransmissionQueueHolDelay = lc.dlQueue.empty () ? 0 : (Simulator::Now () - lc.dlQueue.front ().arrival).GetMicroSeconds ();
+  params.m_rlcRetransmissionQueueSize = 0;
+  params.m_rlcRetransmissionHolDelay = 0;
+  params.m_rlcStatusPduSize = 0;
+  for (unsigned i = 0; i < lc.dlQueue.size () && i < 20; i++)
+    {
+      params.m_txPacketSizes.push_back (lc.dlQueue[i].size);
+      params.m_txPacketDelays.push_back ((Simulator::Now () - lc.dlQueue[i].arrival).GetMicroSeconds ());
+    }
+  params.m_arrivalRate = m_params.dlArrivalRate * m_params.packetSize;
+  m_sched->SchedDlRlcBufferReq (params);
+}
+
+void
+MacSchedulerBenchmark::GenerateTraffic (void)
+{
+  Time now = Simulator::Now ();
+  for (std::vector<BenchmarkUe>::iterator ue = m_ues.begin (); ue != m_ues.end (); ++ue)
+    {
+      for (std::vector<BenchmarkLc>::iterator lc = ue->lcs.begin (); lc != ue->lcs.end (); ++lc)
+        {
+          bool newDlPacket = false;
+          while (lc->nextDlArrival <= now)
+            {
+              BenchmarkPacket packet;
+              packet.size = m_params.packetSize;
+              packet.arrival = lc->nextDlArrival;
+              lc->dlQueue.push_back (packet);
+              lc->dlQueueSize += packet.size;
+              lc->nextDlArrival += Seconds (m_dlInterArrival->GetValue ());
+              newDlPacket = true;
+            }
+          if (newDlPacket)
+            {
+              ReportDlBuffer (*lc, ue->rnti);
+            }
+          while (lc->nextUlArrival <= now)
+            {
+              ue->ulBuffer[lc->lcg] += m_params.packetSize;
+              lc->nextUlArrival += Seconds (m_ulInterArrival->GetValue ());
+            }
+        }
+    }
+}
+
+void
+MacSchedulerBenchmark::ReportBsrs (void)
+{
+  MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters params;
+  params.m_sfnSf = m_slotAllocInfo.m_sfnSf;
+  for (std::vector<BenchmarkUe>::iterator ue = m_ues.begin (); ue != m_ues.end (); ++ue)
+    {
+      MacCeElement bsr;
+      bsr.m_rnti = ue->rnti;
+      bsr.m_macCeType = MacCeElement::BSR;
+      for (uint8_t lcg = 0; lcg < 4; lcg++)
+        {
+          bsr.m_macCeValue.m_bufferStatus.push_back (BufferSizeLevelBsr::BufferSize2BsrId (ue->ulBuffer[lcg]));
+        }
+      params.m_macCeList.push_back (bsr);
+    }
+  m_sched->SchedUlMacCtrlInfoReq (params);
+}
+
+void
+MacSchedulerBenchmark::ReportDlCqis (void)
+{
+  MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters params;
+  for (std::vector<BenchmarkUe>::iterator ue = m_ues.begin (); ue != m_ues.end (); ++ue)
+    {
+      // random walk within the CQI range
+      int step = m_uniform->GetInteger (0, 2) - 1;
+      ue->cqi = std::min<int> (m_params.maxCqi, std::max<int> (m_params.minCqi, ue->cqi + step));
+
+      DlCqiInfo cqi;
+      cqi.m_rnti = ue->rnti;
+      cqi.m_ri = 1;
+      cqi.m_cqiType = DlCqiInfo::WB;
+      cqi.m_wbCqi = ue->cqi;
+      params.m_cqiList.push_back (cqi);
+    }
+  m_sched->SchedDlCqiInfoReq (params);
+}
+
+void
+MacSchedulerBenchmark::ProcessAllocation (void)
+{
+  for (std::deque<TtiAllocInfo>::const_iterator tti = m_slotAllocInfo.m_ttiAllocInfo.begin ();
+       tti != m_slotAllocInfo.m_ttiAllocInfo.end (); ++tti)
+    {
+      if (tti->m_ttiType == TtiAllocInfo::CTRL || tti->m_rnti == 0 || tti->m_rnti > m_ues.size ())
+        {
+          continue;
+        }
+      BenchmarkUe &ue = m_ues[tti->m_rnti - 1];
+      const DciInfoElementTdma &dci = tti->m_dci;
+      bool nack = m_params.harqEnabled && m_uniform->GetValue () < m_params.bler;
+      m_numAllocations++;
+      m_numRetx += (dci.m_rv > 0);
+      BenchmarkFeedback &feedback = GetFeedback (m_slot + m_params.feedbackDelay);
+
+      if (tti->m_tddMode == TtiAllocInfo::DL_slotAllocInfo)
+        {
+          if (dci.m_rv == 0)
+            {
+              // the RLC fills the PDUs, without the MAC subheader
+              for (std::vector<RlcPduInfo>::const_iterator pdu = tti->m_rlcPduInfo.begin (); pdu != tti->m_rlcPduInfo.end (); ++pdu)
+                {
+                  for (std::vector<BenchmarkLc>::iterator lc = ue.lcs.begin (); lc != ue.lcs.end (); ++lc)
+                    {
+                      if (lc->lcid != pdu->m_lcid)
+                        {
+                          continue;
+                        }
+                      uint32_t bytes = pdu->m_size > 4 ? pdu->m_size - 4 : 0;
+                      while (bytes > 2 && !lc->dlQueue.empty ())
+                        {
+                          uint32_t served = std::min (bytes - 2, lc->dlQueue.front ().size);
+                          lc->dlQueue.front ().size -= served;
+                          lc->dlQueueSize -= served;
+                          bytes -= served + 2;
+                          if (lc->dlQueue.front ().size == 0)
+                            {
+                              lc->dlQueue.pop_front ();
+                            }
+                        }
+                      ReportDlBuffer (*lc, ue.rnti);
+                    }
+                }
+            }
+          if (!nack)
+            {
+              m_dlBytes += dci.m_tbSize;
+            }
+          if (m_params.harqEnabled)
+            {
+              DlHarqInfo harqInfo;
+              harqInfo.m_rnti = ue.rnti;
+              harqInfo.m_harqProcessId = dci.m_harqProcess;
+              harqInfo.m_harqStatus = nack ? DlHarqInfo::NACK : DlHarqInfo::ACK;
+              harqInfo.m_numRetx = dci.m_rv;
+              feedback.dlHarq.push_back (harqInfo);
+            }
+        }
+      else
+        {
+          if (dci.m_rv == 0)
+            {
+              uint32_t bytes = dci.m_tbSize;
+              for (uint8_t lcg = 0; lcg < 4 && bytes > 0; lcg++)
+                {
+                  uint32_t served = std::min (bytes, ue.ulBuffer[lcg]);
+                  ue.ulBuffer[lcg] -= served;
+                  bytes -= served;
+                }
+            }
+          if (!nack)
+            {
+              m_ulBytes += dci.m_tbSize;
+            }
+          if (m_params.harqEnabled)
+            {
+              UlHarqInfo harqInfo;
+              harqInfo.m_rnti = ue.rnti;
+              harqInfo.m_harqProcessId = dci.m_harqProcess;
+              harqInfo.m_receptionStatus = nack ? UlHarqInfo::NotOk : UlHarqInfo::Ok;
+              harqInfo.m_numRetx = dci.m_rv;
+              feedback.ulHarq.push_back (harqInfo);
+            }
+
+          // the UL allocations are identified by their start symbol
+          MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+          ulCqi.m_sfnSf = m_slotAllocInfo.m_sfnSf;
+          ulCqi.m_sfnSf.m_symStart = dci.m_symStart;
+          ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+          ulCqi.m_ulCqi.m_sinr.assign (m_config->GetNumChunks (), ue.ulSinr);
+          feedback.ulCqi.push_back (ulCqi);
+        }
+    }
+}
+
+void
+MacSchedulerBenchmark::DoSlot (void)
+{
+  bool measure = m_slot >= m_params.numWarmupSlots;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+  GenerateTraffic ();
+  if (m_slot % m_params.bsrPeriod == 0)
+    {
+      ReportBsrs ();
+    }
+  if (m_slot % m_params.cqiPeriod == 0)
+    {
+      ReportDlCqis ();
+    }
+
+  MmWaveMacSchedSapProvider::SchedTriggerReqParameters params;
+  uint32_t slotsPerFrame = m_config->GetSubframesPerFrame () * m_config->GetSlotsPerSubframe ();
+  uint32_t slotInFrame = m_slot % slotsPerFrame;
+  params.m_snfSf = SfnSf ((m_slot / slotsPerFrame) % 1024, slotInFrame / m_config->GetSlotsPerSubframe (),
+                          slotInFrame % m_config->GetSlotsPerSubframe ());
+  if (!m_feedback.empty () && m_feedback.front ().slot == m_slot)
+    {
+      BenchmarkFeedback &feedback = m_feedback.front ();
+      for (unsigned i = 0; i < feedback.ulCqi.size (); i++)
+        {
+          m_sched->SchedUlCqiInfoReq (feedback.ulCqi[i]);
+        }
+      params.m_dlHarqInfoList.swap (feedback.dlHarq);
+      params.m_ulHarqInfoList.swap (feedback.ulHarq);
+      m_feedback.pop_front ();
+    }
+
+  std::chrono::steady_clock::time_point trigger = std::chrono::steady_clock::now ();
+  m_sched->SchedTriggerReq (params);
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+  ProcessAllocation ();
+
+  if (measure)
+    {
+      m_triggerTimes.push_back (std::chrono::duration<double> (end - trigger).count ());
+      m_reportTime += std::chrono::duration<double> (trigger - start).count ();
+    }
+  else
+    {
+      m_numAllocations = 0;
+      m_numRetx = 0;
+      m_dlBytes = 0;
+      m_ulBytes = 0;
+    }
+
+  m_slot++;
+  if (m_slot < m_params.numWarmupSlots + m_params.numSlots)
+    {
+      Simulator::Schedule (m_config->GetSlotPeriod (), &MacSchedulerBenchmark::DoSlot, this);
+    }
+}
+
+void
+MacSchedulerBenchmark::PrintHeader (void)
+{
+  std::cout << std::left << std::setw (6) << "UEs"
+            << std::setw (6) << "LCs"
+            << std::setw (10) << "p50[us]"
+            << std::setw (10) << "p90[us]"
+            << std::setw (10) << "p99[us]"
+            << std::setw (10) << "max[us]"
+            << std::setw (12) << "report[us]"
+            << std::setw (12) << "allocs/s"
+            << std::setw (10) << "allocs"
+            << std::setw (8) << "retx"
+            << std::setw (10) << "DL[Mbps]"
+            << std::setw (10) << "UL[Mbps]" << std::endl;
+}
+
+void
+MacSchedulerBenchmark::Run (void)
+{
+  Simulator::ScheduleNow (&MacSchedulerBenchmark::DoSlot, this);
+  Simulator::Run ();
+
+  std::vector<double> times = m_triggerTimes;
+  std::sort (times.begin (), times.end ());
+  double totalTime = 0;
+  for (unsigned i = 0; i < times.size (); i++)
+    {
+      totalTime += times[i];
+    }
+  // nearest-rank percentile, in microseconds
+  auto percentile = [&times] (double p)
+    {
+      uint32_t rank = std::ceil (p / 100 * times.size ());
+      return times[std::max<uint32_t> (rank, 1) - 1] * 1e6;
+    };
+  double simTime = m_params.numSlots * m_config->GetSlotPeriod ().GetSeconds ();
+
+  std::cout << std::left << std::setw (6) << m_ues.size ()
+            << std::setw (6) << m_numLcs
+            << std::setw (10) << percentile (50)
+            << std::setw (10) << percentile (90)
+            << std::setw (10) << percentile (99)
+            << std::setw (10) << times.back () * 1e6
+            << std::setw (12) << m_reportTime / times.size () * 1e6
+            << std::setw (12) << (totalTime > 0 ? m_numAllocations / totalTime : 0)
+            << std::setw (10) << m_numAllocations
+            << std::setw (8) << m_numRetx
+            << std::setw (10) << m_dlBytes * 8 / simTime / 1e6
+            << std::setw (10) << m_ulBytes * 8 / simTime / 1e6 << std::endl;
+
+  Simulator::Destroy ();
+}
+
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream stream (list);
+  std::string value;
+  while (std::getline (stream, value, ','))
+    {
+      values.push_back (std::stoul (value));
+    }
+  return values;
+}
+
+int
+main (int argc, char *argv[])
+{
+  BenchmarkParams params;
+  params.schedulerType = "ns3::MmWaveFlexTtiMacScheduler";
+  params.harqEnabled = true;
+  params.numSlots = 8000;
+  params.numWarmupSlots = 800;
+  params.dlArrivalRate = 1000;
+  params.ulArrivalRate = 200;
+  params.packetSize = 1400;
+  params.cqiPeriod = 8;
+  params.bsrPeriod = 8;
+  params.feedbackDelay = 4;
+  params.bler = 0.1;
+  uint32_t minCqi = 5;
+  uint32_t maxCqi = 15;
+  std::string numUesList = "1,4,16,64";
+  std::string numLcsList = "1,4";
+
+  CommandLine cmd;
+  cmd.AddValue ("scheduler", "TypeId of the scheduler", params.schedulerType);
+  cmd.AddValue ("harq", "Enable the HARQ", params.harqEnabled);
+  cmd.AddValue ("numSlots", "Number of measured slots", params.numSlots);
+  cmd.AddValue ("numWarmupSlots", "Number of slots run before the measurements", params.numWarmupSlots);
+  cmd.AddValue ("dlArrivalRate", "Packets per second of each DL logical channel", params.dlArrivalRate);
+  cmd.AddValue ("ulArrivalRate", "Packets per second of each UL logical channel", params.ulArrivalRate);
+  cmd.AddValue ("packetSize", "Size of the packets [bytes]", params.packetSize);
+  cmd.AddValue ("cqiPeriod", "Period of the DL CQI reports [slots]", params.cqiPeriod);
+  cmd.AddValue ("bsrPeriod", "Period of the BSRs [slots]", params.bsrPeriod);
+  cmd.AddValue ("feedbackDelay", "Delay of the HARQ feedback and of the UL CQIs [slots]", params.feedbackDelay);
+  cmd.AddValue ("bler", "Probability of a NACK", params.bler);
+  cmd.AddValue ("minCqi", "Minimum DL CQI", minCqi);
+  cmd.AddValue ("maxCqi", "Maximum DL CQI", maxCqi);
+  cmd.AddValue ("numUes", "Comma-separated numbers of UEs", numUesList);
+  cmd.AddValue ("numLcs", "Comma-separated numbers of logical channels per UE", numLcsList);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (params.cqiPeriod == 0 || params.bsrPeriod == 0 || params.feedbackDelay == 0, "The periods and delays must be positive");
+  NS_ABORT_MSG_IF (minCqi > maxCqi || maxCqi > 15, "Wrong CQI range");
+  params.minCqi = minCqi;
+  params.maxCqi = maxCqi;
+  std::vector<uint32_t> numUes = ParseList (numUesList);
+  std::vector<uint32_t> numLcs = ParseList (numLcsList);
+
+  std::cout << params.schedulerType << ", " << params.numSlots << " slots, HARQ " << (params.harqEnabled ? "on" : "off")
+            << ", BLER " << params.bler << std::endl;
+  MacSchedulerBenchmark::PrintHeader ();
+  for (unsigned i = 0; i < numUes.size (); i++)
+    {
+      for (unsigned j = 0; j < numLcs.size (); j++)
+        {
+          NS_ABORT_MSG_IF (numLcs[j] == 0 || numLcs[j] > 8, "The number of logical channels per UE must be between 1 and 8");
+          MacSchedulerBenchmark benchmark (params, numUes[i], numLcs[j]);
+          benchmark.Run ();
+        }
+    }
+  return 0;
+}
@@ -38,6 +38,7 @@
 #include "ns3/config-store.h"
 #include "ns3/mmwave-point-to-point-epc-helper.h"
 //#include "ns3/gtk-config-store.h"
+#include <chrono>
 
 using namespace ns3;
 using namespace mmwave;
@@ -59,6 +60,8 @@ main (int argc, char *argv[])
   double maxDistance = 150.0; // eNB-UE distance in meters
   bool harqEnabled = true;
   bool rlcAmEnabled = false;
+  bool idleSlotFastForward = false;
+  bool printRunStats = false;
 
   // Command line arguments
   CommandLine cmd;
@@ -68,10 +71,13 @@ main (int argc, char *argv[])
   cmd.AddValue ("interPacketInterval", "Inter-packet interval [us])", interPacketInterval);
   cmd.AddValue ("harq", "Enable Hybrid ARQ", harqEnabled);
   cmd.AddValue ("rlcAm", "Enable RLC-AM", rlcAmEnabled);
+  cmd.AddValue ("idleSlotFastForward", "Fast-forward the idle control TTIs in the PHY", idleSlotFastForward);
+  cmd.AddValue ("printRunStats", "Print the number of events and the wall-clock time of the run", printRunStats);
   cmd.Parse (argc, argv);
 
   Config::SetDefault ("ns3::MmWaveHelper::RlcAmEnabled", BooleanValue (rlcAmEnabled));
   Config::SetDefault ("ns3::MmWaveHelper::HarqEnabled", BooleanValue (harqEnabled));
+  Config::SetDefault ("ns3::MmWavePhy::IdleSlotFastForward", BooleanValue (idleSlotFastForward));
   Config::SetDefault ("ns3::MmWaveFlexTtiMacScheduler::HarqEnabled", BooleanValue (harqEnabled));
   Config::SetDefault ("ns3::LteRlcAm::ReportBufferStatusTimer", TimeValue (MicroSeconds (100.0)));
   Config::SetDefault ("ns3::LteRlcUmLowLat::ReportBufferStatusTimer", TimeValue (MicroSeconds (100.0)));
@@ -205,7 +211,13 @@ main (int argc, char *argv[])
   p2ph.EnablePcapAll ("mmwave-epc-simple");
 
   Simulator::Stop (Seconds (simTime));
+  auto start = std::chrono::steady_clock::now ();
   Simulator::Run ();
+  double wallTime = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+  if (printRunStats)
+    {
+      std::cout << "events: " << Simulator::GetEventCount () << ", wall-clock time: " << wallTime << " s" << std::endl;
+    }
 
   /*GtkConfigStore config;
   config.ConfigureAttributes();*/
@@ -66,6 +66,7 @@
 #include <ns3/mmwave-beamforming-model.h>
 #include <ns3/uniform-planar-array.h>
 #include <ns3/file-beamforming-codebook.h>
+#include <ns3/mmwave-spectrum-transmit-filter.h>
 
 
 namespace ns3 {
@@ -82,6 +83,8 @@ MmWaveHelper::MmWaveHelper (void)
     m_cellIdCounter (1),
     m_harqEnabled (false),
     m_rlcAmEnabled (false),
+    m_transmitFilterEnabled (true),
+    m_sharedChannelRealization (false),
     m_snrTest (false),
     m_useIdealRrc (false)
 {
@@ -150,6 +153,23 @@ MmWaveHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&MmWaveHelper::m_harqEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("TransmitFilterEnabled",
+                   "If true, the mmWave channels discard the BS to BS and UE to UE "
+                   "signals before computing the propagation loss",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveHelper::m_transmitFilterEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SharedChannelRealization",
+                   "If true, the component carriers share the channel condition model "
+                   "and the channel model of the ThreeGppSpectrumPropagationLossModel, "
+                   "hence the LOS condition, the large scale parameters and the clusters "
+                   "of each link are generated once, at the center frequency of the first "
+                   "carrier, while the path loss and the Doppler are evaluated at the "
+                   "center frequency of each carrier. The carriers must use the same "
+                   "antenna configuration",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveHelper::m_sharedChannelRealization),
+                   MakeBooleanChecker ())
     .AddAttribute ("RlcAmEnabled",
                    "Enable RLC Acknowledged Mode",
                    BooleanValue (false),
@@ -338,6 +358,10 @@ MmWaveHelper::MmWaveChannelModelInitialization (void)
 {
   NS_LOG_FUNCTION (this);
   // setup of mmWave channel & related
+  // the models shared by the CCs, if m_sharedChannelRealization is true
+  Ptr<ChannelConditionModel> sharedCcm;
+  Ptr<MatrixBasedChannelModel> sharedChannelModel;
+
   //create a channel for each CC
   for (std::map<uint8_t, MmWaveComponentCarrier >::iterator it = m_componentCarrierPhyParams.begin (); it != m_componentCarrierPhyParams.end (); ++it)
     {
@@ -345,8 +369,8 @@ MmWaveHelper::MmWaveChannelModelInitialization (void)
       Ptr<MmWavePhyMacCommon> phyMacCommon = m_componentCarrierPhyParams.at (it->first).GetConfigurationParameters ();
 
       // create the channel condition model (if needed)
-      Ptr<ChannelConditionModel> ccm;
-      if (!m_channelConditionModelType.empty ())
+      Ptr<ChannelConditionModel> ccm = sharedCcm;
+      if (!ccm && !m_channelConditionModelType.empty ())
       {
         ccm = m_channelConditionModelFactory.Create<ChannelConditionModel> ();
       }
@@ -386,7 +410,17 @@ MmWaveHelper::MmWaveChannelModelInitialization (void)
           // need a special configuration procedure, otherwise, for the other 
           // models, we try to configure the frequency
           Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (splm);
-          if (threeGppSplm)
+          if (threeGppSplm && sharedChannelModel)
+            {
+              // reuse the realizations of the first CC, and evaluate only the
+              // frequency-dependent terms at the frequency of this CC. The
+              // antennas of every CC are created by the same factories, hence
+              // they have the geometry the shared channel coefficients were
+              // computed for, as checked by ThreeGppChannelModel
+              threeGppSplm->SetChannelModel (sharedChannelModel);
+              threeGppSplm->SetAttribute ("Frequency", DoubleValue (phyMacCommon->GetCenterFrequency ()));
+            }
+          else if (threeGppSplm)
             {
               threeGppSplm->SetChannelModelAttribute ("Frequency", DoubleValue (phyMacCommon->GetCenterFrequency ()));
               
@@ -407,6 +441,12 @@ MmWaveHelper::MmWaveChannelModelInitialization (void)
               {
                 NS_LOG_DEBUG ("ChannelConditionModel not set for ThreeGppSpectrumPropagationLossModel");
               }
+
+              if (m_sharedChannelRealization)
+                {
+                  sharedChannelModel = threeGppSplm->GetChannelModel ();
+                  threeGppSplm->SetAttribute ("Frequency", DoubleValue (phyMacCommon->GetCenterFrequency ()));
+                }
             }
           else 
             {
@@ -421,6 +461,19 @@ MmWaveHelper::MmWaveChannelModelInitialization (void)
           NS_LOG_WARN (this << " No SpectrumPropagationLossModel!");
         }
 
+      // filter out the BS to BS and UE to UE signals before computing the
+      // propagation loss, since they are anyway neglected by the receiver
+      if (m_transmitFilterEnabled)
+        {
+          channel->AddSpectrumTransmitFilter (CreateObject<MmWaveSpectrumTransmitFilter> ());
+        }
+
+      if (m_sharedChannelRealization)
+        {
+          NS_ABORT_MSG_IF (!sharedChannelModel, "SharedChannelRealization requires the ThreeGppSpectrumPropagationLossModel");
+          sharedCcm = ccm;
+        }
+
       m_channel [it->first] = channel;
     }    //end for
 }
@@ -526,6 +579,14 @@ MmWaveHelper::SetPathlossModelType (std::string type)
     }
 }
 
+Ptr<SpectrumChannel>
+MmWaveHelper::GetChannel (uint8_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT_MSG (m_channel.find (index) != m_channel.end (), "Unable to find the requested channel");
+  return m_channel.at (index);
+}
+
 Ptr<PropagationLossModel>
 MmWaveHelper::GetPathLossModel (uint8_t index)
 {
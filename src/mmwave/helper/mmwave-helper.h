@@ -266,6 +266,12 @@ public:
   bool GetSnrTest ();
   Ptr<PropagationLossModel> GetPathLossModel (uint8_t index);
 
+  /**
+   * \param index the index of the component carrier
+   * \return the mmWave channel of the component carrier
+   */
+  Ptr<SpectrumChannel> GetChannel (uint8_t index);
+
   /**
   * Set the type of FFR algorithm to be used by LTE eNodeB devices.
   *
@@ -457,6 +463,8 @@ private:
 
   bool m_harqEnabled;
   bool m_rlcAmEnabled;
+  bool m_transmitFilterEnabled;       // if true, a MmWaveSpectrumTransmitFilter is added to each mmWave channel
+  bool m_sharedChannelRealization;       // if true, the mmWave channels of the CCs share the channel condition model and the channel model
   bool m_snrTest;
   bool m_useIdealRrc;       // Initialized as true in the constructor
 
@@ -41,9 +41,84 @@ public:
   static TypeId GetTypeId (void);
 
   /**
-   *
+   * Read-only view of a codeword stored by a codebook. It does not copy the
+   * codeword, and it is valid as long as the codebook exists.
+   */
+  class CodewordView
+  {
+  public:
+    /**
+     * Constructor
+     * \param data pointer to the first element of the codeword
+     * \param size the number of elements of the codeword
+     */
+    CodewordView (const std::complex<double> *data, std::size_t size)
+      : m_data (data),
+        m_size (size)
+    {
+    }
+
+    /**
+     * \return the number of elements of the codeword
+     */
+    std::size_t size () const
+    {
+      return m_size;
+    }
+
+    /**
+     * \param i the element index
+     * \return the weight of the element i
+     */
+    const std::complex<double>& operator[] (std::size_t i) const
+    {
+      return m_data[i];
+    }
+
+    /**
+     * \return pointer to the first element of the codeword
+     */
+    const std::complex<double>* data () const
+    {
+      return m_data;
+    }
+
+    /**
+     * \return iterator to the first element of the codeword
+     */
+    const std::complex<double>* begin () const
+    {
+      return m_data;
+    }
+
+    /**
+     * \return iterator past the last element of the codeword
+     */
+    const std::complex<double>* end () const
+    {
+      return m_data + m_size;
+    }
+
+    /**
+     * Copies the codeword, e.g., to set it as beamforming vector
+     * \return a copy of the codeword
+     */
+    operator PhasedArrayModel::ComplexVector () const
+    {
+      return PhasedArrayModel::ComplexVector (begin (), end ());
+    }
+
+  private:
+    const std::complex<double> *m_data; //!< the first element of the codeword
+    std::size_t m_size; //!< the number of elements of the codeword
+  };
+
+  /**
+   * Returns a view of a codeword
+   * \param idx the codeword index
+   * \return the view of the codeword
    */
-  virtual PhasedArrayModel::ComplexVector GetCodeword (uint32_t idx) const = 0;
+  virtual CodewordView GetCodeword (uint32_t idx) const = 0;
 
   /**
    *
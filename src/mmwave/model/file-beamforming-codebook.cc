@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 
 namespace ns3 {
 
@@ -62,21 +63,114 @@ FileBeamformingCodebook::FileBeamformingCodebook ()
 void
 FileBeamformingCodebook::DoInitialize (void)
 {
-  ImportCodebookFromFile ();
+  NS_ABORT_MSG_IF (m_array == 0, "Array was not set");
+  m_registryKey = GetRegistryKey ();
+  std::map<std::string, Ptr<const Codewords> > &registry = GetRegistry ();
+  auto it = registry.find (m_registryKey);
+  if (it != registry.end ())
+    {
+      NS_LOG_LOGIC ("Codebook " << m_codebookFilename << " already imported");
+      m_codewords = it->second;
+    }
+  else
+    {
+      m_codewords = ImportCodebookFromFile ();
+      registry.emplace (m_registryKey, m_codewords);
+    }
   BeamformingCodebook::DoInitialize ();
 }
 
 
 FileBeamformingCodebook::~FileBeamformingCodebook ()
 {
+  ReleaseCodewords ();
 }
 
 
-PhasedArrayModel::ComplexVector
+void
+FileBeamformingCodebook::DoDispose (void)
+{
+  ReleaseCodewords ();
+  BeamformingCodebook::DoDispose ();
+}
+
+
+void
+FileBeamformingCodebook::ReleaseCodewords (void)
+{
+  if (m_codewords == 0)
+    {
+      return;
+    }
+  m_codewords = 0;
+
+  // the registry holds the last reference
+  std::map<std::string, Ptr<const Codewords> > &registry = GetRegistry ();
+  auto it = registry.find (m_registryKey);
+  if (it != registry.end () && it->second->GetReferenceCount () == 1)
+    {
+      NS_LOG_LOGIC ("Codebook " << m_codebookFilename << " not used anymore");
+      registry.erase (it);
+    }
+}
+
+
+std::map<std::string, Ptr<const FileBeamformingCodebook::Codewords> >&
+FileBeamformingCodebook::GetRegistry (void)
+{
+  static std::map<std::string, Ptr<const Codewords> > registry;
+  return registry;
+}
+
+
+std::string
+FileBeamformingCodebook::GetRegistryKey (void) const
+{
+  // the same attributes checked by ValidateAntenna
+  std::ostringstream key;
+  key << m_codebookFilename << "," << m_array->GetInstanceTypeId ().GetName ();
+  if (m_array->GetInstanceTypeId () == UniformPlanarArray::GetTypeId ())
+    {
+      UintegerValue numRows;
+      UintegerValue numColumns;
+      DoubleValue hSpacing;
+      DoubleValue vSpacing;
+      m_array->GetAttribute ("NumRows", numRows);
+      m_array->GetAttribute ("NumColumns", numColumns);
+      m_array->GetAttribute ("AntennaHorizontalSpacing", hSpacing);
+      m_array->GetAttribute ("AntennaVerticalSpacing", vSpacing);
+      key << "," << numRows.Get () << "x" << numColumns.Get ()
+          << std::setprecision (17) << "," << hSpacing.Get () << "," << vSpacing.Get ();
+    }
+  return key.str ();
+}
+
+
+std::size_t
+FileBeamformingCodebook::GetNumRegisteredCodebooks (void)
+{
+  return GetRegistry ().size ();
+}
+
+
+std::size_t
+FileBeamformingCodebook::GetRegisteredCodewordsSize (void)
+{
+  std::size_t size = 0;
+  for (const auto &entry : GetRegistry ())
+    {
+      size += entry.second->m_values.size () * sizeof (std::complex<double>);
+    }
+  return size;
+}
+
+
+BeamformingCodebook::CodewordView
 FileBeamformingCodebook::GetCodeword (uint32_t idx) const
 {
   NS_LOG_FUNCTION (this << idx);
-  return m_codewords[idx];
+  NS_ASSERT (idx < m_codewords->m_codebookSize);
+  return CodewordView (m_codewords->m_values.data () + idx * m_codewords->m_codewordSize, m_codewords->m_codewordSize);
 }
 
 
@@ -84,12 +178,12 @@ uint32_t
 FileBeamformingCodebook::GetCodebookSize (void) const
 {
   NS_LOG_FUNCTION (this);
-  return m_codewords.size ();
+  return m_codewords->m_codebookSize;
 }
 
 
-void
-FileBeamformingCodebook::ImportCodebookFromFile (void)
+Ptr<FileBeamformingCodebook::Codewords>
+FileBeamformingCodebook::ImportCodebookFromFile (void) const
 {
   NS_LOG_FUNCTION (this);
 
@@ -106,8 +200,6 @@ FileBeamformingCodebook::ImportCodebookFromFile (void)
   NS_ABORT_MSG_IF (tmp <= 0, "Codebook size must be strictly positive");
   uint32_t cbSize = uint32_t (tmp);
 
-  m_codewords.reserve (cbSize); // allocate memory
-
   // read codewords size
   std::getline (cbFile, line);
   tmp = atoi (line.c_str ());
@@ -116,16 +208,22 @@ FileBeamformingCodebook::ImportCodebookFromFile (void)
 
   NS_LOG_DEBUG ("A codeword with " << cbSize << " codewords of size " << cwSize);
 
+  Ptr<Codewords> codewords = Create<Codewords> ();
+  codewords->m_codewordSize = cwSize;
+  codewords->m_values.reserve (cbSize * cwSize); // allocate memory
+
   while (std::getline (cbFile, line))
     {
       // lines with CSV for each codeword
       PhasedArrayModel::ComplexVector cw = ParseCodeword (line, cwSize);
-      m_codewords.push_back (cw);
+      codewords->m_values.insert (codewords->m_values.end (), cw.begin (), cw.end ());
+      codewords->m_codebookSize++;
     }
 
-  NS_ABORT_MSG_IF (m_codewords.size () != cbSize,
-                   "Codebook of unexpected size: m_codewords.size ()=" << m_codewords.size () << ", cbSize=" << cbSize);
+  NS_ABORT_MSG_IF (codewords->m_codebookSize != cbSize,
+                   "Codebook of unexpected size: " << codewords->m_codebookSize << " codewords, cbSize=" << cbSize);
   NS_LOG_LOGIC ("Codebook successfully imported from " << m_codebookFilename);
+  return codewords;
 }
 
 
@@ -36,6 +36,7 @@
 #include <ns3/double.h>
 #include <ns3/math.h>
 #include "ns3/enum.h"
+#include "ns3/boolean.h"
 #include "mmwave-mi-error-model.h"
 
 NS_LOG_COMPONENT_DEFINE ("MmWaveAmc");
@@ -109,12 +110,14 @@ static const int ModulationSchemeForMcs[32] = {
 };
 
 MmWaveAmc::MmWaveAmc ()
+  : m_binaryMcsSearch (true)
 {
   NS_LOG_ERROR ("This construcor should not be invoked");
 }
 
 MmWaveAmc::MmWaveAmc (Ptr<MmWavePhyMacCommon> ConfigParams)
-  : m_phyMacConfig (ConfigParams)
+  : m_binaryMcsSearch (true),
+    m_phyMacConfig (ConfigParams)
 {
   NS_LOG_INFO ("Initialze AMC module");
 }
@@ -141,6 +144,13 @@ MmWaveAmc::GetTypeId (void)
                    MakeEnumAccessor (&MmWaveAmc::m_amcModel),
                    MakeEnumChecker (MmWaveAmc::MiErrorModel, "Vienna",
                                     MmWaveAmc::PiroEW2010, "PiroEW2010"))
+    .AddAttribute ("BinaryMcsSearch",
+                   "If true, the MCS of the MI error model is found with a binary search "
+                   "over the MCSs, otherwise all the MCSs are tested in increasing order. "
+                   "Both select the same MCS.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveAmc::m_binaryMcsSearch),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -268,6 +278,11 @@ MmWaveAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
     }
   else if (m_amcModel == MiErrorModel)
     {
+      std::vector<uint32_t> tbSizes;
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          tbSizes.push_back (GetTbSizeFromMcs (mcs, rbgSize / 18) / 8);
+        }
       std::vector <int> rbgMap;
       int rbId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
@@ -275,26 +290,11 @@ MmWaveAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
           rbgMap.push_back (rbId++);
           if ((rbId % rbgSize == 0)||((it + 1) == sinr.ConstValuesEnd ()))
             {
-              uint8_t mcs = 0;
-              MmWaveTbStats_t tbStats;
-              while (mcs <= 28)
-                {
-                  MmWaveHarqProcessInfoList_t harqInfoList;
-                  tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, GetTbSizeFromMcs (mcs, rbgSize / 18) / 8, mcs, harqInfoList);
-                  if (tbStats.tbler > 0.1)
-                    {
-                      break;
-                    }
-                  mcs++;
-
-                }
-              if (mcs > 0)
-                {
-                  mcs--;
-                }
-              NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
+              double tbler;
+              uint8_t mcs = GetMcsFromMiErrorModel (sinr, rbgMap, tbSizes, tbler);
+              NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbler);
               int rbgCqi = 0;
-              if ((tbStats.tbler > 0.1)&&(mcs == 0))
+              if ((tbler > 0.1)&&(mcs == 0))
                 {
                   rbgCqi = 0;
                 }
@@ -368,31 +368,21 @@ MmWaveAmc::CreateCqiFeedbacksTdma (const SpectrumValue& sinr, uint8_t numSym)
     }
   else if (m_amcModel == MiErrorModel)
     {
+      std::vector<uint32_t> tbSizes;
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          tbSizes.push_back (GetTbSizeFromMcsSymbols (mcs, numSym) / 8);
+        }
       int chunkId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
-          uint8_t mcs = 0;
-          MmWaveTbStats_t tbStats;
           std::vector <int> chunkMap;
           chunkMap.push_back (chunkId++);
-          while (mcs <= 28)
-            {
-              MmWaveHarqProcessInfoList_t harqInfoList;
-              tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, GetTbSizeFromMcsSymbols (mcs, numSym) / 8, mcs, harqInfoList);
-              if (tbStats.tbler > 0.1)
-                {
-                  break;
-                }
-              mcs++;
-
-            }
-          if (mcs > 0)
-            {
-              mcs--;
-            }
-          NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
+          double tbler;
+          uint8_t mcs = GetMcsFromMiErrorModel (sinr, chunkMap, tbSizes, tbler);
+          NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << " TBLER " << tbler);
           int chunkCqi = 0;
-          if ((tbStats.tbler > 0.1)&&(mcs == 0))
+          if ((tbler > 0.1)&&(mcs == 0))
             {
               chunkCqi = 0;
             }
@@ -483,28 +473,15 @@ MmWaveAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, u
         }
       sinrAvg /= chunkId;
 
-      mcs = 0;
-      MmWaveTbStats_t tbStats;
-      while (mcs <= 28)
-        {
-          MmWaveHarqProcessInfoList_t harqInfoList;
-          tbStats = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList);
-          if (tbStats.tbler > 0.1)
-            {
-              break;
-            }
-          mcs++;
-        }
-      if (mcs > 0)
-        {
-          mcs--;
-        }
+      std::vector<uint32_t> tbSizes (29, tbSize);
+      double tbler;
+      mcs = GetMcsFromMiErrorModel (sinr, chunkMap, tbSizes, tbler);
 //		MmWaveHarqProcessInfoList_t harqInfoList;
 //		MmWaveTbStats_t tbStatsFinal = MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList);
 //		NS_LOG_UNCOND ("TBLER " << tbStatsFinal.tbler << " for chunks " << chunkMap.size () << " numSym "
 //		               << (unsigned)numSym << " tbSize " << tbSize << " mcs " << (unsigned)mcs << " sinr " << sinrAvg);
 //		NS_LOG_UNCOND (sinr);
-      if ((tbStats.tbler > 0.1)&&(mcs == 0))
+      if ((tbler > 0.1)&&(mcs == 0))
         {
           cqi = 0;
         }
@@ -526,6 +503,53 @@ MmWaveAmc::CreateCqiFeedbackWbTdma (const SpectrumValue& sinr, uint8_t numSym, u
   return cqi;
 }
 
+uint8_t
+MmWaveAmc::GetMcsFromMiErrorModel (const SpectrumValue& sinr, const std::vector<int>& map,
+                                   const std::vector<uint32_t>& tbSizes, double &tbler)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (tbSizes.size () == 29);
+
+  // the MCSs of each modulation, which share the same mmib
+  const uint8_t modulationEnd[3] = {MMWAVE_MI_QPSK_MAX_ID + 1, MMWAVE_MI_16QAM_MAX_ID + 1, MMWAVE_MI_64QAM_MAX_ID + 1};
+  // the TB error rates of the MCSs tested
+  double mcsTbler[29];
+
+  // for a given mmib, the TB error rate increases with the MCS, but the mmib
+  // changes with the modulation, so the first MCS whose TB error rate exceeds
+  // 10% is searched in the MCSs of each modulation in turn
+  uint8_t low = 0;
+  uint8_t high = 29;
+  for (uint8_t mod = 0; mod < 3 && high == 29; mod++)
+    {
+      double mib = MmWaveMiErrorModel::Mib (sinr, map, low);
+      // the first MCS exceeding 10% is in [low, modHigh], where modHigh equal
+      // to the end of the modulation means that all its MCSs achieve 10%
+      uint8_t modHigh = modulationEnd[mod];
+      while (low < modHigh)
+        {
+          uint8_t mcs = m_binaryMcsSearch ? (low + modHigh) / 2 : low;
+          MmWaveHarqProcessInfoList_t harqInfoList;
+          mcsTbler[mcs] = MmWaveMiErrorModel::GetTbDecodificationStatsFromMi (mib, tbSizes[mcs], mcs, harqInfoList).tbler;
+          if (mcsTbler[mcs] > 0.1)
+            {
+              modHigh = mcs;
+            }
+          else
+            {
+              low = mcs + 1;
+            }
+        }
+      if (modHigh < modulationEnd[mod])
+        {
+          high = modHigh;
+        }
+    }
+  // both the first MCS exceeding 10% and MCS 28 have been tested
+  tbler = mcsTbler[std::min<uint8_t> (high, 28)];
+  return high > 0 ? high - 1 : 0;
+}
+
 int
 MmWaveAmc::GetCqiFromSpectralEfficiency (double s)
 {
@@ -63,8 +63,29 @@ public:
   static const unsigned int m_crcLen = 24;
 
 private:
+  /**
+   * \brief find, with the MI error model, the highest MCS whose TB error rate
+   * does not exceed 10%
+   *
+   * The mmib of the RBs is computed once per modulation. Since the TB error
+   * rate increases with the MCS for a given modulation, the first MCS
+   * exceeding 10% is found with a binary search over the MCSs of each
+   * modulation, unless m_binaryMcsSearch is false. Both searches select the
+   * same MCS as testing all the MCSs in increasing order.
+   *
+   * \param sinr the perceived sinrs in the whole bandwidth
+   * \param map the RBs of the TB
+   * \param tbSizes the size in bytes of the TB for each MCS in [0..28]
+   * \param tbler the TB error rate of the first MCS exceeding 10%, or of
+   *        MCS 28 if none does
+   * \return the MCS, 0 if no MCS achieves 10%
+   */
+  uint8_t GetMcsFromMiErrorModel (const SpectrumValue& sinr, const std::vector<int>& map,
+                                  const std::vector<uint32_t>& tbSizes, double &tbler);
+
   double m_ber;
   AmcModel m_amcModel;
+  bool m_binaryMcsSearch; //!< whether the MCS is found with a binary search
 
   Ptr<MmWavePhyMacCommon> m_phyMacConfig;
   Ptr<SpectrumModel> m_lteRbModel;
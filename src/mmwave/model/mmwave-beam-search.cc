@@ -0,0 +1,500 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-beam-search.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace ns3 {
+
+namespace mmwave {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveBeamSearch");
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveBeamSearch);
+
+TypeId
+MmWaveBeamSearch::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveBeamSearch")
+    .SetParent<Object> ()
+  ;
+  return tid;
+}
+
+MmWaveBeamSearch::MmWaveBeamSearch ()
+  : m_thisSize {0},
+    m_otherSize {0}
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveBeamSearch::~MmWaveBeamSearch ()
+{
+}
+
+void
+MmWaveBeamSearch::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_thisCodebook = 0;
+  m_otherCodebook = 0;
+  m_neighborsCache.clear ();
+  Object::DoDispose ();
+}
+
+uint32_t
+MmWaveBeamSearch::GetNumCandidates (void) const
+{
+  return 1;
+}
+
+uint32_t
+MmWaveBeamSearch::GetNumEvaluations (void) const
+{
+  return m_evaluated.size ();
+}
+
+std::vector<MmWaveBeamSearch::BeamPair>
+MmWaveBeamSearch::Search (Ptr<const BeamformingCodebook> thisCodebook,
+                          Ptr<const BeamformingCodebook> otherCodebook,
+                          const GainFunction &gainFunction,
+                          const std::vector<BeamPair> &previous)
+{
+  NS_LOG_FUNCTION (this << thisCodebook << otherCodebook << previous.size ());
+
+  m_thisCodebook = thisCodebook;
+  m_otherCodebook = otherCodebook;
+  m_thisSize = thisCodebook->GetCodebookSize ();
+  m_otherSize = otherCodebook->GetCodebookSize ();
+  NS_ASSERT_MSG (m_thisSize > 0 && m_otherSize > 0, "Empty codebook");
+
+  m_gainFunction = gainFunction;
+  m_gains.assign (m_thisSize * m_otherSize, std::numeric_limits<double>::quiet_NaN ());
+  m_evaluated.clear ();
+
+  // discard the previous pairs if they do not refer to these codebooks
+  std::vector<BeamPair> validPrevious;
+  for (const auto &pair : previous)
+    {
+      if (pair.thisCbIdx < m_thisSize && pair.otherCbIdx < m_otherSize)
+        {
+          validPrevious.push_back (pair);
+        }
+    }
+
+  DoSearch (validPrevious);
+  NS_ASSERT_MSG (!m_evaluated.empty (), "No pair was evaluated");
+
+  // sort the evaluated pairs by decreasing gain and keep the best ones
+  uint32_t numCandidates = std::min<uint32_t> (std::max<uint32_t> (GetNumCandidates (), 1), m_evaluated.size ());
+  std::partial_sort (m_evaluated.begin (), m_evaluated.begin () + numCandidates, m_evaluated.end (),
+                     [this] (uint32_t a, uint32_t b) { return m_gains[a] > m_gains[b]; });
+
+  std::vector<BeamPair> result;
+  result.reserve (numCandidates);
+  for (uint32_t i = 0; i < numCandidates; i++)
+    {
+      BeamPair pair;
+      pair.thisCbIdx = m_evaluated[i] / m_otherSize;
+      pair.otherCbIdx = m_evaluated[i] % m_otherSize;
+      pair.gain = m_gains[m_evaluated[i]];
+      result.push_back (pair);
+    }
+
+  NS_LOG_DEBUG ("Search completed with " << m_evaluated.size () << " evaluations out of "
+                                         << m_thisSize * m_otherSize << " pairs");
+
+  m_thisCodebook = 0;
+  m_otherCodebook = 0;
+  m_gainFunction = nullptr;
+
+  return result;
+}
+
+double
+MmWaveBeamSearch::Evaluate (uint32_t thisIdx, uint32_t otherIdx)
+{
+  NS_ASSERT (thisIdx < m_thisSize && otherIdx < m_otherSize);
+  uint32_t linearIdx = thisIdx * m_otherSize + otherIdx;
+  if (std::isnan (m_gains[linearIdx]))
+    {
+      m_gains[linearIdx] = m_gainFunction (thisIdx, otherIdx);
+      m_evaluated.push_back (linearIdx);
+    }
+  return m_gains[linearIdx];
+}
+
+void
+MmWaveBeamSearch::EvaluateAll (const std::vector<uint32_t> &thisIdxs, const std::vector<uint32_t> &otherIdxs)
+{
+  for (uint32_t thisIdx : thisIdxs)
+    {
+      for (uint32_t otherIdx : otherIdxs)
+        {
+          Evaluate (thisIdx, otherIdx);
+        }
+    }
+}
+
+MmWaveBeamSearch::BeamPair
+MmWaveBeamSearch::GetBestPair (void) const
+{
+  NS_ASSERT_MSG (!m_evaluated.empty (), "No pair was evaluated");
+  uint32_t best = m_evaluated[0];
+  for (uint32_t linearIdx : m_evaluated)
+    {
+      if (m_gains[linearIdx] > m_gains[best])
+        {
+          best = linearIdx;
+        }
+    }
+
+  BeamPair pair;
+  pair.thisCbIdx = best / m_otherSize;
+  pair.otherCbIdx = best % m_otherSize;
+  pair.gain = m_gains[best];
+  return pair;
+}
+
+std::vector<uint32_t>
+MmWaveBeamSearch::GetNeighbors (Ptr<const BeamformingCodebook> codebook, uint32_t idx, uint32_t n)
+{
+  uint32_t size = codebook->GetCodebookSize ();
+  NS_ASSERT (idx < size);
+
+  std::vector<std::vector<uint32_t> > &sorted = m_neighborsCache[codebook];
+  if (sorted.size () != size)
+    {
+      sorted.assign (size, std::vector<uint32_t> ());
+    }
+
+  if (sorted[idx].empty ())
+    {
+      // sort the codewords by decreasing correlation with the reference one
+      BeamformingCodebook::CodewordView ref = codebook->GetCodeword (idx);
+      std::vector<double> correlation (size);
+      for (uint32_t i = 0; i < size; i++)
+        {
+          BeamformingCodebook::CodewordView cw = codebook->GetCodeword (i);
+          std::complex<double> sum (0, 0);
+          for (size_t e = 0; e < ref.size (); e++)
+            {
+              sum += std::conj (ref[e]) * cw[e];
+            }
+          correlation[i] = std::abs (sum);
+        }
+
+      std::vector<uint32_t> &neighbors = sorted[idx];
+      neighbors.reserve (size);
+      neighbors.push_back (idx);
+      for (uint32_t i = 0; i < size; i++)
+        {
+          if (i != idx)
+            {
+              neighbors.push_back (i);
+            }
+        }
+      std::stable_sort (neighbors.begin () + 1, neighbors.end (),
+                        [&correlation] (uint32_t a, uint32_t b) { return correlation[a] > correlation[b]; });
+    }
+
+  uint32_t num = std::min (n, size);
+  return std::vector<uint32_t> (sorted[idx].begin (), sorted[idx].begin () + num);
+}
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveExhaustiveBeamSearch);
+
+TypeId
+MmWaveExhaustiveBeamSearch::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveExhaustiveBeamSearch")
+    .SetParent<MmWaveBeamSearch> ()
+    .AddConstructor<MmWaveExhaustiveBeamSearch> ()
+  ;
+  return tid;
+}
+
+MmWaveExhaustiveBeamSearch::MmWaveExhaustiveBeamSearch ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveExhaustiveBeamSearch::~MmWaveExhaustiveBeamSearch ()
+{
+}
+
+void
+MmWaveExhaustiveBeamSearch::DoSearch (const std::vector<BeamPair> &previous)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t thisIdx = 0; thisIdx < m_thisSize; thisIdx++)
+    {
+      for (uint32_t otherIdx = 0; otherIdx < m_otherSize; otherIdx++)
+        {
+          Evaluate (thisIdx, otherIdx);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveHierarchicalBeamSearch);
+
+TypeId
+MmWaveHierarchicalBeamSearch::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveHierarchicalBeamSearch")
+    .SetParent<MmWaveBeamSearch> ()
+    .AddConstructor<MmWaveHierarchicalBeamSearch> ()
+    .AddAttribute ("CoarseStride",
+                   "Step between the codewords evaluated in the coarse stage",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&MmWaveHierarchicalBeamSearch::m_coarseStride),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RefinementSize",
+                   "Number of codewords per side evaluated in the refinement stage",
+                   UintegerValue (6),
+                   MakeUintegerAccessor (&MmWaveHierarchicalBeamSearch::m_refinementSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+MmWaveHierarchicalBeamSearch::MmWaveHierarchicalBeamSearch ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveHierarchicalBeamSearch::~MmWaveHierarchicalBeamSearch ()
+{
+}
+
+void
+MmWaveHierarchicalBeamSearch::DoSearch (const std::vector<BeamPair> &previous)
+{
+  NS_LOG_FUNCTION (this);
+
+  // coarse stage
+  std::vector<uint32_t> thisCoarse;
+  for (uint32_t i = 0; i < m_thisSize; i += m_coarseStride)
+    {
+      thisCoarse.push_back (i);
+    }
+  std::vector<uint32_t> otherCoarse;
+  for (uint32_t i = 0; i < m_otherSize; i += m_coarseStride)
+    {
+      otherCoarse.push_back (i);
+    }
+  EvaluateAll (thisCoarse, otherCoarse);
+
+  // refinement stage around the best coarse pair
+  BeamPair coarseBest = GetBestPair ();
+  NS_LOG_DEBUG ("Best coarse pair (" << coarseBest.thisCbIdx << ", " << coarseBest.otherCbIdx << ")");
+  EvaluateAll (GetNeighbors (m_thisCodebook, coarseBest.thisCbIdx, m_refinementSize),
+               GetNeighbors (m_otherCodebook, coarseBest.otherCbIdx, m_refinementSize));
+}
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveIterativeBeamSearch);
+
+TypeId
+MmWaveIterativeBeamSearch::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveIterativeBeamSearch")
+    .SetParent<MmWaveBeamSearch> ()
+    .AddConstructor<MmWaveIterativeBeamSearch> ()
+    .AddAttribute ("MaxIterations",
+                   "Maximum number of alternating sweeps of the two codebooks",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&MmWaveIterativeBeamSearch::m_maxIterations),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+MmWaveIterativeBeamSearch::MmWaveIterativeBeamSearch ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveIterativeBeamSearch::~MmWaveIterativeBeamSearch ()
+{
+}
+
+void
+MmWaveIterativeBeamSearch::DoSearch (const std::vector<BeamPair> &previous)
+{
+  NS_LOG_FUNCTION (this);
+
+  // start from the previous pair, if available
+  uint32_t thisIdx = previous.empty () ? 0 : previous[0].thisCbIdx;
+  uint32_t otherIdx = previous.empty () ? 0 : previous[0].otherCbIdx;
+
+  for (uint32_t iter = 0; iter < m_maxIterations; iter++)
+    {
+      uint32_t oldThisIdx = thisIdx;
+      uint32_t oldOtherIdx = otherIdx;
+
+      // sweep the other codebook keeping this codeword fixed
+      double bestGain = Evaluate (thisIdx, otherIdx);
+      for (uint32_t i = 0; i < m_otherSize; i++)
+        {
+          double gain = Evaluate (thisIdx, i);
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              otherIdx = i;
+            }
+        }
+
+      // sweep this codebook keeping the other codeword fixed
+      for (uint32_t i = 0; i < m_thisSize; i++)
+        {
+          double gain = Evaluate (i, otherIdx);
+          if (gain > bestGain)
+            {
+              bestGain = gain;
+              thisIdx = i;
+            }
+        }
+
+      NS_LOG_DEBUG ("Iteration " << iter << " selected pair (" << thisIdx << ", " << otherIdx << ")");
+      if (thisIdx == oldThisIdx && otherIdx == oldOtherIdx)
+        {
+          break;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveTopKBeamSearch);
+
+TypeId
+MmWaveTopKBeamSearch::GetTypeId ()
+{
+  static TypeId
+    tid =
+    TypeId ("ns3::MmWaveTopKBeamSearch")
+    .SetParent<MmWaveBeamSearch> ()
+    .AddConstructor<MmWaveTopKBeamSearch> ()
+    .AddAttribute ("NumCandidates",
+                   "Number of best pairs retained after each search and tracked by the next one",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&MmWaveTopKBeamSearch::m_numCandidates),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RefinementSize",
+                   "Number of codewords per side evaluated around the previous best pair",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&MmWaveTopKBeamSearch::m_refinementSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("FallbackThreshold",
+                   "If the best tracked gain is lower than the previous one by more than "
+                   "this threshold (in dB), an exhaustive search is performed",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&MmWaveTopKBeamSearch::m_fallbackThreshold),
+                   MakeDoubleChecker<double> (0.0))
+  ;
+  return tid;
+}
+
+MmWaveTopKBeamSearch::MmWaveTopKBeamSearch ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveTopKBeamSearch::~MmWaveTopKBeamSearch ()
+{
+}
+
+uint32_t
+MmWaveTopKBeamSearch::GetNumCandidates (void) const
+{
+  return m_numCandidates;
+}
+
+void
+MmWaveTopKBeamSearch::DoSearch (const std::vector<BeamPair> &previous)
+{
+  NS_LOG_FUNCTION (this);
+
+  bool exhaustive = previous.empty ();
+
+  if (!exhaustive)
+    {
+      // evaluate all the combinations of the codewords of the previous candidates
+      std::vector<uint32_t> thisIdxs;
+      std::vector<uint32_t> otherIdxs;
+      for (const auto &pair : previous)
+        {
+          if (std::find (thisIdxs.begin (), thisIdxs.end (), pair.thisCbIdx) == thisIdxs.end ())
+            {
+              thisIdxs.push_back (pair.thisCbIdx);
+            }
+          if (std::find (otherIdxs.begin (), otherIdxs.end (), pair.otherCbIdx) == otherIdxs.end ())
+            {
+              otherIdxs.push_back (pair.otherCbIdx);
+            }
+        }
+      EvaluateAll (thisIdxs, otherIdxs);
+
+      // evaluate the neighborhood of the previous best pair
+      EvaluateAll (GetNeighbors (m_thisCodebook, previous[0].thisCbIdx, m_refinementSize),
+                   GetNeighbors (m_otherCodebook, previous[0].otherCbIdx, m_refinementSize));
+
+      BeamPair best = GetBestPair ();
+      if (best.gain <= 0 || 10 * std::log10 (previous[0].gain / best.gain) > m_fallbackThreshold)
+        {
+          NS_LOG_DEBUG ("Tracked gain " << best.gain << " previous gain " << previous[0].gain
+                                        << ", fall back to exhaustive search");
+          exhaustive = true;
+        }
+    }
+
+  if (exhaustive)
+    {
+      for (uint32_t thisIdx = 0; thisIdx < m_thisSize; thisIdx++)
+        {
+          for (uint32_t otherIdx = 0; otherIdx < m_otherSize; otherIdx++)
+            {
+              Evaluate (thisIdx, otherIdx);
+            }
+        }
+    }
+}
+
+} // namespace mmwave
+} // namespace ns3
@@ -0,0 +1,295 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MMWAVE_BEAM_SEARCH_H
+#define MMWAVE_BEAM_SEARCH_H
+
+#include "ns3/object.h"
+#include "ns3/beamforming-codebook.h"
+#include <functional>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+namespace mmwave {
+
+/**
+ * This class defines the interface of the strategies used by
+ * MmWaveCodebookBeamforming to select the pair of codewords to be used by
+ * two devices.
+ * A strategy only sees the two codebooks and a function returning the gain
+ * obtained with a given pair of codewords, and tries to find the best pair
+ * with as few evaluations of that function as possible.
+ * Extend this class to implement a specific search algorithm.
+ */
+class MmWaveBeamSearch : public Object
+{
+public:
+  /**
+   * Function returning the gain obtained using the codeword thisIdx of this
+   * codebook and the codeword otherIdx of the other codebook
+   */
+  typedef std::function<double (uint32_t thisIdx, uint32_t otherIdx)> GainFunction;
+
+  /**
+   * A pair of codewords and the corresponding gain
+   */
+  struct BeamPair
+  {
+    uint32_t thisCbIdx; //!< index of the codeword for this antenna
+    uint32_t otherCbIdx; //!< index of the codeword for the other antenna
+    double gain; //!< gain obtained with this pair of codewords
+  };
+
+  /**
+   * Constructor
+   */
+  MmWaveBeamSearch ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveBeamSearch () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Search the best pair of codewords
+   * \param thisCodebook the codebook of this antenna
+   * \param otherCodebook the codebook of the other antenna
+   * \param gainFunction the function used to evaluate a pair of codewords
+   * \param previous the pairs returned by the previous search on the same
+   *        link, if any, sorted by decreasing gain
+   * \return the best pairs found during the search, sorted by decreasing
+   *         gain. The vector contains at least one pair and at most
+   *         GetNumCandidates () pairs.
+   */
+  std::vector<BeamPair> Search (Ptr<const BeamformingCodebook> thisCodebook,
+                                Ptr<const BeamformingCodebook> otherCodebook,
+                                const GainFunction &gainFunction,
+                                const std::vector<BeamPair> &previous);
+
+  /**
+   * Returns the number of pairs that should be retained after each search
+   * and provided to the next one
+   * \return the number of candidate pairs
+   */
+  virtual uint32_t GetNumCandidates (void) const;
+
+  /**
+   * Returns the number of times the gain function was called during the
+   * last search
+   * \return the number of evaluations
+   */
+  uint32_t GetNumEvaluations (void) const;
+
+protected:
+  virtual void DoDispose (void) override;
+
+  /**
+   * Implements the search algorithm. Every pair should be evaluated
+   * through the Evaluate method.
+   * \param previous the pairs returned by the previous search, if any
+   */
+  virtual void DoSearch (const std::vector<BeamPair> &previous) = 0;
+
+  /**
+   * Returns the gain of the given pair, calling the gain function only if
+   * the pair was not evaluated yet during the current search
+   * \param thisIdx index of the codeword for this antenna
+   * \param otherIdx index of the codeword for the other antenna
+   * \return the gain
+   */
+  double Evaluate (uint32_t thisIdx, uint32_t otherIdx);
+
+  /**
+   * Evaluates all the pairs of codewords in thisIdxs x otherIdxs
+   * \param thisIdxs indices of the codewords for this antenna
+   * \param otherIdxs indices of the codewords for the other antenna
+   */
+  void EvaluateAll (const std::vector<uint32_t> &thisIdxs, const std::vector<uint32_t> &otherIdxs);
+
+  /**
+   * Returns the best pair evaluated so far during the current search
+   * \return the best pair
+   */
+  BeamPair GetBestPair (void) const;
+
+  /**
+   * Returns the indices of the n codewords of a codebook which are most
+   * correlated with the codeword idx, i.e., which point to the closest
+   * directions. The codeword idx is always the first element.
+   * \param codebook the codebook
+   * \param idx index of the reference codeword
+   * \param n number of codewords to return
+   * \return the indices of the neighbor codewords
+   */
+  std::vector<uint32_t> GetNeighbors (Ptr<const BeamformingCodebook> codebook, uint32_t idx, uint32_t n);
+
+  Ptr<const BeamformingCodebook> m_thisCodebook; //!< codebook of this antenna used in the current search
+  Ptr<const BeamformingCodebook> m_otherCodebook; //!< codebook of the other antenna used in the current search
+  uint32_t m_thisSize; //!< size of the codebook of this antenna
+  uint32_t m_otherSize; //!< size of the codebook of the other antenna
+
+private:
+  GainFunction m_gainFunction; //!< the gain function used in the current search
+  std::vector<double> m_gains; //!< gains of the pairs evaluated in the current search, NaN if not evaluated
+  std::vector<uint32_t> m_evaluated; //!< linear indices of the pairs evaluated in the current search
+  std::map<Ptr<const BeamformingCodebook>, std::vector<std::vector<uint32_t> > > m_neighborsCache; //!< codewords of each codebook sorted by decreasing correlation
+};
+
+
+/**
+ * This class extends the MmWaveBeamSearch interface.
+ * It evaluates all the possible pairs of codewords.
+ */
+class MmWaveExhaustiveBeamSearch : public MmWaveBeamSearch
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveExhaustiveBeamSearch ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveExhaustiveBeamSearch () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  void DoSearch (const std::vector<BeamPair> &previous) override;
+};
+
+
+/**
+ * This class extends the MmWaveBeamSearch interface.
+ * It implements a two-stage search: first, a coarse sweep considers one
+ * codeword every CoarseStride codewords of each codebook, then the codewords
+ * which are most correlated to the best coarse pair are evaluated.
+ */
+class MmWaveHierarchicalBeamSearch : public MmWaveBeamSearch
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveHierarchicalBeamSearch ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveHierarchicalBeamSearch () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  void DoSearch (const std::vector<BeamPair> &previous) override;
+
+private:
+  uint32_t m_coarseStride; //!< step between the codewords considered in the coarse stage
+  uint32_t m_refinementSize; //!< number of codewords per side considered in the refinement stage
+};
+
+
+/**
+ * This class extends the MmWaveBeamSearch interface.
+ * It alternately sweeps the codebook of one side while keeping the codeword
+ * of the other side fixed, until the selected pair does not change.
+ */
+class MmWaveIterativeBeamSearch : public MmWaveBeamSearch
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveIterativeBeamSearch ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveIterativeBeamSearch () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  void DoSearch (const std::vector<BeamPair> &previous) override;
+
+private:
+  uint32_t m_maxIterations; //!< maximum number of tx/rx sweeps
+};
+
+
+/**
+ * This class extends the MmWaveBeamSearch interface.
+ * It tracks the NumCandidates best pairs found by the previous search,
+ * evaluating only these pairs and the codewords close to the previous best
+ * one. An exhaustive search is performed if there is no previous search or
+ * if the tracked gain dropped by more than FallbackThreshold.
+ */
+class MmWaveTopKBeamSearch : public MmWaveBeamSearch
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveTopKBeamSearch ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveTopKBeamSearch () override;
+
+  /**
+   * Returns the object type id
+   * \return the type id
+   */
+  static TypeId GetTypeId (void);
+
+  uint32_t GetNumCandidates (void) const override;
+
+protected:
+  void DoSearch (const std::vector<BeamPair> &previous) override;
+
+private:
+  uint32_t m_numCandidates; //!< number of pairs retained between two searches
+  uint32_t m_refinementSize; //!< number of codewords per side around the previous best pair
+  double m_fallbackThreshold; //!< maximum gain drop before falling back to an exhaustive search, in dB
+};
+
+} // namespace mmwave
+} // namespace ns3
+
+#endif /* MMWAVE_BEAM_SEARCH_H */
@@ -22,6 +22,8 @@
 #include "ns3/matrix-based-channel-model.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/file-beamforming-codebook.h"
+#include "ns3/mmwave-beam-search.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
 #include "ns3/mmwave-phy-mac-common.h"
 #include "ns3/mmwave-spectrum-value-helper.h"
 #include "ns3/object-factory.h"
@@ -35,6 +37,7 @@
 #include "ns3/log.h"
 #include <fstream>
 #include <algorithm>
+#include <memory>
 
 
 namespace ns3 {
@@ -250,7 +253,7 @@ MmWaveSvdBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice,
 
   if (!m_useCache || toCache)
     {
-      if (channelMatrix->m_channel[0][0].size () == 0)
+      if (channelMatrix->m_channel.GetNumClusters () == 0)
         {
           NS_LOG_LOGIC ("Channel has no MPCs");
 
@@ -312,9 +315,9 @@ std::pair<PhasedArrayModel::ComplexVector, PhasedArrayModel::ComplexVector>
 MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const
 {
   //generate transmitter side spatial correlation matrix
-  uint16_t aSize = params->m_channel.size ();
-  uint16_t bSize = params->m_channel[0].size ();
-  uint16_t clusterSize = params->m_channel[0][0].size ();
+  uint16_t aSize = params->m_channel.GetNumRxElements ();
+  uint16_t bSize = params->m_channel.GetNumTxElements ();
+  uint16_t clusterSize = params->m_channel.GetNumClusters ();
 
   // compute narrowband channel by summing over the cluster index
   MatrixBasedChannelModel::Complex2DVector narrowbandChannel;
@@ -332,7 +335,7 @@ MmWaveSvdBeamforming::ComputeBeamformingVectors (Ptr<const MatrixBasedChannelMod
           std::complex<double> cSum (0, 0);
           for (uint16_t cIndex = 0; cIndex < clusterSize; cIndex++)
             {
-              cSum += params->m_channel[aIndex][bIndex][cIndex];
+              cSum += params->m_channel (aIndex, bIndex, cIndex);
             }
           narrowbandChannel[aIndex][bIndex] = cSum;
         }
@@ -474,12 +477,25 @@ MmWaveCodebookBeamforming::GetTypeId ()
                    TimeValue (MilliSeconds (0.0)),
                    MakeTimeAccessor (&MmWaveCodebookBeamforming::m_updatePeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("BeamSearch",
+                   "The strategy used to select the best pair of codewords",
+                   StringValue ("ns3::MmWaveExhaustiveBeamSearch"),
+                   MakePointerAccessor (&MmWaveCodebookBeamforming::m_beamSearch),
+                   MakePointerChecker<MmWaveBeamSearch> ())
+    .AddAttribute ("ClosedFormGain",
+                   "If true and the SpectrumPropagationLossModel is a ThreeGppSpectrumPropagationLossModel, "
+                   "the gain of each pair of codewords is computed directly from the channel matrix, "
+                   "without computing the received PSD",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MmWaveCodebookBeamforming::m_closedFormGain),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 
 MmWaveCodebookBeamforming::MmWaveCodebookBeamforming ()
+  : m_closedFormGain {true}
 {
   NS_LOG_FUNCTION (this);
 }
@@ -490,6 +506,18 @@ MmWaveCodebookBeamforming::~MmWaveCodebookBeamforming ()
 }
 
 
+void
+MmWaveCodebookBeamforming::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_splm = 0;
+  m_txPsd = 0;
+  m_beamSearch = 0;
+  m_codebookIdsCache.clear ();
+  MmWaveBeamformingModel::DoDispose ();
+}
+
+
 void
 MmWaveCodebookBeamforming::SetBeamformingCodebookFactory (ObjectFactory factory)
 {
@@ -519,6 +547,13 @@ MmWaveCodebookBeamforming::DoInitialize (void)
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_antenna->GetObject<BeamformingCodebook> ())
+    {
+      // the antenna is already configured, e.g., by another beamforming model
+      NS_LOG_LOGIC ("Antenna " << m_antenna << " already has a codebook");
+      return;
+    }
+
   NS_ASSERT_MSG (m_beamformingCodebookFactory.IsTypeIdSet (),
                  "The BeamformingCodebook factory is not initialized");
 
@@ -568,33 +603,52 @@ MmWaveCodebookBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDe
   
   if (notFound || update)
   {
-    MmWaveCodebookBeamforming::Matrix2D powerMatrix = ComputeBeamformingCodebookMatrix (otherDevice, otherAntenna);
-    
-    // find best beam couple
-    std::vector<double> maxPowers;
-    maxPowers.reserve (powerMatrix.size ());
-    std::vector<uint32_t> argMaxPowers;
-    argMaxPowers.reserve (powerMatrix.size ());
-    
-    for (uint32_t i = 0; i < powerMatrix.size (); i++)
-    {
-      auto argMaxIt = std::max_element (powerMatrix[i].begin (), powerMatrix[i].end ());
-      argMaxPowers.push_back (std::distance (powerMatrix[i].begin (), argMaxIt));
-      maxPowers.push_back (*argMaxIt);
-    }
-    
-    auto argMaxIt = std::max_element (maxPowers.begin (), maxPowers.end ());
-    thisCbIdx = std::distance (maxPowers.begin (), argMaxIt);
-    otherCbIdx = argMaxPowers[thisCbIdx];
-    
+    Ptr<BeamformingCodebook> thisCodebook = m_antenna->GetObject<BeamformingCodebook> ();
+    Ptr<BeamformingCodebook> otherCodebook = otherAntenna->GetObject<BeamformingCodebook> ();
+
+    // save pre-existing bf vectors
+    auto thisOldBfVector = m_antenna->GetBeamformingVector ();
+    auto otherOldBfVector = otherAntenna->GetBeamformingVector ();
+
+    std::vector<MmWaveBeamSearch::BeamPair> previous;
+    if (!notFound)
+      {
+        previous = it->second.candidates;
+      }
+
+    MmWaveBeamSearch::GainFunction gainFunction;
+    Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (m_splm);
+    if (m_closedFormGain && threeGppSplm)
+      {
+        gainFunction = CreateClosedFormGainFunction (otherDevice, otherAntenna, threeGppSplm);
+      }
+    else
+      {
+        gainFunction = [this, otherDevice, otherAntenna] (uint32_t thisIdx, uint32_t otherIdx)
+          {
+            return ComputeBeamPairGain (otherDevice, otherAntenna, thisIdx, otherIdx);
+          };
+      }
+    std::vector<MmWaveBeamSearch::BeamPair> candidates = m_beamSearch->Search (thisCodebook, otherCodebook,
+                                                                               gainFunction, previous);
+
+    // reset to pre-existing bf vectors
+    m_antenna->SetBeamformingVector (thisOldBfVector);
+    otherAntenna->SetBeamformingVector (otherOldBfVector);
+
+    thisCbIdx = candidates[0].thisCbIdx;
+    otherCbIdx = candidates[0].otherCbIdx;
+
     NS_LOG_DEBUG ("Best beam pair: thisCbIdx=" << thisCbIdx << ", otherCbIdx=" << otherCbIdx <<
-    " with power " << 10 * std::log10 (*argMaxIt) + 30 << " dBm");
+    " with power " << 10 * std::log10 (candidates[0].gain) + 30 << " dBm" <<
+    " after " << m_beamSearch->GetNumEvaluations () << " evaluations");
     
     // insert the new entry in the map
     Entry newEntry; 
     newEntry.thisCbIdx = thisCbIdx;
     newEntry.otherCbIdx = otherCbIdx;
     newEntry.lastUpdate = Simulator::Now ();
+    newEntry.candidates = candidates;
     m_codebookIdsCache [otherAntenna] = newEntry;    
   }
 
@@ -602,18 +656,16 @@ MmWaveCodebookBeamforming::SetBeamformingVectorForDevice (Ptr<NetDevice> otherDe
   Ptr<BeamformingCodebook> thisCodebook = m_antenna->GetObject<BeamformingCodebook> ();
   Ptr<BeamformingCodebook> otherCodebook = otherAntenna->GetObject<BeamformingCodebook> ();
   
-  PhasedArrayModel::ComplexVector thisAntennaWeights = thisCodebook->GetCodeword (thisCbIdx);
-  PhasedArrayModel::ComplexVector otherAntennaWeights = otherCodebook->GetCodeword (otherCbIdx);
-
-  m_antenna->SetBeamformingVector (thisAntennaWeights);
-  otherAntenna->SetBeamformingVector (otherAntennaWeights);
+  m_antenna->SetBeamformingVector (thisCodebook->GetCodeword (thisCbIdx));
+  otherAntenna->SetBeamformingVector (otherCodebook->GetCodeword (otherCbIdx));
 }
 
 
-MmWaveCodebookBeamforming::Matrix2D
-MmWaveCodebookBeamforming::ComputeBeamformingCodebookMatrix (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna) const
+double
+MmWaveCodebookBeamforming::ComputeBeamPairGain (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna,
+                                                uint32_t thisIdx, uint32_t otherIdx) const
 {
-  NS_LOG_FUNCTION (this << otherDevice << otherAntenna);
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna << thisIdx << otherIdx);
 
   Ptr<BeamformingCodebook> thisCodebook = m_antenna->GetObject<BeamformingCodebook> ();
   Ptr<BeamformingCodebook> otherCodebook = otherAntenna->GetObject<BeamformingCodebook> ();
@@ -621,39 +673,109 @@ MmWaveCodebookBeamforming::ComputeBeamformingCodebookMatrix (Ptr<NetDevice> othe
   Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
   Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
 
-  // init matrix
-  MmWaveCodebookBeamforming::Matrix2D matrix {};
-  matrix.resize (thisCodebook->GetCodebookSize ());
-  for (uint64_t i = 0; i < thisCodebook->GetCodebookSize (); i++)
+  m_antenna->SetBeamformingVector (thisCodebook->GetCodeword (thisIdx));
+  otherAntenna->SetBeamformingVector (otherCodebook->GetCodeword (otherIdx));
+
+  Ptr<SpectrumValue> rxPsd = m_splm->CalcRxPowerSpectralDensity (m_txPsd, thisMob, otherMob);
+  return Sum (*rxPsd) / (rxPsd->GetSpectrumModel ()->GetNumBands ());
+}
+
+
+MmWaveBeamSearch::GainFunction
+MmWaveCodebookBeamforming::CreateClosedFormGainFunction (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna,
+                                                         Ptr<ThreeGppSpectrumPropagationLossModel> splm) const
+{
+  NS_LOG_FUNCTION (this << otherDevice << otherAntenna << splm);
+
+  Ptr<MobilityModel> thisMob = m_device->GetNode ()->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> otherMob = otherDevice->GetNode ()->GetObject<MobilityModel> ();
+
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix = splm->GetChannelModel ()->GetChannel (thisMob, otherMob, m_antenna, otherAntenna);
+  const Complex3DArray &channel = channelMatrix->m_channel;
+
+  struct ClosedFormGainData
+  {
+    MatrixBasedChannelModel::Complex2DVector correlation; //!< correlation among the clusters, see ThreeGppSpectrumPropagationLossModel::CalcLongTermCorrelation
+    std::vector<MatrixBasedChannelModel::Complex2DVector> projections; //!< projections[j][c][k] = sum_i w_j[i] H_c[i][k], for all the codewords w_j of the projected side
+    std::vector<BeamformingCodebook::CodewordView> codewords; //!< codewords of the other side
+    bool projectThis; //!< true if the codewords of this antenna are projected
+    bool thisIsU; //!< true if this antenna is the u-node of the channel matrix
+  };
+  auto data = std::make_shared<ClosedFormGainData> ();
+
+  // the average received power for a pair (sW, uW) is l^H R l, where
+  // l_c = sum_s sum_u uW[u] H[u][s][c] sW[s] is the long term component
+  data->correlation = splm->CalcLongTermCorrelation (m_txPsd, thisMob, otherMob, channelMatrix);
+  data->thisIsU = channelMatrix->IsReverse (m_device->GetNode ()->GetId (), otherDevice->GetNode ()->GetId ());
+
+  // project the channel on all the codewords of the smallest codebook,
+  // then each pair only requires an inner product per cluster
+  Ptr<BeamformingCodebook> thisCodebook = m_antenna->GetObject<BeamformingCodebook> ();
+  Ptr<BeamformingCodebook> otherCodebook = otherAntenna->GetObject<BeamformingCodebook> ();
+  data->projectThis = thisCodebook->GetCodebookSize () <= otherCodebook->GetCodebookSize ();
+  Ptr<BeamformingCodebook> projectedCodebook = data->projectThis ? thisCodebook : otherCodebook;
+  Ptr<BeamformingCodebook> innerCodebook = data->projectThis ? otherCodebook : thisCodebook;
+  bool projectU = (data->projectThis == data->thisIsU);
+
+  uint64_t uSize = channel.GetNumRxElements ();
+  uint64_t sSize = channel.GetNumTxElements ();
+  uint64_t numClusters = channel.GetNumClusters ();
+  uint64_t innerSize = projectU ? sSize : uSize;
+
+  data->projections.resize (projectedCodebook->GetCodebookSize ());
+  for (uint32_t j = 0; j < projectedCodebook->GetCodebookSize (); j++)
     {
-      matrix[i].reserve (otherCodebook->GetCodebookSize ());
+      BeamformingCodebook::CodewordView w = projectedCodebook->GetCodeword (j);
+      MatrixBasedChannelModel::Complex2DVector &projection = data->projections[j];
+      projection.assign (numClusters, PhasedArrayModel::ComplexVector (innerSize));
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+              std::complex<double> weight = projectU ? w[uIndex] : w[sIndex];
+              uint64_t innerIndex = projectU ? sIndex : uIndex;
+              for (uint64_t cIndex = 0; cIndex < numClusters; cIndex++)
+                {
+                  projection[cIndex][innerIndex] += weight * channel (uIndex, sIndex, cIndex);
+                }
+            }
+        }
     }
 
-  // save pre-existing bf vectors
-  auto thisOldBfVector = m_antenna->GetBeamformingVector ();
-  auto otherOldBfVector = otherAntenna->GetBeamformingVector ();
+  data->codewords.reserve (innerCodebook->GetCodebookSize ());
+  for (uint32_t i = 0; i < innerCodebook->GetCodebookSize (); i++)
+    {
+      data->codewords.push_back (innerCodebook->GetCodeword (i));
+    }
 
-  // fill matrix
-  for (uint32_t thisIdx = 0; thisIdx < thisCodebook->GetCodebookSize (); thisIdx++)
+  return [data, numClusters] (uint32_t thisIdx, uint32_t otherIdx)
     {
-      m_antenna->SetBeamformingVector (thisCodebook->GetCodeword (thisIdx));
+      const MatrixBasedChannelModel::Complex2DVector &projection = data->projections[data->projectThis ? thisIdx : otherIdx];
+      const BeamformingCodebook::CodewordView &w = data->codewords[data->projectThis ? otherIdx : thisIdx];
 
-      for (uint32_t otherIdx = 0; otherIdx < otherCodebook->GetCodebookSize (); otherIdx++)
+      PhasedArrayModel::ComplexVector longTerm (numClusters);
+      for (uint64_t cIndex = 0; cIndex < numClusters; cIndex++)
         {
-          otherAntenna->SetBeamformingVector (otherCodebook->GetCodeword (otherIdx));
-
-          Ptr<SpectrumValue> rxPsd = m_splm->CalcRxPowerSpectralDensity (m_txPsd, thisMob, otherMob);
-          double avgRxPsd = Sum (*rxPsd) / (rxPsd->GetSpectrumModel ()->GetNumBands ());
-          matrix[thisIdx].push_back (avgRxPsd);
+          std::complex<double> sum (0, 0);
+          for (size_t k = 0; k < w.size (); k++)
+            {
+              sum += w[k] * projection[cIndex][k];
+            }
+          longTerm[cIndex] = sum;
         }
-    }
-  NS_LOG_DEBUG ("Matrix of size " << matrix.size () << "x" << matrix[0].size ());
-
-  // reset to pre-existing bf vectors
-  m_antenna->SetBeamformingVector (thisOldBfVector);
-  otherAntenna->SetBeamformingVector (otherOldBfVector);
 
-  return matrix;
+      std::complex<double> gain (0, 0);
+      for (uint64_t c1Index = 0; c1Index < numClusters; c1Index++)
+        {
+          std::complex<double> sum (0, 0);
+          for (uint64_t c2Index = 0; c2Index < numClusters; c2Index++)
+            {
+              sum += data->correlation[c1Index][c2Index] * longTerm[c2Index];
+            }
+          gain += std::conj (longTerm[c1Index]) * sum;
+        }
+      return gain.real ();
+    };
 }
 
 
@@ -22,6 +22,7 @@
 #include "ns3/object.h"
 #include "ns3/matrix-based-channel-model.h"
 #include "ns3/beamforming-codebook.h"
+#include "ns3/mmwave-beam-search.h"
 #include "ns3/spectrum-propagation-loss-model.h"
 #include "ns3/spectrum-value.h"
 #include "ns3/object-factory.h"
@@ -34,6 +35,7 @@ class MobilityModel;
 class PhasedArrayModel;
 class NetDevice;
 class ChannelConditionModel;
+class ThreeGppSpectrumPropagationLossModel;
 
 namespace mmwave {
 
@@ -253,22 +255,46 @@ public:
   void SetBeamformingVectorForDevice (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna) override;
 
 private:
-  using Matrix2D = std::vector<std::vector<double> >;
+  void DoDispose (void) override;
+
   /**
-   *
+   * Computes the average received power obtained when this antenna and the
+   * other antenna use the given codewords
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \param thisIdx index of the codeword for this antenna
+   * \param otherIdx index of the codeword for the other antenna
+   * \return the average received power
    */
-  Matrix2D ComputeBeamformingCodebookMatrix (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna) const;
+  double ComputeBeamPairGain (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna,
+                              uint32_t thisIdx, uint32_t otherIdx) const;
+
+  /**
+   * Creates a function which computes the average received power obtained
+   * with a pair of codewords directly from the channel matrix, without
+   * changing the beamforming vectors of the antennas nor computing the
+   * received PSD
+   * \param otherDevice the target device
+   * \param otherAntenna the target antenna of otherDevice
+   * \param splm the spectrum propagation loss model
+   * \return the gain function
+   */
+  MmWaveBeamSearch::GainFunction CreateClosedFormGainFunction (Ptr<NetDevice> otherDevice, Ptr<PhasedArrayModel> otherAntenna,
+                                                               Ptr<ThreeGppSpectrumPropagationLossModel> splm) const;
 
   ObjectFactory m_beamformingCodebookFactory;
   Ptr<SpectrumPropagationLossModel> m_splm; //!<
   Ptr<SpectrumValue> m_txPsd;
-  
+  Ptr<MmWaveBeamSearch> m_beamSearch; //!< the strategy used to select the beam pairs
+  bool m_closedFormGain; //!< if true, compute the gain of the beam pairs directly from the channel matrix
+
   /* struct used to store the selected beam pairs */
   struct Entry
   {
-    uint32_t thisCbIdx; //!< index of the codeword for this antenna  
+    uint32_t thisCbIdx; //!< index of the codeword for this antenna
     uint32_t otherCbIdx; //!< index of the codeword for the other antenna
     Time lastUpdate; //!< time stamp
+    std::vector<MmWaveBeamSearch::BeamPair> candidates; //!< best pairs found by the last search, used by the next one
   };
   std::map<Ptr<PhasedArrayModel>, Entry> m_codebookIdsCache; //!< stores the selected beam pairs 
   Time m_updatePeriod; //!< defines the refresh period for updating the beam pairs
@@ -62,6 +62,7 @@
 #include <algorithm>
 #include <array>
 #include <ns3/antenna-model.h>
+#include <ns3/three-gpp-spectrum-propagation-loss-model.h>
 
 namespace ns3 {
 
@@ -120,6 +121,37 @@ MmWaveEnbPhy::GetTypeId (void)
                    DoubleValue (25.6),
                    MakeDoubleAccessor (&MmWaveEnbPhy::m_ueUpdateSinrPeriod),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("SinrEstimateMaxDistance",
+                   "If positive, the periodic SINR estimate only considers the UEs "
+                   "within this distance (in m) from the eNB. The other UEs are "
+                   "reported with a null SINR",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&MmWaveEnbPhy::m_sinrEstimateMaxDistance),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("SinrEstimateMaxPathLoss",
+                   "If positive, the periodic SINR estimate only considers the UEs "
+                   "whose path loss (in dB) is lower than this value. The other UEs "
+                   "are reported with a null SINR",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&MmWaveEnbPhy::m_sinrEstimateMaxPathLoss),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("SinrEstimateCacheEnabled",
+                   "If true, the periodic SINR estimate reuses the rx PSD of a link "
+                   "if the channel matrix, the beamforming vectors, the positions "
+                   "and the tx power did not change, and the devices are static. "
+                   "It requires the ThreeGppSpectrumPropagationLossModel",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveEnbPhy::m_sinrEstimateCacheEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SinrEstimatePrefetchChannels",
+                   "If true, the periodic SINR estimate generates the channel "
+                   "realizations of the candidate UEs which are not available or "
+                   "have to be updated in a single batch, using "
+                   "MatrixBasedChannelModel::GetChannels, before evaluating them. "
+                   "It requires the ThreeGppSpectrumPropagationLossModel",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveEnbPhy::m_sinrEstimatePrefetchChannels),
+                   MakeBooleanChecker ())
     .AddAttribute ("Transient",
                    "Transient period (in microseconds) in which just collect SINR values without filtering the sample",
                    IntegerValue (320000),
@@ -157,6 +189,11 @@ MmWaveEnbPhy::GetTypeId (void)
                      "Report the allocation info for the current DL transmission",
                      MakeTraceSourceAccessor (&MmWaveEnbPhy::m_dlPhyTrace),
                      "ns3::DlPhyTransmission::TracedCallback")
+    .AddTraceSource ("SinrEstimateStats",
+                     "Number of links evaluated, reused from the cache and skipped "
+                     "in each periodic SINR estimate",
+                     MakeTraceSourceAccessor (&MmWaveEnbPhy::m_sinrEstimateStatsTrace),
+                     "ns3::mmwave::MmWaveEnbPhy::SinrEstimateStatsTracedCallback")
 
   ;
   return tid;
@@ -202,7 +239,7 @@ MmWaveEnbPhy::DoInitialize (void)
 void
 MmWaveEnbPhy::DoDispose (void)
 {
-
+  m_sinrEstimateCache.clear ();
 }
 
 
@@ -577,6 +614,19 @@ MmWaveEnbPhy::GetUlSpectrumPhy () const
   return m_uplinkSpectrumPhy;
 }
 
+Ptr<PhasedArrayModel>
+MmWaveEnbPhy::GetDeviceAntenna (Ptr<NetDevice> device) const
+{
+  Ptr<MmWaveNetDevice> mmNetDevice = DynamicCast<MmWaveNetDevice> (device);
+  if (mmNetDevice)
+    {
+      return mmNetDevice->GetAntenna (m_componentCarrierId);
+    }
+  Ptr<McUeNetDevice> mcUeNetDevice = DynamicCast<McUeNetDevice> (device);
+  NS_ABORT_MSG_IF (!mcUeNetDevice, "Unrecognized device");
+  return mcUeNetDevice->GetAntenna (m_componentCarrierId);
+}
+
 void
 MmWaveEnbPhy::UpdateUeSinrEstimate ()
 {
@@ -589,6 +639,46 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
   Ptr<SpectrumValue> noisePsd = MmWaveSpectrumValueHelper::CreateNoisePowerSpectralDensity (m_phyMacConfig, m_noiseFigure);
   Ptr<SpectrumValue> totalReceivedPsd = Create <SpectrumValue> (SpectrumValue (noisePsd->GetSpectrumModel ()));
 
+  // the cached rx PSDs can be reused only if the channel matrices can be
+  // retrieved, and they are outdated if the tx PSD changes
+  Ptr<ThreeGppSpectrumPropagationLossModel> threeGppSplm;
+  if (m_sinrEstimateCacheEnabled)
+    {
+      threeGppSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (m_spectrumPropagationLossModel);
+      if (m_listOfSubchannels != m_sinrEstimateSubchannels)
+        {
+          m_sinrEstimateCache.clear ();
+          m_sinrEstimateSubchannels = m_listOfSubchannels;
+        }
+    }
+
+  // generate the channel realizations of all the candidate UEs at once, so
+  // that those due for update are generated in a single batch
+  Ptr<ThreeGppSpectrumPropagationLossModel> prefetchSplm;
+  if (m_sinrEstimatePrefetchChannels)
+    {
+      prefetchSplm = DynamicCast<ThreeGppSpectrumPropagationLossModel> (m_spectrumPropagationLossModel);
+    }
+  if (prefetchSplm)
+    {
+      Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
+      Ptr<const PhasedArrayModel> enbAntenna = GetDeviceAntenna (m_netDevice);
+      std::vector<MatrixBasedChannelModel::Link> links;
+      for (std::map<uint64_t, Ptr<NetDevice> >::iterator ue = m_ueAttachedImsiMap.begin (); ue != m_ueAttachedImsiMap.end (); ++ue)
+        {
+          Ptr<MobilityModel> ueMob = ue->second->GetNode ()->GetObject<MobilityModel> ();
+          if (m_sinrEstimateMaxDistance <= 0 || enbMob->GetDistanceFrom (ueMob) <= m_sinrEstimateMaxDistance)
+            {
+              links.push_back (MatrixBasedChannelModel::Link (ueMob, enbMob, GetDeviceAntenna (ue->second), enbAntenna));
+            }
+        }
+      prefetchSplm->GetChannelModel ()->GetChannels (links);
+    }
+
+  uint32_t numEvaluated = 0;
+  uint32_t numReused = 0;
+  uint32_t numSkipped = 0;
+
   for (std::map<uint64_t, Ptr<NetDevice> >::iterator ue = m_ueAttachedImsiMap.begin (); ue != m_ueAttachedImsiMap.end (); ++ue)
     {
       // distinguish between MC and MmWaveNetDevice
@@ -613,16 +703,6 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
           NS_FATAL_ERROR ("Unrecognized device");
         }
       NS_LOG_LOGIC ("UE Tx power = " << ueTxPower);
-      double powerTxW = std::pow (10., (ueTxPower - 30) / 10);
-      double txPowerDensity = 0;
-      txPowerDensity = (powerTxW / (m_phyMacConfig->GetBandwidth ()));
-      NS_LOG_LOGIC ("Linear UE Tx power = " << powerTxW);
-      NS_LOG_LOGIC ("System bandwidth = " << m_phyMacConfig->GetBandwidth ());
-      NS_LOG_LOGIC ("txPowerDensity = " << txPowerDensity);
-      // create tx psd
-      Ptr<SpectrumValue> txPsd =                                                        // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
-        MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
-      NS_LOG_LOGIC ("TxPsd " << *txPsd);
 
       // get this node and remote node mobility
       Ptr<MobilityModel> enbMob = m_netDevice->GetNode ()->GetObject<MobilityModel> ();
@@ -630,45 +710,122 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
       Ptr<MobilityModel> ueMob = ue->second->GetNode ()->GetObject<MobilityModel> ();
       NS_LOG_DEBUG ("UE mobility " << ueMob->GetPosition ());
 
-      // compute rx psd
+      // only the UEs within the configured distance and path loss are
+      // candidates, the others are reported with a null SINR
+      double propagationGainDb = 0;
+      bool candidate = m_sinrEstimateMaxDistance <= 0 || enbMob->GetDistanceFrom (ueMob) <= m_sinrEstimateMaxDistance;
+      if (candidate && m_propagationLoss)
+        {
+          propagationGainDb = m_propagationLoss->CalcRxPower (0, ueMob, enbMob);
+          candidate = m_sinrEstimateMaxPathLoss <= 0 || -propagationGainDb <= m_sinrEstimateMaxPathLoss;
+        }
+      if (!candidate)
+        {
+          NS_LOG_LOGIC ("UE " << ue->first << " is not a candidate for cell " << m_cellId);
+          m_rxPsdMap[ue->first] = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+          numSkipped++;
+          continue;
+        }
 
       // adjuts beamforming of antenna model wrt user
       m_downlinkSpectrumPhy->ConfigureBeamforming (ue->second);
       uePhy->GetDlSpectrumPhy ()->ConfigureBeamforming (m_netDevice);
 
-      // TODO remove, the antenna gains are taken into account by the channel
-      // model. Should we support other kinds of antennas?
-      Ptr<AntennaModel> rxAntenna = GetDlSpectrumPhy ()->GetRxAntenna ();
-      Ptr<AntennaModel> txAntenna = uePhy->GetDlSpectrumPhy ()->GetRxAntenna ();          // Dl, since the Ul is not actually used (TDD device)
-      double pathLossDb = 0;
-      if (txAntenna != 0)
+      // reuse the rx PSD computed in a previous period if neither the
+      // channel matrix nor the beams changed, and the devices are static
+      SinrEstimateCacheEntry* cacheEntry = nullptr;
+      Ptr<SpectrumValue> rxPsd;
+      if (threeGppSplm)
         {
-          Angles txAngles (enbMob->GetPosition (), ueMob->GetPosition ());
-          double txAntennaGain = txAntenna->GetGainDb (txAngles);
-          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-          pathLossDb -= txAntennaGain;
+          Ptr<const PhasedArrayModel> enbAntenna = GetDeviceAntenna (m_netDevice);
+          Ptr<const PhasedArrayModel> ueAntenna = GetDeviceAntenna (ue->second);
+          Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel =
+            threeGppSplm->GetChannelModel ()->GetChannel (ueMob, enbMob, ueAntenna, enbAntenna);
+
+          cacheEntry = &m_sinrEstimateCache[ue->first];
+          cacheEntry->m_used = true;
+          if (cacheEntry->m_rxPsd
+              && cacheEntry->m_channel == channel
+              && cacheEntry->m_enbPosition == enbMob->GetPosition ()
+              && cacheEntry->m_uePosition == ueMob->GetPosition ()
+              && enbMob->GetVelocity () == Vector ()
+              && ueMob->GetVelocity () == Vector ()
+              && cacheEntry->m_ueTxPower == ueTxPower
+              && cacheEntry->m_enbBf == enbAntenna->GetBeamformingVectorRef ()
+              && cacheEntry->m_ueBf == ueAntenna->GetBeamformingVectorRef ())
+            {
+              NS_LOG_LOGIC ("Reuse the rx PSD of UE " << ue->first);
+              rxPsd = cacheEntry->m_rxPsd;
+            }
+          else
+            {
+              cacheEntry->m_channel = channel;
+              cacheEntry->m_enbPosition = enbMob->GetPosition ();
+              cacheEntry->m_uePosition = ueMob->GetPosition ();
+              cacheEntry->m_ueTxPower = ueTxPower;
+              cacheEntry->m_enbBf = enbAntenna->GetBeamformingVectorRef ();
+              cacheEntry->m_ueBf = ueAntenna->GetBeamformingVectorRef ();
+            }
         }
-      if (rxAntenna != 0)
+
+      if (rxPsd)
         {
-          Angles rxAngles (ueMob->GetPosition (), enbMob->GetPosition ());
-          double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-          pathLossDb -= rxAntennaGain;
+          numReused++;
         }
-      if (m_propagationLoss)
+      else
         {
-          double propagationGainDb = m_propagationLoss->CalcRxPower (0, ueMob, enbMob);
-          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-          pathLossDb -= propagationGainDb;
-        }
-      //NS_LOG_DEBUG ("total pathLoss = " << pathLossDb << " dB");
+          double powerTxW = std::pow (10., (ueTxPower - 30) / 10);
+          double txPowerDensity = 0;
+          txPowerDensity = (powerTxW / (m_phyMacConfig->GetBandwidth ()));
+          NS_LOG_LOGIC ("Linear UE Tx power = " << powerTxW);
+          NS_LOG_LOGIC ("System bandwidth = " << m_phyMacConfig->GetBandwidth ());
+          NS_LOG_LOGIC ("txPowerDensity = " << txPowerDensity);
+          // create tx psd
+          Ptr<SpectrumValue> txPsd =                                                        // it is the eNB that dictates the conf, m_listOfSubchannels contains all the subch
+            MmWaveSpectrumValueHelper::CreateTxPowerSpectralDensity (m_phyMacConfig, ueTxPower, m_listOfSubchannels);
+          NS_LOG_LOGIC ("TxPsd " << *txPsd);
+
+          // compute rx psd
+
+          // TODO remove, the antenna gains are taken into account by the channel
+          // model. Should we support other kinds of antennas?
+          Ptr<AntennaModel> rxAntenna = GetDlSpectrumPhy ()->GetRxAntenna ();
+          Ptr<AntennaModel> txAntenna = uePhy->GetDlSpectrumPhy ()->GetRxAntenna ();          // Dl, since the Ul is not actually used (TDD device)
+          double pathLossDb = 0;
+          if (txAntenna != 0)
+            {
+              Angles txAngles (enbMob->GetPosition (), ueMob->GetPosition ());
+              double txAntennaGain = txAntenna->GetGainDb (txAngles);
+              NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+              pathLossDb -= txAntennaGain;
+            }
+          if (rxAntenna != 0)
+            {
+              Angles rxAngles (ueMob->GetPosition (), enbMob->GetPosition ());
+              double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+              NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+              pathLossDb -= rxAntennaGain;
+            }
+          if (m_propagationLoss)
+            {
+              NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+              pathLossDb -= propagationGainDb;
+            }
+          //NS_LOG_DEBUG ("total pathLoss = " << pathLossDb << " dB");
 
-      double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-      Ptr<SpectrumValue> rxPsd = txPsd->Copy ();
-      *(rxPsd) *= pathGainLinear;
+          double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+          rxPsd = txPsd->Copy ();
+          *(rxPsd) *= pathGainLinear;
 
-      rxPsd = m_spectrumPropagationLossModel->CalcRxPowerSpectralDensity (rxPsd, ueMob, enbMob);
-      NS_LOG_LOGIC ("RxPsd " << *rxPsd);
+          rxPsd = m_spectrumPropagationLossModel->CalcRxPowerSpectralDensity (rxPsd, ueMob, enbMob);
+          NS_LOG_LOGIC ("RxPsd " << *rxPsd);
+
+          if (cacheEntry)
+            {
+              cacheEntry->m_rxPsd = rxPsd;
+            }
+          numEvaluated++;
+        }
 
       m_rxPsdMap[ue->first] = rxPsd;
       *totalReceivedPsd += *rxPsd;
@@ -695,6 +852,22 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
 
     }
 
+  // drop the rx PSDs of the UEs detached or no longer candidates, which
+  // would otherwise be kept until the cache is cleared
+  for (std::unordered_map<uint64_t, SinrEstimateCacheEntry>::iterator entry = m_sinrEstimateCache.begin ();
+       entry != m_sinrEstimateCache.end (); )
+    {
+      if (entry->second.m_used)
+        {
+          entry->second.m_used = false;
+          ++entry;
+        }
+      else
+        {
+          entry = m_sinrEstimateCache.erase (entry);
+        }
+    }
+
   for (std::map<uint64_t, Ptr<SpectrumValue> >::iterator ue = m_rxPsdMap.begin (); ue != m_rxPsdMap.end (); ++ue)
     {
       SpectrumValue interference = *totalReceivedPsd - *(ue->second);
@@ -891,6 +1064,8 @@ MmWaveEnbPhy::UpdateUeSinrEstimate ()
       m_roundFromLastUeSinrUpdate++;
     }
 
+  m_sinrEstimateStatsTrace (m_cellId, numEvaluated, numReused, numSkipped);
+
   LteEnbCphySapUser::UeAssociatedSinrInfo info;
   info.ueImsiSinrMap = m_sinrMap;
   info.componentCarrierId = m_componentCarrierId;
@@ -1017,7 +1192,14 @@ MmWaveEnbPhy::StartTti (void)
       // Trace current DL transmission info
       TraceDlPhyTransmission (currTti.m_dci, PhyTransmissionTraceParams::CTRL);
 
-      SendCtrlChannels (ctrlMsgs, ttiPeriod - NanoSeconds (1.0));       // -1 ns ensures control ends before data period
+      if (!m_idleSlotFastForward || !ctrlMsgs.empty ())
+        {
+          SendCtrlChannels (ctrlMsgs, ttiPeriod - NanoSeconds (1.0));       // -1 ns ensures control ends before data period
+        }
+      else
+        {
+          NS_LOG_LOGIC ("ENB " << m_cellId << " skipping empty DL CTRL frame");
+        }
     }
   else if (m_ttiIndex == m_currSlotNumTti - 1)      // Last TTI of this slot: reserved UL control
     {
@@ -1102,7 +1284,16 @@ MmWaveEnbPhy::StartTti (void)
   NS_ASSERT (m_ttiIndex != 0 || currTti.m_dci.m_symStart == m_ttiIndex);
   m_phySapUser->SlotIndication (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));  // trigger MAC
 
-  Simulator::Schedule (ttiPeriod, &MmWaveEnbPhy::EndTti, this);
+  if (m_idleSlotFastForward && (m_ttiIndex == 0 || m_ttiIndex == m_currSlotNumTti - 1))
+    {
+      // nothing happens at the end of the control TTIs, and EndTti schedules
+      // the next TTI or slot at an absolute time: no need for a separate event
+      EndTti ();
+    }
+  else
+    {
+      Simulator::Schedule (ttiPeriod, &MmWaveEnbPhy::EndTti, this);
+    }
 }
 
 void
@@ -43,6 +43,9 @@
 #include <ns3/lte-enb-phy-sap.h>
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/mmwave-harq-phy.h>
+#include <ns3/matrix-based-channel-model.h>
+#include <ns3/phased-array-model.h>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -67,6 +70,18 @@ public:
 
   static TypeId GetTypeId (void);
   virtual void DoInitialize (void) override;
+
+  /**
+   * TracedCallback signature for the statistics of the periodic SINR
+   * estimation.
+   *
+   * \param [in] cellId the cell ID
+   * \param [in] numEvaluated the number of links whose rx PSD was computed
+   * \param [in] numReused the number of links whose cached rx PSD was reused
+   * \param [in] numSkipped the number of links outside the candidate set
+   */
+  typedef void (* SinrEstimateStatsTracedCallback)(uint16_t cellId, uint32_t numEvaluated,
+                                                   uint32_t numReused, uint32_t numSkipped);
   virtual void DoDispose (void) override;
 
   void SetMmWaveEnbCphySapUser (LteEnbCphySapUser* s);
@@ -194,6 +209,30 @@ private:
   */
   void TraceDlPhyTransmission (DciInfoElementTdma dciInfo, uint8_t tddType);
 
+  /**
+   * Returns the antenna used by the given device on this component carrier
+   *
+   * \param device the eNB, UE or MC UE device
+   * \return the antenna
+   */
+  Ptr<PhasedArrayModel> GetDeviceAntenna (Ptr<NetDevice> device) const;
+
+  /**
+   * The inputs and the result of the last rx PSD computed for a UE by
+   * UpdateUeSinrEstimate
+   */
+  struct SinrEstimateCacheEntry
+  {
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< the channel matrix
+    Vector m_enbPosition; //!< the position of the eNB
+    Vector m_uePosition; //!< the position of the UE
+    double m_ueTxPower {0}; //!< the tx power of the UE
+    PhasedArrayModel::ComplexVector m_enbBf; //!< the beamforming vector of the eNB
+    PhasedArrayModel::ComplexVector m_ueBf; //!< the beamforming vector of the UE
+    Ptr<SpectrumValue> m_rxPsd; //!< the rx PSD
+    bool m_used {false}; //!< true if the UE was evaluated by the current estimate
+  };
+
   uint8_t m_currSlotNumTti;     //!< The amount of TTIs scheduled in the current slot
 
   std::set <uint64_t> m_ueAttached;
@@ -227,6 +266,12 @@ private:
   uint16_t m_roundFromLastUeSinrUpdate;       // the ratio between the two above
   double m_transient;       // after m_transient, we can start apply the filter
   bool m_noiseAndFilter;       // If true, use noisy SINR samples, filtered. If false, just use the SINR measure
+  double m_sinrEstimateMaxDistance;       // UEs farther than this distance (m) are not considered in the SINR estimate, if positive
+  double m_sinrEstimateMaxPathLoss;       // UEs with a higher path loss (dB) are not considered in the SINR estimate, if positive
+  bool m_sinrEstimateCacheEnabled;       // If true, reuse the rx PSDs of the links whose inputs did not change
+  bool m_sinrEstimatePrefetchChannels;       // If true, generate the channels of the candidate UEs in a single batch
+  std::unordered_map<uint64_t, SinrEstimateCacheEntry> m_sinrEstimateCache;       // the cached rx PSDs, indexed by IMSI
+  std::vector <int> m_sinrEstimateSubchannels;       // the subchannels used to compute the cached rx PSDs
 
   Ptr<MmWaveHarqPhy> m_harqPhyModule;
   std::vector <int> m_channelChunks;
@@ -236,6 +281,8 @@ private:
   TracedCallback< uint64_t, SpectrumValue&, SpectrumValue& > m_ulSinrTrace;
 
   TracedCallback<PhyTransmissionTraceParams> m_dlPhyTrace;   //!< Traces the current TTI allocation info, from the eNB side
+
+  TracedCallback<uint16_t, uint32_t, uint32_t, uint32_t> m_sinrEstimateStatsTrace; //!< Traces the links evaluated by UpdateUeSinrEstimate
 };
 
 } // namespace mmwave
@@ -0,0 +1,1758 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mmwave-flex-tti-ranked-mac-scheduler.h"
+#include "mmwave-spectrum-value-helper.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+#include <ns3/enum.h>
+#include <ns3/lte-common.h>
+#include <ns3/eps-bearer.h>
+#include <cmath>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveFlexTtiRankedMacScheduler");
+
+namespace mmwave {
+
+MmWaveFlexTtiRankedUeInfo::MmWaveFlexTtiRankedUeInfo (uint16_t rnti)
+  : m_rnti (rnti),
+    m_configured (false),
+    m_allocated (false),
+    m_dlCqiValid (false),
+    m_dlCqi (0),
+    m_dlCqiMcs (0),
+    m_dlCqiTimer (0),
+    m_ulCqiValid (false),
+    m_ulCqiChanged (false),
+    m_ulSinrNumSym (0),
+    m_ulSinrTbSize (0),
+    m_ulCqiTimer (0),
+    m_ulCqi (0),
+    m_ulCqiMcs (0)
+{
+  ResetSchedInfo ();
+}
+
+void
+MmWaveFlexTtiRankedUeInfo::ResetSchedInfo (void)
+{
+  m_dlMcs = 0;
+  m_ulMcs = 0;
+  m_dlSymbols = 0;
+  m_ulSymbols = 0;
+  m_dlSymbolsRetx = 0;
+  m_ulSymbolsRetx = 0;
+  m_dlTbSize = 0;
+  m_ulTbSize = 0;
+  m_totBufDl = 0;
+  m_totBufUl = 0;
+  m_dlAllocDone = false;
+  m_ulAllocDone = false;
+  m_allocUlLast = false;
+  m_rlcPduInfo.clear ();
+  m_currTputDl = 0;
+  m_currTputUl = 0;
+  m_avgTputDl = 0;
+  m_avgTputUl = 0;
+  m_lastAvgTputDl = 0;
+  m_lastAvgTputUl = 0;
+  m_flowStatsDl.clear ();
+  m_flowStatsUl.clear ();
+  for (uint8_t i = 0; i <= 3; i++)
+    {
+      m_flowStatsDl.push_back (FlowStats (i));
+      m_flowStatsUl.push_back (FlowStats (i));
+    }
+}
+
+template <class Policy>
+class MmWaveFlexTtiRankedMacCschedSapProvider : public MmWaveMacCschedSapProvider
+{
+public:
+  MmWaveFlexTtiRankedMacCschedSapProvider (MmWaveFlexTtiRankedMacScheduler<Policy>* scheduler);
+
+  // inherited from MmWaveMacCschedSapProvider
+  virtual void CschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params);
+  virtual void CschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params);
+  virtual void CschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params);
+  virtual void CschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params);
+  virtual void CschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params);
+
+private:
+  MmWaveFlexTtiRankedMacScheduler<Policy>* m_scheduler;
+};
+
+template <class Policy>
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::MmWaveFlexTtiRankedMacCschedSapProvider (MmWaveFlexTtiRankedMacScheduler<Policy>* scheduler)
+  : m_scheduler (scheduler)
+{
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::CschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  m_scheduler->DoCschedCellConfigReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::CschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  m_scheduler->DoCschedUeConfigReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::CschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  m_scheduler->DoCschedLcConfigReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::CschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  m_scheduler->DoCschedLcReleaseReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacCschedSapProvider<Policy>::CschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  m_scheduler->DoCschedUeReleaseReq (params);
+}
+
+template <class Policy>
+class MmWaveFlexTtiRankedMacSchedSapProvider : public MmWaveMacSchedSapProvider
+{
+public:
+  MmWaveFlexTtiRankedMacSchedSapProvider (MmWaveFlexTtiRankedMacScheduler<Policy>* sched);
+
+  virtual void SchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  virtual void SchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params);
+  virtual void SchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
+  virtual void SchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
+  virtual void SchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params);
+  virtual void SchedSetMcs (int mcs);
+
+private:
+  MmWaveFlexTtiRankedMacScheduler<Policy>* m_scheduler;
+};
+
+template <class Policy>
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::MmWaveFlexTtiRankedMacSchedSapProvider (MmWaveFlexTtiRankedMacScheduler<Policy>* sched)
+  : m_scheduler (sched)
+{
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  m_scheduler->DoSchedDlRlcBufferReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
+{
+  m_scheduler->DoSchedTriggerReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  m_scheduler->DoSchedDlCqiInfoReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  m_scheduler->DoSchedUlCqiInfoReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  m_scheduler->DoSchedUlMacCtrlInfoReq (params);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacSchedSapProvider<Policy>::SchedSetMcs (int mcs)
+{
+  m_scheduler->DoSchedSetMcs (mcs);
+}
+
+
+template <class Policy>
+const unsigned MmWaveFlexTtiRankedMacScheduler<Policy>::m_subHdrSize = 4;
+template <class Policy>
+const unsigned MmWaveFlexTtiRankedMacScheduler<Policy>::m_rlcHdrSize = 3;
+
+template <class Policy>
+MmWaveFlexTtiRankedMacScheduler<Policy>::MmWaveFlexTtiRankedMacScheduler ()
+  : m_ueMcsList (30),
+    m_tbUid (0),
+    m_dlNoCqiMcs (0),
+    m_macSchedSapUser (0),
+    m_macCschedSapUser (0),
+    m_timeWindow (99.0),
+    m_algorithm (EDF)
+{
+  NS_LOG_FUNCTION (this);
+  m_macSchedSapProvider = new MmWaveFlexTtiRankedMacSchedSapProvider<Policy> (this);
+  m_macCschedSapProvider = new MmWaveFlexTtiRankedMacCschedSapProvider<Policy> (this);
+}
+
+template <class Policy>
+MmWaveFlexTtiRankedMacScheduler<Policy>::~MmWaveFlexTtiRankedMacScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ues.clear ();
+  m_ueOrder.clear ();
+  m_allocated.clear ();
+  m_ueStatHeap.clear ();
+  m_ueMetrics.clear ();
+  m_ueMcsList.clear ();
+  m_flowHeap.clear ();
+  m_ulAllocationMap.clear ();
+  m_dlHarqInfoList.clear ();
+  m_ulHarqInfoList.clear ();
+  m_amc = 0;
+  delete m_macCschedSapProvider;
+  delete m_macSchedSapProvider;
+}
+
+template <class Policy>
+TypeId
+MmWaveFlexTtiRankedMacScheduler<Policy>::GetTypeId (void)
+{
+  static TypeId tid = AddPolicyAttributes (TypeId (Policy::GetTypeName ())
+    .SetParent<MmWaveMacScheduler> ()
+    .AddConstructor<MmWaveFlexTtiRankedMacScheduler<Policy> > ()
+    .AddAttribute ("CqiTimerThreshold",
+                   "The number of TTIs a CQI is valid (default 1000 - 1 sec.)",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_cqiTimersThreshold),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("HarqEnabled",
+                   "Activate/Deactivate the HARQ [by default is active].",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_harqOn),
+                   MakeBooleanChecker ())
+    .AddAttribute ("FixedMcsDl",
+                   "Fix MCS to value set in McsDlDefault",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_fixedMcsDl),
+                   MakeBooleanChecker ())
+    .AddAttribute ("McsDefaultDl",
+                   "Fixed DL MCS",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_mcsDefaultDl),
+                   MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("FixedMcsUl",
+                   "Fix MCS to value set in McsUlDefault (for testing)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_fixedMcsUl),
+                   MakeBooleanChecker ())
+    .AddAttribute ("McsDefaultUl",
+                   "Fixed UL MCS (for testing)",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_mcsDefaultUl),
+                   MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("DlSchedOnly",
+                   "Only schedule downlink traffic (for testing)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_dlOnly),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UlSchedOnly",
+                   "Only schedule uplink traffic (for testing)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_ulOnly),
+                   MakeBooleanChecker ())
+    .AddAttribute ("FixedTti",
+                   "Fix slot size",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_fixedTti),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SymPerSlot",
+                   "Number of symbols per slot in Fixed TTI mode",
+                   UintegerValue (6),
+                   MakeUintegerAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_symPerSlot),
+                   MakeUintegerChecker<uint8_t> ()));
+
+  return tid;
+}
+
+template <class Policy>
+TypeId
+MmWaveFlexTtiRankedMacScheduler<Policy>::AddPolicyAttributes (TypeId tid)
+{
+  if (Policy::RANKING == RANK_DEADLINES)
+    {
+      tid.AddAttribute ("Algorithm",
+                        "Max weight algorithm. Determines order of FlowStats element in priorty queue.",
+                        EnumValue (MmWaveFlexTtiRankedMacScheduler<Policy>::EDF),
+                        MakeEnumAccessor (&MmWaveFlexTtiRankedMacScheduler<Policy>::m_algorithm),
+                        MakeEnumChecker (MmWaveFlexTtiRankedMacScheduler<Policy>::DELIVERY_DEBT, "DeliveryDebt",
+                                         MmWaveFlexTtiRankedMacScheduler<Policy>::EDF, "EDF"));
+    }
+  return tid;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::SetMacSchedSapUser (MmWaveMacSchedSapUser* sap)
+{
+  m_macSchedSapUser = sap;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::SetMacCschedSapUser (MmWaveMacCschedSapUser* sap)
+{
+  m_macCschedSapUser = sap;
+}
+
+template <class Policy>
+MmWaveMacSchedSapProvider*
+MmWaveFlexTtiRankedMacScheduler<Policy>::GetMacSchedSapProvider ()
+{
+  return m_macSchedSapProvider;
+}
+
+template <class Policy>
+MmWaveMacCschedSapProvider*
+MmWaveFlexTtiRankedMacScheduler<Policy>::GetMacCschedSapProvider ()
+{
+  return m_macCschedSapProvider;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::ConfigureCommonParameters (Ptr<MmWavePhyMacCommon> config)
+{
+  m_phyMacConfig = config;
+  m_amc = CreateObject <MmWaveAmc> (m_phyMacConfig);
+  m_dlNoCqiMcs = m_amc->GetMcsFromCqi (1);
+}
+
+template <class Policy>
+uint32_t
+MmWaveFlexTtiRankedMacScheduler<Policy>::FindUe (uint16_t rnti) const
+{
+  std::vector<uint32_t>::const_iterator it = std::lower_bound (m_ueOrder.begin (), m_ueOrder.end (), rnti,
+                                                               [this] (uint32_t idx, uint16_t r)
+                                                               { return m_ues[idx].m_rnti < r; });
+  if (it == m_ueOrder.end () || m_ues[*it].m_rnti != rnti)
+    {
+      return m_ues.size ();
+    }
+  return *it;
+}
+
+template <class Policy>
+uint32_t
+MmWaveFlexTtiRankedMacScheduler<Policy>::FindOrAddUe (uint16_t rnti)
+{
+  std::vector<uint32_t>::iterator it = std::lower_bound (m_ueOrder.begin (), m_ueOrder.end (), rnti,
+                                                         [this] (uint32_t idx, uint16_t r)
+                                                         { return m_ues[idx].m_rnti < r; });
+  if (it != m_ueOrder.end () && m_ues[*it].m_rnti == rnti)
+    {
+      return *it;
+    }
+  uint32_t idx = m_ues.size ();
+  m_ues.push_back (MmWaveFlexTtiRankedUeInfo (rnti));
+  m_ueOrder.insert (it, idx);
+  return idx;
+}
+
+template <class Policy>
+MmWaveFlexTtiRankedUeInfo::FlowStats&
+MmWaveFlexTtiRankedMacScheduler<Policy>::GetFlowStats (const FlowRef &flow)
+{
+  MmWaveFlexTtiRankedUeInfo &ue = m_ues[flow.m_ue];
+  return flow.m_uplink ? ue.m_flowStatsUl[flow.m_lcid] : ue.m_flowStatsDl[flow.m_lcid];
+}
+
+template <class Policy>
+bool
+MmWaveFlexTtiRankedMacScheduler<Policy>::CompareFlowDeadlines (const FlowRef &lflow, const FlowRef &rflow)
+{
+  const MmWaveFlexTtiRankedUeInfo::FlowStats &l = GetFlowStats (lflow);
+  const MmWaveFlexTtiRankedUeInfo::FlowStats &r = GetFlowStats (rflow);
+  int lRelDeadline = l.m_deadlineUs - l.m_txQueueHolDelay;
+  int rRelDeadline = r.m_deadlineUs - r.m_txQueueHolDelay;
+  return (lRelDeadline < rRelDeadline);           // earlier deadline = greater weight
+}
+
+template <class Policy>
+uint32_t
+MmWaveFlexTtiRankedMacScheduler<Policy>::BsrId2BufferSize (uint8_t val) const
+{
+  NS_ABORT_MSG_UNLESS (val < 64, "val = " << val << " is out of range");
+  return BufferSizeLevelBsrTable[val];
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedDlRlcBufferReq (const struct MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti << (uint32_t) params.m_logicalChannelIdentity);
+  uint32_t idx = FindUe (params.m_rnti);
+  if (idx == m_ues.size () || !m_ues[idx].m_configured)
+    {
+      NS_LOG_ERROR ("UE entry not found in sched info map");
+      return;
+    }
+  MmWaveFlexTtiRankedUeInfo &ue = m_ues[idx];
+  uint8_t lcid = params.m_logicalChannelIdentity;
+  if ((unsigned)lcid >= ue.m_flowStatsDl.size ())
+    {
+      NS_LOG_ERROR ("LC not registered");
+      return;
+    }
+  MmWaveFlexTtiRankedUeInfo::FlowStats &flow = ue.m_flowStatsDl[lcid];
+  if (params.m_txPacketSizes.size () > 0)
+    {
+      flow.m_txPacketSizes.clear ();
+      flow.m_txPacketDelays.clear ();
+      // add the new DL PDCP packet sizes and their delays
+      uint32_t totalSize = 0;
+      double maxDelay = 0.0;
+      std::list<uint32_t>::const_iterator itSize = params.m_txPacketSizes.begin ();
+      std::list<double>::const_iterator itDelay = params.m_txPacketDelays.begin ();
+      while (itSize != params.m_txPacketSizes.end () && itDelay != params.m_txPacketDelays.end ())
+        {
+          totalSize += *itSize;
+          if (totalSize > 0)
+            {
+              flow.m_totalBufSize = params.m_rlcTransmissionQueueSize;
+              if (Policy::RANKING == RANK_DEADLINES)
+                {
+                  // only the earliest deadline ranking serves the packets one by one
+                  flow.m_txPacketSizes.push_back (*itSize);
+                  flow.m_txPacketDelays.push_back (*itDelay);
+                }
+              if (*itDelay > maxDelay)
+                {
+                  maxDelay = *itDelay;
+                }
+            }
+          itSize++;
+          itDelay++;
+        }
+      flow.m_txQueueHolDelay = maxDelay;
+    }
+  else if (params.m_rlcTransmissionQueueSize > 0)        // case for RlcSm
+    {
+      flow.m_totalBufSize = params.m_rlcTransmissionQueueSize;
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedUlMacCtrlInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
+    {
+      if ( params.m_macCeList.at (i).m_macCeType == MacCeElement::BSR )
+        {
+          // buffer status report, the LCGs are handled as separate flows
+          uint16_t rnti = params.m_macCeList.at (i).m_rnti;
+          uint32_t idx = FindUe (rnti);
+          for (uint8_t lcg = 1; lcg <= 3; ++lcg)
+            {
+              uint8_t bsrId = params.m_macCeList.at (i).m_macCeValue.m_bufferStatus.at (lcg - 1);
+              uint32_t bufSize = BsrId2BufferSize (bsrId);
+              if (bufSize > 0)
+                {
+                  if (idx == m_ues.size () || !m_ues[idx].m_configured)
+                    {
+                      NS_LOG_ERROR ("UE entry not found in sched info map");
+                      continue;
+                    }
+                  MmWaveFlexTtiRankedUeInfo::FlowStats &flow = m_ues[idx].m_flowStatsUl[lcg];
+                  int diff = bufSize - flow.m_totalBufSize;
+                  if (diff > 0)
+                    {
+                      // estimate additional packet sizes
+                      flow.m_totalBufSize += diff;
+                      if (Policy::RANKING == RANK_DEADLINES)
+                        {
+                          // since we expect the BSR to be generated following a packet arrival and sent at least by the end of the prev. subframe,
+                          // the maximum delay is one SF (in microseconds)
+                          flow.m_txPacketSizes.push_back (diff);
+                          flow.m_txPacketDelays.push_back (m_phyMacConfig->GetSubframePeriod ().GetMicroSeconds ());
+                          if (flow.m_txQueueHolDelay == 0)
+                            {
+                              flow.m_txQueueHolDelay = m_phyMacConfig->GetSubframePeriod ().GetMicroSeconds ();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedDlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
+    {
+      if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::WB )
+        {
+          // wideband CQI reporting, kept also for the UEs not configured yet
+          MmWaveFlexTtiRankedUeInfo &ue = m_ues[FindOrAddUe (params.m_cqiList.at (i).m_rnti)];
+          ue.m_dlCqiValid = true;
+          ue.m_dlCqi = params.m_cqiList.at (i).m_wbCqi;
+          ue.m_dlCqiMcs = m_amc->GetMcsFromCqi (ue.m_dlCqi);
+          ue.m_dlCqiTimer = m_cqiTimersThreshold;
+        }
+      else if ( params.m_cqiList.at (i).m_cqiType == DlCqiInfo::SB )
+        {
+          // subband CQI reporting high layer configured
+          // Not used by this scheduler
+        }
+      else
+        {
+          NS_LOG_ERROR (this << " CQI type unknown");
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedUlCqiInfoReq (const struct MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+
+  switch (params.m_ulCqi.m_type)
+    {
+    case UlCqiInfo::PUSCH:
+      {
+        typename std::map <uint32_t, struct AllocMapElem>::iterator itMap = m_ulAllocationMap.find (params.m_sfnSf.Encode ());
+        if (itMap == m_ulAllocationMap.end ())
+          {
+            NS_LOG_INFO (this << " Does not find info on allocation, size : " << m_ulAllocationMap.size ());
+            return;
+          }
+        uint32_t numChunks = m_phyMacConfig->GetNumChunks ();
+        NS_ASSERT_MSG (itMap->second.m_rntiPerChunk.size () == numChunks, "SINR chunk map must cover full BW in TDMA mode");
+        NS_ASSERT (params.m_ulCqi.m_sinr.size () >= numChunks);
+        // the TTI is allocated to a single UE in TDMA mode
+        MmWaveFlexTtiRankedUeInfo &ue = m_ues[FindOrAddUe (itMap->second.m_rntiPerChunk.at (0))];
+        NS_LOG_INFO ("UL CQI report for RNTI " << ue.m_rnti << " frame " << params.m_sfnSf.m_frameNum <<
+                     " subframe " << (unsigned)params.m_sfnSf.m_sfNum << " slot " << (unsigned)params.m_sfnSf.m_slotNum <<
+                     " startSym " << (unsigned)params.m_sfnSf.m_symStart);
+        ue.m_ulSinr.assign (params.m_ulCqi.m_sinr.begin (), params.m_ulCqi.m_sinr.begin () + numChunks);
+        ue.m_ulSinrNumSym = itMap->second.m_numSym;
+        ue.m_ulSinrTbSize = itMap->second.m_tbSize;
+        ue.m_ulCqiTimer = m_cqiTimersThreshold;
+        ue.m_ulCqiValid = true;
+        ue.m_ulCqiChanged = true;
+        // remove obsolete info on allocation
+        m_ulAllocationMap.erase (itMap);
+      }
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown type of UL-CQI");
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedSetMcs (int mcs)
+{
+  if (mcs >= 0 && mcs <= 28)
+    {
+      m_mcsDefaultDl = mcs;
+      m_mcsDefaultUl = mcs;
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::RefreshCqis (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<MmWaveFlexTtiRankedUeInfo>::iterator ue = m_ues.begin (); ue != m_ues.end (); ++ue)
+    {
+      if (ue->m_dlCqiValid)
+        {
+          if (ue->m_dlCqiTimer == 0)
+            {
+              NS_LOG_INFO (this << " DL CQI expired for user " << ue->m_rnti);
+              ue->m_dlCqiValid = false;
+            }
+          else
+            {
+              ue->m_dlCqiTimer--;
+            }
+        }
+      if (ue->m_ulCqiValid)
+        {
+          if (ue->m_ulCqiTimer == 0)
+            {
+              NS_LOG_INFO (this << " UL CQI expired for user " << ue->m_rnti);
+              ue->m_ulCqiValid = false;
+              ue->m_ulSinr.clear ();
+            }
+          else
+            {
+              ue->m_ulCqiTimer--;
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::RefreshHarqProcesses (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint8_t harqTimeout = m_phyMacConfig->GetHarqTimeout ();
+  for (std::vector<MmWaveFlexTtiRankedUeInfo>::iterator ue = m_ues.begin (); ue != m_ues.end (); ++ue)
+    {
+      for (uint16_t i = 0; i < ue->m_dlHarqTimer.size (); i++)
+        {
+          if (ue->m_dlHarqTimer[i] == harqTimeout)
+            {
+              NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << ue->m_rnti);
+              ue->m_dlHarqStatus[i] = 0;
+              ue->m_dlHarqTimer[i] = 0;
+            }
+          else
+            {
+              ue->m_dlHarqTimer[i]++;
+            }
+        }
+      for (uint16_t i = 0; i < ue->m_ulHarqTimer.size (); i++)
+        {
+          if (ue->m_ulHarqTimer[i] == harqTimeout)
+            {
+              NS_LOG_INFO (this << " Reset HARQ proc " << i << " for RNTI " << ue->m_rnti);
+              ue->m_ulHarqStatus[i] = 0;
+              ue->m_ulHarqTimer[i] = 0;
+            }
+          else
+            {
+              ue->m_ulHarqTimer[i]++;
+            }
+        }
+    }
+}
+
+template <class Policy>
+int
+MmWaveFlexTtiRankedMacScheduler<Policy>::GetUlCqi (MmWaveFlexTtiRankedUeInfo &ue, int &mcs)
+{
+  if (!ue.m_ulCqiValid)
+    {
+      NS_LOG_INFO (this << " UE " << ue.m_rnti << " does not have UL-CQI");
+      mcs = 0;
+      return 1;
+    }
+  if (ue.m_ulCqiChanged)
+    {
+      // translate vector of doubles to SpectrumValue's
+      SpectrumValue specVals (MmWaveSpectrumValueHelper::GetSpectrumModel (m_phyMacConfig));
+      Values::iterator specIt = specVals.ValuesBegin ();
+      for (uint32_t ichunk = 0; ichunk < ue.m_ulSinr.size (); ichunk++)
+        {
+          NS_ASSERT (specIt != specVals.ValuesEnd ());
+          *specIt = ue.m_ulSinr[ichunk];
+          specIt++;
+        }
+      // for UL CQI, we need to know the TB size previously allocated to accurately compute CQI/MCS
+      ue.m_ulCqi = m_amc->CreateCqiFeedbackWbTdma (specVals, ue.m_ulSinrNumSym, ue.m_ulSinrTbSize, ue.m_ulCqiMcs);
+      ue.m_ulCqiChanged = false;
+    }
+  mcs = ue.m_ulCqiMcs;
+  return ue.m_ulCqi;
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiRankedMacScheduler<Policy>::UpdateDlHarqProcessId (MmWaveFlexTtiRankedUeInfo &ue)
+{
+  NS_LOG_FUNCTION (this << ue.m_rnti);
+
+  if (m_harqOn == false)
+    {
+      uint8_t tbUid = m_tbUid;
+      m_tbUid = (m_tbUid + 1) % m_phyMacConfig->GetNumHarqProcess ();
+      return tbUid;
+    }
+
+  if (ue.m_dlHarqStatus.empty ())
+    {
+      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << ue.m_rnti);
+    }
+
+  // search for available process ID, if none available return numHarqProcess
+  uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
+  for (unsigned i = 0; i < ue.m_dlHarqStatus.size (); i++)
+    {
+      if (ue.m_dlHarqStatus[i] == 0)
+        {
+          ue.m_dlHarqStatus[i] = 1;
+          harqId = i;
+          break;
+        }
+    }
+  return harqId;
+}
+
+template <class Policy>
+uint8_t
+MmWaveFlexTtiRankedMacScheduler<Policy>::UpdateUlHarqProcessId (MmWaveFlexTtiRankedUeInfo &ue)
+{
+  NS_LOG_FUNCTION (this << ue.m_rnti);
+
+  if (m_harqOn == false)
+    {
+      uint8_t tbUid = m_tbUid;
+      m_tbUid = (m_tbUid + 1) % m_phyMacConfig->GetNumHarqProcess ();
+      return tbUid;
+    }
+
+  if (ue.m_ulHarqStatus.empty ())
+    {
+      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << ue.m_rnti);
+    }
+
+  // search for available process ID, if none available return numHarqProcess
+  uint8_t harqId = m_phyMacConfig->GetNumHarqProcess ();
+  for (unsigned i = 0; i < ue.m_ulHarqStatus.size (); i++)
+    {
+      if (ue.m_ulHarqStatus[i] == 0)
+        {
+          ue.m_ulHarqStatus[i] = 1;
+          harqId = i;
+          break;
+        }
+    }
+  return harqId;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AddAllocatedUe (uint32_t ueIdx)
+{
+  if (!m_ues[ueIdx].m_allocated)
+    {
+      m_ues[ueIdx].m_allocated = true;
+      m_allocated.push_back (ueIdx);
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::ScheduleHarqRetx (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret,
+                                                           int &symAvail, uint8_t &symIdx, uint8_t &ttiIdx)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Process DL HARQ feedback and assign slots for RETX if resources available
+  // (the feedback after the last symbol allocated is dropped)
+  std::vector <struct DlHarqInfo> dlInfoListUntxed;        // TBs not able to be retransmitted in this slot
+  for (unsigned i = 0; i < m_dlHarqInfoList.size (); i++)
+    {
+      if (symAvail == 0)
+        {
+          break;                // no symbols left to allocate
+        }
+      uint8_t harqId = m_dlHarqInfoList.at (i).m_harqProcessId;
+      uint16_t rnti = m_dlHarqInfoList.at (i).m_rnti;
+      uint32_t idx = FindUe (rnti);
+      NS_ASSERT (idx < m_ues.size () && m_ues[idx].m_configured);
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[idx];
+      if (ue.m_dlHarqStatus.empty ())
+        {
+          NS_FATAL_ERROR ("No HARQ status info found for UE " << rnti);
+        }
+      if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::ACK || ue.m_dlHarqStatus.at (harqId) == 0)
+        {
+          // acknowledgment or process timeout, reset process
+          ue.m_dlHarqStatus.at (harqId) = 0;
+          ue.m_dlHarqRlcPdu.at (harqId).clear ();
+          continue;
+        }
+      else if (m_dlHarqInfoList.at (i).m_harqStatus == DlHarqInfo::NACK)
+        {
+          DciInfoElementTdma dciInfoReTx = ue.m_dlHarqDci.at (harqId);
+          NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
+          NS_ASSERT (ue.m_dlHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
+          if (dciInfoReTx.m_rv == 3)             // maximum number of retx reached -> drop process
+            {
+              NS_LOG_INFO ("Max number of retransmissions reached -> drop process");
+              ue.m_dlHarqStatus.at (harqId) = 0;
+              ue.m_dlHarqRlcPdu.at (harqId).clear ();
+              continue;
+            }
+          // allocate retx if enough symbols are available
+          if (symAvail >= dciInfoReTx.m_numSym)
+            {
+              symAvail -= dciInfoReTx.m_numSym;
+              dciInfoReTx.m_symStart = symIdx;
+              symIdx += dciInfoReTx.m_numSym;
+              NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+              dciInfoReTx.m_rv++;
+              dciInfoReTx.m_ndi = 0;
+              ue.m_dlHarqDci.at (harqId) = dciInfoReTx;
+              ue.m_dlHarqStatus.at (harqId) = ue.m_dlHarqStatus.at (harqId) + 1;
+              TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
+              ttiInfo.m_dci = dciInfoReTx;
+              NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets DL slots " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
+                            " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
+                            " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " RETX");
+              ttiInfo.m_rlcPduInfo = ue.m_dlHarqRlcPdu.at (dciInfoReTx.m_harqProcess);
+              ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+              ret.m_slotAllocInfo.m_numSymAlloc += dciInfoReTx.m_numSym;
+
+              ue.m_dlSymbolsRetx = dciInfoReTx.m_numSym;
+              AddAllocatedUe (idx);
+            }
+          else
+            {
+              NS_LOG_INFO ("No resource for this retx -> buffer it");
+              dlInfoListUntxed.push_back (m_dlHarqInfoList.at (i));
+            }
+        }
+    }
+  m_dlHarqInfoList = dlInfoListUntxed;
+
+  // Process UL HARQ feedback
+  std::vector <struct UlHarqInfo> ulInfoListUntxed;
+  for (uint16_t i = 0; i < m_ulHarqInfoList.size (); i++)
+    {
+      if (symAvail == 0)
+        {
+          break;                // no symbols left to allocate
+        }
+      UlHarqInfo harqInfo = m_ulHarqInfoList.at (i);
+      uint8_t harqId = harqInfo.m_harqProcessId;
+      uint16_t rnti = harqInfo.m_rnti;
+      uint32_t idx = FindUe (rnti);
+      NS_ASSERT (idx < m_ues.size () && m_ues[idx].m_configured);
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[idx];
+      if (ue.m_ulHarqStatus.empty ())
+        {
+          NS_LOG_ERROR ("No info found in HARQ buffer for UE (might have changed eNB) " << rnti);
+          continue;
+        }
+      if (harqInfo.m_receptionStatus == UlHarqInfo::Ok || ue.m_ulHarqStatus.at (harqId) == 0)
+        {
+          ue.m_ulHarqStatus.at (harqId) = 0;            // release process ID
+        }
+      else if (harqInfo.m_receptionStatus == UlHarqInfo::NotOk)
+        {
+          // retx correspondent block: retrieve the UL-DCI
+          DciInfoElementTdma dciInfoReTx = ue.m_ulHarqDci.at (harqId);
+          NS_ASSERT (harqId == dciInfoReTx.m_harqProcess);
+          NS_ASSERT (ue.m_ulHarqStatus.at (harqId) > 0);
+          NS_ASSERT (ue.m_ulHarqStatus.at (harqId) - 1 == dciInfoReTx.m_rv);
+          if (dciInfoReTx.m_rv == 3)
+            {
+              NS_LOG_INFO ("Max number of retransmissions reached (UL)-> drop process");
+              ue.m_ulHarqStatus.at (harqId) = 0;
+              continue;
+            }
+          if (symAvail >= dciInfoReTx.m_numSym)
+            {
+              symAvail -= dciInfoReTx.m_numSym;
+              dciInfoReTx.m_symStart = symIdx;
+              symIdx += dciInfoReTx.m_numSym;
+              NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+              dciInfoReTx.m_rv++;
+              dciInfoReTx.m_ndi = 0;
+              ue.m_ulHarqStatus.at (harqId) = ue.m_ulHarqStatus.at (harqId) + 1;
+              ue.m_ulHarqDci.at (harqId) = dciInfoReTx;
+              TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, rnti);
+              ttiInfo.m_dci = dciInfoReTx;
+              NS_LOG_DEBUG ("UE" << dciInfoReTx.m_rnti << " gets UL OFDM symbols " << (unsigned)dciInfoReTx.m_symStart << "-" << (unsigned)(dciInfoReTx.m_symStart + dciInfoReTx.m_numSym - 1) <<
+                            " tbs " << dciInfoReTx.m_tbSize << " harqId " << (unsigned)dciInfoReTx.m_harqProcess <<
+                            " rv " << (unsigned)dciInfoReTx.m_rv << " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum << " slot " <<
+                            (unsigned)ret.m_sfnSf.m_slotNum << " RETX");
+              ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+              ret.m_slotAllocInfo.m_numSymAlloc += dciInfoReTx.m_numSym;
+
+              ue.m_ulSymbolsRetx = dciInfoReTx.m_numSym;
+              AddAllocatedUe (idx);
+            }
+          else
+            {
+              ulInfoListUntxed.push_back (m_ulHarqInfoList.at (i));
+            }
+        }
+    }
+  m_ulHarqInfoList = ulInfoListUntxed;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::UpdateCandidates (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (Policy::RANKING == RANK_MCS)
+    {
+      for (unsigned i = 0; i < m_ueMcsList.size (); i++)
+        {
+          m_ueMcsList[i].clear ();
+        }
+    }
+
+  // compute achievable rates in current slot
+  double slotPeriod = m_phyMacConfig->GetSlotPeriod ().GetSeconds ();
+  for (std::vector<uint32_t>::const_iterator it = m_ueOrder.begin (); it != m_ueOrder.end (); ++it)
+    {
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[*it];
+      if (!ue.m_configured)
+        {
+          continue;
+        }
+
+      // get DL-CQI and compute DL rate per symbol
+      bool dlAdded = false;
+      uint8_t cqi = 1;            // lowest value for trying a transmission
+      uint8_t mcs = m_dlNoCqiMcs;
+      if (ue.m_dlCqiValid)
+        {
+          cqi = ue.m_dlCqi;
+          mcs = ue.m_dlCqiMcs;
+        }
+      else
+        {
+          NS_LOG_INFO (this << " UE " << ue.m_rnti << " does not have DL-CQI");
+        }
+      if (cqi != 0)
+        {
+          ue.m_dlMcs = mcs;
+          if (Policy::RANKING == RANK_MCS)
+            {
+              m_ueMcsList[ue.m_dlMcs].push_back (*it);
+            }
+          // compute total DL bytes buffered
+          for (unsigned iflow = 0; iflow < ue.m_flowStatsDl.size (); iflow++)
+            {
+              if (ue.m_flowStatsDl[iflow].m_totalBufSize > 0)
+                {
+                  ue.m_totBufDl += ue.m_flowStatsDl[iflow].m_totalBufSize;
+                  RlcPduInfo newRlcEl;
+                  newRlcEl.m_lcid = ue.m_flowStatsDl[iflow].m_lcid;
+                  newRlcEl.m_size = ue.m_flowStatsDl[iflow].m_totalBufSize + (Policy::ADD_HEADERS ? m_subHdrSize + m_rlcHdrSize : 0);
+                  ue.m_rlcPduInfo.push_back (newRlcEl);
+                }
+            }
+          if (ue.m_totBufDl > 0)
+            {
+              uint32_t tbSizeMax = m_amc->GetTbSizeFromMcsSymbols (ue.m_dlMcs, 1);
+              ue.m_currTputDl = std::min (ue.m_totBufDl,tbSizeMax) / slotPeriod;
+              if (Policy::RANKING == RANK_UES)
+                {
+                  m_ueStatHeap.push_back (*it);
+                }
+              AddAllocatedUe (*it);
+              dlAdded = true;
+            }
+        }
+
+      // get UL-CQI and compute UL rate per symbol
+      int ulMcs = 0;
+      int ulCqi = GetUlCqi (ue, ulMcs);
+      if (ulCqi != 0)
+        {
+          ue.m_ulMcs = ulMcs;
+          if (Policy::RANKING == RANK_MCS)
+            {
+              std::vector<uint32_t> &ueList = m_ueMcsList[ue.m_ulMcs];
+              if (ueList.empty () || ueList.back () != *it)
+                {
+                  ueList.push_back (*it);
+                }
+            }
+          for (unsigned iflow = 0; iflow < ue.m_flowStatsUl.size (); iflow++)
+            {
+              ue.m_totBufUl += ue.m_flowStatsUl[iflow].m_totalBufSize + (Policy::ADD_HEADERS ? m_subHdrSize + m_rlcHdrSize : 0);
+            }
+          if (ue.m_totBufUl > 0)
+            {
+              uint32_t tbSizeMax = m_amc->GetTbSizeFromMcsSymbols (ue.m_ulMcs, 1);
+              ue.m_currTputUl = std::min (ue.m_totBufUl,tbSizeMax) / slotPeriod;
+              if (!dlAdded)
+                {
+                  if (Policy::RANKING == RANK_UES)
+                    {
+                      m_ueStatHeap.push_back (*it);
+                    }
+                  AddAllocatedUe (*it);
+                }
+            }
+        }
+    }
+}
+
+template <class Policy>
+bool
+MmWaveFlexTtiRankedMacScheduler<Policy>::AllocateSymbol (MmWaveFlexTtiRankedUeInfo &ue, int &symAvail)
+{
+  double slotPeriod = m_phyMacConfig->GetSlotPeriod ().GetSeconds ();
+  if (ue.m_totBufDl == 0)
+    {
+      ue.m_dlAllocDone = true;
+    }
+  if (ue.m_totBufUl == 0)
+    {
+      ue.m_ulAllocDone = true;
+    }
+  if ((ue.m_allocUlLast || ue.m_dlAllocDone) && !ue.m_ulAllocDone)
+    {
+      // allocate to the UL if the DL was served last
+      ue.m_ulSymbols++;
+      symAvail--;
+      ue.m_ulTbSize = m_amc->GetTbSizeFromMcsSymbols (ue.m_ulMcs, ue.m_ulSymbols) / 8;
+      if (ue.m_ulTbSize >= ue.m_totBufUl)
+        {
+          ue.m_ulAllocDone = true;
+          ue.m_lastAvgTputUl = ue.m_avgTputUl;
+        }
+      ue.m_allocUlLast = true;
+
+      uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ue.m_ulMcs, ue.m_ulSymbols);
+      ue.m_currTputUl = std::min (ue.m_totBufUl,tbSize) / slotPeriod;
+      ue.m_avgTputUl = ((1.0 - (1.0 / m_timeWindow)) * ue.m_lastAvgTputUl) +
+        ((1.0 / m_timeWindow) * ((double)ue.m_ulTbSize / slotPeriod));
+      return true;
+    }
+  else if (!ue.m_dlAllocDone)
+    {
+      ue.m_dlSymbols++;
+      symAvail--;
+      ue.m_dlTbSize = m_amc->GetTbSizeFromMcsSymbols (ue.m_dlMcs, ue.m_dlSymbols) / 8;
+      if (ue.m_dlTbSize >= ue.m_totBufDl)
+        {
+          ue.m_dlAllocDone = true;
+          ue.m_lastAvgTputDl = ue.m_avgTputDl;
+        }
+      ue.m_allocUlLast = false;
+
+      uint32_t tbSize = m_amc->GetTbSizeFromMcsSymbols (ue.m_dlMcs, ue.m_dlSymbols);
+      ue.m_currTputDl = std::min (ue.m_totBufDl,tbSize) / slotPeriod;
+      ue.m_avgTputDl = ((1.0 - (1.0 / m_timeWindow)) * ue.m_lastAvgTputDl) +
+        ((1.0 / m_timeWindow) * ((double)ue.m_dlTbSize / slotPeriod));
+      return true;
+    }
+  return false;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AllocateSymbols (int &symAvail, RankingTag<RANK_UES>)
+{
+  NS_LOG_FUNCTION (this);
+  // the UEs ranked first by the policy get one symbol at a time, and the UEs are ranked again
+  // after each symbol. Only the metric of the UE served changes, so the metrics are computed
+  // once and then updated, rather than in each comparison of the sort.
+  m_ueMetrics.resize (m_ues.size ());
+  for (uint32_t i = 0; i < m_ues.size (); i++)
+    {
+      m_ueMetrics[i] = Policy::GetMetric (m_ues[i]);
+    }
+  const double *metrics = m_ueMetrics.data ();
+  while (symAvail > 0)
+    {
+      std::sort (m_ueStatHeap.begin (), m_ueStatHeap.end (),
+                 [metrics] (uint32_t lue, uint32_t rue)
+                 { return metrics[lue] > metrics[rue]; });
+      bool ueAlloc = false;
+      for (std::vector<uint32_t>::iterator it = m_ueStatHeap.begin (); !ueAlloc && it != m_ueStatHeap.end (); ++it)
+        {
+          ueAlloc = AllocateSymbol (m_ues[*it], symAvail);
+          if (ueAlloc)
+            {
+              m_ueMetrics[*it] = Policy::GetMetric (m_ues[*it]);
+            }
+        }
+      if (!ueAlloc)
+        {
+          break;
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AllocateSymbols (int &symAvail, RankingTag<RANK_MCS>)
+{
+  NS_LOG_FUNCTION (this);
+  // the UEs with the highest MCS get one symbol each in turn until they are served
+  for (int imcs = 28; imcs >= 0; imcs--)
+    {
+      const std::vector<uint32_t> &ueList = m_ueMcsList[imcs];
+      bool ueAlloc = !ueList.empty ();
+      while (symAvail > 0 && ueAlloc)
+        {
+          ueAlloc = false;
+          for (unsigned i = 0; i < ueList.size () && symAvail > 0; i++)
+            {
+              if (AllocateSymbol (m_ues[ueList[i]], symAvail))
+                {
+                  ueAlloc = true;
+                }
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AllocateSymbols (int &symAvail, RankingTag<RANK_DEADLINES>)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_algorithm != EDF)
+    {
+      // only the earliest deadline first order is implemented
+      return;
+    }
+
+  while (symAvail > 0)
+    {
+      // sort flow heap by relative deadline
+      std::sort (m_flowHeap.begin (), m_flowHeap.end (),
+                 [this] (const FlowRef &lflow, const FlowRef &rflow)
+                 { return CompareFlowDeadlines (lflow, rflow); });
+      bool flowFound = false;
+      // find flow with CQI in range (not in outage)
+      for (typename std::vector<FlowRef>::iterator it = m_flowHeap.begin (); !flowFound && it != m_flowHeap.end () && symAvail > 0; ++it)
+        {
+          MmWaveFlexTtiRankedUeInfo::FlowStats &flow = GetFlowStats (*it);
+          if (flow.m_txPacketSizes.empty ())
+            {
+              continue;
+            }
+          MmWaveFlexTtiRankedUeInfo &ue = m_ues[it->m_ue];
+          int cqi = 1;              // lowest value for trying a transmission
+          int mcs = 0;
+          if (!it->m_uplink)
+            {
+              mcs = m_dlNoCqiMcs;
+              if (ue.m_dlCqiValid)
+                {
+                  cqi = ue.m_dlCqi;
+                  mcs = ue.m_dlCqiMcs;
+                }
+            }
+          else
+            {
+              cqi = GetUlCqi (ue, mcs);
+            }
+          if (cqi == 0)
+            {
+              // out of range (SINR too low)
+              NS_LOG_INFO ("*** RNTI " << ue.m_rnti << " CQI out of range, skipping allocation");
+              continue;
+            }
+          flowFound = true;
+          AddAllocatedUe (it->m_ue);
+          if (!it->m_uplink)
+            {
+              ue.m_dlMcs = mcs;
+            }
+          else
+            {
+              ue.m_ulMcs = mcs;
+            }
+          AllocatePacket (flow, ue, it->m_uplink, symAvail);
+        }
+      if (!flowFound)
+        {
+          // no active flows found
+          break;
+        }
+    }
+
+  // since any remaining packets in buffer will not be scheduled this subframe,
+  // add 1 SF of additional delay
+  double sfPeriodUs = m_phyMacConfig->GetSubframePeriod ().GetMicroSeconds ();
+  for (typename std::vector<FlowRef>::iterator it = m_flowHeap.begin (); it != m_flowHeap.end (); ++it)
+    {
+      MmWaveFlexTtiRankedUeInfo::FlowStats &flow = GetFlowStats (*it);
+      for (std::deque<double>::iterator delayIt = flow.m_txPacketDelays.begin ();
+           delayIt != flow.m_txPacketDelays.end (); delayIt++)
+        {
+          *delayIt += sfPeriodUs;
+        }
+      if (flow.m_txPacketDelays.size () > 0)
+        {
+          flow.m_txQueueHolDelay = flow.m_txPacketDelays.front ();
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AllocatePacket (MmWaveFlexTtiRankedUeInfo::FlowStats &flow, MmWaveFlexTtiRankedUeInfo &ue,
+                                                         bool uplink, int &symAvail)
+{
+  uint8_t &symbols = uplink ? ue.m_ulSymbols : ue.m_dlSymbols;
+  uint32_t &tbSize = uplink ? ue.m_ulTbSize : ue.m_dlTbSize;
+  uint8_t mcs = uplink ? ue.m_ulMcs : ue.m_dlMcs;
+
+  // compute total TB size if we send whole RLC PDU
+  uint32_t pduSize = flow.m_txPacketSizes.front () + m_rlcHdrSize + m_subHdrSize;
+  // get required additional symbols to send whole RLC PDU given current TB size
+  // (could be zero additional symbols if enough resources already allocated)
+  uint32_t numSymReq = m_amc->GetNumSymbolsFromTbsMcs ((tbSize + pduSize) * 8, mcs) - symbols;
+  if (numSymReq <= (unsigned)symAvail)
+    {
+      // sufficient symbols to TX whole RLC PDU at this MCS
+      flow.m_txPacketSizes.pop_front ();
+      // fixed TTI: slot must be multiple of m_symPerSlot symbols
+      // (for last slot, can be less due to control period)
+      if (m_fixedTti)
+        {
+          uint32_t numSymFixed = m_symPerSlot * ceil ((double)numSymReq / (double)m_symPerSlot);
+          if (numSymFixed > (unsigned)symAvail)
+            {
+              numSymFixed = symAvail;
+            }
+          if (numSymFixed > numSymReq)
+            {
+              numSymReq = numSymFixed;
+              // recalculate TB size in case numSymReq increased
+              pduSize = m_amc->GetTbSizeFromMcsSymbols (mcs, symbols + numSymReq) / 8 - tbSize;
+            }
+        }
+      symbols += numSymReq;
+      tbSize += pduSize;
+      symAvail -= numSymReq;
+      flow.m_txPacketDelays.pop_front ();
+      if (flow.m_txPacketDelays.size () > 0)
+        {
+          flow.m_txQueueHolDelay = flow.m_txPacketDelays.front ();
+        }
+    }
+  else
+    {
+      // insufficient symbols, allocate remaining symbols (must segment RLC PDU)
+      uint32_t tbSizeBits = m_amc->GetTbSizeFromMcsSymbols (mcs, symbols + symAvail);
+      pduSize = ceil (tbSizeBits / 8.0) - tbSize - (m_rlcHdrSize + m_subHdrSize);
+      NS_ASSERT (!uplink || pduSize <= flow.m_txPacketSizes.front ());
+      flow.m_txPacketSizes.front () -= pduSize;            // subtract from HOL packet
+      symbols += symAvail;
+      tbSize += pduSize;
+      symAvail = 0;
+    }
+  NS_LOG_DEBUG ("UE" << ue.m_rnti << " LCID " << (unsigned)flow.m_lcid << " assigned " << (unsigned)symbols <<
+                (uplink ? " UL" : " DL") << " symbols at MCS " << (unsigned)mcs << " (remaining == " << symAvail << ")");
+  if (!uplink)
+    {
+      ue.m_rlcPduInfo.push_back (RlcPduInfo (flow.m_lcid, pduSize));
+    }
+  uint32_t sduSize = pduSize - (m_rlcHdrSize + m_subHdrSize);
+  flow.m_totalBufSize -= sduSize;
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::AddRlcPdus (MmWaveFlexTtiRankedUeInfo &ue, const DciInfoElementTdma &dci, TtiAllocInfo &ttiInfo)
+{
+  if (Policy::RANKING == RANK_DEADLINES)
+    {
+      // the PDUs are the packets allocated, the remaining bytes go to the default bearer
+      unsigned totalBytesAlloc = 0;
+      for (unsigned i = 0; i < ue.m_rlcPduInfo.size (); i++)
+        {
+          totalBytesAlloc += ue.m_rlcPduInfo[i].m_size;
+        }
+      for (unsigned i = 0; i < ue.m_rlcPduInfo.size (); i++)
+        {
+          if (ue.m_rlcPduInfo[i].m_lcid == 3 && totalBytesAlloc < dci.m_tbSize)
+            {
+              ue.m_rlcPduInfo[i].m_size += dci.m_tbSize - totalBytesAlloc;
+            }
+          ttiInfo.m_rlcPduInfo.push_back (ue.m_rlcPduInfo[i]);
+          if (m_harqOn == true)
+            {
+              // store RLC PDU list for HARQ
+              ue.m_dlHarqRlcPdu.at (dci.m_harqProcess).push_back (ue.m_rlcPduInfo[i]);
+            }
+        }
+      return;
+    }
+
+  // distribute bytes between active RLC queues
+  unsigned numLc = ue.m_rlcPduInfo.size ();
+  unsigned bytesRem = dci.m_tbSize;
+  unsigned numFulfilled = 0;
+  uint16_t avgPduSize = bytesRem / numLc;
+  // first for loop computes extra to add to average if some flows are less than average
+  for (unsigned i = 0; i < ue.m_rlcPduInfo.size (); i++)
+    {
+      if (ue.m_rlcPduInfo[i].m_size < avgPduSize)
+        {
+          bytesRem -= ue.m_rlcPduInfo[i].m_size;
+          numFulfilled++;
+        }
+    }
+
+  if (numFulfilled < ue.m_rlcPduInfo.size ())
+    {
+      avgPduSize = bytesRem / (ue.m_rlcPduInfo.size () - numFulfilled);
+    }
+
+  for (unsigned i = 0; i < ue.m_rlcPduInfo.size (); i++)
+    {
+      if (ue.m_rlcPduInfo[i].m_size > avgPduSize)
+        {
+          ue.m_rlcPduInfo[i].m_size = avgPduSize;
+        }
+      // else tbSize equals RLC queue size
+      NS_ASSERT (ue.m_rlcPduInfo[i].m_size > 0);
+    }
+
+  // each PDU is added twice, as by the former implementations of the PF and
+  // maximum rate schedulers
+  for (unsigned k = 0; k < 2; k++)
+    {
+      for (unsigned i = 0; i < ue.m_rlcPduInfo.size (); i++)
+        {
+          ttiInfo.m_rlcPduInfo.push_back (ue.m_rlcPduInfo[i]);
+          if (m_harqOn == true)
+            {
+              // store RLC PDU list for HARQ
+              ue.m_dlHarqRlcPdu.at (dci.m_harqProcess).push_back (ue.m_rlcPduInfo[i]);
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::CreateDcis (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret, uint8_t symIdx, uint8_t ttiIdx)
+{
+  NS_LOG_FUNCTION (this);
+
+  // the DCIs are created in increasing RNTI order
+  std::sort (m_allocated.begin (), m_allocated.end (),
+             [this] (uint32_t lue, uint32_t rue)
+             { return m_ues[lue].m_rnti < m_ues[rue].m_rnti; });
+
+  // iterate through the allocated UEs, assign TDMA symbol indices and create DCIs
+  for (std::vector<uint32_t>::const_iterator it = m_allocated.begin (); it != m_allocated.end (); ++it)
+    {
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[*it];
+      if (ue.m_dlSymbols == 0)
+        {
+          continue;
+        }
+      DciInfoElementTdma dci;
+      dci.m_rnti = ue.m_rnti;
+      dci.m_format = 0;
+      dci.m_symStart = symIdx;
+      dci.m_numSym = ue.m_dlSymbols;
+      symIdx += ue.m_dlSymbols;
+      NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+      dci.m_mcs = ue.m_dlMcs;
+      dci.m_rv = 0;
+      dci.m_ndi = 1;
+      dci.m_tbSize = m_amc->GetTbSizeFromMcsSymbols (dci.m_mcs, dci.m_numSym) / 8;
+      dci.m_harqProcess = UpdateDlHarqProcessId (ue);
+      NS_ASSERT (dci.m_harqProcess < m_phyMacConfig->GetNumHarqProcess ());
+      TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, ue.m_rnti);
+      ttiInfo.m_dci = dci;
+      NS_LOG_DEBUG ("UE" << dci.m_rnti << " gets DL symbols " << (unsigned)dci.m_symStart << "-" << (unsigned)(dci.m_symStart + dci.m_numSym - 1) <<
+                    " tbs " << dci.m_tbSize << " mcs " << (unsigned)dci.m_mcs << " harqId " << (unsigned)dci.m_harqProcess << " rv " << (unsigned)dci.m_rv <<
+                    " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum);
+
+      if (m_harqOn == true)
+        {
+          // store DCI for HARQ buffer and refresh timer
+          ue.m_dlHarqDci.at (dci.m_harqProcess) = dci;
+          ue.m_dlHarqTimer.at (dci.m_harqProcess) = 0;
+        }
+
+      AddRlcPdus (ue, dci, ttiInfo);
+
+      if (m_harqOn == true)
+        {
+          // reorder/reindex slots to maintain DL before UL slot order
+          bool reordered = false;
+          std::deque <TtiAllocInfo>::iterator itTti = ret.m_slotAllocInfo.m_ttiAllocInfo.begin ();
+          for (unsigned iTti = 0; iTti < ret.m_slotAllocInfo.m_ttiAllocInfo.size (); iTti++)
+            {
+              if (ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_tddMode == TtiAllocInfo::UL_slotAllocInfo)
+                {
+                  ttiInfo.m_ttiIdx = ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_ttiIdx;
+                  ttiInfo.m_dci.m_symStart = ret.m_slotAllocInfo.m_ttiAllocInfo [iTti].m_dci.m_symStart;
+                  ret.m_slotAllocInfo.m_ttiAllocInfo.insert (itTti, ttiInfo);
+                  for (unsigned jTti = iTti + 1; jTti < ret.m_slotAllocInfo.m_ttiAllocInfo.size (); jTti++)
+                    {
+                      ret.m_slotAllocInfo.m_ttiAllocInfo[jTti].m_ttiIdx++;         // increase indices of UL slots
+                      ret.m_slotAllocInfo.m_ttiAllocInfo[jTti].m_dci.m_symStart =
+                        ret.m_slotAllocInfo.m_ttiAllocInfo[jTti - 1].m_dci.m_symStart +
+                        ret.m_slotAllocInfo.m_ttiAllocInfo[jTti - 1].m_dci.m_numSym;
+                    }
+                  reordered = true;
+                  break;
+                }
+              itTti++;
+            }
+          if (!reordered)
+            {
+              ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+            }
+        }
+      else
+        {
+          ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+        }
+      ret.m_slotAllocInfo.m_numSymAlloc += dci.m_numSym;
+    }
+
+  ttiIdx = ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_ttiIdx + 1;
+  symIdx = ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_dci.m_symStart + ret.m_slotAllocInfo.m_ttiAllocInfo.back ().m_dci.m_numSym;
+
+  for (std::vector<uint32_t>::const_iterator it = m_allocated.begin (); it != m_allocated.end (); ++it)
+    {
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[*it];
+      // Note: UL-DCI applies to subframe i+Tsched
+      if (ue.m_ulSymbols == 0)
+        {
+          continue;
+        }
+      DciInfoElementTdma dci;
+      dci.m_rnti = ue.m_rnti;
+      dci.m_format = 1;
+      dci.m_symStart = symIdx;
+      dci.m_numSym = ue.m_ulSymbols;
+      symIdx += ue.m_ulSymbols;
+      NS_ASSERT (symIdx <= m_phyMacConfig->GetSymbPerSlot () - m_phyMacConfig->GetUlCtrlSymbols ());
+      dci.m_mcs = ue.m_ulMcs;
+      dci.m_ndi = 1;
+      dci.m_tbSize = m_amc->GetTbSizeFromMcsSymbols (dci.m_mcs, dci.m_numSym) / 8;
+      dci.m_harqProcess = UpdateUlHarqProcessId (ue);
+      NS_ASSERT (dci.m_harqProcess < m_phyMacConfig->GetNumHarqProcess ());
+      TtiAllocInfo ttiInfo (ttiIdx++, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL_DATA, ue.m_rnti);
+      ttiInfo.m_dci = dci;
+      NS_LOG_DEBUG ("UE" << dci.m_rnti << " gets UL symbols " << (unsigned)dci.m_symStart << "-" << (unsigned)(dci.m_symStart + dci.m_numSym - 1) <<
+                    " tbs " << dci.m_tbSize << " mcs " << (unsigned)dci.m_mcs << " harqId " << (unsigned)dci.m_harqProcess << " rv " << (unsigned)dci.m_rv <<
+                    " in frame " << ret.m_sfnSf.m_frameNum << " subframe " << (unsigned)ret.m_sfnSf.m_sfNum);
+      ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ttiInfo);
+      ret.m_slotAllocInfo.m_numSymAlloc += dci.m_numSym;
+
+      // insert into allocation map to recall previous allocations upon receiving UL-CQI
+      std::vector<uint16_t> ueChunkMap (m_phyMacConfig->GetNumChunks (), dci.m_rnti);
+      SfnSf slotSfn = ret.m_slotAllocInfo.m_sfnSf;
+      slotSfn.m_slotNum = dci.m_symStart;        // use the start symbol index of the slot because the absolute UL slot index depends on the future DL allocation
+      m_ulAllocationMap.insert (std::pair<uint32_t, struct AllocMapElem> (slotSfn.Encode (), AllocMapElem (ueChunkMap, dci.m_numSym, dci.m_tbSize)));
+
+      if (m_harqOn == true)
+        {
+          // store DCI for HARQ buffer and refresh timer
+          ue.m_ulHarqDci.at (dci.m_harqProcess) = dci;
+          NS_ASSERT (ue.m_ulHarqStatus[dci.m_harqProcess] > 0);
+          ue.m_ulHarqTimer.at (dci.m_harqProcess) = 0;
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::ResetAllocation (void)
+{
+  // reset the alloc info for the next scheduler call, the last average throughputs and the
+  // direction of the last symbol are kept
+  for (std::vector<uint32_t>::const_iterator it = m_allocated.begin (); it != m_allocated.end (); ++it)
+    {
+      MmWaveFlexTtiRankedUeInfo &ue = m_ues[*it];
+      ue.m_allocated = false;
+      ue.m_dlSymbols = 0;
+      ue.m_ulSymbols = 0;
+      ue.m_dlTbSize = 0;
+      ue.m_ulTbSize = 0;
+      ue.m_dlSymbolsRetx = 0;
+      ue.m_ulSymbolsRetx = 0;
+      ue.m_currTputDl = 0;
+      ue.m_currTputUl = 0;
+      ue.m_avgTputDl = 0;
+      ue.m_avgTputUl = 0;
+      ue.m_totBufDl = 0;
+      ue.m_totBufUl = 0;
+      ue.m_dlAllocDone = false;
+      ue.m_ulAllocDone = false;
+      ue.m_rlcPduInfo.clear ();
+    }
+  m_allocated.clear ();
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::SendAllocation (MmWaveMacSchedSapUser::SchedConfigIndParameters &ret)
+{
+  // add slot for UL control
+  TtiAllocInfo ulCtrlSlot (0xFF, TtiAllocInfo::UL_slotAllocInfo, TtiAllocInfo::CTRL, 0);
+  ulCtrlSlot.m_dci.m_numSym = 1;
+  ulCtrlSlot.m_dci.m_symStart = m_phyMacConfig->GetSymbPerSlot () - 1;
+  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (ulCtrlSlot);
+  m_macSchedSapUser->SchedConfigInd (ret);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoSchedTriggerReq (const struct MmWaveMacSchedSapProvider::SchedTriggerReqParameters& params)
+{
+  MmWaveMacSchedSapUser::SchedConfigIndParameters ret;
+  ret.m_sfnSf = params.m_snfSf;
+  ret.m_slotAllocInfo.m_sfnSf = ret.m_sfnSf;
+
+  NS_LOG_DEBUG ("Creating scheduling allocation info for: frame " << params.m_snfSf.m_frameNum << " subframe "
+                << (unsigned)params.m_snfSf.m_sfNum << " slot " << (unsigned)params.m_snfSf.m_slotNum);
+
+  // Add TTI for DL control at the beginning of the slot
+  TtiAllocInfo dlCtrlSlot (0, TtiAllocInfo::DL_slotAllocInfo, TtiAllocInfo::CTRL, 0);
+  dlCtrlSlot.m_dci.m_numSym = 1;
+  dlCtrlSlot.m_dci.m_symStart = 0;
+  ret.m_slotAllocInfo.m_ttiAllocInfo.push_back (dlCtrlSlot);
+  int resvCtrl = m_phyMacConfig->GetDlCtrlSymbols () + m_phyMacConfig->GetUlCtrlSymbols ();
+  int symAvail = m_phyMacConfig->GetSymbPerSlot () - resvCtrl;
+  uint8_t ttiIdx = 1;
+  uint8_t symIdx = m_phyMacConfig->GetDlCtrlSymbols ();      // symbols reserved for control at beginning of subframe
+
+  RefreshCqis ();
+  RefreshHarqProcesses ();
+
+  // retrieve past HARQ retx buffered
+  m_dlHarqInfoList.insert (m_dlHarqInfoList.end (), params.m_dlHarqInfoList.begin (), params.m_dlHarqInfoList.end ());
+  m_ulHarqInfoList.insert (m_ulHarqInfoList.end (), params.m_ulHarqInfoList.begin (), params.m_ulHarqInfoList.end ());
+
+  if (m_harqOn == false)
+    {
+      // Ignore HARQ feedback
+      m_dlHarqInfoList.clear ();
+    }
+  else
+    {
+      ScheduleHarqRetx (ret, symAvail, symIdx, ttiIdx);
+    }
+
+  if (symAvail == 0)
+    {
+      // no further allocations, only the retransmissions are reset
+      SendAllocation (ret);
+      for (std::vector<uint32_t>::const_iterator it = m_allocated.begin (); it != m_allocated.end (); ++it)
+        {
+          m_ues[*it].m_allocated = false;
+          m_ues[*it].m_dlSymbolsRetx = 0;
+          m_ues[*it].m_ulSymbolsRetx = 0;
+        }
+      m_allocated.clear ();
+      return;
+    }
+
+  if (Policy::RANKING != RANK_DEADLINES)
+    {
+      UpdateCandidates ();
+    }
+  AllocateSymbols (symAvail, RankingTag<Policy::RANKING> ());
+
+  if (m_allocated.empty ())
+    {
+      // no further allocations
+      SendAllocation (ret);
+      return;
+    }
+
+  CreateDcis (ret, symIdx, ttiIdx);
+  ResetAllocation ();
+  SendAllocation (ret);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoCschedCellConfigReq (const struct MmWaveMacCschedSapProvider::CschedCellConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  // Read the subset of parameters used
+  m_cschedCellConfig = params;
+  MmWaveMacCschedSapUser::CschedUeConfigCnfParameters cnf;
+  cnf.m_result = SUCCESS;
+  m_macCschedSapUser->CschedUeConfigCnf (cnf);
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoCschedUeConfigReq (const struct MmWaveMacCschedSapProvider::CschedUeConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
+
+  MmWaveFlexTtiRankedUeInfo &ue = m_ues[FindOrAddUe (params.m_rnti)];
+  ue.m_configured = true;
+  uint8_t numHarqProcess = m_phyMacConfig->GetNumHarqProcess ();
+  if (ue.m_dlHarqStatus.empty ())
+    {
+      ue.m_dlHarqStatus.resize (numHarqProcess, 0);
+      ue.m_dlHarqTimer.resize (numHarqProcess, 0);
+      ue.m_dlHarqDci.resize (numHarqProcess);
+      ue.m_dlHarqRlcPdu.resize (numHarqProcess);
+    }
+  if (ue.m_ulHarqStatus.empty ())
+    {
+      ue.m_ulHarqStatus.resize (numHarqProcess, 0);
+      ue.m_ulHarqTimer.resize (numHarqProcess, 0);
+      ue.m_ulHarqDci.resize (numHarqProcess);
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoCschedLcConfigReq (const struct MmWaveMacCschedSapProvider::CschedLcConfigReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t idx = FindUe (params.m_rnti);
+  if (idx == m_ues.size () || !m_ues[idx].m_configured)
+    {
+      NS_LOG_ERROR ("Cannot find UE info entry");
+      return;
+    }
+  MmWaveFlexTtiRankedUeInfo &ue = m_ues[idx];
+  EpsBearer lowLatBearer (EpsBearer::NGBR_LOW_LAT_EMBB_AR);
+  for (uint16_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
+    {
+      const LogicalChannelConfigListElement_s &lc = params.m_logicalChannelConfigList[i];
+      if (lc.m_direction == LogicalChannelConfigListElement_s::DIR_DL)
+        {
+          uint8_t lcid = lc.m_logicalChannelIdentity;
+          for (unsigned j = ue.m_flowStatsDl.size (); j <= lcid; j++)
+            {
+              ue.m_flowStatsDl.push_back (MmWaveFlexTtiRankedUeInfo::FlowStats (j));
+            }
+          ue.m_flowStatsDl[lcid].m_qci = lc.m_qci;
+          if (lc.m_qci == EpsBearer::NGBR_LOW_LAT_EMBB_AR)
+            {
+              ue.m_flowStatsDl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+            }
+          if (Policy::RANKING == RANK_DEADLINES)
+            {
+              m_flowHeap.push_back (FlowRef (idx, false, lcid));
+            }
+        }
+      else if (lc.m_direction == LogicalChannelConfigListElement_s::DIR_UL)
+        {
+          uint8_t lcid = lc.m_logicalChannelGroup;   // use LCG ID instead of LCID
+          for (unsigned j = ue.m_flowStatsUl.size (); j <= lcid; j++)
+            {
+              ue.m_flowStatsUl.push_back (MmWaveFlexTtiRankedUeInfo::FlowStats (j));
+            }
+          ue.m_flowStatsUl[lcid].m_qci = lc.m_qci;
+          if (lc.m_qci == EpsBearer::NGBR_LOW_LAT_EMBB_AR)
+            {
+              ue.m_flowStatsUl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+            }
+          if (Policy::RANKING == RANK_DEADLINES)
+            {
+              m_flowHeap.push_back (FlowRef (idx, true, lcid));
+            }
+        }
+      else if (lc.m_direction == LogicalChannelConfigListElement_s::DIR_BOTH)
+        {
+          uint8_t lcid = lc.m_logicalChannelIdentity;
+          for (unsigned j = ue.m_flowStatsDl.size (); j <= lcid; j++)
+            {
+              ue.m_flowStatsDl.push_back (MmWaveFlexTtiRankedUeInfo::FlowStats (j));
+              ue.m_flowStatsUl.push_back (MmWaveFlexTtiRankedUeInfo::FlowStats (j));
+            }
+          ue.m_flowStatsDl[lcid].m_qci = lc.m_qci;
+          ue.m_flowStatsUl[lcid].m_qci = lc.m_qci;
+          // the bidirectional bearers always get the low latency delay budget
+          ue.m_flowStatsDl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+          ue.m_flowStatsUl[lcid].m_deadlineUs = lowLatBearer.GetPacketDelayBudgetMs () * 1000;
+          if (Policy::RANKING == RANK_DEADLINES)
+            {
+              m_flowHeap.push_back (FlowRef (idx, false, lcid));
+              m_flowHeap.push_back (FlowRef (idx, true, lcid));
+            }
+        }
+    }
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoCschedLcReleaseReq (const struct MmWaveMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this);
+  // the buffers are refreshed by the next RLC buffer reports
+}
+
+template <class Policy>
+void
+MmWaveFlexTtiRankedMacScheduler<Policy>::DoCschedUeReleaseReq (const struct MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << " Release RNTI " << params.m_rnti);
+  uint32_t idx = FindUe (params.m_rnti);
+  if (idx == m_ues.size ())
+    {
+      return;
+    }
+  // the CQIs are kept, as the UE may be configured again
+  MmWaveFlexTtiRankedUeInfo &ue = m_ues[idx];
+  ue.m_dlHarqStatus.clear ();
+  ue.m_dlHarqTimer.clear ();
+  ue.m_dlHarqDci.clear ();
+  ue.m_dlHarqRlcPdu.clear ();
+  ue.m_ulHarqStatus.clear ();
+  ue.m_ulHarqTimer.clear ();
+  ue.m_ulHarqDci.clear ();
+  if (Policy::RELEASE_UE_INFO)
+    {
+      ue.ResetSchedInfo ();
+      ue.m_configured = false;
+    }
+}
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveFlexTtiPfMacScheduler);
+NS_OBJECT_ENSURE_REGISTERED (MmWaveFlexTtiMaxRateMacScheduler);
+NS_OBJECT_ENSURE_REGISTERED (MmWaveFlexTtiMaxWeightMacScheduler);
+
+} // namespace mmwave
+
+} // namespace ns3
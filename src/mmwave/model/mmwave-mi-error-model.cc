@@ -37,6 +37,7 @@
 #include <ns3/pointer.h>
 #include <stdint.h>
 #include <cmath>
+#include <algorithm>
 #include <stdint.h>
 #include "stdlib.h"
 #include "mmwave-mi-error-model.h"
@@ -49,88 +50,101 @@ namespace ns3 {
 
 namespace mmwave {
 
+namespace {
+
+/**
+ * The parameters of the BLER curves of bEcrTable and cEcrTable, with the
+ * missing entries replaced by the ones of the lowest CB size including the
+ * CB, for removing CB size quantization errors. They are computed once,
+ * instead of at each call of MappingMiBler.
+ */
+struct BlerCurveTable
+{
+  BlerCurveTable ()
+  {
+    for (int j = 0; j < 9; j++)
+      {
+        for (int k = 0; k <= MMWAVE_MI_64QAM_BLER_MAX_ID; k++)
+          {
+            double bEntry = bEcrTable[j][k];
+            int i = j;
+            while ((i < 9)&&(bEntry < 0))
+              {
+                bEntry = bEcrTable[i++][k];
+              }
+            double cEntry = cEcrTable[j][k];
+            i = j;
+            while ((i < 9)&&(cEntry < 0))
+              {
+                cEntry = cEcrTable[i++][k];
+              }
+            b[j][k] = bEntry;
+            cSqrt2[j][k] = sqrt (2) * cEntry;
+          }
+      }
+  }
+
+  double b[9][MMWAVE_MI_64QAM_BLER_MAX_ID + 1];      //!< b parameter of the curves
+  double cSqrt2[9][MMWAVE_MI_64QAM_BLER_MAX_ID + 1]; //!< c parameter of the curves, times sqrt (2)
+};
+
+} // unnamed namespace
 
 double
 MmWaveMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+  NS_ASSERT_MSG (map.empty () || *std::max_element (map.begin (), map.end ()) < (int) sinr.GetValuesN (),
+                 "RB out of the SINR");
 
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
+  return Mib (&(*sinr.ConstValuesBegin ()), map.data (), map.size (), mcs);
+}
 
-  for (uint32_t i = 0; i < map.size (); i++)
+double
+MmWaveMiErrorModel::Mib (const double *sinr, const int *map, uint32_t mapSize, uint8_t mcs)
+{
+  // select the MI curve of the modulation once for all the RBs
+  const double *miMap;
+  const double *miAxis;
+  uint32_t miSize;
+  if (mcs <= MMWAVE_MI_QPSK_MAX_ID)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MMWAVE_MI_QPSK_MAX_ID) // QPSK
-        {
+      miMap = MI_map_qpsk;
+      miAxis = MI_map_qpsk_axis;
+      miSize = MMWAVE_MI_MAP_QPSK_SIZE;
+    }
+  else if (mcs <= MMWAVE_MI_16QAM_MAX_ID)
+    {
+      miMap = MI_map_16qam;
+      miAxis = MI_map_16qam_axis;
+      miSize = MMWAVE_MI_MAP_16QAM_SIZE;
+    }
+  else
+    {
+      miMap = MI_map_64qam;
+      miAxis = MI_map_64qam_axis;
+      miSize = MMWAVE_MI_MAP_64QAM_SIZE;
+    }
+  const double axisMin = miAxis[0];
+  const double axisMax = miAxis[miSize - 1];
+  // since the values of the axis are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  const double scalingCoeff = (miSize - 1) / (axisMax - axisMin);
+  const double maxIndex = miSize - 1;
 
-          if (sinrLin > MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1])
-            {
-              MI = 1;
-            }
-          else
-            {
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk =
-                (MMWAVE_MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MMWAVE_MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MMWAVE_MI_QPSK_MAX_ID && mcs <= MMWAVE_MI_16QAM_MAX_ID )    // 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam =
-                    (MMWAVE_MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MMWAVE_MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam =
-                    (MMWAVE_MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MMWAVE_MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MMWAVE_MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
+  // the loop has no branches, so that the compiler can vectorize the lookups:
+  // the index is clamped to the map, and the MI is 1 above the axis
+  double MIsum = 0.0;
+  for (uint32_t i = 0; i < mapSize; i++)
+    {
+      double sinrLin = sinr[map[i]];
+      double sinrIndexDouble = (sinrLin - axisMin) * scalingCoeff + 1;
+      uint32_t sinrIndex = std::min (maxIndex, std::max (0.0, std::floor (sinrIndexDouble)));
+      double MI = miMap[sinrIndex];
+      MIsum += (sinrLin > axisMax) ? 1.0 : MI;
     }
-  MI = MIsum / map.size ();
-  NS_LOG_LOGIC (" MI = " << MI);
+  double MI = MIsum / mapSize;
+  NS_LOG_LOGIC (" RBs " << mapSize << ", MCS = " << (uint16_t)mcs << ", MI = " << MI);
   return MI;
 }
 
@@ -139,9 +153,6 @@ double
 MmWaveMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
-
   NS_ASSERT_MSG (ecrId <= MMWAVE_MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
   while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex] <= cbSize))
@@ -151,31 +162,12 @@ MmWaveMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b < 0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i < 9)&&(b < 0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c < 0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i < 9)&&(c < 0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  static const BlerCurveTable table;
+  double b = table.b[cbIndex][ecrId];
+  double cSqrt2 = table.cSqrt2[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5 * ( 1 - erf ((mib - b) / (sqrt (2) * c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+  double bler = 0.5 * ( 1 - erf ((mib - b) / cSqrt2) );
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << cSqrt2 / sqrt (2));
   return bler;
 }
 
@@ -184,7 +176,14 @@ MmWaveMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const s
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib (sinr, map, mcs);
+  return GetTbDecodificationStatsFromMi (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+MmWaveTbStats_t
+MmWaveMiErrorModel::GetTbDecodificationStatsFromMi (double tbMi, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
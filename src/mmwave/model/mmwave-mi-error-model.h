@@ -336,6 +336,19 @@ public:
    * \return the mmib
    */
   static double Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs);
+  /**
+   * \brief find the mmib (mean mutual information per bit) for different modulations of the specified TB
+   *
+   * The modulation is selected once, and the loop over the RBs has no
+   * branches, so that it can be vectorized by the compiler.
+   *
+   * \param sinr the perceived sinrs in the whole bandwidth
+   * \param map the actives RBs for the TB, which must be valid indices of sinr
+   * \param mapSize the number of actives RBs
+   * \param mcs the MCS of the TB
+   * \return the mmib
+   */
+  static double Mib (const double *sinr, const int *map, uint32_t mapSize, uint8_t mcs);
   /**
    * \brief map the mmib (mean mutual information per bit) for different MCS
    * \param mib mean mutual information per bit of a code-block
@@ -355,6 +368,18 @@ public:
    */
   static MmWaveTbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory);
 
+  /**
+   * \brief run the error-model algorithm for the specified TB, given the mmib
+   * of its RBs as returned by Mib. Since the mmib only depends on the
+   * modulation of the MCS, it can be computed once and reused for all the
+   * MCSs with the same modulation.
+   * \param tbMi the mmib of the RBs of the TB
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \return the TB error rate and MI
+   */
+  static MmWaveTbStats_t GetTbDecodificationStatsFromMi (double tbMi, uint32_t size, uint8_t mcs, MmWaveHarqProcessInfoList_t miHistory);
+
 
 //private:
 
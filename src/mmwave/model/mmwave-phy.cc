@@ -38,6 +38,7 @@
 #include <ns3/node.h>
 #include <ns3/packet.h>
 #include <ns3/log.h>
+#include <ns3/boolean.h>
 #include "mmwave-phy.h"
 #include "mmwave-phy-sap.h"
 #include "mmwave-mac-pdu-tag.h"
@@ -108,6 +109,15 @@ MmWavePhy::GetTypeId ()
     tid =
     TypeId ("ns3::MmWavePhy")
     .SetParent<Object> ()
+    .AddAttribute ("IdleSlotFastForward",
+                   "If true, the control TTIs whose processing does not depend on "
+                   "the end of the TTI are fast-forwarded, i.e., the next TTI is "
+                   "scheduled directly when they start, and empty control frames "
+                   "are not transmitted. This reduces the number of events "
+                   "processed in idle slots.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWavePhy::m_idleSlotFastForward),
+                   MakeBooleanChecker ())
   ;
 
   return tid;
@@ -128,7 +138,8 @@ MmWavePhy::MmWavePhy (Ptr<MmWaveSpectrumPhy> dlChannelPhy, Ptr<MmWaveSpectrumPhy
   m_slotNum (0),
   m_ttiIndex (0),
   m_sfAllocInfoUpdated (false),
-  m_componentCarrierId (0)
+  m_componentCarrierId (0),
+  m_idleSlotFastForward (false)
 {
   NS_LOG_FUNCTION (this);
   m_phySapProvider = new MmWaveMemberPhySapProvider (this);
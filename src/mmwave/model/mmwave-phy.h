@@ -199,6 +199,8 @@ protected:
   /// component carrier Id used to address sap
   uint8_t m_componentCarrierId;
 
+  bool m_idleSlotFastForward; //!< if true, fast-forward the control TTIs and skip empty control frames
+
 
 private:
 };
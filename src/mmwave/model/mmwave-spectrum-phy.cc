@@ -98,7 +98,8 @@ static const double EffectiveCodingRate[29] = {
 MmWaveSpectrumPhy::MmWaveSpectrumPhy ()
   : m_cellId (0),
     m_state (IDLE),
-    m_componentCarrierId (0)
+    m_componentCarrierId (0),
+    m_isEnb (false)
 {
   m_interferenceData = CreateObject<mmWaveInterference> ();
   m_random = CreateObject<UniformRandomVariable> ();
@@ -175,7 +176,6 @@ MmWaveSpectrumPhy::SetDevice (Ptr<NetDevice> d)
 
   Ptr<MmWaveEnbNetDevice> enbNetDev = DynamicCast<MmWaveEnbNetDevice> (GetDevice ());
 
-  // TODO m_isEnb is never used
   if (enbNetDev != 0)
     {
       m_isEnb = true;
@@ -192,6 +192,12 @@ MmWaveSpectrumPhy::GetDevice () const
   return m_device;
 }
 
+bool
+MmWaveSpectrumPhy::IsEnb () const
+{
+  return m_isEnb;
+}
+
 void
 MmWaveSpectrumPhy::SetMobility (Ptr<MobilityModel> m)
 {
@@ -885,6 +891,12 @@ MmWaveSpectrumPhy::SetCellId (uint16_t cellId)
   m_cellId = cellId;
 }
 
+uint16_t
+MmWaveSpectrumPhy::GetCellId () const
+{
+  return m_cellId;
+}
+
 void
 MmWaveSpectrumPhy::SetComponentCarrierId (uint8_t componentCarrierId)
 {
@@ -119,6 +119,13 @@ public:
 
   void SetDevice (Ptr<NetDevice> d) override;
   Ptr<NetDevice> GetDevice () const override;
+
+  /**
+  * \return true if the device associated to this PHY is an eNB, false
+  *         otherwise
+  */
+  bool IsEnb () const;
+
   void SetMobility (Ptr<MobilityModel> m) override;
   Ptr<MobilityModel> GetMobility () override;
   void SetChannel (Ptr<SpectrumChannel> c) override;
@@ -159,6 +166,11 @@ public:
   Ptr<SpectrumChannel> GetSpectrumChannel ();
   void SetCellId (uint16_t cellId);
 
+  /**
+   * \return the ID of the cell this PHY is synchronized with
+   */
+  uint16_t GetCellId () const;
+
   /**
    *
    * \param componentCarrierId the component carrier id
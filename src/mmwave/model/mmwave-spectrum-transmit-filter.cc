@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-spectrum-transmit-filter.h"
+#include "ns3/mmwave-spectrum-phy.h"
+#include "ns3/mmwave-spectrum-signal-parameters.h"
+#include "ns3/mmwave-enb-net-device.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+namespace mmwave {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSpectrumTransmitFilter");
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSpectrumTransmitFilter);
+
+MmWaveSpectrumTransmitFilter::MmWaveSpectrumTransmitFilter ()
+  : m_bsToBsFiltered (0),
+    m_ueToUeFiltered (0),
+    m_dlCtrlFiltered (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveSpectrumTransmitFilter::~MmWaveSpectrumTransmitFilter ()
+{
+}
+
+TypeId
+MmWaveSpectrumTransmitFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSpectrumTransmitFilter")
+    .SetParent<SpectrumTransmitFilter> ()
+    .AddConstructor<MmWaveSpectrumTransmitFilter> ()
+    .AddTraceSource ("BsToBsFiltered",
+                     "The number of BS to BS signals filtered out",
+                     MakeTraceSourceAccessor (&MmWaveSpectrumTransmitFilter::m_bsToBsFiltered),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("UeToUeFiltered",
+                     "The number of UE to UE signals filtered out",
+                     MakeTraceSourceAccessor (&MmWaveSpectrumTransmitFilter::m_ueToUeFiltered),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("DlCtrlFiltered",
+                     "The number of DL CTRL frames filtered out because the "
+                     "receiver does not belong to the transmitting cell",
+                     MakeTraceSourceAccessor (&MmWaveSpectrumTransmitFilter::m_dlCtrlFiltered),
+                     "ns3::TracedValueCallback::Uint64")
+  ;
+  return tid;
+}
+
+uint64_t
+MmWaveSpectrumTransmitFilter::GetBsToBsFiltered (void) const
+{
+  return m_bsToBsFiltered;
+}
+
+uint64_t
+MmWaveSpectrumTransmitFilter::GetUeToUeFiltered (void) const
+{
+  return m_ueToUeFiltered;
+}
+
+uint64_t
+MmWaveSpectrumTransmitFilter::GetDlCtrlFiltered (void) const
+{
+  return m_dlCtrlFiltered;
+}
+
+bool
+MmWaveSpectrumTransmitFilter::DoFilter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy)
+{
+  NS_LOG_FUNCTION (this << params << receiverPhy);
+
+  // only the signals directed to a MmWaveSpectrumPhy are filtered
+  Ptr<const MmWaveSpectrumPhy> rxPhy = DynamicCast<const MmWaveSpectrumPhy> (receiverPhy);
+  if (rxPhy == 0)
+    {
+      return false;
+    }
+
+  // use the same criterion as MmWaveSpectrumPhy::StartRx, i.e., every
+  // transmitter which is not associated to a MmWaveEnbNetDevice is a UE
+  bool txIsEnb;
+  Ptr<const MmWaveSpectrumPhy> txPhy = DynamicCast<const MmWaveSpectrumPhy> (params->txPhy);
+  if (txPhy != 0)
+    {
+      txIsEnb = txPhy->IsEnb ();
+    }
+  else
+    {
+      txIsEnb = (DynamicCast<MmWaveEnbNetDevice> (params->txPhy->GetDevice ()) != 0);
+    }
+
+  if (txIsEnb && rxPhy->IsEnb ())
+    {
+      NS_LOG_LOGIC ("BS to BS signal filtered out");
+      m_bsToBsFiltered++;
+      return true;
+    }
+  if (!txIsEnb && !rxPhy->IsEnb ())
+    {
+      NS_LOG_LOGIC ("UE to UE signal filtered out");
+      m_ueToUeFiltered++;
+      return true;
+    }
+
+  // the DL CTRL frames are only received by the UEs synchronized with the
+  // transmitting cell, and they do not contribute to the interference
+  Ptr<const MmWaveSpectrumSignalParametersDlCtrlFrame> dlCtrlParams = DynamicCast<const MmWaveSpectrumSignalParametersDlCtrlFrame> (params);
+  if (dlCtrlParams != 0 && dlCtrlParams->cellId != rxPhy->GetCellId ())
+    {
+      NS_LOG_LOGIC ("DL CTRL frame of cell " << dlCtrlParams->cellId << " filtered out for a UE of cell " << rxPhy->GetCellId ());
+      m_dlCtrlFiltered++;
+      return true;
+    }
+  return false;
+}
+
+} // namespace mmwave
+
+} // namespace ns3
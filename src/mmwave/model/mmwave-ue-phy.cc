@@ -562,7 +562,14 @@ MmWaveUePhy::StartTti ()
       // Trace current UL transmission info
       TraceUlPhyTransmission (currTti.m_dci, PhyTransmissionTraceParams::CTRL);
 
-      SendCtrlChannels (ctrlMsg, currTtiDuration - NanoSeconds (1.0));
+      if (!m_idleSlotFastForward || !ctrlMsg.empty ())
+        {
+          SendCtrlChannels (ctrlMsg, currTtiDuration - NanoSeconds (1.0));
+        }
+      else
+        {
+          NS_LOG_LOGIC ("UE" << m_rnti << " skipping empty UL CTRL frame");
+        }
 
     }
   else if (currTti.m_dci.m_format == DciInfoElementTdma::DL_dci)  // Scheduled DL data Tti
@@ -622,8 +629,19 @@ MmWaveUePhy::StartTti ()
   NS_ASSERT (m_ttiIndex != 0 || currTti.m_dci.m_symStart == m_ttiIndex);
   m_phySapUser->SlotIndication (SfnSf (m_frameNum, m_sfNum, m_slotNum, currTti.m_dci.m_symStart));            // trigger mac
 
-  NS_LOG_DEBUG ("MmWaveUePhy: Scheduling TTI end after " << currTtiDuration);
-  Simulator::Schedule (currTtiDuration, &MmWaveUePhy::EndTti, this);
+  if (m_idleSlotFastForward && m_ttiIndex == m_currSlotAllocInfo.m_ttiAllocInfo.size () - 1)
+    {
+      // nothing happens at the end of the UL control TTI, and EndTti schedules
+      // the next slot at an absolute time: no need for a separate event.
+      // The DL control TTI cannot be skipped, since the DCIs received during
+      // it update the allocation of the current slot
+      EndTti ();
+    }
+  else
+    {
+      NS_LOG_DEBUG ("MmWaveUePhy: Scheduling TTI end after " << currTtiDuration);
+      Simulator::Schedule (currTtiDuration, &MmWaveUePhy::EndTti, this);
+    }
 }
 
 
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-amc.h"
+#include "ns3/mmwave-mi-error-model.h"
+#include "ns3/mmwave-spectrum-value-helper.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveAmcMcsSelectionTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks if the binary search of the MCS in MmWaveAmc selects
+* the same MCS and CQI as testing all the MCSs in increasing order, for
+* flat and frequency selective SINRs
+*/
+class MmWaveAmcMcsSelectionTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveAmcMcsSelectionTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveAmcMcsSelectionTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Compare the feedbacks of the two AMCs for a SINR
+  * \param sinr the SINR
+  */
+  void CompareFeedbacks (const SpectrumValue& sinr);
+
+  Ptr<MmWaveAmc> m_binaryAmc; //!< the AMC with the binary search
+  Ptr<MmWaveAmc> m_linearAmc; //!< the AMC with the linear search
+  uint32_t m_numMcsTested; //!< the number of wideband MCSs compared
+};
+
+MmWaveAmcMcsSelectionTestCase::MmWaveAmcMcsSelectionTestCase ()
+  : TestCase ("Checks if the binary search of the MCS selects the same MCS and CQI as the linear search"),
+    m_numMcsTested (0)
+{
+}
+
+MmWaveAmcMcsSelectionTestCase::~MmWaveAmcMcsSelectionTestCase ()
+{
+}
+
+void
+MmWaveAmcMcsSelectionTestCase::CompareFeedbacks (const SpectrumValue& sinr)
+{
+  std::vector<int> binaryCqi = m_binaryAmc->CreateCqiFeedbacks (sinr, 4);
+  std::vector<int> linearCqi = m_linearAmc->CreateCqiFeedbacks (sinr, 4);
+  NS_TEST_ASSERT_MSG_EQ ((binaryCqi == linearCqi), true, "Different CQIs per RBG for SINR " << sinr);
+
+  const uint8_t numSymbols[] = {1, 4, 12, 24};
+  for (uint8_t numSym : numSymbols)
+    {
+      binaryCqi = m_binaryAmc->CreateCqiFeedbacksTdma (sinr, numSym);
+      linearCqi = m_linearAmc->CreateCqiFeedbacksTdma (sinr, numSym);
+      NS_TEST_ASSERT_MSG_EQ ((binaryCqi == linearCqi), true, "Different CQIs per chunk for SINR " << sinr);
+
+      for (unsigned tbMcs = 0; tbMcs <= 28; tbMcs += 7)
+        {
+          uint32_t tbSize = m_binaryAmc->GetTbSizeFromMcsSymbols (tbMcs, numSym) / 8;
+          int binaryMcs;
+          int linearMcs;
+          int binaryWbCqi = m_binaryAmc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, binaryMcs);
+          int linearWbCqi = m_linearAmc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, linearMcs);
+          NS_TEST_ASSERT_MSG_EQ (binaryWbCqi, linearWbCqi, "Different wideband CQIs for SINR " << sinr);
+          NS_TEST_ASSERT_MSG_EQ (binaryMcs, linearMcs, "Different wideband MCSs for SINR " << sinr);
+
+          // reference: test the MCSs in increasing order with the error model
+          std::vector<int> chunkMap;
+          for (uint32_t i = 0; i < sinr.GetSpectrumModel ()->GetNumBands (); i++)
+            {
+              chunkMap.push_back (i);
+            }
+          int mcs = 0;
+          while (mcs <= 28)
+            {
+              MmWaveHarqProcessInfoList_t harqInfoList;
+              if (MmWaveMiErrorModel::GetTbDecodificationStats (sinr, chunkMap, tbSize, mcs, harqInfoList).tbler > 0.1)
+                {
+                  break;
+                }
+              mcs++;
+            }
+          if (mcs > 0)
+            {
+              mcs--;
+            }
+          NS_TEST_ASSERT_MSG_EQ (binaryMcs, mcs, "Wrong wideband MCS for SINR " << sinr);
+          m_numMcsTested++;
+        }
+    }
+}
+
+void
+MmWaveAmcMcsSelectionTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  // used by the TB sizes of CreateCqiFeedbacks, and not initialized otherwise
+  config->SetNumReferenceSymbols (1);
+  Ptr<SpectrumModel> model = MmWaveSpectrumValueHelper::GetSpectrumModel (config);
+  m_binaryAmc = CreateObject<MmWaveAmc> (config);
+  m_linearAmc = CreateObject<MmWaveAmc> (config);
+  m_linearAmc->SetAttribute ("BinaryMcsSearch", BooleanValue (false));
+
+  // flat SINRs, finely spaced to hit the transitions between the MCSs
+  for (double sinrDb = -10.0; sinrDb <= 30.0; sinrDb += 0.25)
+    {
+      SpectrumValue sinr (model);
+      sinr = std::pow (10.0, sinrDb / 10.0);
+      CompareFeedbacks (sinr);
+    }
+
+  // frequency selective SINRs
+  Ptr<UniformRandomVariable> meanDb = CreateObject<UniformRandomVariable> ();
+  meanDb->SetAttribute ("Min", DoubleValue (-10.0));
+  meanDb->SetAttribute ("Max", DoubleValue (30.0));
+  meanDb->SetStream (1);
+  Ptr<NormalRandomVariable> fadingDb = CreateObject<NormalRandomVariable> ();
+  fadingDb->SetAttribute ("Variance", DoubleValue (25.0));
+  fadingDb->SetStream (2);
+  for (uint32_t n = 0; n < 50; n++)
+    {
+      SpectrumValue sinr (model);
+      double mean = meanDb->GetValue ();
+      for (Values::iterator it = sinr.ValuesBegin (); it != sinr.ValuesEnd (); it++)
+        {
+          *it = std::pow (10.0, (mean + fadingDb->GetValue ()) / 10.0);
+        }
+      CompareFeedbacks (sinr);
+    }
+
+  NS_TEST_ASSERT_MSG_GT (m_numMcsTested, 0, "No MCS compared");
+}
+
+/**
+* This suite tests the MCS selection of MmWaveAmc
+*/
+class MmWaveAmcMcsSelectionTest : public TestSuite
+{
+public:
+  MmWaveAmcMcsSelectionTest ();
+};
+
+MmWaveAmcMcsSelectionTest::MmWaveAmcMcsSelectionTest ()
+  : TestSuite ("mmwave-amc-mcs-selection-test", UNIT)
+{
+  AddTestCase (new MmWaveAmcMcsSelectionTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveAmcMcsSelectionTest mmwaveAmcMcsSelectionTestSuite;
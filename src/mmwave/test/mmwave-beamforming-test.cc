@@ -16,6 +16,12 @@
 */
 
 #include "ns3/mmwave-beamforming-model.h"
+#include "ns3/mmwave-beam-search.h"
+#include "ns3/file-beamforming-codebook.h"
+#include "ns3/string.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/channel-condition-model.h"
+#include "ns3/mmwave-phy-mac-common.h"
 #include "ns3/test.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/constant-position-mobility-model.h"
@@ -29,6 +35,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/node.h"
 #include "simple-matrix-based-channel-model.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("MmWaveBeamformingTest");
 
@@ -322,6 +329,327 @@ MmWaveSvdBeamformingTestCase::DoRun (void)
     }
 }
 
+/**
+* This test case checks if the MmWaveBeamSearch strategies select the
+* expected pair of codewords
+*/
+class MmWaveBeamSearchTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveBeamSearchTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveBeamSearchTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveBeamSearchTestCase::MmWaveBeamSearchTestCase ()
+  : TestCase ("Checks if the MmWaveBeamSearch strategies work as expected")
+{
+}
+
+MmWaveBeamSearchTestCase::~MmWaveBeamSearchTestCase ()
+{
+}
+
+/**
+* Returns the beamforming gain of the codeword cw towards the direction
+* identified by the steering vector sv
+*/
+static double
+GetCodewordGain (const PhasedArrayModel::ComplexVector &cw, const PhasedArrayModel::ComplexVector &sv)
+{
+  std::complex<double> sum (0, 0);
+  for (size_t i = 0; i < cw.size (); i++)
+    {
+      sum += std::conj (sv[i]) * cw[i];
+    }
+  return std::norm (sum);
+}
+
+void
+MmWaveBeamSearchTestCase::DoRun (void)
+{
+  // create the antennas and the associated codebooks
+  Ptr<PhasedArrayModel> thisAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (8),
+                                                                                      "NumColumns", UintegerValue (8),
+                                                                                      "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  Ptr<PhasedArrayModel> otherAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (4),
+                                                                                       "NumColumns", UintegerValue (4),
+                                                                                       "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  Ptr<BeamformingCodebook> thisCodebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue ("src/mmwave/model/Codebooks/8x8.txt"),
+                                                                                               "Array", PointerValue (thisAntenna));
+  thisCodebook->Initialize ();
+  Ptr<BeamformingCodebook> otherCodebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue ("src/mmwave/model/Codebooks/4x4.txt"),
+                                                                                                "Array", PointerValue (otherAntenna));
+  otherCodebook->Initialize ();
+
+  // single path channel: the gain of a pair is the product of the gains of
+  // the two codewords towards the departure and arrival directions
+  PhasedArrayModel::ComplexVector thisSv = GetManualBfVector (thisAntenna, Angles (DegreesToRadians (20), DegreesToRadians (80)));
+  PhasedArrayModel::ComplexVector otherSv = GetManualBfVector (otherAntenna, Angles (DegreesToRadians (-130), DegreesToRadians (100)));
+
+  std::vector<double> thisGains;
+  for (uint32_t i = 0; i < thisCodebook->GetCodebookSize (); i++)
+    {
+      thisGains.push_back (GetCodewordGain (thisCodebook->GetCodeword (i), thisSv));
+    }
+  std::vector<double> otherGains;
+  for (uint32_t i = 0; i < otherCodebook->GetCodebookSize (); i++)
+    {
+      otherGains.push_back (GetCodewordGain (otherCodebook->GetCodeword (i), otherSv));
+    }
+
+  MmWaveBeamSearch::GainFunction gainFunction = [&thisGains, &otherGains] (uint32_t thisIdx, uint32_t otherIdx)
+    {
+      return thisGains[thisIdx] * otherGains[otherIdx];
+    };
+
+  uint32_t numPairs = thisCodebook->GetCodebookSize () * otherCodebook->GetCodebookSize ();
+  double maxGain = *std::max_element (thisGains.begin (), thisGains.end ())
+    * *std::max_element (otherGains.begin (), otherGains.end ());
+  std::vector<MmWaveBeamSearch::BeamPair> noPrevious;
+
+  // the exhaustive search evaluates all the pairs and finds the optimum
+  Ptr<MmWaveBeamSearch> exhaustive = CreateObject<MmWaveExhaustiveBeamSearch> ();
+  std::vector<MmWaveBeamSearch::BeamPair> best = exhaustive->Search (thisCodebook, otherCodebook, gainFunction, noPrevious);
+  NS_TEST_ASSERT_MSG_EQ (exhaustive->GetNumEvaluations (), numPairs, "The exhaustive search should evaluate all the pairs");
+  NS_TEST_ASSERT_MSG_EQ_TOL (best[0].gain, maxGain, 1e-12, "The exhaustive search should find the optimum");
+
+  // the iterative search finds the optimum of a separable gain
+  Ptr<MmWaveBeamSearch> iterative = CreateObject<MmWaveIterativeBeamSearch> ();
+  std::vector<MmWaveBeamSearch::BeamPair> result = iterative->Search (thisCodebook, otherCodebook, gainFunction, noPrevious);
+  NS_TEST_ASSERT_MSG_LT (iterative->GetNumEvaluations (), numPairs / 4, "Too many evaluations for the iterative search");
+  NS_TEST_ASSERT_MSG_EQ_TOL (result[0].gain, maxGain, 1e-12, "The iterative search should find the optimum");
+
+  // the hierarchical search gets close to the optimum
+  Ptr<MmWaveBeamSearch> hierarchical = CreateObject<MmWaveHierarchicalBeamSearch> ();
+  result = hierarchical->Search (thisCodebook, otherCodebook, gainFunction, noPrevious);
+  NS_TEST_ASSERT_MSG_LT (hierarchical->GetNumEvaluations (), numPairs / 4, "Too many evaluations for the hierarchical search");
+  NS_TEST_ASSERT_MSG_LT (10 * std::log10 (maxGain / result[0].gain), 3.0, "The hierarchical search should select a good pair");
+
+  // the top-K search falls back to an exhaustive search the first time,
+  // then tracks the previous candidates
+  Ptr<MmWaveBeamSearch> topK = CreateObjectWithAttributes<MmWaveTopKBeamSearch> ("NumCandidates", UintegerValue (4));
+  std::vector<MmWaveBeamSearch::BeamPair> candidates = topK->Search (thisCodebook, otherCodebook, gainFunction, noPrevious);
+  NS_TEST_ASSERT_MSG_EQ (topK->GetNumEvaluations (), numPairs, "The first top-K search should evaluate all the pairs");
+  NS_TEST_ASSERT_MSG_EQ (candidates.size (), 4, "The top-K search should retain 4 candidates");
+  for (uint32_t i = 1; i < candidates.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (candidates[i - 1].gain, candidates[i].gain, "Candidates should be sorted by decreasing gain");
+    }
+  result = topK->Search (thisCodebook, otherCodebook, gainFunction, candidates);
+  NS_TEST_ASSERT_MSG_LT (topK->GetNumEvaluations (), numPairs / 4, "Too many evaluations for the top-K search");
+  NS_TEST_ASSERT_MSG_EQ_TOL (result[0].gain, maxGain, 1e-12, "The top-K search should keep the optimum");
+}
+
+/**
+* This test case checks if the closed form evaluation of the codebook gain
+* used by MmWaveCodebookBeamforming selects the same beam pairs as the
+* evaluation through the received PSD
+*/
+class MmWaveCodebookClosedFormGainTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveCodebookClosedFormGainTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveCodebookClosedFormGainTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+};
+
+MmWaveCodebookClosedFormGainTestCase::MmWaveCodebookClosedFormGainTestCase ()
+  : TestCase ("Checks if the closed form codebook gain matches the PSD-based one")
+{
+}
+
+MmWaveCodebookClosedFormGainTestCase::~MmWaveCodebookClosedFormGainTestCase ()
+{
+}
+
+void
+MmWaveCodebookClosedFormGainTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> phyMacConfig = CreateObject<MmWavePhyMacCommon> ();
+
+  // create the spectrum propagation loss model
+  Ptr<ThreeGppSpectrumPropagationLossModel> splm = CreateObject<ThreeGppSpectrumPropagationLossModel> ();
+  splm->SetChannelModelAttribute ("Frequency", DoubleValue (phyMacConfig->GetCenterFrequency ()));
+  splm->SetChannelModelAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  splm->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (CreateObject<ThreeGppUmiStreetCanyonChannelConditionModel> ()));
+
+  // create this device
+  Ptr<Node> thisNode = CreateObject<Node> ();
+  Ptr<MobilityModel> thisMob = CreateObject<ConstantPositionMobilityModel> ();
+  thisMob->SetPosition (Vector (0, 0, 10));
+  thisNode->AggregateObject (thisMob);
+  Ptr<NetDevice> thisDevice = CreateObject<SimpleNetDevice> ();
+  thisDevice->SetNode (thisNode);
+  thisNode->AddDevice (thisDevice);
+  Ptr<PhasedArrayModel> thisAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (8),
+                                                                                      "NumColumns", UintegerValue (8),
+                                                                                      "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  splm->AddDevice (thisDevice, thisAntenna);
+
+  // create two beamforming models for this device, one evaluating the
+  // codebook gain through the received PSD and one using the closed form
+  ObjectFactory cbFactory;
+  cbFactory.SetTypeId (FileBeamformingCodebook::GetTypeId ());
+  cbFactory.Set ("CodebookFilename", StringValue ("src/mmwave/model/Codebooks/8x8.txt"));
+
+  Ptr<MmWaveCodebookBeamforming> psdModel = CreateObjectWithAttributes<MmWaveCodebookBeamforming> ("Device", PointerValue (thisDevice),
+                                                                                                   "Antenna", PointerValue (thisAntenna),
+                                                                                                   "SpectrumPropagationLossModel", PointerValue (splm),
+                                                                                                   "MmWavePhyMacCommon", PointerValue (phyMacConfig),
+                                                                                                   "ClosedFormGain", BooleanValue (false));
+  psdModel->SetBeamformingCodebookFactory (cbFactory);
+  psdModel->Initialize ();
+
+  Ptr<MmWaveCodebookBeamforming> closedFormModel = CreateObjectWithAttributes<MmWaveCodebookBeamforming> ("Device", PointerValue (thisDevice),
+                                                                                                          "Antenna", PointerValue (thisAntenna),
+                                                                                                          "SpectrumPropagationLossModel", PointerValue (splm),
+                                                                                                          "MmWavePhyMacCommon", PointerValue (phyMacConfig),
+                                                                                                          "ClosedFormGain", BooleanValue (true));
+  closedFormModel->SetBeamformingCodebookFactory (cbFactory);
+  closedFormModel->Initialize ();
+
+  std::vector<Vector> positions {Vector (30, 10, 1.5), Vector (-50, 40, 1.5), Vector (10, -80, 1.5)};
+  for (const auto &pos : positions)
+    {
+      // create the other device
+      Ptr<Node> otherNode = CreateObject<Node> ();
+      Ptr<MobilityModel> otherMob = CreateObject<ConstantPositionMobilityModel> ();
+      otherMob->SetPosition (pos);
+      otherNode->AggregateObject (otherMob);
+      Ptr<NetDevice> otherDevice = CreateObject<SimpleNetDevice> ();
+      otherDevice->SetNode (otherNode);
+      otherNode->AddDevice (otherDevice);
+      Ptr<PhasedArrayModel> otherAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (4),
+                                                                                           "NumColumns", UintegerValue (4),
+                                                                                           "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+      Ptr<BeamformingCodebook> otherCodebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue ("src/mmwave/model/Codebooks/4x4.txt"),
+                                                                                                    "Array", PointerValue (otherAntenna));
+      otherCodebook->Initialize ();
+      otherAntenna->AggregateObject (otherCodebook);
+      splm->AddDevice (otherDevice, otherAntenna);
+
+      psdModel->SetBeamformingVectorForDevice (otherDevice, otherAntenna);
+      PhasedArrayModel::ComplexVector psdThisBf = thisAntenna->GetBeamformingVector ();
+      PhasedArrayModel::ComplexVector psdOtherBf = otherAntenna->GetBeamformingVector ();
+
+      closedFormModel->SetBeamformingVectorForDevice (otherDevice, otherAntenna);
+      NS_TEST_ASSERT_MSG_EQ ((thisAntenna->GetBeamformingVector () == psdThisBf), true, "The closed form gain selected a different codeword for this antenna");
+      NS_TEST_ASSERT_MSG_EQ ((otherAntenna->GetBeamformingVector () == psdOtherBf), true, "The closed form gain selected a different codeword for the other antenna");
+    }
+}
+
+/**
+* This test case checks if the FileBeamformingCodebook objects created from
+* the same file for arrays with the same geometry share the codewords, and
+* if the codewords are released when they are not used anymore
+*/
+class MmWaveCodebookRegistryTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveCodebookRegistryTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveCodebookRegistryTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Creates a codebook for a new array
+  * \param filename the codebook file
+  * \param numRows the number of rows of the array
+  * \param numColumns the number of columns of the array
+  * \return the initialized codebook
+  */
+  static Ptr<BeamformingCodebook> CreateCodebook (std::string filename, uint32_t numRows, uint32_t numColumns);
+};
+
+MmWaveCodebookRegistryTestCase::MmWaveCodebookRegistryTestCase ()
+  : TestCase ("Checks if the FileBeamformingCodebook objects share the codewords")
+{
+}
+
+MmWaveCodebookRegistryTestCase::~MmWaveCodebookRegistryTestCase ()
+{
+}
+
+Ptr<BeamformingCodebook>
+MmWaveCodebookRegistryTestCase::CreateCodebook (std::string filename, uint32_t numRows, uint32_t numColumns)
+{
+  Ptr<PhasedArrayModel> antenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumRows", UintegerValue (numRows),
+                                                                                  "NumColumns", UintegerValue (numColumns));
+  Ptr<BeamformingCodebook> codebook = CreateObjectWithAttributes<FileBeamformingCodebook> ("CodebookFilename", StringValue (filename),
+                                                                                          "Array", PointerValue (antenna));
+  codebook->Initialize ();
+  return codebook;
+}
+
+void
+MmWaveCodebookRegistryTestCase::DoRun (void)
+{
+  std::size_t numRegistered = FileBeamformingCodebook::GetNumRegisteredCodebooks ();
+
+  // use codebooks not imported by the other test cases
+  Ptr<BeamformingCodebook> first = CreateCodebook ("src/mmwave/model/Codebooks/2x2.txt", 2, 2);
+  Ptr<BeamformingCodebook> second = CreateCodebook ("src/mmwave/model/Codebooks/2x2.txt", 2, 2);
+  Ptr<BeamformingCodebook> third = CreateCodebook ("src/mmwave/model/Codebooks/4x8.txt", 4, 8);
+
+  NS_TEST_ASSERT_MSG_EQ (FileBeamformingCodebook::GetNumRegisteredCodebooks (), numRegistered + 2, "The 2x2 codebook should be imported only once");
+  NS_TEST_ASSERT_MSG_EQ (first->GetCodebookSize (), second->GetCodebookSize (), "Codebooks imported from the same file should have the same size");
+  NS_TEST_ASSERT_MSG_EQ (first->GetCodeword (0).data (), second->GetCodeword (0).data (), "The codewords should be shared");
+  NS_TEST_ASSERT_MSG_NE (first->GetCodeword (0).data (), third->GetCodeword (0).data (), "Different codebooks should not share the codewords");
+  NS_TEST_ASSERT_MSG_EQ (first->GetCodeword (1).data (), first->GetCodeword (0).data () + 4, "The codewords should be stored contiguously");
+  NS_TEST_ASSERT_MSG_EQ (reinterpret_cast<uintptr_t> (first->GetCodeword (0).data ()) % Complex3DArray::ALIGNMENT, 0, "The codewords are not aligned");
+
+  // the view can be copied in a beamforming vector
+  PhasedArrayModel::ComplexVector cw = first->GetCodeword (1);
+  NS_TEST_ASSERT_MSG_EQ (cw.size (), 4, "Wrong codeword size");
+  NS_TEST_ASSERT_MSG_EQ ((cw == PhasedArrayModel::ComplexVector (second->GetCodeword (1).begin (), second->GetCodeword (1).end ())), true,
+                         "The copy of the codeword is different");
+
+  // the codewords are released when the last codebook using them is disposed
+  first->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (FileBeamformingCodebook::GetNumRegisteredCodebooks (), numRegistered + 2, "The 2x2 codebook is still used");
+  second->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (FileBeamformingCodebook::GetNumRegisteredCodebooks (), numRegistered + 1, "The 2x2 codebook is not used anymore");
+  third = 0;
+  NS_TEST_ASSERT_MSG_EQ (FileBeamformingCodebook::GetNumRegisteredCodebooks (), numRegistered, "The 4x8 codebook is not used anymore");
+}
+
 /**
 * This suite tests if the beamforming module works properly
 */
@@ -337,6 +665,9 @@ MmWaveBeamformingTest::MmWaveBeamformingTest ()
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new MmWaveDftBeamformingTestCase, TestCase::QUICK);
   AddTestCase (new MmWaveSvdBeamformingTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveBeamSearchTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveCodebookClosedFormGainTestCase, TestCase::QUICK);
+  AddTestCase (new MmWaveCodebookRegistryTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
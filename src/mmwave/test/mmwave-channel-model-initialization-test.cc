@@ -27,15 +27,17 @@ using namespace mmwave;
 
 /**
 * This test case checks if the MmWaveHelper correctly initializes the
-* 3GPP channel model
+* 3GPP channel model, with a channel model for each CC or with a channel
+* model shared by the CCs
 */
 class MmwaveThreeGppChannelInitializationTestCase : public TestCase
 {
 public:
   /**
   * Constructor
+  * \param shared if true, the CCs share the channel realizations
   */
-  MmwaveThreeGppChannelInitializationTestCase ();
+  MmwaveThreeGppChannelInitializationTestCase (bool shared);
 
   /**
   * Destructor
@@ -47,10 +49,14 @@ private:
   * Run the test
   */
   virtual void DoRun (void);
+
+  bool m_shared; //!< if true, the CCs share the channel realizations
 };
 
-MmwaveThreeGppChannelInitializationTestCase::MmwaveThreeGppChannelInitializationTestCase ()
-  : TestCase ("Checks if the MmWaveHelper correctly initializes the 3GPP channel model")
+MmwaveThreeGppChannelInitializationTestCase::MmwaveThreeGppChannelInitializationTestCase (bool shared)
+  : TestCase (std::string ("Checks if the MmWaveHelper correctly initializes the 3GPP channel model")
+              + (shared ? " shared by the CCs" : "")),
+    m_shared (shared)
 {
 }
 
@@ -68,6 +74,7 @@ MmwaveThreeGppChannelInitializationTestCase::DoRun (void)
   Ptr<MmWaveHelper> helper = CreateObject<MmWaveHelper> ();
   helper->SetAttribute ("UseCa", BooleanValue ((numCc > 1)));
   helper->SetAttribute ("NumberOfComponentCarriers", UintegerValue (numCc));
+  helper->SetAttribute ("SharedChannelRealization", BooleanValue (m_shared));
 
   // create and configure the CCs
   std::map<uint8_t, MmWaveComponentCarrier> ccMap;
@@ -114,6 +121,23 @@ MmwaveThreeGppChannelInitializationTestCase::DoRun (void)
   // retrive the MmWaveEnbNetDevice
   Ptr<MmWaveEnbNetDevice> mmWaveEnbDev = DynamicCast<MmWaveEnbNetDevice> (bsNetDev.Get (0));
 
+  // create the UE node, and install the UE device
+  NodeContainer ueNodes;
+  ueNodes.Create (1);
+  Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator> ();
+  uePositionAlloc->Add (Vector (50.0, 10.0, 1.5));
+  MobilityHelper ueMobility;
+  ueMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  ueMobility.SetPositionAllocator (uePositionAlloc);
+  ueMobility.Install (ueNodes);
+  NetDeviceContainer ueNetDev = helper->InstallUeDevice (ueNodes);
+  Ptr<MmWaveUeNetDevice> mmWaveUeDev = DynamicCast<MmWaveUeNetDevice> (ueNetDev.Get (0));
+
+  // the models of the first CC
+  Ptr<MatrixBasedChannelModel> firstChannelModel;
+  Ptr<ChannelConditionModel> firstCcm;
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> firstChannel;
+
   // iterate through the CCs
   for (auto ccIndex : mmWaveEnbDev->GetCcMap ())
   {
@@ -160,6 +184,13 @@ MmwaveThreeGppChannelInitializationTestCase::DoRun (void)
     NS_TEST_ASSERT_MSG_EQ (phyFreq, plmFreq.Get (), "The operating frequency of the propagation loss model has not properly configured");
     DoubleValue splmFreq;
     threeGppSplm->GetChannelModelAttribute ("Frequency", splmFreq);
+    if (m_shared)
+    {
+      // the realizations are generated at the frequency of the first CC, and
+      // the spectrum propagation loss model uses the frequency of its CC
+      NS_TEST_ASSERT_MSG_EQ (splmFreq.Get (), freq [0], "The shared channel model should operate at the frequency of the first CC");
+      threeGppSplm->GetAttribute ("Frequency", splmFreq);
+    }
     NS_TEST_ASSERT_MSG_EQ (phyFreq, splmFreq.Get (), "The operating frequency of the spectrum propagation loss model has not properly configured");
 
     // be sure that the MmWaveHelper has created the proper channel condition
@@ -177,6 +208,41 @@ MmwaveThreeGppChannelInitializationTestCase::DoRun (void)
     // be sure that the MmWaveHelper has associated the same channel condition model
     // also with the spectrum propagation loss model
     NS_TEST_ASSERT_MSG_EQ (ccm, threeGppSplmCcm, "The channel condition model associated to the propagation loss model is not the same as the one associated to the spectrum propagation loss model");
+
+    // be sure that the CCs share the channel model and the channel condition
+    // model only if requested
+    if (!firstChannelModel)
+    {
+      firstChannelModel = threeGppSplm->GetChannelModel ();
+      firstCcm = ccm;
+    }
+    else
+    {
+      NS_TEST_ASSERT_MSG_EQ ((threeGppSplm->GetChannelModel () == firstChannelModel), m_shared, "The channel model should be shared only if SharedChannelRealization is true");
+      NS_TEST_ASSERT_MSG_EQ ((ccm == firstCcm), m_shared, "The channel condition model should be shared only if SharedChannelRealization is true");
+    }
+
+    // be sure that the link between the BS and the UE gets the same clusters
+    // on every CC only if requested. The antennas of each CC are distinct
+    // objects, created by the MmWaveHelper with the same geometry
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix =
+      threeGppSplm->GetChannelModel ()->GetChannel (ueNodes.Get (0)->GetObject<MobilityModel> (),
+                                                    bsNodes.Get (0)->GetObject<MobilityModel> (),
+                                                    mmWaveUeDev->GetAntenna (ccIndex.first),
+                                                    mmWaveEnbDev->GetAntenna (ccIndex.first));
+    if (!firstChannel)
+    {
+      firstChannel = channelMatrix;
+    }
+    else
+    {
+      NS_TEST_ASSERT_MSG_NE (mmWaveEnbDev->GetAntenna (ccIndex.first), mmWaveEnbDev->GetAntenna (0), "Each CC should have its own antenna");
+      NS_TEST_ASSERT_MSG_EQ ((channelMatrix->m_delay == firstChannel->m_delay), m_shared, "The cluster delays should be shared only if SharedChannelRealization is true");
+      NS_TEST_ASSERT_MSG_EQ ((channelMatrix->m_angle == firstChannel->m_angle), m_shared, "The cluster angles should be shared only if SharedChannelRealization is true");
+      NS_TEST_ASSERT_MSG_EQ ((channelMatrix->m_channel.GetNumClusters () == firstChannel->m_channel.GetNumClusters ()
+                              && channelMatrix->m_channel (0, 0, 0) == firstChannel->m_channel (0, 0, 0)), m_shared,
+                             "The channel coefficients should be shared only if SharedChannelRealization is true");
+    }
   }
 }
 
@@ -193,7 +259,8 @@ MmWaveChannelModelInitializationTestSuite::MmWaveChannelModelInitializationTestS
   : TestSuite ("mmwave-channel-model-initialization-test", UNIT)
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
-  AddTestCase (new MmwaveThreeGppChannelInitializationTestCase, TestCase::QUICK);
+  AddTestCase (new MmwaveThreeGppChannelInitializationTestCase (false), TestCase::QUICK);
+  AddTestCase (new MmwaveThreeGppChannelInitializationTestCase (true), TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,466 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-mac-scheduler.h"
+#include "ns3/mmwave-amc.h"
+#include "ns3/object-factory.h"
+#include "ns3/boolean.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveFlexTtiRankedSchedulerTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* SCHED SAP user which stores the last allocation of the scheduler
+*/
+class MmWaveRankedSchedTestSapUser : public MmWaveMacSchedSapUser
+{
+public:
+  virtual void SchedConfigInd (const struct SchedConfigIndParameters& params)
+  {
+    m_slotAllocInfo = params.m_slotAllocInfo;
+  }
+
+  SlotAllocInfo m_slotAllocInfo; ///< the last allocation
+};
+
+/**
+* CSCHED SAP user which ignores the confirmations of the scheduler
+*/
+class MmWaveRankedCschedTestSapUser : public MmWaveMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params) {}
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params) {}
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params) {}
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params) {}
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params) {}
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params) {}
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params) {}
+};
+
+/**
+* This test case feeds random CQIs, buffer reports, BSRs, UL SINRs and HARQ
+* feedback to a flex-TTI scheduler, checks that the allocations of each slot
+* are valid, and compares them with a trace recorded from the original
+* implementation of the scheduler. The trace is recorded again with the
+* --update-data option of the test runner.
+*/
+class MmWaveFlexTtiRankedSchedulerTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  * \param type the TypeId of the scheduler
+  * \param harq true to enable the HARQ
+  * \param fixedTti true to allocate fixed TTIs
+  * \param numUes the number of UEs
+  * \param numSlots the number of slots
+  * \param traceFile the name of the reference trace
+  */
+  MmWaveFlexTtiRankedSchedulerTestCase (std::string type, bool harq, bool fixedTti,
+                                        uint16_t numUes, uint32_t numSlots, std::string traceFile);
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveFlexTtiRankedSchedulerTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Check that the TTIs of a slot are contiguous and the DCIs are consistent
+  * \param slot the allocation of the slot
+  * \param config the PHY/MAC configuration
+  * \param amc the AMC used to compute the TB sizes
+  */
+  void CheckSlot (const SlotAllocInfo &slot, Ptr<MmWavePhyMacCommon> config, Ptr<MmWaveAmc> amc);
+
+  /**
+  * Write the allocation of a slot as a line of the trace
+  * \param slot the allocation of the slot
+  * \param slotIdx the index of the slot
+  * \return the line of the trace
+  */
+  static std::string PrintSlot (const SlotAllocInfo &slot, uint32_t slotIdx);
+
+  /**
+  * Check that the trace of the run is the reference one
+  * \param actualFile the trace of the run
+  * \param expectedFile the reference trace
+  */
+  void CompareTraces (std::string actualFile, std::string expectedFile);
+
+  std::string m_type; ///< the TypeId of the scheduler
+  bool m_harq; ///< true to enable the HARQ
+  bool m_fixedTti; ///< true to allocate fixed TTIs
+  uint16_t m_numUes; ///< the number of UEs
+  uint32_t m_numSlots; ///< the number of slots
+  std::string m_traceFile; ///< the name of the reference trace
+};
+
+MmWaveFlexTtiRankedSchedulerTestCase::MmWaveFlexTtiRankedSchedulerTestCase (std::string type, bool harq, bool fixedTti,
+                                                                            uint16_t numUes, uint32_t numSlots, std::string traceFile)
+  : TestCase (type + (harq ? ", HARQ" : "") + (fixedTti ? ", fixed TTI" : "")
+              + ", " + std::to_string (numUes) + " UEs"),
+    m_type (type),
+    m_harq (harq),
+    m_fixedTti (fixedTti),
+    m_numUes (numUes),
+    m_numSlots (numSlots),
+    m_traceFile (traceFile)
+{
+}
+
+MmWaveFlexTtiRankedSchedulerTestCase::~MmWaveFlexTtiRankedSchedulerTestCase ()
+{
+}
+
+void
+MmWaveFlexTtiRankedSchedulerTestCase::CheckSlot (const SlotAllocInfo &slot, Ptr<MmWavePhyMacCommon> config, Ptr<MmWaveAmc> amc)
+{
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (slot.m_ttiAllocInfo.size (), 2u, "The control TTIs are missing");
+  const TtiAllocInfo &dlCtrl = slot.m_ttiAllocInfo.front ();
+  NS_TEST_ASSERT_MSG_EQ ((dlCtrl.m_ttiType == TtiAllocInfo::CTRL && dlCtrl.m_tddMode == TtiAllocInfo::DL_slotAllocInfo), true,
+                         "The first TTI should be the DL control");
+  const TtiAllocInfo &ulCtrl = slot.m_ttiAllocInfo.back ();
+  NS_TEST_ASSERT_MSG_EQ ((ulCtrl.m_ttiType == TtiAllocInfo::CTRL && ulCtrl.m_tddMode == TtiAllocInfo::UL_slotAllocInfo), true,
+                         "The last TTI should be the UL control");
+  NS_TEST_ASSERT_MSG_EQ ((unsigned) ulCtrl.m_dci.m_symStart, config->GetSymbPerSlot () - 1u, "Wrong start of the UL control");
+
+  unsigned symIdx = config->GetDlCtrlSymbols ();
+  for (unsigned i = 1; i + 1 < slot.m_ttiAllocInfo.size (); i++)
+    {
+      const TtiAllocInfo &tti = slot.m_ttiAllocInfo[i];
+      NS_TEST_ASSERT_MSG_EQ ((unsigned) tti.m_dci.m_symStart, symIdx, "The TTIs should be contiguous");
+      NS_TEST_ASSERT_MSG_GT ((unsigned) tti.m_dci.m_numSym, 0u, "Empty TTI");
+      symIdx += tti.m_dci.m_numSym;
+      NS_TEST_ASSERT_MSG_EQ (tti.m_dci.m_tbSize, (uint32_t) amc->GetTbSizeFromMcsSymbols (tti.m_dci.m_mcs, tti.m_dci.m_numSym) / 8,
+                             "Wrong TB size");
+      NS_TEST_ASSERT_MSG_LT ((unsigned) tti.m_dci.m_harqProcess, (unsigned) config->GetNumHarqProcess (), "Wrong HARQ process");
+      if (tti.m_tddMode == TtiAllocInfo::DL_slotAllocInfo)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((unsigned) tti.m_dci.m_format, 0u, "Wrong format of a DL DCI");
+          NS_TEST_ASSERT_MSG_GT (tti.m_rlcPduInfo.size (), 0u, "A DL TTI without RLC PDUs");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ ((unsigned) tti.m_dci.m_format, 1u, "Wrong format of an UL DCI");
+        }
+    }
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (symIdx, config->GetSymbPerSlot () - config->GetUlCtrlSymbols (), "The TTIs exceed the slot");
+}
+
+std::string
+MmWaveFlexTtiRankedSchedulerTestCase::PrintSlot (const SlotAllocInfo &slot, uint32_t slotIdx)
+{
+  // one TTI after the other: index, direction, type, RNTI, DCI RNTI, DCI
+  // format, first symbol, symbols, MCS, TB size, NDI, RV, HARQ process and
+  // the LCID:size of the RLC PDUs
+  std::ostringstream oss;
+  oss << slotIdx << " " << (unsigned) slot.m_numSymAlloc;
+  for (unsigned i = 0; i < slot.m_ttiAllocInfo.size (); i++)
+    {
+      const TtiAllocInfo &tti = slot.m_ttiAllocInfo[i];
+      oss << " | " << (unsigned) tti.m_ttiIdx << " " << tti.m_tddMode << " " << tti.m_ttiType
+          << " " << tti.m_rnti << " " << tti.m_dci.m_rnti << " " << (unsigned) tti.m_dci.m_format
+          << " " << (unsigned) tti.m_dci.m_symStart << " " << (unsigned) tti.m_dci.m_numSym
+          << " " << (unsigned) tti.m_dci.m_mcs << " " << tti.m_dci.m_tbSize << " " << (unsigned) tti.m_dci.m_ndi
+          << " " << (unsigned) tti.m_dci.m_rv << " " << (unsigned) tti.m_dci.m_harqProcess;
+      for (unsigned j = 0; j < tti.m_rlcPduInfo.size (); j++)
+        {
+          oss << " " << (unsigned) tti.m_rlcPduInfo[j].m_lcid << ":" << tti.m_rlcPduInfo[j].m_size;
+        }
+    }
+  return oss.str ();
+}
+
+void
+MmWaveFlexTtiRankedSchedulerTestCase::CompareTraces (std::string actualFile, std::string expectedFile)
+{
+  std::ifstream actual (actualFile.c_str ());
+  std::ifstream expected (expectedFile.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (expected.good (), true, "Unable to open the reference trace " << expectedFile);
+  std::string actualLine;
+  std::string expectedLine;
+  uint32_t slot = 0;
+  while (std::getline (expected, expectedLine))
+    {
+      NS_TEST_ASSERT_MSG_EQ (static_cast<bool> (std::getline (actual, actualLine)), true, "Missing slot " << slot);
+      NS_TEST_ASSERT_MSG_EQ (actualLine, expectedLine, "Different allocation of slot " << slot);
+      slot++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (static_cast<bool> (std::getline (actual, actualLine)), false, "Slots beyond the reference trace");
+}
+
+void
+MmWaveFlexTtiRankedSchedulerTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> config = CreateObject<MmWavePhyMacCommon> ();
+  config->SetNumReferenceSymbols (1);
+  Ptr<MmWaveAmc> amc = CreateObject<MmWaveAmc> (config);
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+
+  ObjectFactory factory;
+  factory.SetTypeId (m_type);
+  factory.Set ("HarqEnabled", BooleanValue (m_harq));
+  factory.Set ("FixedTti", BooleanValue (m_fixedTti));
+  Ptr<MmWaveMacScheduler> scheduler = factory.Create<MmWaveMacScheduler> ();
+  MmWaveRankedSchedTestSapUser schedSapUser;
+  MmWaveRankedCschedTestSapUser cschedSapUser;
+  scheduler->SetMacSchedSapUser (&schedSapUser);
+  scheduler->SetMacCschedSapUser (&cschedSapUser);
+  scheduler->ConfigureCommonParameters (config);
+  MmWaveMacSchedSapProvider *sched = scheduler->GetMacSchedSapProvider ();
+  MmWaveMacCschedSapProvider *csched = scheduler->GetMacCschedSapProvider ();
+
+  std::string traceFile = CreateTempDirFilename (m_traceFile);
+  std::ofstream trace (traceFile.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (trace.good (), true, "Unable to open the trace " << traceFile);
+
+  uint8_t lcid = 3;
+  MmWaveMacCschedSapProvider::CschedLcConfigReqParameters lcParams;
+  lcParams.m_reconfigureFlag = false;
+  LogicalChannelConfigListElement_s lc;
+  lc.m_logicalChannelIdentity = lcid;
+  lc.m_logicalChannelGroup = 1;
+  lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+  lc.m_qci = 9;
+  lcParams.m_logicalChannelConfigList.push_back (lc);
+  MmWaveMacCschedSapProvider::CschedUeConfigReqParameters ueParams;
+  ueParams.m_transmissionMode = 0;
+  for (uint16_t rnti = 1; rnti <= m_numUes; rnti++)
+    {
+      ueParams.m_rnti = rnti;
+      lcParams.m_rnti = rnti;
+      csched->CschedUeConfigReq (ueParams);
+      csched->CschedLcConfigReq (lcParams);
+    }
+
+  // the UE released and configured again, without HARQ as its feedback would refer to released processes
+  uint16_t releasedRnti = 2;
+  uint32_t releaseSlot = m_harq ? m_numSlots : m_numSlots / 3;
+  uint32_t reconfigSlot = releaseSlot + 10;
+
+  std::vector<uint8_t> cqis (m_numUes + 1, 8);
+  uint32_t slotsPerSf = config->GetSlotsPerSubframe ();
+  uint32_t slotsPerFrame = slotsPerSf * config->GetSubframesPerFrame ();
+  std::deque<MmWaveMacSchedSapProvider::SchedTriggerReqParameters> feedback;
+  const uint32_t feedbackDelay = 2;
+  for (uint32_t slot = 0; slot < m_numSlots; slot++)
+    {
+      if (slot == releaseSlot)
+        {
+          MmWaveMacCschedSapProvider::CschedUeReleaseReqParameters releaseParams;
+          releaseParams.m_rnti = releasedRnti;
+          csched->CschedUeReleaseReq (releaseParams);
+        }
+      else if (slot == reconfigSlot)
+        {
+          ueParams.m_rnti = releasedRnti;
+          lcParams.m_rnti = releasedRnti;
+          csched->CschedUeConfigReq (ueParams);
+          csched->CschedLcConfigReq (lcParams);
+        }
+
+      // DL CQIs in a random walk, sometimes out of range, also of an unknown UE
+      MmWaveMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiParams;
+      for (uint16_t rnti = 1; rnti <= m_numUes + 1; rnti++)
+        {
+          if (uniform->GetValue () < 0.3)
+            {
+              int cqi = cqis[rnti - 1] + uniform->GetInteger (0, 4) - 2;
+              cqis[rnti - 1] = std::max (1, std::min (15, cqi));
+              DlCqiInfo info;
+              info.m_rnti = rnti;
+              info.m_ri = 1;
+              info.m_cqiType = DlCqiInfo::WB;
+              info.m_wbCqi = uniform->GetValue () < 0.05 ? 0 : cqis[rnti - 1];
+              cqiParams.m_cqiList.push_back (info);
+            }
+        }
+
+      // DL RLC buffer reports, with and without the packets
+      std::vector<MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters> rlcParams;
+      for (uint16_t rnti = 1; rnti <= m_numUes; rnti++)
+        {
+          if (uniform->GetValue () < 0.5)
+            {
+              MmWaveMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+              params.m_rnti = rnti;
+              params.m_logicalChannelIdentity = lcid;
+              params.m_rlcTransmissionQueueSize = 0;
+              params.m_rlcTransmissionQueueHolDelay = 0;
+              params.m_rlcRetransmissionQueueSize = 0;
+              params.m_rlcRetransmissionHolDelay = 0;
+              params.m_rlcStatusPduSize = 0;
+              params.m_arrivalRate = 0;
+              uint32_t numPackets = uniform->GetInteger (0, 3);
+              for (uint32_t p = 0; p < numPackets; p++)
+                {
+                  uint32_t size = uniform->GetInteger (50, 1500);
+                  params.m_txPacketSizes.push_back (size);
+                  params.m_txPacketDelays.push_back (uniform->GetValue (0, 5000));
+                  params.m_rlcTransmissionQueueSize += size;
+                }
+              if (numPackets == 0)
+                {
+                  params.m_rlcTransmissionQueueSize = uniform->GetInteger (0, 3000);
+                }
+              rlcParams.push_back (params);
+            }
+        }
+
+      // BSRs of the UL logical channel groups
+      MmWaveMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsrParams;
+      for (uint16_t rnti = 1; rnti <= m_numUes; rnti++)
+        {
+          if (uniform->GetValue () < 0.3)
+            {
+              MacCeElement bsr;
+              bsr.m_rnti = rnti;
+              bsr.m_macCeType = MacCeElement::BSR;
+              for (unsigned lcg = 0; lcg < 4; lcg++)
+                {
+                  bsr.m_macCeValue.m_bufferStatus.push_back (uniform->GetInteger (0, 40));
+                }
+              bsrParams.m_macCeList.push_back (bsr);
+            }
+        }
+
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters triggerParams;
+      if (feedback.size () == feedbackDelay)
+        {
+          triggerParams = feedback.front ();
+          feedback.pop_front ();
+        }
+      triggerParams.m_snfSf = SfnSf (slot / slotsPerFrame, (slot % slotsPerFrame) / slotsPerSf, slot % slotsPerSf);
+
+      sched->SchedDlCqiInfoReq (cqiParams);
+      for (unsigned i = 0; i < rlcParams.size (); i++)
+        {
+          sched->SchedDlRlcBufferReq (rlcParams[i]);
+        }
+      sched->SchedUlMacCtrlInfoReq (bsrParams);
+      sched->SchedTriggerReq (triggerParams);
+
+      const SlotAllocInfo &allocation = schedSapUser.m_slotAllocInfo;
+      CheckSlot (allocation, config, amc);
+      trace << PrintSlot (allocation, slot) << std::endl;
+      if (IsStatusFailure ())
+        {
+          break;
+        }
+
+      // the UL SINRs of the UL TTIs and the HARQ feedback of the TTIs, received in later slots
+      MmWaveMacSchedSapProvider::SchedTriggerReqParameters nextFeedback;
+      std::vector<MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters> ulCqiParams;
+      for (unsigned i = 0; i < allocation.m_ttiAllocInfo.size (); i++)
+        {
+          const TtiAllocInfo &tti = allocation.m_ttiAllocInfo[i];
+          if (tti.m_ttiType == TtiAllocInfo::CTRL)
+            {
+              continue;
+            }
+          bool nack = uniform->GetValue () < 0.1;
+          if (tti.m_tddMode == TtiAllocInfo::DL_slotAllocInfo)
+            {
+              DlHarqInfo harqInfo;
+              harqInfo.m_rnti = tti.m_dci.m_rnti;
+              harqInfo.m_harqProcessId = tti.m_dci.m_harqProcess;
+              harqInfo.m_harqStatus = nack ? DlHarqInfo::NACK : DlHarqInfo::ACK;
+              harqInfo.m_numRetx = tti.m_dci.m_rv;
+              nextFeedback.m_dlHarqInfoList.push_back (harqInfo);
+            }
+          else
+            {
+              UlHarqInfo harqInfo;
+              harqInfo.m_rnti = tti.m_dci.m_rnti;
+              harqInfo.m_harqProcessId = tti.m_dci.m_harqProcess;
+              harqInfo.m_receptionStatus = nack ? UlHarqInfo::NotOk : UlHarqInfo::Ok;
+              harqInfo.m_numRetx = tti.m_dci.m_rv;
+              nextFeedback.m_ulHarqInfoList.push_back (harqInfo);
+
+              MmWaveMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+              ulCqi.m_sfnSf = allocation.m_sfnSf;
+              ulCqi.m_sfnSf.m_slotNum = tti.m_dci.m_symStart;
+              ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+              for (uint32_t chunk = 0; chunk < config->GetNumChunks (); chunk++)
+                {
+                  ulCqi.m_ulCqi.m_sinr.push_back (std::pow (10.0, uniform->GetValue (-5, 30) / 10.0));
+                }
+              ulCqiParams.push_back (ulCqi);
+            }
+        }
+      feedback.push_back (nextFeedback);
+      for (unsigned i = 0; i < ulCqiParams.size (); i++)
+        {
+          sched->SchedUlCqiInfoReq (ulCqiParams[i]);
+        }
+    }
+  trace.close ();
+  scheduler->Dispose ();
+
+  std::string referenceFile = CreateDataDirFilename (m_traceFile);
+  if (!IsStatusFailure () && traceFile != referenceFile)
+    {
+      CompareTraces (traceFile, referenceFile);
+    }
+}
+
+/**
+* Test suite of the flex-TTI schedulers ranking the UEs, against the traces
+* of the original implementations
+*/
+class MmWaveFlexTtiRankedSchedulerTestSuite : public TestSuite
+{
+public:
+  MmWaveFlexTtiRankedSchedulerTestSuite ();
+};
+
+MmWaveFlexTtiRankedSchedulerTestSuite::MmWaveFlexTtiRankedSchedulerTestSuite ()
+  : TestSuite ("mmwave-flex-tti-ranked-scheduler", UNIT)
+{
+  SetDataDir (NS_TEST_SOURCEDIR);
+  for (unsigned harq = 0; harq <= 1; harq++)
+    {
+      std::string suffix = harq ? "-harq.txt" : ".txt";
+      AddTestCase (new MmWaveFlexTtiRankedSchedulerTestCase ("ns3::MmWaveFlexTtiPfMacScheduler", harq, false, 12, 400,
+                                                             "mmwave-flex-tti-pf-trace" + suffix), TestCase::QUICK);
+      AddTestCase (new MmWaveFlexTtiRankedSchedulerTestCase ("ns3::MmWaveFlexTtiMaxRateMacScheduler", harq, false, 12, 400,
+                                                             "mmwave-flex-tti-maxrate-trace" + suffix), TestCase::QUICK);
+      AddTestCase (new MmWaveFlexTtiRankedSchedulerTestCase ("ns3::MmWaveFlexTtiMaxWeightMacScheduler", harq, false, 12, 400,
+                                                             "mmwave-flex-tti-maxweight-trace" + suffix), TestCase::QUICK);
+    }
+  AddTestCase (new MmWaveFlexTtiRankedSchedulerTestCase ("ns3::MmWaveFlexTtiMaxWeightMacScheduler", true, true, 12, 400,
+                                                         "mmwave-flex-tti-maxweight-trace-harq-fixed-tti.txt"), TestCase::QUICK);
+}
+
+static MmWaveFlexTtiRankedSchedulerTestSuite mmWaveFlexTtiRankedSchedulerTestSuite;
@@ -0,0 +1,206 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-mi-error-model.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/test.h"
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveMiErrorModelPerfTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case measures the time taken by MmWaveMiErrorModel::Mib for a
+* number of RBs, and checks its result against a per-RB lookup which selects
+* the MI curve of the modulation for each RB
+*/
+class MmWaveMibPerfTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  * \param numRbs the number of RBs
+  * \param repetitions the number of calls to measure
+  */
+  MmWaveMibPerfTestCase (uint32_t numRbs, uint32_t repetitions);
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveMibPerfTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Compute the mmib with a lookup per RB, as a reference
+  * \param sinr the perceived sinrs in the whole bandwidth
+  * \param map the actives RBs for the TB
+  * \param mcs the MCS of the TB
+  * \return the mmib
+  */
+  static double ReferenceMib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs);
+
+  /**
+  * Lookup the MI of a RB in a MI curve
+  * \param sinrLin the SINR of the RB
+  * \param miMap the MI curve
+  * \param miAxis the SINRs of the MI curve
+  * \param miSize the size of the MI curve
+  * \return the MI
+  */
+  static double LookupMi (double sinrLin, const double *miMap, const double *miAxis, uint32_t miSize);
+
+  uint32_t m_numRbs; //!< the number of RBs
+  uint32_t m_repetitions; //!< the number of calls to measure
+};
+
+MmWaveMibPerfTestCase::MmWaveMibPerfTestCase (uint32_t numRbs, uint32_t repetitions)
+  : TestCase ("Measures the time taken by the MI computation of " + std::to_string (numRbs) + " RBs"),
+    m_numRbs (numRbs),
+    m_repetitions (repetitions)
+{
+}
+
+MmWaveMibPerfTestCase::~MmWaveMibPerfTestCase ()
+{
+}
+
+double
+MmWaveMibPerfTestCase::LookupMi (double sinrLin, const double *miMap, const double *miAxis, uint32_t miSize)
+{
+  if (sinrLin > miAxis[miSize - 1])
+    {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - miAxis[0]) * (miSize - 1) / (miAxis[miSize - 1] - miAxis[0]) + 1;
+  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+  return miMap[sinrIndex];
+}
+
+double
+MmWaveMibPerfTestCase::ReferenceMib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  double MIsum = 0.0;
+  for (uint32_t i = 0; i < map.size (); i++)
+    {
+      double sinrLin = sinr[map.at (i)];
+      if (mcs <= MMWAVE_MI_QPSK_MAX_ID)
+        {
+          MIsum += LookupMi (sinrLin, MI_map_qpsk, MI_map_qpsk_axis, MMWAVE_MI_MAP_QPSK_SIZE);
+        }
+      else if (mcs <= MMWAVE_MI_16QAM_MAX_ID)
+        {
+          MIsum += LookupMi (sinrLin, MI_map_16qam, MI_map_16qam_axis, MMWAVE_MI_MAP_16QAM_SIZE);
+        }
+      else
+        {
+          MIsum += LookupMi (sinrLin, MI_map_64qam, MI_map_64qam_axis, MMWAVE_MI_MAP_64QAM_SIZE);
+        }
+    }
+  return MIsum / map.size ();
+}
+
+void
+MmWaveMibPerfTestCase::DoRun (void)
+{
+  std::vector<double> centerFrequencies;
+  for (uint32_t i = 0; i < m_numRbs; i++)
+    {
+      centerFrequencies.push_back (28e9 + i * 1.44e6);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (centerFrequencies);
+
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetAttribute ("Min", DoubleValue (-10.0));
+  sinrDb->SetAttribute ("Max", DoubleValue (30.0));
+  sinrDb->SetStream (1);
+  SpectrumValue sinr (model);
+  for (Values::iterator it = sinr.ValuesBegin (); it != sinr.ValuesEnd (); it++)
+    {
+      *it = std::pow (10.0, sinrDb->GetValue () / 10.0);
+    }
+  // a TB over all the RBs, and a TB over every other RB
+  std::vector<int> fullMap;
+  std::vector<int> halfMap;
+  for (uint32_t i = 0; i < m_numRbs; i++)
+    {
+      fullMap.push_back (i);
+      if (i % 2 == 0)
+        {
+          halfMap.push_back (i);
+        }
+    }
+
+  const uint8_t mcsList[] = {0, MMWAVE_MI_QPSK_MAX_ID + 1, MMWAVE_MI_16QAM_MAX_ID + 1};
+  for (uint8_t mcs : mcsList)
+    {
+      NS_TEST_ASSERT_MSG_EQ (MmWaveMiErrorModel::Mib (sinr, fullMap, mcs), ReferenceMib (sinr, fullMap, mcs),
+                             "Wrong MI for MCS " << (uint16_t) mcs);
+      NS_TEST_ASSERT_MSG_EQ (MmWaveMiErrorModel::Mib (sinr, halfMap, mcs), ReferenceMib (sinr, halfMap, mcs),
+                             "Wrong MI for MCS " << (uint16_t) mcs);
+
+      // the sum is printed so that the calls are not optimized out
+      SystemWallClockMs clock;
+      double sum = 0.0;
+      clock.Start ();
+      for (uint32_t rep = 0; rep < m_repetitions; rep++)
+        {
+          sum += MmWaveMiErrorModel::Mib (sinr, fullMap, mcs);
+        }
+      int64_t kernelMs = clock.End ();
+      clock.Start ();
+      for (uint32_t rep = 0; rep < m_repetitions; rep++)
+        {
+          sum += ReferenceMib (sinr, fullMap, mcs);
+        }
+      int64_t referenceMs = clock.End ();
+
+      std::cout << "Mib, " << m_numRbs << " RBs, MCS " << (uint16_t) mcs
+                << ": " << 1e6 * kernelMs / m_repetitions << " ns/call"
+                << " (per-RB lookup: " << 1e6 * referenceMs / m_repetitions << " ns/call)"
+                << " checksum " << sum << std::endl;
+    }
+}
+
+/**
+* This suite measures the performance of the MI computation of the
+* MmWaveMiErrorModel, for the typical numbers of RBs
+*/
+class MmWaveMiErrorModelPerfTest : public TestSuite
+{
+public:
+  MmWaveMiErrorModelPerfTest ();
+};
+
+MmWaveMiErrorModelPerfTest::MmWaveMiErrorModelPerfTest ()
+  : TestSuite ("mmwave-mi-error-model-perf", PERFORMANCE)
+{
+  AddTestCase (new MmWaveMibPerfTestCase (72, 100000), TestCase::QUICK);
+  AddTestCase (new MmWaveMibPerfTestCase (400, 20000), TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveMiErrorModelPerfTest mmwaveMiErrorModelPerfTestSuite;
@@ -0,0 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSinrEstimateTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks if the periodic SINR estimate of the MmWaveEnbPhy
+* skips the UEs outside the configured distance and reuses the rx PSDs of
+* the static links, by means of the SinrEstimateStats trace source
+*/
+class MmWaveSinrEstimateTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveSinrEstimateTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveSinrEstimateTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Collects the statistics of a SINR estimate
+  * \param cellId the cell ID
+  * \param numEvaluated the number of links whose rx PSD was computed
+  * \param numReused the number of links whose cached rx PSD was reused
+  * \param numSkipped the number of links outside the candidate set
+  */
+  void UpdateStats (uint16_t cellId, uint32_t numEvaluated, uint32_t numReused, uint32_t numSkipped);
+
+  uint32_t m_numEstimates; //!< the number of SINR estimates
+  uint32_t m_numEvaluated; //!< the total number of links evaluated
+  uint32_t m_numReused; //!< the total number of links reused
+  uint32_t m_numSkipped; //!< the total number of links skipped
+};
+
+MmWaveSinrEstimateTestCase::MmWaveSinrEstimateTestCase ()
+  : TestCase ("Checks if the periodic SINR estimate skips the far UEs and reuses the rx PSDs of the static links"),
+    m_numEstimates (0),
+    m_numEvaluated (0),
+    m_numReused (0),
+    m_numSkipped (0)
+{
+}
+
+MmWaveSinrEstimateTestCase::~MmWaveSinrEstimateTestCase ()
+{
+}
+
+void
+MmWaveSinrEstimateTestCase::UpdateStats (uint16_t cellId, uint32_t numEvaluated, uint32_t numReused, uint32_t numSkipped)
+{
+  NS_TEST_EXPECT_MSG_EQ (numEvaluated + numReused, 1, "Only the close UE should be a candidate");
+  NS_TEST_EXPECT_MSG_EQ (numSkipped, 1, "The far UE should be skipped");
+  m_numEstimates++;
+  m_numEvaluated += numEvaluated;
+  m_numReused += numReused;
+  m_numSkipped += numSkipped;
+}
+
+void
+MmWaveSinrEstimateTestCase::DoRun (void)
+{
+  // create a BS, a UE close to it and a UE far from it
+  Ptr<MmWaveHelper> helper = CreateObject<MmWaveHelper> ();
+
+  NodeContainer bsNodes;
+  bsNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (2);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 25.0));
+  positionAlloc->Add (Vector (50.0, 0.0, 1.6));
+  positionAlloc->Add (Vector (0.0, 400.0, 1.6));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (bsNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer bsNetDevs = helper->InstallEnbDevice (bsNodes);
+  NetDeviceContainer ueNetDevs = helper->InstallUeDevice (ueNodes);
+  helper->AttachToClosestEnb (ueNetDevs, bsNetDevs);
+
+  Ptr<MmWaveEnbPhy> enbPhy = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (0))->GetPhy (0);
+  enbPhy->SetAttribute ("SinrEstimateMaxDistance", DoubleValue (200.0));
+  enbPhy->SetAttribute ("SinrEstimateCacheEnabled", BooleanValue (true));
+  enbPhy->TraceConnectWithoutContext ("SinrEstimateStats", MakeCallback (&MmWaveSinrEstimateTestCase::UpdateStats, this));
+
+  Simulator::Stop (MilliSeconds (10));
+  Simulator::Run ();
+
+  // the rx PSD of the close UE is computed at least once, and then reused
+  // as long as its beam does not change
+  NS_TEST_ASSERT_MSG_GT (m_numEstimates, 1, "The SINR should be estimated periodically");
+  NS_TEST_ASSERT_MSG_EQ (m_numSkipped, m_numEstimates, "The far UE should be skipped in every estimate");
+  NS_TEST_ASSERT_MSG_GT (m_numEvaluated, 0, "The rx PSD of the close UE should be computed");
+  NS_TEST_ASSERT_MSG_GT (m_numReused, 0, "The rx PSD of the close UE should be reused");
+
+  Simulator::Destroy ();
+}
+
+/**
+* This suite tests the periodic SINR estimate of the MmWaveEnbPhy
+*/
+class MmWaveSinrEstimateTest : public TestSuite
+{
+public:
+  MmWaveSinrEstimateTest ();
+};
+
+MmWaveSinrEstimateTest::MmWaveSinrEstimateTest ()
+  : TestSuite ("mmwave-sinr-estimate-test", UNIT)
+{
+  AddTestCase (new MmWaveSinrEstimateTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveSinrEstimateTest mmwaveSinrEstimateTestSuite;
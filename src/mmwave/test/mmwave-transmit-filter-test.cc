@@ -0,0 +1,174 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/mmwave-helper.h"
+#include "ns3/mmwave-spectrum-transmit-filter.h"
+#include "ns3/mmwave-spectrum-signal-parameters.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveTransmitFilterTest");
+
+using namespace ns3;
+using namespace mmwave;
+
+/**
+* This test case checks if the MmWaveSpectrumTransmitFilter installed by the
+* MmWaveHelper filters out the BS to BS and UE to UE signals and the DL CTRL
+* frames directed to UEs of other cells, and only them, and if it correctly
+* counts the filtered signals
+*/
+class MmWaveTransmitFilterTestCase : public TestCase
+{
+public:
+  /**
+  * Constructor
+  */
+  MmWaveTransmitFilterTestCase ();
+
+  /**
+  * Destructor
+  */
+  virtual ~MmWaveTransmitFilterTestCase ();
+
+private:
+  /**
+  * Run the test
+  */
+  virtual void DoRun (void);
+
+  /**
+  * Creates the parameters of a signal transmitted by the given PHY
+  * \param txPhy the transmitter
+  * \return the signal parameters
+  */
+  static Ptr<SpectrumSignalParameters> CreateParams (Ptr<SpectrumPhy> txPhy);
+};
+
+MmWaveTransmitFilterTestCase::MmWaveTransmitFilterTestCase ()
+  : TestCase ("Checks if the MmWaveSpectrumTransmitFilter filters out the BS to BS and UE to UE signals")
+{
+}
+
+MmWaveTransmitFilterTestCase::~MmWaveTransmitFilterTestCase ()
+{
+}
+
+Ptr<SpectrumSignalParameters>
+MmWaveTransmitFilterTestCase::CreateParams (Ptr<SpectrumPhy> txPhy)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->txPhy = txPhy;
+  return params;
+}
+
+void
+MmWaveTransmitFilterTestCase::DoRun (void)
+{
+  // create two BSs and two UEs
+  Ptr<MmWaveHelper> helper = CreateObject<MmWaveHelper> ();
+
+  NodeContainer bsNodes;
+  bsNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (2);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 25.0));
+  positionAlloc->Add (Vector (100.0, 0.0, 25.0));
+  positionAlloc->Add (Vector (0.0, 20.0, 1.6));
+  positionAlloc->Add (Vector (100.0, 20.0, 1.6));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (bsNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer bsNetDevs = helper->InstallEnbDevice (bsNodes);
+  NetDeviceContainer ueNetDevs = helper->InstallUeDevice (ueNodes);
+
+  Ptr<MmWaveSpectrumPhy> enbPhy1 = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (0))->GetPhy (0)->GetDlSpectrumPhy ();
+  Ptr<MmWaveSpectrumPhy> enbPhy2 = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (1))->GetPhy (0)->GetDlSpectrumPhy ();
+  Ptr<MmWaveSpectrumPhy> uePhy1 = DynamicCast<MmWaveUeNetDevice> (ueNetDevs.Get (0))->GetPhy (0)->GetDlSpectrumPhy ();
+  Ptr<MmWaveSpectrumPhy> uePhy2 = DynamicCast<MmWaveUeNetDevice> (ueNetDevs.Get (1))->GetPhy (0)->GetDlSpectrumPhy ();
+
+  NS_TEST_ASSERT_MSG_EQ (enbPhy1->IsEnb (), true, "The PHY of an eNB device should be an eNB PHY");
+  NS_TEST_ASSERT_MSG_EQ (uePhy1->IsEnb (), false, "The PHY of a UE device should not be an eNB PHY");
+
+  // retrieve the filter installed on the channel
+  Ptr<MmWaveSpectrumTransmitFilter> filter = DynamicCast<MmWaveSpectrumTransmitFilter> (helper->GetChannel (0)->GetSpectrumTransmitFilter ());
+  NS_TEST_ASSERT_MSG_NE (filter, 0, "The MmWaveHelper did not install the transmit filter");
+
+  // BS to UE and UE to BS signals have to be delivered
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (CreateParams (enbPhy1), uePhy1), false, "BS to UE signal filtered out");
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (CreateParams (uePhy1), enbPhy2), false, "UE to BS signal filtered out");
+
+  // BS to BS and UE to UE signals have to be filtered out
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (CreateParams (enbPhy1), enbPhy2), true, "BS to BS signal not filtered out");
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (CreateParams (enbPhy2), enbPhy1), true, "BS to BS signal not filtered out");
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (CreateParams (uePhy1), uePhy2), true, "UE to UE signal not filtered out");
+
+  NS_TEST_ASSERT_MSG_EQ (filter->GetBsToBsFiltered (), 2, "Wrong number of BS to BS signals filtered out");
+  NS_TEST_ASSERT_MSG_EQ (filter->GetUeToUeFiltered (), 1, "Wrong number of UE to UE signals filtered out");
+
+  // the DL CTRL frames have to be delivered only to the UEs of the cell
+  helper->AttachToClosestEnb (ueNetDevs, bsNetDevs);
+  uint16_t cellId1 = DynamicCast<MmWaveEnbNetDevice> (bsNetDevs.Get (0))->GetCellId ();
+  NS_TEST_ASSERT_MSG_EQ (uePhy1->GetCellId (), cellId1, "UE 1 should be attached to BS 1");
+  NS_TEST_ASSERT_MSG_NE (uePhy2->GetCellId (), cellId1, "UE 2 should not be attached to BS 1");
+
+  Ptr<MmWaveSpectrumSignalParametersDlCtrlFrame> dlCtrlParams = Create<MmWaveSpectrumSignalParametersDlCtrlFrame> ();
+  dlCtrlParams->txPhy = enbPhy1;
+  dlCtrlParams->cellId = cellId1;
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (dlCtrlParams, uePhy1), false, "DL CTRL frame filtered out for a UE of the cell");
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (dlCtrlParams, uePhy2), true, "DL CTRL frame not filtered out for a UE of another cell");
+  NS_TEST_ASSERT_MSG_EQ (filter->GetDlCtrlFiltered (), 1, "Wrong number of DL CTRL frames filtered out");
+
+  // the DATA frames have to be delivered to all the UEs, since they are
+  // needed to compute the interference
+  Ptr<MmwaveSpectrumSignalParametersDataFrame> dataParams = Create<MmwaveSpectrumSignalParametersDataFrame> ();
+  dataParams->txPhy = enbPhy1;
+  dataParams->cellId = cellId1;
+  NS_TEST_ASSERT_MSG_EQ (filter->Filter (dataParams, uePhy2), false, "DATA frame filtered out for a UE of another cell");
+
+  // check if the filters added to a channel are chained
+  Ptr<MmWaveSpectrumTransmitFilter> otherFilter = CreateObject<MmWaveSpectrumTransmitFilter> ();
+  helper->GetChannel (0)->AddSpectrumTransmitFilter (otherFilter);
+  NS_TEST_ASSERT_MSG_EQ (helper->GetChannel (0)->GetSpectrumTransmitFilter (), otherFilter, "The last filter added should be the first of the chain");
+  NS_TEST_ASSERT_MSG_EQ (otherFilter->GetNext (), filter, "The filters are not chained");
+
+  Simulator::Destroy ();
+}
+
+/**
+* This suite tests if the MmWaveSpectrumTransmitFilter works properly
+*/
+class MmWaveTransmitFilterTest : public TestSuite
+{
+public:
+  MmWaveTransmitFilterTest ();
+};
+
+MmWaveTransmitFilterTest::MmWaveTransmitFilterTest ()
+  : TestSuite ("mmwave-transmit-filter-test", UNIT)
+{
+  AddTestCase (new MmWaveTransmitFilterTestCase, TestCase::QUICK);
+}
+
+// Do not forget to allocate an instance of this TestSuite
+static MmWaveTransmitFilterTest mmwaveTransmitFilterTestSuite;
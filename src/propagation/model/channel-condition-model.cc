@@ -20,6 +20,9 @@
 #include "channel-condition-model.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/mobility-model.h"
 #include <cmath>
 #include "ns3/node.h"
@@ -181,12 +184,50 @@ ThreeGppChannelConditionModel::GetTypeId (void)
                    TimeValue (MilliSeconds (0)),
                    MakeTimeAccessor (&ThreeGppChannelConditionModel::m_updatePeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("CounterBasedRng",
+                   "If true, the random value which determines the condition of a link "
+                   "is drawn from a counter-based generator specific to the link and "
+                   "to the update epoch, so that it does not depend on the order "
+                   "in which the links are evaluated",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppChannelConditionModel::m_counterBasedRng),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CacheMaxSize",
+                   "The memory budget in bytes of the cache of the channel conditions. "
+                   "When the estimated size of the cache exceeds it, the least recently "
+                   "used conditions are evicted. 0 means unbounded",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreeGppChannelConditionModel::SetCacheMaxSize,
+                                         &ThreeGppChannelConditionModel::GetCacheMaxSize),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddTraceSource ("CacheHits",
+                     "The number of times a valid channel condition was found in the cache",
+                     MakeTraceSourceAccessor (&ThreeGppChannelConditionModel::m_cacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheMisses",
+                     "The number of times a channel condition had to be generated",
+                     MakeTraceSourceAccessor (&ThreeGppChannelConditionModel::m_cacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheEvictions",
+                     "The number of channel conditions evicted from the cache",
+                     MakeTraceSourceAccessor (&ThreeGppChannelConditionModel::m_cacheEvictions),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("CacheSize",
+                     "The estimated size in bytes of the cache of the channel conditions",
+                     MakeTraceSourceAccessor (&ThreeGppChannelConditionModel::m_cacheSize),
+                     "ns3::TracedValueCallback::Uint64")
   ;
   return tid;
 }
 
 ThreeGppChannelConditionModel::ThreeGppChannelConditionModel ()
-  : ChannelConditionModel ()
+  : ChannelConditionModel (),
+    m_cacheHits (0),
+    m_cacheMisses (0),
+    m_cacheEvictions (0),
+    m_cacheSize (0),
+    m_rngKey (0),
+    m_rngKeyDrawn (false)
 {
   m_uniformVar = CreateObject<UniformRandomVariable> ();
   m_uniformVar->SetAttribute ("Min", DoubleValue (0));
@@ -199,7 +240,7 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel ()
 
 void ThreeGppChannelConditionModel::DoDispose ()
 {
-  m_channelConditionMap.clear ();
+  m_channelConditionMap.Clear ();
   m_updatePeriod = Seconds (0.0);
 }
 
@@ -210,20 +251,20 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
   Ptr<ChannelCondition> cond;
 
   // get the key for this channel
-  uint32_t key = GetKey (a, b);
+  uint64_t key = GetKey (a, b);
 
   bool notFound = false; // indicates if the channel condition is not present in the map
   bool update = false; // indicates if the channel condition has to be updated
 
   // look for the channel condition in m_channelConditionMap
-  auto mapItem = m_channelConditionMap.find (key);
-  if (mapItem != m_channelConditionMap.end ())
+  Item *mapItem = m_channelConditionMap.Find (key);
+  if (mapItem != nullptr)
     {
       NS_LOG_DEBUG ("found the channel condition in the map");
-      cond = mapItem->second.m_condition;
+      cond = mapItem->m_condition;
 
       // check if it has to be updated
-      if (!m_updatePeriod.IsZero () && Simulator::Now () - mapItem->second.m_generatedTime > m_updatePeriod)
+      if (!m_updatePeriod.IsZero () && Simulator::Now () - mapItem->m_generatedTime > m_updatePeriod)
         {
           NS_LOG_DEBUG ("it has to be updated");
           update = true;
@@ -239,11 +280,13 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
   // generate a new channel condition
   if (notFound || update)
     {
+      m_cacheMisses++;
+
       // compute the LOS probability (see 3GPP TR 38.901, Sec. 7.4.2)
       double pLos = ComputePlos (a, b);
 
       // draw a random value
-      double pRef = m_uniformVar->GetValue ();
+      double pRef = m_counterBasedRng ? GetLinkRng (a, b).RandU01 () : m_uniformVar->GetValue ();
 
       // get the channel condition
       cond = CreateObject<ChannelCondition> ();
@@ -259,14 +302,24 @@ ThreeGppChannelConditionModel::GetChannelCondition (Ptr<const MobilityModel> a,
         }
 
       {
-        // store the channel condition in m_channelConditionMap, used as cache.
-        // For this reason you see a const_cast.
+        // store the channel condition in m_channelConditionMap, used as cache
         Item mapItem;
         mapItem.m_condition = cond;
         mapItem.m_generatedTime = Simulator::Now ();
-        const_cast<ThreeGppChannelConditionModel*> (this)->m_channelConditionMap [key] = mapItem;
+        m_channelConditionMap.Insert (key, mapItem);
+        uint32_t numEvicted = m_channelConditionMap.SetEntrySize (key, sizeof (Item) + sizeof (ChannelCondition));
+        if (numEvicted > 0)
+          {
+            NS_LOG_DEBUG ("Evicted " << numEvicted << " channel conditions");
+            m_cacheEvictions += numEvicted;
+          }
+        m_cacheSize = m_channelConditionMap.GetSize ();
       }
     }
+  else
+    {
+      m_cacheHits++;
+    }
 
   return cond;
 }
@@ -275,9 +328,27 @@ int64_t
 ThreeGppChannelConditionModel::AssignStreams (int64_t stream)
 {
   m_uniformVar->SetStream (stream);
+  m_rngKeyDrawn = false;
   return 1;
 }
 
+PhiloxRng
+ThreeGppChannelConditionModel::GetLinkRng (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const
+{
+  // the key is drawn from the stream of this model, hence it depends on the
+  // run and on the stream number
+  if (!m_rngKeyDrawn)
+    {
+      m_rngKey = (static_cast<uint64_t> (m_uniformVar->GetInteger (0, UINT32_MAX)) << 32) | m_uniformVar->GetInteger (0, UINT32_MAX);
+      m_rngKeyDrawn = true;
+    }
+
+  uint64_t x1 = std::min (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint64_t x2 = std::max (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint32_t epoch = m_updatePeriod.IsZero () ? 0 : Simulator::Now ().GetTimeStep () / m_updatePeriod.GetTimeStep ();
+  return PhiloxRng (m_rngKey, (x1 << 32) | x2, epoch);
+}
+
 double
 ThreeGppChannelConditionModel::Calculate2dDistance (const Vector &a, const Vector &b)
 {
@@ -288,20 +359,34 @@ ThreeGppChannelConditionModel::Calculate2dDistance (const Vector &a, const Vecto
   return distance2D;
 }
 
-uint32_t
+uint64_t
 ThreeGppChannelConditionModel::GetKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
 {
   // use the nodes ids to obtain a unique key for the channel between a and b
   // sort the nodes ids so that the key is reciprocal
-  uint32_t x1 = std::min (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
-  uint32_t x2 = std::max (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint64_t x1 = std::min (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint64_t x2 = std::max (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
 
-  // use the cantor function to obtain the key
-  uint32_t key = (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+  // concatenate the ids, so that the key is different for each pair
+  uint64_t key = (x1 << 32) | x2;
 
   return key;
 }
 
+void
+ThreeGppChannelConditionModel::SetCacheMaxSize (uint64_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_cacheEvictions += m_channelConditionMap.SetMaxSize (maxSize);
+  m_cacheSize = m_channelConditionMap.GetSize ();
+}
+
+uint64_t
+ThreeGppChannelConditionModel::GetCacheMaxSize (void) const
+{
+  return m_channelConditionMap.GetMaxSize ();
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppRmaChannelConditionModel);
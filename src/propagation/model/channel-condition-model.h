@@ -24,6 +24,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 #include "ns3/nstime.h"
+#include "ns3/philox-rng.h"
+#include "ns3/lru-cache.h"
+#include "ns3/traced-value.h"
 #include <unordered_map>
 
 namespace ns3 {
@@ -353,7 +356,32 @@ private:
    * \param b rx mobility model
    * \return channel key
    */
-  static uint32_t GetKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+  static uint64_t GetKey (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+
+  /**
+   * Set the memory budget of m_channelConditionMap, evicting the least
+   * recently used channel conditions if needed
+   * \param maxSize the maximum size in bytes, 0 for an unbounded cache
+   */
+  void SetCacheMaxSize (uint64_t maxSize);
+
+  /**
+   * Get the memory budget of m_channelConditionMap
+   * \return the maximum size in bytes, 0 for an unbounded cache
+   */
+  uint64_t GetCacheMaxSize (void) const;
+
+  /**
+   * Returns the counter-based generator of the random values used to generate
+   * the condition of the channel between a and b at the current time. The
+   * generator depends on the run, on the stream of this model, on the link
+   * and on the current update epoch, but not on the other links.
+   *
+   * \param a mobility model
+   * \param b mobility model
+   * \return the counter-based generator
+   */
+  PhiloxRng GetLinkRng (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
 
   /**
    * Struct to store the channel condition in the m_channelConditionMap
@@ -364,9 +392,16 @@ private:
     Time m_generatedTime; //!< the time when the condition was generated
   };
 
-  std::unordered_map<uint32_t, Item> m_channelConditionMap; //!< map to store the channel conditions
+  mutable LruCache<uint64_t, Item> m_channelConditionMap; //!< cache to store the channel conditions
+  mutable TracedValue<uint64_t> m_cacheHits; //!< number of times a valid channel condition was found in m_channelConditionMap
+  mutable TracedValue<uint64_t> m_cacheMisses; //!< number of times a channel condition had to be generated
+  mutable TracedValue<uint64_t> m_cacheEvictions; //!< number of channel conditions evicted from m_channelConditionMap
+  mutable TracedValue<uint64_t> m_cacheSize; //!< estimated size of m_channelConditionMap in bytes
   Time m_updatePeriod; //!< the update period for the channel condition
   Ptr<UniformRandomVariable> m_uniformVar; //!< uniform random variable
+  bool m_counterBasedRng; //!< if true, the random values of each link are drawn from a counter-based generator
+  mutable uint64_t m_rngKey; //!< the key of the counter-based generators, drawn from m_uniformVar
+  mutable bool m_rngKeyDrawn; //!< true if m_rngKey was drawn
 };
 
 /**
@@ -170,7 +170,7 @@ ThreeGppPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityMo
   double shadowingValue;
 
   // compute the channel key
-  uint32_t key = GetKey (a, b);
+  uint64_t key = GetKey (a, b);
 
   bool notFound = false; // indicates if the shadowing value has not been computed yet
   bool newCondition = false; // indicates if the channel condition has changed
@@ -243,16 +243,16 @@ ThreeGppPropagationLossModel::Calculate2dDistance (Vector a, Vector b)
   return distance2D;
 }
 
-uint32_t
+uint64_t
 ThreeGppPropagationLossModel::GetKey (Ptr<MobilityModel> a, Ptr<MobilityModel> b)
 {
   // use the nodes ids to obtain an unique key for the channel between a and b
   // sort the nodes ids so that the key is reciprocal
-  uint32_t x1 = std::min (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
-  uint32_t x2 = std::max (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint64_t x1 = std::min (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
+  uint64_t x2 = std::max (a->GetObject<Node> ()->GetId (), b->GetObject<Node> ()->GetId ());
 
-  // use the cantor function to obtain the key
-  uint32_t key = (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+  // concatenate the ids, so that the key is different for each pair
+  uint64_t key = (x1 << 32) | x2;
 
   return key;
 }
@@ -176,15 +176,14 @@ private:
   /**
    * \brief Returns an unique key for the channel between a and b.
    *
-   * The key is the value of the Cantor function calculated by using as
-   * first parameter the lowest node ID, and as a second parameter the highest
-   * node ID.
+   * The key contains the lowest node ID in the 32 most significant bits,
+   * and the highest node ID in the 32 least significant bits.
    *
    * \param a tx mobility model
    * \param b rx mobility model
    * \return channel key
    */
-  static uint32_t GetKey (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+  static uint64_t GetKey (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
 
   /**
    * \brief Get the difference between the node position
@@ -222,7 +221,7 @@ protected:
     Vector m_distance; //!< the vector AB
   };
 
-  mutable std::unordered_map<uint32_t, ShadowingMapItem> m_shadowingMap; //!< map to store the shadowing values
+  mutable std::unordered_map<uint64_t, ShadowingMapItem> m_shadowingMap; //!< map to store the shadowing values
 };
 
 /**
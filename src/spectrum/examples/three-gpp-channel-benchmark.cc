@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+* This program measures the time needed by the 3GPP channel model classes to
+* generate the channel matrices and to compute the received PSD.
+* A BS with a 8x8 array is connected to numUes UEs with a 4x4 array, randomly
+* placed around it. The program reports:
+* - the average time needed to generate a new channel matrix,
+* - the average time needed to compute the received PSD when the long term
+*   component is retrieved from the cache,
+* - the average time needed to compute the received PSD when the beamforming
+*   vectors change at every call, i.e., when the long term component has to be
+*   computed again.
+* With the batch option, the channel matrices are generated by a single call
+* to GetChannels, which uses numWorkerThreads threads.
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/three-gpp-channel-model.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/channel-condition-model.h"
+#include "ns3/uniform-planar-array.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/simple-net-device.h"
+#include <chrono>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("ThreeGppChannelBenchmark");
+
+using namespace ns3;
+
+/**
+ * Returns a beamforming vector pointing towards the given direction
+ * \param antenna the antenna array
+ * \param angle the direction
+ * \return the beamforming vector
+ */
+static PhasedArrayModel::ComplexVector
+GetBeam (Ptr<PhasedArrayModel> antenna, Angles angle)
+{
+  uint32_t numElements = antenna->GetNumberOfElements ();
+  PhasedArrayModel::ComplexVector bf (numElements);
+  for (uint32_t i = 0; i < numElements; i++)
+    {
+      Vector loc = antenna->GetElementLocation (i);
+      double phase = -2 * M_PI * (sin (angle.theta) * cos (angle.phi) * loc.x
+                                  + sin (angle.theta) * sin (angle.phi) * loc.y
+                                  + cos (angle.theta) * loc.z);
+      bf[i] = exp (std::complex<double> (0, phase)) / sqrt (numElements);
+    }
+  return bf;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numUes = 50; // number of UEs
+  uint32_t numIterations = 20; // number of PSD computations for each UE
+  uint32_t bsSize = 8; // number of rows and columns of the BS array
+  uint32_t ueSize = 4; // number of rows and columns of the UE array
+  uint32_t numBands = 100; // number of sub-bands of the PSD
+  std::string scenario = "UMi-StreetCanyon";
+  bool batch = false; // if true, generate the channel matrices in a single batch
+  uint32_t numWorkerThreads = 1; // number of threads used to generate a batch
+
+  CommandLine cmd;
+  cmd.AddValue ("numUes", "Number of UEs", numUes);
+  cmd.AddValue ("numIterations", "Number of PSD computations for each UE", numIterations);
+  cmd.AddValue ("bsSize", "Number of rows and columns of the BS array", bsSize);
+  cmd.AddValue ("ueSize", "Number of rows and columns of the UE array", ueSize);
+  cmd.AddValue ("numBands", "Number of sub-bands of the PSD", numBands);
+  cmd.AddValue ("scenario", "The 3GPP propagation scenario", scenario);
+  cmd.AddValue ("batch", "If true, generate the channel matrices in a single batch", batch);
+  cmd.AddValue ("numWorkerThreads", "Number of threads used to generate a batch of channel matrices", numWorkerThreads);
+  cmd.Parse (argc, argv);
+
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  double frequency = 28e9;
+  double subcarrierSpacing = 120e3 * 12;
+
+  Ptr<ChannelConditionModel> condModel = CreateObject<ThreeGppUmiStreetCanyonChannelConditionModel> ();
+  Ptr<ThreeGppSpectrumPropagationLossModel> splm = CreateObject<ThreeGppSpectrumPropagationLossModel> ();
+  splm->SetChannelModelAttribute ("Frequency", DoubleValue (frequency));
+  splm->SetChannelModelAttribute ("Scenario", StringValue (scenario));
+  splm->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (condModel));
+  splm->SetChannelModelAttribute ("NumWorkerThreads", UintegerValue (numWorkerThreads));
+  Ptr<MatrixBasedChannelModel> channelModel = splm->GetChannelModel ();
+
+  // create the nodes
+  NodeContainer bsNode;
+  bsNode.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (numUes);
+
+  Ptr<MobilityModel> bsMob = CreateObject<ConstantPositionMobilityModel> ();
+  bsMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  bsNode.Get (0)->AggregateObject (bsMob);
+
+  Ptr<UniformRandomVariable> posRv = CreateObject<UniformRandomVariable> ();
+  std::vector<Ptr<MobilityModel> > ueMobs;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      Ptr<MobilityModel> ueMob = CreateObject<ConstantPositionMobilityModel> ();
+      ueMob->SetPosition (Vector (posRv->GetValue (-100.0, 100.0), posRv->GetValue (10.0, 100.0), 1.5));
+      ueNodes.Get (i)->AggregateObject (ueMob);
+      ueMobs.push_back (ueMob);
+    }
+
+  // create the devices
+  Ptr<SimpleNetDevice> bsDev = CreateObject<SimpleNetDevice> ();
+  bsNode.Get (0)->AddDevice (bsDev);
+  std::vector<Ptr<SimpleNetDevice> > ueDevs;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      Ptr<SimpleNetDevice> ueDev = CreateObject<SimpleNetDevice> ();
+      ueNodes.Get (i)->AddDevice (ueDev);
+      ueDevs.push_back (ueDev);
+    }
+
+  // create the antennas
+  Ptr<PhasedArrayModel> bsAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (bsSize),
+                                                                                    "NumRows", UintegerValue (bsSize));
+  splm->AddDevice (bsDev, bsAntenna);
+  std::vector<Ptr<PhasedArrayModel> > ueAntennas;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      Ptr<PhasedArrayModel> ueAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (ueSize),
+                                                                                        "NumRows", UintegerValue (ueSize));
+      splm->AddDevice (ueDevs[i], ueAntenna);
+      ueAntennas.push_back (ueAntenna);
+    }
+
+  // create the PSD
+  std::vector<BandInfo> bands;
+  for (uint32_t i = 0; i < numBands; i++)
+    {
+      BandInfo band;
+      band.fc = frequency + (i - numBands / 2.0) * subcarrierSpacing;
+      band.fl = band.fc - subcarrierSpacing / 2;
+      band.fh = band.fc + subcarrierSpacing / 2;
+      bands.push_back (band);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (bands);
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (sm);
+  (*txPsd) = 1e-9;
+
+  // channel generation
+  auto start = std::chrono::steady_clock::now ();
+  if (batch)
+    {
+      std::vector<MatrixBasedChannelModel::Link> links;
+      for (uint32_t i = 0; i < numUes; i++)
+        {
+          links.push_back (MatrixBasedChannelModel::Link (bsMob, ueMobs[i], bsAntenna, ueAntennas[i]));
+        }
+      channelModel->GetChannels (links);
+    }
+  else
+    {
+      for (uint32_t i = 0; i < numUes; i++)
+        {
+          channelModel->GetChannel (bsMob, ueMobs[i], bsAntenna, ueAntennas[i]);
+        }
+    }
+  double channelTime = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+  // compute two different beams for each link
+  std::vector<PhasedArrayModel::ComplexVector> bsBeams[2];
+  std::vector<PhasedArrayModel::ComplexVector> ueBeams[2];
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      Angles bsAngle (ueMobs[i]->GetPosition (), bsMob->GetPosition ());
+      Angles ueAngle (bsMob->GetPosition (), ueMobs[i]->GetPosition ());
+      bsBeams[0].push_back (GetBeam (bsAntenna, bsAngle));
+      ueBeams[0].push_back (GetBeam (ueAntennas[i], ueAngle));
+      bsBeams[1].push_back (GetBeam (bsAntenna, Angles (bsAngle.phi + 0.2, bsAngle.theta)));
+      ueBeams[1].push_back (GetBeam (ueAntennas[i], Angles (ueAngle.phi - 0.2, ueAngle.theta)));
+    }
+
+  // PSD computation with fixed beams, the long term component is computed
+  // only once for each link
+  double cachedTime = 0.0;
+  double updatedTime = 0.0;
+  double checksum = 0.0;
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      bsAntenna->SetBeamformingVector (bsBeams[0][i]);
+      ueAntennas[i]->SetBeamformingVector (ueBeams[0][i]);
+      splm->CalcRxPowerSpectralDensity (txPsd, bsMob, ueMobs[i]);
+
+      start = std::chrono::steady_clock::now ();
+      for (uint32_t it = 0; it < numIterations; it++)
+        {
+          checksum += Sum (*splm->CalcRxPowerSpectralDensity (txPsd, bsMob, ueMobs[i]));
+        }
+      cachedTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+      // PSD computation with a different beam at each call, the long term
+      // component is computed every time
+      start = std::chrono::steady_clock::now ();
+      for (uint32_t it = 0; it < numIterations; it++)
+        {
+          bsAntenna->SetBeamformingVector (bsBeams[it % 2][i]);
+          ueAntennas[i]->SetBeamformingVector (ueBeams[it % 2][i]);
+          checksum += Sum (*splm->CalcRxPowerSpectralDensity (txPsd, bsMob, ueMobs[i]));
+        }
+      updatedTime += std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+    }
+
+  double numPsds = numUes * numIterations;
+  std::cout << "array sizes: " << bsSize * bsSize << "x" << ueSize * ueSize
+            << ", bands: " << numBands << ", UEs: " << numUes << std::endl;
+  std::cout << "channel generation: " << channelTime / numUes * 1e6 << " us per channel" << std::endl;
+  std::cout << "rx PSD, cached long term: " << cachedTime / numPsds * 1e6 << " us per call" << std::endl;
+  std::cout << "rx PSD, updated long term: " << updatedTime / numPsds * 1e6 << " us per call" << std::endl;
+  std::cout << "long term computation: " << (updatedTime - cachedTime) / numPsds * 1e6 << " us per call" << std::endl;
+  std::cout << "checksum: " << checksum << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
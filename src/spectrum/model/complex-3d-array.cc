@@ -0,0 +1,114 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "complex-3d-array.h"
+
+namespace ns3 {
+
+const std::size_t Complex3DArray::ALIGNMENT;
+
+Complex3DArray::Complex3DArray ()
+  : Complex3DArray (0, 0, 0)
+{
+}
+
+Complex3DArray::Complex3DArray (std::size_t numRxElements, std::size_t numTxElements, std::size_t numClusters,
+                                Layout layout)
+  : m_numRxElements (numRxElements),
+    m_numTxElements (numTxElements),
+    m_numClusters (numClusters),
+    m_layout (layout),
+    m_values (numRxElements * numTxElements * numClusters)
+{
+  ComputeStrides ();
+}
+
+Complex3DArray::Complex3DArray (const NestedVector &nested, Layout layout)
+  : Complex3DArray (nested.size (),
+                    nested.empty () ? 0 : nested[0].size (),
+                    nested.empty () || nested[0].empty () ? 0 : nested[0][0].size (),
+                    layout)
+{
+  for (std::size_t u = 0; u < m_numRxElements; u++)
+    {
+      NS_ABORT_MSG_IF (nested[u].size () != m_numTxElements, "All the rows must have the same size");
+      for (std::size_t s = 0; s < m_numTxElements; s++)
+        {
+          NS_ABORT_MSG_IF (nested[u][s].size () != m_numClusters, "All the antenna pairs must have the same number of clusters");
+          for (std::size_t n = 0; n < m_numClusters; n++)
+            {
+              (*this) (u, s, n) = nested[u][s][n];
+            }
+        }
+    }
+}
+
+Complex3DArray::Complex3DArray (const Complex3DArray &other, Layout layout)
+  : Complex3DArray (other.m_numRxElements, other.m_numTxElements, other.m_numClusters, layout)
+{
+  for (std::size_t u = 0; u < m_numRxElements; u++)
+    {
+      for (std::size_t s = 0; s < m_numTxElements; s++)
+        {
+          for (std::size_t n = 0; n < m_numClusters; n++)
+            {
+              (*this) (u, s, n) = other (u, s, n);
+            }
+        }
+    }
+}
+
+void
+Complex3DArray::ComputeStrides ()
+{
+  switch (m_layout)
+    {
+    case ANTENNA_MAJOR:
+      m_clusterStride = 1;
+      m_txStride = m_numClusters;
+      m_rxStride = m_numTxElements * m_numClusters;
+      break;
+    case CLUSTER_MAJOR:
+      m_txStride = 1;
+      m_rxStride = m_numTxElements;
+      m_clusterStride = m_numRxElements * m_numTxElements;
+      break;
+    default:
+      NS_ABORT_MSG ("Unknown layout");
+    }
+}
+
+Complex3DArray::NestedVector
+Complex3DArray::ToNestedVector () const
+{
+  NestedVector nested (m_numRxElements, std::vector<ComplexVector> (m_numTxElements, ComplexVector (m_numClusters)));
+  for (std::size_t u = 0; u < m_numRxElements; u++)
+    {
+      for (std::size_t s = 0; s < m_numTxElements; s++)
+        {
+          for (std::size_t n = 0; n < m_numClusters; n++)
+            {
+              nested[u][s][n] = (*this) (u, s, n);
+            }
+        }
+    }
+  return nested;
+}
+
+} // namespace ns3
@@ -0,0 +1,349 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "complex-vector-kernels.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+#if (defined (__x86_64__) || defined (__i386__)) && (defined (__GNUC__) || defined (__clang__))
+#define NS3_COMPLEX_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ComplexVectorKernels");
+
+namespace {
+
+// The complex values are accessed as pairs of doubles, which is allowed by
+// the standard (std::complex<double> is layout-compatible with double[2]).
+
+void
+WeightedSumPortable (std::size_t numRows, std::size_t rowSize, const std::complex<double> *w,
+                     const std::complex<double> *x, std::complex<double> *y)
+{
+  const double *xd = reinterpret_cast<const double*> (x);
+  double *yd = reinterpret_cast<double*> (y);
+  for (std::size_t r = 0; r < numRows; r++)
+    {
+      double wRe = w[r].real ();
+      double wIm = w[r].imag ();
+      for (std::size_t i = 0; i < rowSize; i++)
+        {
+          double xRe = xd[2 * i];
+          double xIm = xd[2 * i + 1];
+          yd[2 * i] += wRe * xRe - wIm * xIm;
+          yd[2 * i + 1] += wRe * xIm + wIm * xRe;
+        }
+      xd += 2 * rowSize;
+    }
+}
+
+std::complex<double>
+DotPortable (std::size_t n, const std::complex<double> *w, const std::complex<double> *x)
+{
+  const double *wd = reinterpret_cast<const double*> (w);
+  const double *xd = reinterpret_cast<const double*> (x);
+  double sumRe = 0.0;
+  double sumIm = 0.0;
+  for (std::size_t i = 0; i < n; i++)
+    {
+      sumRe += wd[2 * i] * xd[2 * i] - wd[2 * i + 1] * xd[2 * i + 1];
+      sumIm += wd[2 * i] * xd[2 * i + 1] + wd[2 * i + 1] * xd[2 * i];
+    }
+  return std::complex<double> (sumRe, sumIm);
+}
+
+void
+PhasorSumPortable (std::size_t n, std::size_t numSteps, double *aRe, double *aIm,
+                   const double *sRe, const double *sIm, double *gain)
+{
+  for (std::size_t k = 0; k < numSteps; k++)
+    {
+      double sumRe = 0.0;
+      double sumIm = 0.0;
+      for (std::size_t i = 0; i < n; i++)
+        {
+          double re = aRe[i];
+          double im = aIm[i];
+          sumRe += re;
+          sumIm += im;
+          aRe[i] = re * sRe[i] - im * sIm[i];
+          aIm[i] = re * sIm[i] + im * sRe[i];
+        }
+      gain[k] = sumRe * sumRe + sumIm * sumIm;
+    }
+}
+
+#ifdef NS3_COMPLEX_KERNELS_X86
+
+__attribute__ ((target ("avx2,fma"))) void
+WeightedSumAvx2 (std::size_t numRows, std::size_t rowSize, const std::complex<double> *w,
+                 const std::complex<double> *x, std::complex<double> *y)
+{
+  const double *xd = reinterpret_cast<const double*> (x);
+  double *yd = reinterpret_cast<double*> (y);
+  std::size_t nv = rowSize - rowSize % 2;
+  for (std::size_t r = 0; r < numRows; r++)
+    {
+      __m256d wRe = _mm256_set1_pd (w[r].real ());
+      __m256d wIm = _mm256_set1_pd (w[r].imag ());
+      for (std::size_t i = 0; i < nv; i += 2)
+        {
+          // [xRe0 xIm0 xRe1 xIm1]
+          __m256d xv = _mm256_loadu_pd (xd + 2 * i);
+          // [xIm0 * wIm, xRe0 * wIm, ...]
+          __m256d t = _mm256_mul_pd (_mm256_permute_pd (xv, 0x5), wIm);
+          // [xRe * wRe - xIm * wIm, xIm * wRe + xRe * wIm, ...]
+          __m256d res = _mm256_fmaddsub_pd (xv, wRe, t);
+          _mm256_storeu_pd (yd + 2 * i, _mm256_add_pd (_mm256_loadu_pd (yd + 2 * i), res));
+        }
+      xd += 2 * rowSize;
+      WeightedSumPortable (1, rowSize - nv, w + r, x + r * rowSize + nv, y + nv);
+    }
+}
+
+__attribute__ ((target ("avx2,fma"))) std::complex<double>
+DotAvx2 (std::size_t n, const std::complex<double> *w, const std::complex<double> *x)
+{
+  const double *wd = reinterpret_cast<const double*> (w);
+  const double *xd = reinterpret_cast<const double*> (x);
+  __m256d acc = _mm256_setzero_pd ();
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    {
+      __m256d wv = _mm256_loadu_pd (wd + 2 * i);
+      __m256d xv = _mm256_loadu_pd (xd + 2 * i);
+      __m256d t = _mm256_mul_pd (_mm256_permute_pd (xv, 0x5), _mm256_permute_pd (wv, 0xF));
+      acc = _mm256_add_pd (acc, _mm256_fmaddsub_pd (xv, _mm256_movedup_pd (wv), t));
+    }
+  alignas (32) double sums[4];
+  _mm256_store_pd (sums, acc);
+  return std::complex<double> (sums[0] + sums[2], sums[1] + sums[3]) + DotPortable (n - i, w + i, x + i);
+}
+
+__attribute__ ((target ("avx2,fma"))) void
+PhasorSumAvx2 (std::size_t n, std::size_t numSteps, double *aRe, double *aIm,
+               const double *sRe, const double *sIm, double *gain)
+{
+  std::size_t nv = n - n % 4;
+  for (std::size_t k = 0; k < numSteps; k++)
+    {
+      __m256d accRe = _mm256_setzero_pd ();
+      __m256d accIm = _mm256_setzero_pd ();
+      for (std::size_t i = 0; i < nv; i += 4)
+        {
+          __m256d re = _mm256_loadu_pd (aRe + i);
+          __m256d im = _mm256_loadu_pd (aIm + i);
+          __m256d stepRe = _mm256_loadu_pd (sRe + i);
+          __m256d stepIm = _mm256_loadu_pd (sIm + i);
+          accRe = _mm256_add_pd (accRe, re);
+          accIm = _mm256_add_pd (accIm, im);
+          _mm256_storeu_pd (aRe + i, _mm256_fmsub_pd (re, stepRe, _mm256_mul_pd (im, stepIm)));
+          _mm256_storeu_pd (aIm + i, _mm256_fmadd_pd (re, stepIm, _mm256_mul_pd (im, stepRe)));
+        }
+      alignas (32) double sumsRe[4];
+      alignas (32) double sumsIm[4];
+      _mm256_store_pd (sumsRe, accRe);
+      _mm256_store_pd (sumsIm, accIm);
+      double sumRe = (sumsRe[0] + sumsRe[1]) + (sumsRe[2] + sumsRe[3]);
+      double sumIm = (sumsIm[0] + sumsIm[1]) + (sumsIm[2] + sumsIm[3]);
+      for (std::size_t i = nv; i < n; i++)
+        {
+          double re = aRe[i];
+          double im = aIm[i];
+          sumRe += re;
+          sumIm += im;
+          aRe[i] = re * sRe[i] - im * sIm[i];
+          aIm[i] = re * sIm[i] + im * sRe[i];
+        }
+      gain[k] = sumRe * sumRe + sumIm * sumIm;
+    }
+}
+
+__attribute__ ((target ("avx512f"))) void
+WeightedSumAvx512 (std::size_t numRows, std::size_t rowSize, const std::complex<double> *w,
+                   const std::complex<double> *x, std::complex<double> *y)
+{
+  const double *xd = reinterpret_cast<const double*> (x);
+  double *yd = reinterpret_cast<double*> (y);
+  std::size_t nv = rowSize - rowSize % 4;
+  for (std::size_t r = 0; r < numRows; r++)
+    {
+      __m512d wRe = _mm512_set1_pd (w[r].real ());
+      __m512d wIm = _mm512_set1_pd (w[r].imag ());
+      for (std::size_t i = 0; i < nv; i += 4)
+        {
+          __m512d xv = _mm512_loadu_pd (xd + 2 * i);
+          __m512d t = _mm512_mul_pd (_mm512_permute_pd (xv, 0x55), wIm);
+          __m512d res = _mm512_fmaddsub_pd (xv, wRe, t);
+          _mm512_storeu_pd (yd + 2 * i, _mm512_add_pd (_mm512_loadu_pd (yd + 2 * i), res));
+        }
+      xd += 2 * rowSize;
+      WeightedSumPortable (1, rowSize - nv, w + r, x + r * rowSize + nv, y + nv);
+    }
+}
+
+__attribute__ ((target ("avx512f"))) std::complex<double>
+DotAvx512 (std::size_t n, const std::complex<double> *w, const std::complex<double> *x)
+{
+  const double *wd = reinterpret_cast<const double*> (w);
+  const double *xd = reinterpret_cast<const double*> (x);
+  __m512d acc = _mm512_setzero_pd ();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+      __m512d wv = _mm512_loadu_pd (wd + 2 * i);
+      __m512d xv = _mm512_loadu_pd (xd + 2 * i);
+      __m512d t = _mm512_mul_pd (_mm512_permute_pd (xv, 0x55), _mm512_permute_pd (wv, 0xFF));
+      acc = _mm512_add_pd (acc, _mm512_fmaddsub_pd (xv, _mm512_movedup_pd (wv), t));
+    }
+  alignas (64) double sums[8];
+  _mm512_store_pd (sums, acc);
+  return std::complex<double> ((sums[0] + sums[2]) + (sums[4] + sums[6]), (sums[1] + sums[3]) + (sums[5] + sums[7]))
+         + DotAvx2 (n - i, w + i, x + i);
+}
+
+__attribute__ ((target ("avx512f"))) void
+PhasorSumAvx512 (std::size_t n, std::size_t numSteps, double *aRe, double *aIm,
+                 const double *sRe, const double *sIm, double *gain)
+{
+  std::size_t nv = n - n % 8;
+  for (std::size_t k = 0; k < numSteps; k++)
+    {
+      __m512d accRe = _mm512_setzero_pd ();
+      __m512d accIm = _mm512_setzero_pd ();
+      for (std::size_t i = 0; i < nv; i += 8)
+        {
+          __m512d re = _mm512_loadu_pd (aRe + i);
+          __m512d im = _mm512_loadu_pd (aIm + i);
+          __m512d stepRe = _mm512_loadu_pd (sRe + i);
+          __m512d stepIm = _mm512_loadu_pd (sIm + i);
+          accRe = _mm512_add_pd (accRe, re);
+          accIm = _mm512_add_pd (accIm, im);
+          _mm512_storeu_pd (aRe + i, _mm512_fmsub_pd (re, stepRe, _mm512_mul_pd (im, stepIm)));
+          _mm512_storeu_pd (aIm + i, _mm512_fmadd_pd (re, stepIm, _mm512_mul_pd (im, stepRe)));
+        }
+      double sumRe = _mm512_reduce_add_pd (accRe);
+      double sumIm = _mm512_reduce_add_pd (accIm);
+      for (std::size_t i = nv; i < n; i++)
+        {
+          double re = aRe[i];
+          double im = aIm[i];
+          sumRe += re;
+          sumIm += im;
+          aRe[i] = re * sRe[i] - im * sIm[i];
+          aIm[i] = re * sIm[i] + im * sRe[i];
+        }
+      gain[k] = sumRe * sumRe + sumIm * sumIm;
+    }
+}
+
+#endif /* NS3_COMPLEX_KERNELS_X86 */
+
+} // unnamed namespace
+
+ComplexVectorKernels::InstructionSet
+ComplexVectorKernels::GetInstructionSet (void)
+{
+  return GetKernels ().isa;
+}
+
+void
+ComplexVectorKernels::SetInstructionSet (InstructionSet isa)
+{
+  NS_LOG_FUNCTION (GetName (isa));
+  NS_ABORT_MSG_UNLESS (IsSupported (isa), "Instruction set " << GetName (isa) << " not supported");
+  GetKernels () = MakeKernels (isa);
+}
+
+bool
+ComplexVectorKernels::IsSupported (InstructionSet isa)
+{
+  switch (isa)
+    {
+    case PORTABLE:
+      return true;
+#ifdef NS3_COMPLEX_KERNELS_X86
+    case AVX2:
+      return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+    case AVX512:
+      return __builtin_cpu_supports ("avx512f") && IsSupported (AVX2);
+#endif
+    default:
+      return false;
+    }
+}
+
+std::string
+ComplexVectorKernels::GetName (InstructionSet isa)
+{
+  switch (isa)
+    {
+    case PORTABLE:
+      return "portable";
+    case AVX2:
+      return "AVX2";
+    case AVX512:
+      return "AVX-512";
+    default:
+      NS_ABORT_MSG ("Unknown instruction set");
+      return "";
+    }
+}
+
+ComplexVectorKernels::Kernels&
+ComplexVectorKernels::GetKernels (void)
+{
+  static Kernels kernels = MakeKernels (IsSupported (AVX512) ? AVX512 : IsSupported (AVX2) ? AVX2 : PORTABLE);
+  return kernels;
+}
+
+ComplexVectorKernels::Kernels
+ComplexVectorKernels::MakeKernels (InstructionSet isa)
+{
+  NS_LOG_INFO ("Using the " << GetName (isa) << " kernels");
+  Kernels kernels;
+  kernels.isa = isa;
+  switch (isa)
+    {
+#ifdef NS3_COMPLEX_KERNELS_X86
+    case AVX512:
+      kernels.weightedSum = &WeightedSumAvx512;
+      kernels.dot = &DotAvx512;
+      kernels.phasorSum = &PhasorSumAvx512;
+      break;
+    case AVX2:
+      kernels.weightedSum = &WeightedSumAvx2;
+      kernels.dot = &DotAvx2;
+      kernels.phasorSum = &PhasorSumAvx2;
+      break;
+#endif
+    default:
+      kernels.isa = PORTABLE;
+      kernels.weightedSum = &WeightedSumPortable;
+      kernels.dot = &DotPortable;
+      kernels.phasorSum = &PhasorSumPortable;
+      break;
+    }
+  return kernels;
+}
+
+} // namespace ns3
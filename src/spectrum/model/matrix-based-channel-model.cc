@@ -27,4 +27,16 @@ MatrixBasedChannelModel::~MatrixBasedChannelModel()
 {
 }
 
+std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> >
+MatrixBasedChannelModel::GetChannels (const std::vector<Link> &links)
+{
+  std::vector<Ptr<const ChannelMatrix> > channels;
+  channels.reserve (links.size ());
+  for (const Link &link : links)
+    {
+      channels.push_back (GetChannel (link.m_aMob, link.m_bMob, link.m_aAntenna, link.m_bAntenna));
+    }
+  return channels;
+}
+
 }
@@ -26,13 +26,14 @@
 #include <ns3/object.h>
 #include <ns3/nstime.h>
 #include <ns3/vector.h>
+#include <ns3/mobility-model.h>
 #include <ns3/phased-array-model.h>
+#include <ns3/complex-3d-array.h>
 #include <tuple>
+#include <vector>
 
 namespace ns3 {
 
-class MobilityModel;
-
 /**
  * \ingroup spectrum
  *
@@ -52,7 +53,7 @@ public:
   typedef std::vector<DoubleVector> Double2DVector; //!< type definition for matrices of doubles
   typedef std::vector<Double2DVector> Double3DVector; //!< type definition for 3D matrices of doubles
   typedef std::vector<PhasedArrayModel::ComplexVector> Complex2DVector; //!< type definition for complex matrices
-  typedef std::vector<Complex2DVector> Complex3DVector; //!< type definition for complex 3D matrices
+  typedef std::vector<Complex2DVector> Complex3DVector; //!< type definition for complex 3D matrices stored as nested vectors
 
 
   /**
@@ -60,7 +61,7 @@ public:
    */
   struct ChannelMatrix : public SimpleRefCount<ChannelMatrix>
   {
-    Complex3DVector    m_channel; //!< channel matrix H[u][s][n].
+    Complex3DArray     m_channel; //!< channel matrix H[u][s][n].
     DoubleVector       m_delay; //!< cluster delay in nanoseconds.
     Double2DVector     m_angle; //!< cluster angle angle[direction][n], where direction = 0(AOA), 1(ZOA), 2(AOD), 3(ZOD) in degree.
     Time               m_generatedTime; //!< generation time
@@ -112,14 +113,57 @@ public:
                                                Ptr<const PhasedArrayModel> bAntenna) = 0;
 
   /**
-   * Calculate the channel key using the Cantor function
+   * Data structure that describes a link, i.e., the mobility models and the
+   * antennas of its two devices
+   */
+  struct Link
+  {
+    Ptr<const MobilityModel> m_aMob; //!< mobility model of the a device
+    Ptr<const MobilityModel> m_bMob; //!< mobility model of the b device
+    Ptr<const PhasedArrayModel> m_aAntenna; //!< antenna of the a device
+    Ptr<const PhasedArrayModel> m_bAntenna; //!< antenna of the b device
+
+    /**
+     * Constructor
+     * \param aMob mobility model of the a device
+     * \param bMob mobility model of the b device
+     * \param aAntenna antenna of the a device
+     * \param bAntenna antenna of the b device
+     */
+    Link (Ptr<const MobilityModel> aMob, Ptr<const MobilityModel> bMob,
+          Ptr<const PhasedArrayModel> aAntenna, Ptr<const PhasedArrayModel> bAntenna)
+      : m_aMob (aMob),
+        m_bMob (bMob),
+        m_aAntenna (aAntenna),
+        m_bAntenna (bAntenna)
+    {
+    }
+  };
+
+  /**
+   * Returns the channel matrices of a set of links, as GetChannel would do
+   * for each of them.
+   *
+   * This allows the channel models to generate the realizations of the links
+   * which are not available or have to be updated in a single batch, e.g.,
+   * to prefetch all the links of a cell at the beginning of a coherence
+   * period. The default implementation calls GetChannel for each link.
+   *
+   * \param links the links
+   * \return the channel matrices, in the same order as the links
+   */
+  virtual std::vector<Ptr<const ChannelMatrix> > GetChannels (const std::vector<Link> &links);
+
+  /**
+   * Calculate the channel key, which is different for each pair (x1, x2)
    * \param x1 first value
    * \param x2 second value
-   * \return \f$ (((x1 + x2) * (x1 + x2 + 1))/2) + x2; \f$
+   * \return x1 in the 32 most significant bits and x2 in the 32 least
+   *         significant bits
    */
-  static constexpr uint32_t GetKey (uint32_t x1, uint32_t x2)
+  static constexpr uint64_t GetKey (uint32_t x1, uint32_t x2)
   {
-   return (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+   return (static_cast<uint64_t> (x1) << 32) | x2;
   }
 
   static const uint8_t AOA_INDEX = 0; //!< index of the AOA value in the m_angle array
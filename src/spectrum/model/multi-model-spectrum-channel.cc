@@ -269,6 +269,14 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
+              // skip the receivers that the transmit filters discard, before
+              // computing any propagation loss
+              if (m_filter && m_filter->Filter (txParams, *rxPhyIterator))
+                {
+                  NS_LOG_LOGIC ("signal filtered out for receiver " << *rxPhyIterator);
+                  continue;
+                }
+
               NS_LOG_LOGIC ("copying signal parameters " << txParams);
               Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
               rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
@@ -112,6 +112,14 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
     {
       if ((*rxPhyIterator) != txParams->txPhy)
         {
+          // skip the receivers that the transmit filters discard, before
+          // computing any propagation loss
+          if (m_filter && m_filter->Filter (txParams, *rxPhyIterator))
+            {
+              NS_LOG_LOGIC ("signal filtered out for receiver " << *rxPhyIterator);
+              continue;
+            }
+
           Time delay  = MicroSeconds (0);
 
           Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
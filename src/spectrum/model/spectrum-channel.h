@@ -30,6 +30,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/propagation-loss-model.h>
 #include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-transmit-filter.h>
 #include <ns3/traced-callback.h>
 #include <ns3/mobility-model.h>
 
@@ -101,6 +102,21 @@ public:
    */
   Ptr<PropagationLossModel> GetPropagationLossModel (void);
 
+  /**
+   * Add the transmit filter to be used to filter out receivers before
+   * computing the propagation loss. If other filters were previously added,
+   * the new filter is chained to them.
+   *
+   * \param filter a pointer to the filter to be added
+   */
+  void AddSpectrumTransmitFilter (Ptr<SpectrumTransmitFilter> filter);
+
+  /**
+   * Get the transmit filter, i.e., the first filter of the chain.
+   * \returns a pointer to the transmit filter
+   */
+  Ptr<SpectrumTransmitFilter> GetSpectrumTransmitFilter (void) const;
+
   /**
    * Used by attached PHY instances to transmit signals on the channel
    *
@@ -198,6 +214,11 @@ protected:
    */
   Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
 
+  /**
+   * Transmit filter to be used with this channel.
+   */
+  Ptr<SpectrumTransmitFilter> m_filter;
+
 
 };
 
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 SIGNET Lab, Department of Information Engineering,
+ * University of Padova
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPECTRUM_TRANSMIT_FILTER_H
+#define SPECTRUM_TRANSMIT_FILTER_H
+
+#include <ns3/object.h>
+
+namespace ns3 {
+
+struct SpectrumSignalParameters;
+class SpectrumPhy;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief spectrum-aware transmit filter object
+ *
+ * Interface for transmit filters used by the SpectrumChannel to decide,
+ * before evaluating the propagation loss models, whether a signal has to be
+ * delivered to a receiver. Filtering out the receivers that would anyway
+ * discard the signal avoids computing the propagation loss, and possibly
+ * generating a new channel matrix, for links that are never used.
+ *
+ * Multiple filters can be chained: a signal is filtered out if at least one
+ * of the filters in the chain filters it out.
+ */
+class SpectrumTransmitFilter : public Object
+{
+public:
+  SpectrumTransmitFilter ();
+  virtual ~SpectrumTransmitFilter ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Used to chain various instances of SpectrumTransmitFilter
+   *
+   * \param next the filter to be evaluated after this one
+   */
+  void SetNext (Ptr<SpectrumTransmitFilter> next);
+
+  /**
+   * \return the filter chained to this one
+   */
+  Ptr<const SpectrumTransmitFilter> GetNext (void) const;
+
+  /**
+   * Evaluate whether the signal described by params should be filtered
+   * out before reaching the receiver, by this filter or by any of the
+   * filters chained to it
+   *
+   * \param params the parameters of the transmitted signal
+   * \param receiverPhy the receiver
+   * \return true if the signal has to be filtered out, false otherwise
+   */
+  bool Filter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Evaluate whether the signal described by params should be filtered
+   * out before reaching the receiver
+   *
+   * \param params the parameters of the transmitted signal
+   * \param receiverPhy the receiver
+   * \return true if the signal has to be filtered out, false otherwise
+   */
+  virtual bool DoFilter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) = 0;
+
+  Ptr<SpectrumTransmitFilter> m_next; //!< SpectrumTransmitFilter chained to this one.
+};
+
+} // namespace ns3
+
+#endif /* SPECTRUM_TRANSMIT_FILTER_H */
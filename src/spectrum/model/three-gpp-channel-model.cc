@@ -27,12 +27,20 @@
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 #include <algorithm>
 #include <random>
 #include "ns3/log.h"
 #include <ns3/simulator.h>
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#endif
+#include <map>
 
 namespace ns3 {
 
@@ -161,6 +169,12 @@ static const double sqrtC_office_NLOS[6][6] = {
 };
 
 ThreeGppChannelModel::ThreeGppChannelModel ()
+  : m_channelCacheHits (0),
+    m_channelCacheMisses (0),
+    m_channelCacheEvictions (0),
+    m_channelCacheSize (0),
+    m_rngKey (0),
+    m_rngKeyDrawn (false)
 {
   NS_LOG_FUNCTION (this);
   m_uniformRv = CreateObject<UniformRandomVariable> ();
@@ -178,8 +192,11 @@ ThreeGppChannelModel::~ThreeGppChannelModel ()
 void
 ThreeGppChannelModel::DoDispose ()
 {
-  m_channelMap.clear ();
-  m_channelConditionModel->Dispose ();
+  m_channelMap.Clear ();
+  if (m_channelConditionModel)
+    {
+      m_channelConditionModel->Dispose ();
+    }
   m_channelConditionModel = nullptr;
 }
 
@@ -235,6 +252,44 @@ ThreeGppChannelModel::GetTypeId (void)
                    DoubleValue (1),
                    MakeDoubleAccessor (&ThreeGppChannelModel::m_blockerSpeed),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("NumWorkerThreads",
+                   "The number of threads computing the channel coefficients "
+                   "when multiple channel realizations are generated by GetChannels",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&ThreeGppChannelModel::m_numWorkerThreads),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("CounterBasedRng",
+                   "If true, the random variables of a channel realization are drawn "
+                   "from a counter-based generator specific to the link, to the update "
+                   "epoch and to the LOS condition, so that they do not depend on the "
+                   "order in which the links are evaluated",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ThreeGppChannelModel::m_counterBasedRng),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ChannelCacheMaxSize",
+                   "The memory budget in bytes of the cache of the channel realizations. "
+                   "When the estimated size of the cache exceeds it, the least recently "
+                   "used realizations are evicted. 0 means unbounded",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreeGppChannelModel::SetChannelCacheMaxSize,
+                                         &ThreeGppChannelModel::GetChannelCacheMaxSize),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddTraceSource ("ChannelCacheHits",
+                     "The number of times a valid channel realization was found in the cache",
+                     MakeTraceSourceAccessor (&ThreeGppChannelModel::m_channelCacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("ChannelCacheMisses",
+                     "The number of times a channel realization had to be generated",
+                     MakeTraceSourceAccessor (&ThreeGppChannelModel::m_channelCacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("ChannelCacheEvictions",
+                     "The number of channel realizations evicted from the cache",
+                     MakeTraceSourceAccessor (&ThreeGppChannelModel::m_channelCacheEvictions),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("ChannelCacheSize",
+                     "The estimated size in bytes of the cache of the channel realizations",
+                     MakeTraceSourceAccessor (&ThreeGppChannelModel::m_channelCacheSize),
+                     "ns3::TracedValueCallback::Uint64")
     ;
   return tid;
 }
@@ -739,18 +794,18 @@ ThreeGppChannelModel::ChannelMatrixNeedsUpdate (Ptr<const ThreeGppChannelMatrix>
   return update;
 }
 
-Ptr<const MatrixBasedChannelModel::ChannelMatrix>
-ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
-                                  Ptr<const MobilityModel> bMob,
-                                  Ptr<const PhasedArrayModel> aAntenna,
-                                  Ptr<const PhasedArrayModel> bAntenna)
+bool
+ThreeGppChannelModel::LookupChannel (Ptr<const MobilityModel> aMob,
+                                     Ptr<const MobilityModel> bMob,
+                                     Ptr<ThreeGppChannelMatrix> &channelMatrix,
+                                     RayParams &rays)
 {
   NS_LOG_FUNCTION (this);
 
   // Compute the channel key. The key is reciprocal, i.e., key (a, b) = key (b, a)
   uint32_t x1 = std::min (aMob->GetObject<Node> ()->GetId (), bMob->GetObject<Node> ()->GetId ());
   uint32_t x2 = std::max (aMob->GetObject<Node> ()->GetId (), bMob->GetObject<Node> ()->GetId ());
-  uint32_t channelId = GetKey (x1, x2);
+  uint64_t channelId = GetKey (x1, x2);
 
   // retrieve the channel condition
   Ptr<const ChannelCondition> condition = m_channelConditionModel->GetChannelCondition (aMob, bMob);
@@ -761,12 +816,12 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
   // generate a new channel
   bool update = false;
   bool notFound = false;
-  Ptr<ThreeGppChannelMatrix> channelMatrix;
-  if (m_channelMap.find (channelId) != m_channelMap.end ())
+  Ptr<ThreeGppChannelMatrix> *mapItem = m_channelMap.Find (channelId);
+  if (mapItem != nullptr)
     {
       // channel matrix present in the map
       NS_LOG_DEBUG ("channel matrix present in the map");
-      channelMatrix = m_channelMap[channelId];
+      channelMatrix = *mapItem;
 
       // check if it has to be updated
       update = ChannelMatrixNeedsUpdate (channelMatrix, los);
@@ -777,6 +832,15 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
     notFound = true;
   }
 
+  if (notFound || update)
+    {
+      m_channelCacheMisses++;
+    }
+  else
+    {
+      m_channelCacheHits++;
+    }
+
   // If the channel is not present in the map or if it has to be updated
   // generate a new realization
   if (notFound || update)
@@ -800,22 +864,284 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
       // tx and rx instead
       Vector locUt = Vector (0.0, 0.0, 0.0);
 
-      channelMatrix = GetNewChannel (locUt, los, o2i, aAntenna, bAntenna, rxAngle, txAngle, distance2D, hBs, hUt);
+      RandomSource rng = m_counterBasedRng ? RandomSource (GetLinkRng (x1, x2, los))
+                                           : RandomSource (m_uniformRv, m_normalRv);
+      channelMatrix = GetNewChannel (locUt, los, o2i, rxAngle, txAngle, distance2D, hBs, hUt, rays, rng);
       channelMatrix->m_nodeIds = std::make_pair (aMob->GetObject<Node> ()->GetId (), bMob->GetObject<Node> ()->GetId ());
 
-      // store or replace the channel matrix in the channel map
-      m_channelMap[channelId] = channelMatrix;
+      // store or replace the channel matrix in the channel map. Its size is
+      // updated once its channel coefficients have been computed
+      m_channelMap.Insert (channelId, channelMatrix);
   }
 
+  return notFound || update;
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
+                                  Ptr<const MobilityModel> bMob,
+                                  Ptr<const PhasedArrayModel> aAntenna,
+                                  Ptr<const PhasedArrayModel> bAntenna)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<ThreeGppChannelMatrix> channelMatrix;
+  RayParams rays;
+  if (LookupChannel (aMob, bMob, channelMatrix, rays))
+    {
+      channelMatrix->m_channel = ComputeChannelCoefficients (rays, *aAntenna, *bAntenna);
+      channelMatrix->m_sAntenna = aAntenna;
+      channelMatrix->m_uAntenna = bAntenna;
+      UpdateChannelCacheEntry (channelMatrix);
+    }
+
+  // the realization may have been generated for other antennas, e.g., by
+  // another component carrier sharing this channel model
+  NS_ASSERT_MSG (IsAntennaGeometryMatching (channelMatrix, aMob->GetObject<Node> ()->GetId (), aAntenna, bAntenna),
+                 "The antennas do not match the ones used to generate the channel matrix");
+
   return channelMatrix;
 }
 
+/**
+ * Computes the channel coefficients of a batch of channel realizations. The
+ * realizations are shared among the threads which call Run, each of them
+ * taking the next realization whose coefficients have not been computed yet.
+ */
+class ThreeGppChannelModel::ChannelCoefficientsJob
+{
+public:
+  /**
+   * Constructor
+   * \param model the channel model
+   * \param pending the channel realizations whose coefficients have to be computed
+   */
+  ChannelCoefficientsJob (const ThreeGppChannelModel *model, std::vector<PendingChannel> &pending)
+    : m_model (model),
+      m_pending (pending),
+      m_next (0)
+  {
+  }
+
+  /**
+   * Computes the channel coefficients of the pending realizations until
+   * all of them have been taken
+   */
+  void Run (void)
+  {
+    while (true)
+      {
+        std::size_t index;
+        {
+#ifdef HAVE_PTHREAD_H
+          CriticalSection cs (m_mutex);
+#endif
+          index = m_next++;
+        }
+        if (index >= m_pending.size ())
+          {
+            break;
+          }
+        // NOTE the Ptrs are not thread safe, hence they must not be copied here
+        PendingChannel &pending = m_pending[index];
+        pending.m_channelMatrix->m_channel = m_model->ComputeChannelCoefficients (pending.m_rays,
+                                                                                  *pending.m_sAntenna,
+                                                                                  *pending.m_uAntenna);
+      }
+  }
+
+private:
+  const ThreeGppChannelModel *m_model; //!< the channel model
+  std::vector<PendingChannel> &m_pending; //!< the pending channel realizations
+  std::size_t m_next; //!< the index of the next pending realization
+#ifdef HAVE_PTHREAD_H
+  SystemMutex m_mutex; //!< the mutex protecting m_next
+#endif
+};
+
+std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> >
+ThreeGppChannelModel::GetChannels (const std::vector<Link> &links)
+{
+  NS_LOG_FUNCTION (this << links.size ());
+
+  // The random parameters of the new realizations are drawn in the order of
+  // the channel keys, so that they do not depend on the order of the links,
+  // and then the channel coefficients, which are the most expensive part, are
+  // computed in parallel. Each link is looked up once, even if it appears
+  // multiple times.
+  std::map<uint64_t, std::size_t> firstLink; // the index of the first occurrence of each channel key
+  for (std::size_t i = 0; i < links.size (); i++)
+    {
+      uint32_t aId = links[i].m_aMob->GetObject<Node> ()->GetId ();
+      uint32_t bId = links[i].m_bMob->GetObject<Node> ()->GetId ();
+      firstLink.insert (std::make_pair (GetKey (std::min (aId, bId), std::max (aId, bId)), i));
+    }
+
+  std::vector<PendingChannel> pending;
+  std::unordered_map<uint64_t, Ptr<const ChannelMatrix> > channels;
+  for (const auto &entry : firstLink)
+    {
+      const Link &link = links[entry.second];
+      Ptr<ThreeGppChannelMatrix> channelMatrix;
+      RayParams rays;
+      if (LookupChannel (link.m_aMob, link.m_bMob, channelMatrix, rays))
+        {
+          PendingChannel p;
+          p.m_channelMatrix = channelMatrix;
+          p.m_rays = std::move (rays);
+          p.m_sAntenna = link.m_aAntenna;
+          p.m_uAntenna = link.m_bAntenna;
+          channelMatrix->m_sAntenna = link.m_aAntenna;
+          channelMatrix->m_uAntenna = link.m_bAntenna;
+          pending.push_back (std::move (p));
+        }
+      channels[entry.first] = channelMatrix;
+    }
+
+  NS_LOG_DEBUG ("Generate " << pending.size () << " channel realizations out of " << firstLink.size () << " links");
+
+  ChannelCoefficientsJob job (this, pending);
+#ifdef HAVE_PTHREAD_H
+  // the calling thread takes part in the job as well
+  std::size_t numThreads = std::min<std::size_t> (m_numWorkerThreads, pending.size ());
+  std::vector<Ptr<SystemThread> > threads;
+  for (std::size_t i = 1; i < numThreads; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&ChannelCoefficientsJob::Run, &job));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+  job.Run ();
+  for (auto &thread : threads)
+    {
+      thread->Join ();
+    }
+#else
+  job.Run ();
+#endif
+
+  for (const PendingChannel &p : pending)
+    {
+      UpdateChannelCacheEntry (p.m_channelMatrix);
+    }
+
+  std::vector<Ptr<const ChannelMatrix> > result;
+  result.reserve (links.size ());
+  for (const Link &link : links)
+    {
+      uint32_t aId = link.m_aMob->GetObject<Node> ()->GetId ();
+      uint32_t bId = link.m_bMob->GetObject<Node> ()->GetId ();
+      Ptr<const ChannelMatrix> channelMatrix = channels[GetKey (std::min (aId, bId), std::max (aId, bId))];
+      NS_ASSERT_MSG (IsAntennaGeometryMatching (DynamicCast<const ThreeGppChannelMatrix> (channelMatrix), aId,
+                                                link.m_aAntenna, link.m_bAntenna),
+                     "The antennas do not match the ones used to generate the channel matrix");
+      result.push_back (channelMatrix);
+    }
+  return result;
+}
+
+bool
+ThreeGppChannelModel::IsAntennaGeometryMatching (Ptr<const ThreeGppChannelMatrix> channelMatrix,
+                                                 uint32_t aId,
+                                                 Ptr<const PhasedArrayModel> aAntenna,
+                                                 Ptr<const PhasedArrayModel> bAntenna)
+{
+  // the channel coefficients may have been computed with a as the u-node
+  Ptr<const PhasedArrayModel> sAntenna = aAntenna;
+  Ptr<const PhasedArrayModel> uAntenna = bAntenna;
+  if (channelMatrix->m_nodeIds.first != aId)
+    {
+      std::swap (sAntenna, uAntenna);
+    }
+
+  // compare the number of elements of each antenna, and their locations,
+  // which set the phases of the channel coefficients
+  std::pair<Ptr<const PhasedArrayModel>, Ptr<const PhasedArrayModel> > antennas[] = {
+    std::make_pair (sAntenna, channelMatrix->m_sAntenna),
+    std::make_pair (uAntenna, channelMatrix->m_uAntenna)};
+  for (const auto &antenna : antennas)
+    {
+      if (antenna.first == antenna.second)
+        {
+          continue;
+        }
+      uint64_t numElements = antenna.first->GetNumberOfElements ();
+      if (numElements != antenna.second->GetNumberOfElements ())
+        {
+          return false;
+        }
+      for (uint64_t i = 0; i < numElements; i++)
+        {
+          if (!(antenna.first->GetElementLocation (i) == antenna.second->GetElementLocation (i)))
+            {
+              return false;
+            }
+        }
+    }
+  return true;
+}
+
+void
+ThreeGppChannelModel::SetChannelCacheMaxSize (uint64_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_channelCacheEvictions += m_channelMap.SetMaxSize (maxSize);
+  m_channelCacheSize = m_channelMap.GetSize ();
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheMaxSize (void) const
+{
+  return m_channelMap.GetMaxSize ();
+}
+
+void
+ThreeGppChannelModel::UpdateChannelCacheEntry (Ptr<const ThreeGppChannelMatrix> channelMatrix)
+{
+  uint32_t x1 = std::min (channelMatrix->m_nodeIds.first, channelMatrix->m_nodeIds.second);
+  uint32_t x2 = std::max (channelMatrix->m_nodeIds.first, channelMatrix->m_nodeIds.second);
+  uint32_t numEvicted = m_channelMap.SetEntrySize (GetKey (x1, x2), GetChannelMatrixSize (*channelMatrix));
+  if (numEvicted > 0)
+    {
+      NS_LOG_DEBUG ("Evicted " << numEvicted << " channel realizations");
+      m_channelCacheEvictions += numEvicted;
+    }
+  m_channelCacheSize = m_channelMap.GetSize ();
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelMatrixSize (const ThreeGppChannelMatrix &channelMatrix)
+{
+  uint64_t numDoubles = channelMatrix.m_delay.size ();
+  for (const auto &v : channelMatrix.m_angle)
+    {
+      numDoubles += v.size ();
+    }
+  for (const auto &v : channelMatrix.m_nonSelfBlocking)
+    {
+      numDoubles += v.size ();
+    }
+  for (const auto &v : channelMatrix.m_norRvAngles)
+    {
+      numDoubles += v.size ();
+    }
+  for (const auto &m : channelMatrix.m_clusterPhase)
+    {
+      for (const auto &v : m)
+        {
+          numDoubles += v.size ();
+        }
+    }
+  return sizeof (ThreeGppChannelMatrix)
+         + channelMatrix.m_channel.GetNumElements () * sizeof (std::complex<double>)
+         + numDoubles * sizeof (double);
+}
+
 Ptr<ThreeGppChannelModel::ThreeGppChannelMatrix>
 ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
-                                     Ptr<const PhasedArrayModel> sAntenna,
-                                     Ptr<const PhasedArrayModel> uAntenna,
                                      Angles &uAngle, Angles &sAngle,
-                                     double dis2D, double hBS, double hUT) const
+                                     double dis2D, double hBS, double hUT,
+                                     RayParams &rays, RandomSource &rng) const
 {
   NS_LOG_FUNCTION (this);
 
@@ -851,7 +1177,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   //Generate paramNum independent LSPs.
   for (uint8_t iter = 0; iter < paramNum; iter++)
     {
-      LSPsIndep.push_back (m_normalRv->GetValue ());
+      LSPsIndep.push_back (rng.GetNormal ());
     }
   for (uint8_t row = 0; row < paramNum; row++)
     {
@@ -899,7 +1225,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   double minTau = 100.0;
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
-      double tau = -1*table3gpp->m_rTau*DS*log (m_uniformRv->GetValue (0,1)); //(7.5-1)
+      double tau = -1*table3gpp->m_rTau*DS*log (rng.GetUniform (0,1)); //(7.5-1)
       if (minTau > tau)
         {
           minTau = tau;
@@ -922,7 +1248,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
       double power = exp (-1 * clusterDelay[cIndex] * (table3gpp->m_rTau - 1) / table3gpp->m_rTau / DS) *
-        pow (10,-1 * m_normalRv->GetValue () * table3gpp->m_perClusterShadowingStd / 10);                       //(7.5-5)
+        pow (10,-1 * rng.GetNormal () * table3gpp->m_perClusterShadowingStd / 10);                       //(7.5-5)
       powerSum += power;
       clusterPower.push_back (power);
     }
@@ -1099,21 +1425,21 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
     {
       int Xn = 1;
-      if (m_uniformRv->GetValue (0,1) < 0.5)
+      if (rng.GetUniform (0,1) < 0.5)
         {
           Xn = -1;
         }
-      clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (m_normalRv->GetValue () * ASA / 7) + uAngle.phi * 180 / M_PI;        //(7.5-11)
-      clusterAod[cIndex] = clusterAod[cIndex] * Xn + (m_normalRv->GetValue () * ASD / 7) + sAngle.phi * 180 / M_PI;
+      clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (rng.GetNormal () * ASA / 7) + uAngle.phi * 180 / M_PI;        //(7.5-11)
+      clusterAod[cIndex] = clusterAod[cIndex] * Xn + (rng.GetNormal () * ASD / 7) + sAngle.phi * 180 / M_PI;
       if (o2i)
         {
-          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (m_normalRv->GetValue () * ZSA / 7) + 90;            //(7.5-16)
+          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (rng.GetNormal () * ZSA / 7) + 90;            //(7.5-16)
         }
       else
         {
-          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (m_normalRv->GetValue () * ZSA / 7) + uAngle.theta * 180 / M_PI;            //(7.5-16)
+          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (rng.GetNormal () * ZSA / 7) + uAngle.theta * 180 / M_PI;            //(7.5-16)
         }
-      clusterZod[cIndex] = clusterZod[cIndex] * Xn + (m_normalRv->GetValue () * ZSD / 7) + sAngle.theta * 180 / M_PI + table3gpp->m_offsetZOD;        //(7.5-19)
+      clusterZod[cIndex] = clusterZod[cIndex] * Xn + (rng.GetNormal () * ZSD / 7) + sAngle.theta * 180 / M_PI + table3gpp->m_offsetZOD;        //(7.5-19)
 
     }
 
@@ -1136,10 +1462,10 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
         }
     }
 
-  double rayAoa_radian[numReducedCluster][raysPerCluster]; //rayAoa_radian[n][m], where n is cluster index, m is ray index
-  double rayAod_radian[numReducedCluster][raysPerCluster]; //rayAod_radian[n][m], where n is cluster index, m is ray index
-  double rayZoa_radian[numReducedCluster][raysPerCluster]; //rayZoa_radian[n][m], where n is cluster index, m is ray index
-  double rayZod_radian[numReducedCluster][raysPerCluster]; //rayZod_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayAoa_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayAoa_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayAod_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayAod_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayZoa_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayZoa_radian[n][m], where n is cluster index, m is ray index
+  Double2DVector rayZod_radian (numReducedCluster, DoubleVector (raysPerCluster)); //rayZod_radian[n][m], where n is cluster index, m is ray index
 
   for (uint8_t nInd = 0; nInd < numReducedCluster; nInd++)
     {
@@ -1275,7 +1601,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   DoubleVector attenuation_dB;
   if (m_blockage)
     {
-      attenuation_dB = CalcAttenuationOfBlockage (channelParams, clusterAoa, clusterZoa);
+      attenuation_dB = CalcAttenuationOfBlockage (channelParams, clusterAoa, clusterZoa, rng);
       for (uint8_t cInd = 0; cInd < numReducedCluster; cInd++)
         {
           clusterPower[cInd] = clusterPower[cInd] / pow (10,attenuation_dB[cInd] / 10);
@@ -1290,10 +1616,10 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   //shuffle all the arrays to perform random coupling
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
     {
-      std::shuffle (&rayAod_radian[cIndex][0],&rayAod_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 100));
-      std::shuffle (&rayAoa_radian[cIndex][0],&rayAoa_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 200));
-      std::shuffle (&rayZod_radian[cIndex][0],&rayZod_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 300));
-      std::shuffle (&rayZoa_radian[cIndex][0],&rayZoa_radian[cIndex][raysPerCluster],std::default_random_engine (cIndex * 1000 + 400));
+      std::shuffle (rayAod_radian[cIndex].begin (),rayAod_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 100));
+      std::shuffle (rayAoa_radian[cIndex].begin (),rayAoa_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 200));
+      std::shuffle (rayZod_radian[cIndex].begin (),rayZod_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 300));
+      std::shuffle (rayZoa_radian[cIndex].begin (),rayZoa_radian[cIndex].end (),std::default_random_engine (cIndex * 1000 + 400));
     }
 
   //Step 9: Generate the cross polarization power ratios
@@ -1309,11 +1635,11 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
           double uXprLinear = pow (10, table3gpp->m_uXpr / 10); // convert to linear
           double sigXprLinear = pow (10, table3gpp->m_sigXpr / 10); // convert to linear
 
-          temp.push_back (std::pow (10, (m_normalRv->GetValue () * sigXprLinear + uXprLinear) / 10));
+          temp.push_back (std::pow (10, (rng.GetNormal () * sigXprLinear + uXprLinear) / 10));
           DoubleVector temp3; // used to store the PHI valuse
           for (uint8_t pInd = 0; pInd < 4; pInd++)
             {
-              temp3.push_back (m_uniformRv->GetValue (-1 * M_PI, M_PI));
+              temp3.push_back (rng.GetUniform (-1 * M_PI, M_PI));
             }
           temp2.push_back (temp3);
         }
@@ -1322,14 +1648,6 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
     }
   channelParams->m_clusterPhase = clusterPhase;
 
-  //Step 11: Generate channel coefficients for each cluster n and each receiver
-  // and transmitter element pair u,s.
-
-  Complex3DVector H_NLOS; // channel coefficients H_NLOS [u][s][n],
-  // where u and s are receive and transmit antenna element, n is cluster index.
-  uint64_t uSize = uAntenna->GetNumberOfElements ();
-  uint64_t sSize = sAntenna->GetNumberOfElements ();
-
   uint8_t cluster1st = 0, cluster2nd = 0; // first and second strongest cluster;
   double maxPower = 0;
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
@@ -1352,166 +1670,23 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
 
   NS_LOG_INFO ("1st strongest cluster:" << (int)cluster1st << ", 2nd strongest cluster:" << (int)cluster2nd);
 
-  Complex3DVector H_usn;  //channel coffecient H_usn[u][s][n];
-  // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
-  // the total cluster will be numReducedCLuster + 4.
-
-  H_usn.resize (uSize);
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
-    {
-      H_usn[uIndex].resize (sSize);
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
-        {
-          H_usn[uIndex][sIndex].resize (numReducedCluster);
-        }
-    }
-
-  // The following for loops computes the channel coefficients
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
-    {
-      Vector uLoc = uAntenna->GetElementLocation (uIndex);
-
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
-        {
-
-          Vector sLoc = sAntenna->GetElementLocation (sIndex);
-
-          for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
-            {
-              //Compute the N-2 weakest cluster, only vertical polarization. (7.5-22)
-              if (nIndex != cluster1st && nIndex != cluster2nd)
-                {
-                  std::complex<double> rays (0,0);
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
-                    {
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
-                      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-                      // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      rays += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                               +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                        * exp (std::complex<double> (0, rxPhaseDiff))
-                        * exp (std::complex<double> (0, txPhaseDiff));
-                    }
-                  rays *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = rays;
-                }
-              else  //(7.5-28)
-                {
-                  std::complex<double> raysSub1 (0,0);
-                  std::complex<double> raysSub2 (0,0);
-                  std::complex<double> raysSub3 (0,0);
-
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
-                    {
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
-
-                      //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
-
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      switch (mIndex)
-                        {
-                        case 9:
-                        case 10:
-                        case 11:
-                        case 12:
-                        case 17:
-                        case 18:
-                          raysSub2 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        case 13:
-                        case 14:
-                        case 15:
-                        case 16:
-                          raysSub3 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        default:                        //case 1,2,3,4,5,6,7,8,19,20
-                          raysSub1 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                       +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                       +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                            * exp (std::complex<double> (0, rxPhaseDiff))
-                            * exp (std::complex<double> (0, txPhaseDiff));
-                          break;
-                        }
-                    }
-                  raysSub1 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub2 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub3 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = raysSub1;
-                  H_usn[uIndex][sIndex].push_back (raysSub2);
-                  H_usn[uIndex][sIndex].push_back (raysSub3);
-
-                }
-            }
-          if (los) //(7.5-29) && (7.5-30)
-            {
-              std::complex<double> ray (0,0);
-              double rxPhaseDiff = 2 * M_PI * (sin (uAngle.theta) * cos (uAngle.phi) * uLoc.x
-                                               + sin (uAngle.theta) * sin (uAngle.phi) * uLoc.y
-                                               + cos (uAngle.theta) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (sAngle.theta) * cos (sAngle.phi) * sLoc.x
-                                               + sin (sAngle.theta) * sin (sAngle.phi) * sLoc.y
-                                               + cos (sAngle.theta) * sLoc.z);
-
-              double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-              std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.phi, uAngle.theta));
-              std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.phi, sAngle.theta));
-
-              double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
-
-              ray = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
-                  * exp (std::complex<double> (0, - 2 * M_PI * dis3D / lambda))
-                  * exp (std::complex<double> (0, rxPhaseDiff))
-                  * exp (std::complex<double> (0, txPhaseDiff));
-
-              double K_linear = pow (10,K_factor / 10);
-              // the LOS path should be attenuated if blockage is enabled.
-              H_usn[uIndex][sIndex][0] = sqrt (1 / (K_linear + 1)) * H_usn[uIndex][sIndex][0] + sqrt (K_linear / (1 + K_linear)) * ray / pow (10,attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
-              double tempSize = H_usn[uIndex][sIndex].size ();
-              for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
-                {
-                  H_usn[uIndex][sIndex][nIndex] *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
-                }
-
-            }
-        }
-    }
+  // store the parameters needed to compute the channel coefficients
+  rays.m_los = los;
+  rays.m_K = K_factor;
+  rays.m_dis3D = dis3D;
+  rays.m_losAttenuation = attenuation_dB[0];
+  rays.m_uAngle = uAngle;
+  rays.m_sAngle = sAngle;
+  rays.m_raysPerCluster = raysPerCluster;
+  rays.m_cluster1st = cluster1st;
+  rays.m_cluster2nd = cluster2nd;
+  rays.m_clusterPower = clusterPower;
+  rays.m_rayAoa = std::move (rayAoa_radian);
+  rays.m_rayZoa = std::move (rayZoa_radian);
+  rays.m_rayAod = std::move (rayAod_radian);
+  rays.m_rayZod = std::move (rayZod_radian);
+  rays.m_crossPolarizationPowerRatios = std::move (crossPolarizationPowerRatios);
+  rays.m_clusterPhase = std::move (clusterPhase);
 
   // store the delays and the angles for the subclusters
   if (cluster1st == cluster2nd)
@@ -1572,9 +1747,6 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
 
     }
 
-  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.size () << "][" << H_usn[0].size () << "][" << H_usn[0][0].size () << "]");
-
-  channelParams->m_channel = H_usn;
   channelParams->m_delay = clusterDelay;
 
   channelParams->m_angle.clear ();
@@ -1586,10 +1758,230 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, bool los, bool o2i,
   return channelParams;
 }
 
+Complex3DArray
+ThreeGppChannelModel::ComputeChannelCoefficients (const RayParams &rays,
+                                                  const PhasedArrayModel &sAntenna,
+                                                  const PhasedArrayModel &uAntenna) const
+{
+  NS_LOG_FUNCTION (this);
+
+  //Step 11: Generate channel coefficients for each cluster n and each receiver
+  // and transmitter element pair u,s.
+  uint64_t uSize = uAntenna.GetNumberOfElements ();
+  uint64_t sSize = sAntenna.GetNumberOfElements ();
+
+  bool los = rays.m_los;
+  double K_factor = rays.m_K;
+  double dis3D = rays.m_dis3D;
+  const Angles &uAngle = rays.m_uAngle;
+  const Angles &sAngle = rays.m_sAngle;
+  uint8_t numReducedCluster = rays.m_clusterPower.size ();
+  uint8_t raysPerCluster = rays.m_raysPerCluster;
+  uint8_t cluster1st = rays.m_cluster1st;
+  uint8_t cluster2nd = rays.m_cluster2nd;
+  const DoubleVector &clusterPower = rays.m_clusterPower;
+  const Double2DVector &rayAoa_radian = rays.m_rayAoa;
+  const Double2DVector &rayZoa_radian = rays.m_rayZoa;
+  const Double2DVector &rayAod_radian = rays.m_rayAod;
+  const Double2DVector &rayZod_radian = rays.m_rayZod;
+  const Double2DVector &crossPolarizationPowerRatios = rays.m_crossPolarizationPowerRatios;
+  const Double3DVector &clusterPhase = rays.m_clusterPhase;
+
+  // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
+  // the total cluster will be numReducedCLuster + 4 (or numReducedCluster + 2
+  // if there is a single cluster). The sub-clusters are stored after the
+  // numReducedCluster clusters, starting from those of the strongest cluster
+  // with the lowest index.
+  uint8_t numSubClusters = (cluster1st == cluster2nd) ? 2 : 4;
+  uint8_t numTotClusters = numReducedCluster + numSubClusters;
+  uint8_t minStrongCluster = std::min (cluster1st, cluster2nd);
+
+  // channel coefficients H_usn[u][s][n], where u and s are receive and
+  // transmit antenna element, n is cluster index.
+  Complex3DArray H_usn (uSize, sSize, numTotClusters);
+
+  // The contribution of a ray to H_usn is the product of a term that only
+  // depends on the ray, i.e., the field patterns and the polarization, and
+  // of a rx and a tx phasor, which depend on the location of the elements u
+  // and s. Hence, these terms are computed once per ray and per ray and
+  // element, respectively, and each cluster is the sum of the rank-1
+  // matrices of its rays. Each ray contributes to a single cluster: the N-2
+  // weakest clusters (7.5-22), or one of the three sub-clusters of the two
+  // strongest clusters (7.5-28).
+  std::vector<Vector> uLoc (uSize);
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      uLoc[uIndex] = uAntenna.GetElementLocation (uIndex);
+    }
+  std::vector<Vector> sLoc (sSize);
+  for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+      sLoc[sIndex] = sAntenna.GetElementLocation (sIndex);
+    }
+
+  uint64_t numRays = numReducedCluster * raysPerCluster;
+  PhasedArrayModel::ComplexVector rayTerm (numRays); // the term depending on the ray only
+  PhasedArrayModel::ComplexVector rxPhasor (numRays * uSize); // rxPhasor[r * uSize + u], the rx phasor of ray r and element u
+  PhasedArrayModel::ComplexVector txPhasor (numRays * sSize); // txPhasor[r * sSize + s], the tx phasor of ray r and element s
+  std::vector<std::vector<uint64_t> > clusterRays (numTotClusters); // the rays contributing to each cluster, in increasing order
+  DoubleVector clusterScale (numTotClusters); // the normalization factor of each cluster
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      uint8_t subClusterIndex = (nIndex == minStrongCluster) ? numReducedCluster : numReducedCluster + 2;
+      double scale = sqrt (clusterPower[nIndex] / raysPerCluster);
+      clusterScale[nIndex] = scale;
+      if (nIndex == cluster1st || nIndex == cluster2nd)
+        {
+          clusterScale[subClusterIndex] = scale;
+          clusterScale[subClusterIndex + 1] = scale;
+        }
+
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          uint64_t rIndex = nIndex * raysPerCluster + mIndex;
+          const DoubleVector &initialPhase = clusterPhase[nIndex][mIndex];
+          double k = crossPolarizationPowerRatios[nIndex][mIndex];
+
+          double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+          std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna.GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
+          std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna.GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
+
+          rayTerm[rIndex] = exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+            +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi;
+
+          //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+          // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
+          double sinZoaCosAoa = sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]);
+          double sinZoaSinAoa = sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]);
+          double cosZoa = cos (rayZoa_radian[nIndex][mIndex]);
+          for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+            {
+              double rxPhaseDiff = 2 * M_PI * (sinZoaCosAoa * uLoc[uIndex].x
+                                               + sinZoaSinAoa * uLoc[uIndex].y
+                                               + cosZoa * uLoc[uIndex].z);
+              rxPhasor[rIndex * uSize + uIndex] = exp (std::complex<double> (0, rxPhaseDiff));
+            }
+
+          double sinZodCosAod = sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]);
+          double sinZodSinAod = sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]);
+          double cosZod = cos (rayZod_radian[nIndex][mIndex]);
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+              double txPhaseDiff = 2 * M_PI * (sinZodCosAod * sLoc[sIndex].x
+                                               + sinZodSinAod * sLoc[sIndex].y
+                                               + cosZod * sLoc[sIndex].z);
+              txPhasor[rIndex * sSize + sIndex] = exp (std::complex<double> (0, txPhaseDiff));
+            }
+
+          if (nIndex != cluster1st && nIndex != cluster2nd)
+            {
+              clusterRays[nIndex].push_back (rIndex);
+            }
+          else
+            {
+              //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
+              switch (mIndex)
+                {
+                case 9:
+                case 10:
+                case 11:
+                case 12:
+                case 17:
+                case 18:
+                  clusterRays[subClusterIndex].push_back (rIndex);
+                  break;
+                case 13:
+                case 14:
+                case 15:
+                case 16:
+                  clusterRays[subClusterIndex + 1].push_back (rIndex);
+                  break;
+                default:                        //case 1,2,3,4,5,6,7,8,19,20
+                  clusterRays[nIndex].push_back (rIndex);
+                  break;
+                }
+            }
+        }
+    }
+
+  // The following for loops computes the channel coefficients, accumulating
+  // the contribution of each ray on a row of H_usn
+  PhasedArrayModel::ComplexVector row (sSize);
+  for (uint8_t cIndex = 0; cIndex < numTotClusters; cIndex++)
+    {
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          std::fill (row.begin (), row.end (), std::complex<double> (0, 0));
+          for (uint64_t rIndex : clusterRays[cIndex])
+            {
+              std::complex<double> rxTerm = rayTerm[rIndex] * rxPhasor[rIndex * uSize + uIndex];
+              const std::complex<double> *tx = &txPhasor[rIndex * sSize];
+              for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+                {
+                  row[sIndex] += rxTerm * tx[sIndex];
+                }
+            }
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+              H_usn (uIndex, sIndex, cIndex) = row[sIndex] * clusterScale[cIndex];
+            }
+        }
+    }
+
+  if (los) //(7.5-29) && (7.5-30)
+    {
+      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna.GetElementFieldPattern (Angles (uAngle.phi, uAngle.theta));
+      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna.GetElementFieldPattern (Angles (sAngle.phi, sAngle.theta));
+
+      double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
+
+      std::complex<double> losTerm = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
+        * exp (std::complex<double> (0, - 2 * M_PI * dis3D / lambda));
+
+      PhasedArrayModel::ComplexVector losTxPhasor (sSize);
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          double txPhaseDiff = 2 * M_PI * (sin (sAngle.theta) * cos (sAngle.phi) * sLoc[sIndex].x
+                                           + sin (sAngle.theta) * sin (sAngle.phi) * sLoc[sIndex].y
+                                           + cos (sAngle.theta) * sLoc[sIndex].z);
+          losTxPhasor[sIndex] = exp (std::complex<double> (0, txPhaseDiff));
+        }
+
+      double K_linear = pow (10,K_factor / 10);
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          double rxPhaseDiff = 2 * M_PI * (sin (uAngle.theta) * cos (uAngle.phi) * uLoc[uIndex].x
+                                           + sin (uAngle.theta) * sin (uAngle.phi) * uLoc[uIndex].y
+                                           + cos (uAngle.theta) * uLoc[uIndex].z);
+          std::complex<double> rxTerm = losTerm * exp (std::complex<double> (0, rxPhaseDiff));
+
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+              std::complex<double> ray = rxTerm * losTxPhasor[sIndex];
+
+              // the LOS path should be attenuated if blockage is enabled.
+              H_usn (uIndex, sIndex, 0) = sqrt (1 / (K_linear + 1)) * H_usn (uIndex, sIndex, 0) + sqrt (K_linear / (1 + K_linear)) * ray / pow (10,rays.m_losAttenuation / 10);           //(7.5-30) for tau = tau1
+              for (uint8_t nIndex = 1; nIndex < numTotClusters; nIndex++)
+                {
+                  H_usn (uIndex, sIndex, nIndex) *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
+                }
+            }
+        }
+    }
+
+  NS_LOG_INFO ("size of coefficient matrix =[" << H_usn.GetNumRxElements () << "][" << H_usn.GetNumTxElements () << "][" << H_usn.GetNumClusters () << "]");
+
+  return H_usn;
+}
+
 MatrixBasedChannelModel::DoubleVector
 ThreeGppChannelModel::CalcAttenuationOfBlockage (Ptr<ThreeGppChannelModel::ThreeGppChannelMatrix> params,
                                                  const DoubleVector &clusterAOA,
-                                                 const DoubleVector &clusterZOA) const
+                                                 const DoubleVector &clusterZOA,
+                                                 RandomSource &rng) const
 {
   NS_LOG_FUNCTION (this);
 
@@ -1627,17 +2019,17 @@ ThreeGppChannelModel::CalcAttenuationOfBlockage (Ptr<ThreeGppChannelModel::Three
         {
           //draw value from table 7.6.4.1-2 Blocking region parameters
           DoubleVector table;
-          table.push_back (m_normalRv->GetValue ()); //phi_k: store the normal RV that will be mapped to uniform (0,360) later.
+          table.push_back (rng.GetNormal ()); //phi_k: store the normal RV that will be mapped to uniform (0,360) later.
           if (m_scenario == "InH-OfficeMixed" || m_scenario == "InH-OfficeOpen")
             {
-              table.push_back (m_uniformRv->GetValue (15, 45)); //x_k
+              table.push_back (rng.GetUniform (15, 45)); //x_k
               table.push_back (90);  //Theta_k
-              table.push_back (m_uniformRv->GetValue (5, 15)); //y_k
+              table.push_back (rng.GetUniform (5, 15)); //y_k
               table.push_back (2);  //r
             }
           else
             {
-              table.push_back (m_uniformRv->GetValue (5, 15)); //x_k
+              table.push_back (rng.GetUniform (5, 15)); //x_k
               table.push_back (90);  //Theta_k
               table.push_back (5);  //y_k
               table.push_back (10);  //r
@@ -1700,7 +2092,7 @@ ThreeGppChannelModel::CalcAttenuationOfBlockage (Ptr<ThreeGppChannelModel::Three
 
               //Generate a new correlated normal RV with the following formula
               params->m_nonSelfBlocking[blockInd][PHI_INDEX] =
-                R * params->m_nonSelfBlocking[blockInd][PHI_INDEX] + sqrt (1 - R * R) * m_normalRv->GetValue ();
+                R * params->m_nonSelfBlocking[blockInd][PHI_INDEX] + sqrt (1 - R * R) * rng.GetNormal ();
             }
         }
 
@@ -1812,7 +2204,72 @@ ThreeGppChannelModel::AssignStreams (int64_t stream)
   NS_LOG_FUNCTION (this << stream);
   m_normalRv->SetStream (stream);
   m_uniformRv->SetStream (stream + 1);
+  m_rngKeyDrawn = false;
   return 2;
 }
 
+PhiloxRng
+ThreeGppChannelModel::GetLinkRng (uint32_t x1, uint32_t x2, bool los) const
+{
+  // the key is drawn from the stream of this model, hence it depends on the
+  // run and on the stream number
+  if (!m_rngKeyDrawn)
+    {
+      m_rngKey = (static_cast<uint64_t> (m_uniformRv->GetInteger (0, UINT32_MAX)) << 32) | m_uniformRv->GetInteger (0, UINT32_MAX);
+      m_rngKeyDrawn = true;
+    }
+
+  // a new realization in the same epoch has the same parameters, unless the
+  // LOS condition changed
+  uint32_t epoch = m_updatePeriod.IsZero () ? 0 : Simulator::Now ().GetTimeStep () / m_updatePeriod.GetTimeStep ();
+  return PhiloxRng (m_rngKey, (static_cast<uint64_t> (x1) << 32) | x2, (epoch << 1) | los);
+}
+
+ThreeGppChannelModel::RandomSource::RandomSource (Ptr<UniformRandomVariable> uniformRv, Ptr<NormalRandomVariable> normalRv)
+  : m_uniformRv (uniformRv),
+    m_normalRv (normalRv),
+    m_counterBased (false),
+    m_hasNextNormal (false),
+    m_nextNormal (0)
+{
+}
+
+ThreeGppChannelModel::RandomSource::RandomSource (const PhiloxRng &rng)
+  : m_rng (rng),
+    m_counterBased (true),
+    m_hasNextNormal (false),
+    m_nextNormal (0)
+{
+}
+
+double
+ThreeGppChannelModel::RandomSource::GetUniform (double min, double max)
+{
+  if (!m_counterBased)
+    {
+      return m_uniformRv->GetValue (min, max);
+    }
+  return min + m_rng.RandU01 () * (max - min);
+}
+
+double
+ThreeGppChannelModel::RandomSource::GetNormal (void)
+{
+  if (!m_counterBased)
+    {
+      return m_normalRv->GetValue ();
+    }
+  if (m_hasNextNormal)
+    {
+      m_hasNextNormal = false;
+      return m_nextNormal;
+    }
+  // Box-Muller transform, the second value is returned by the next call
+  double r = std::sqrt (-2 * std::log (m_rng.RandU01 ()));
+  double phi = 2 * M_PI * m_rng.RandU01 ();
+  m_nextNormal = r * std::sin (phi);
+  m_hasNextNormal = true;
+  return r * std::cos (phi);
+}
+
 }  // namespace ns3
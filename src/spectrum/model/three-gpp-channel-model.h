@@ -27,6 +27,7 @@
 #include <ns3/object.h>
 #include <ns3/nstime.h>
 #include <ns3/random-variable-stream.h>
+#include <ns3/philox-rng.h>
 #include <ns3/boolean.h>
 #include <unordered_map>
 #include <ns3/channel-condition-model.h>
@@ -119,6 +120,24 @@ public:
                                        Ptr<const MobilityModel> bMob,
                                        Ptr<const PhasedArrayModel> aAntenna,
                                        Ptr<const PhasedArrayModel> bAntenna) override;
+
+  /**
+   * Returns the channel matrices of a set of links, as GetChannel would do
+   * for each of them.
+   *
+   * The random parameters of the realizations which have to be generated are
+   * drawn sequentially, in the order of the channel keys, and then their
+   * channel coefficients are computed in parallel by NumWorkerThreads
+   * threads. Hence, the result does not depend on the order of the links or
+   * on the number of threads. Unless CounterBasedRng is enabled, it is
+   * different from that of a sequence of GetChannel calls, which draw the
+   * random parameters in the order in which the links are evaluated.
+   *
+   * \param links the links
+   * \return the channel matrices, in the same order as the links
+   */
+  std::vector<Ptr<const ChannelMatrix> > GetChannels (const std::vector<Link> &links) override;
+
   /**
    * \brief Assign a fixed random variable stream number to the random variables
    * used by this model.
@@ -152,8 +171,104 @@ private:
     Vector m_speed; //!< velocity
     double m_dis2D; //!< 2D distance between tx and rx
     double m_dis3D; //!< 3D distance between tx and rx
+    Ptr<const PhasedArrayModel> m_sAntenna; //!< the s-node antenna used to compute the channel coefficients
+    Ptr<const PhasedArrayModel> m_uAntenna; //!< the u-node antenna used to compute the channel coefficients
+  };
+
+  /**
+   * Data structure that stores the parameters of the clusters and of the rays
+   * of a channel realization, which are needed to compute its channel
+   * coefficients
+   */
+  struct RayParams
+  {
+    bool m_los = false; //!< true if LOS, false if NLOS
+    double m_K = 0; //!< K factor in dB
+    double m_dis3D = 0; //!< 3D distance between tx and rx
+    double m_losAttenuation = 0; //!< the blockage attenuation of the LOS path in dB
+    Angles m_uAngle; //!< the u node angle
+    Angles m_sAngle; //!< the s node angle
+    uint8_t m_raysPerCluster = 0; //!< the number of rays per cluster
+    uint8_t m_cluster1st = 0; //!< the strongest cluster
+    uint8_t m_cluster2nd = 0; //!< the second strongest cluster
+    DoubleVector m_clusterPower; //!< the power of the clusters, whose number is the reduced cluster number
+    Double2DVector m_rayAoa; //!< the azimuth angles of arrival of the rays rayAoa[n][m] in radians, where n is cluster index, m is ray index
+    Double2DVector m_rayZoa; //!< the zenith angles of arrival of the rays in radians
+    Double2DVector m_rayAod; //!< the azimuth angles of departure of the rays in radians
+    Double2DVector m_rayZod; //!< the zenith angles of departure of the rays in radians
+    Double2DVector m_crossPolarizationPowerRatios; //!< the cross polarization power ratios (7.5-21)
+    Double3DVector m_clusterPhase; //!< the initial random phases
+  };
+
+  /**
+   * The source of the random variables used to generate a channel
+   * realization, which is either the pair of random variable streams of the
+   * model, or a counter-based generator specific to the link and to the
+   * update epoch
+   */
+  class RandomSource
+  {
+  public:
+    /**
+     * Constructor for a source which uses the random variable streams of
+     * the model
+     * \param uniformRv the uniform random variable
+     * \param normalRv the standard normal random variable
+     */
+    RandomSource (Ptr<UniformRandomVariable> uniformRv, Ptr<NormalRandomVariable> normalRv);
+
+    /**
+     * Constructor for a source which uses a counter-based generator
+     * \param rng the counter-based generator
+     */
+    RandomSource (const PhiloxRng &rng);
+
+    /**
+     * \param min the minimum value
+     * \param max the maximum value
+     * \return a value uniformly distributed between min and max
+     */
+    double GetUniform (double min, double max);
+
+    /**
+     * \return a value with standard normal distribution
+     */
+    double GetNormal (void);
+
+  private:
+    Ptr<UniformRandomVariable> m_uniformRv; //!< the uniform random variable, if not counter-based
+    Ptr<NormalRandomVariable> m_normalRv; //!< the normal random variable, if not counter-based
+    PhiloxRng m_rng; //!< the counter-based generator
+    bool m_counterBased; //!< true if the counter-based generator is used
+    bool m_hasNextNormal; //!< true if m_nextNormal has not been returned yet
+    double m_nextNormal; //!< the second value generated by the Box-Muller transform
+  };
+
+  /**
+   * Returns the counter-based generator of the random variables used to
+   * generate a channel realization at the current time. The generator
+   * depends on the run, on the stream of this model, on the link, on the
+   * update epoch and on the LOS condition, but not on the other links.
+   * \param x1 the lowest node ID of the link
+   * \param x2 the highest node ID of the link
+   * \param los the LOS condition
+   * \return the counter-based generator
+   */
+  PhiloxRng GetLinkRng (uint32_t x1, uint32_t x2, bool los) const;
+
+  /**
+   * A channel realization whose channel coefficients have to be computed
+   */
+  struct PendingChannel
+  {
+    Ptr<ThreeGppChannelMatrix> m_channelMatrix; //!< the channel realization
+    RayParams m_rays; //!< the parameters of the clusters and rays
+    Ptr<const PhasedArrayModel> m_sAntenna; //!< the s node antenna array
+    Ptr<const PhasedArrayModel> m_uAntenna; //!< the u node antenna array
   };
 
+  class ChannelCoefficientsJob;
+
   /**
    * Data structure that stores the parameters of 3GPP TR 38.901, Table 7.5-6,
    * for a certain scenario
@@ -199,36 +314,69 @@ private:
   Ptr<const ParamsTable> GetThreeGppTable (bool los, bool o2i, double hBS, double hUT, double distance2D) const;
 
   /**
-   * Compute the channel matrix between two devices using the procedure
-   * described in 3GPP TR 38.901
+   * Generate a new channel realization between two devices using the
+   * procedure described in 3GPP TR 38.901, up to Step 10. The channel
+   * coefficients (Step 11) are computed by ComputeChannelCoefficients.
    * \param locUT the location of the UT
    * \param los the LOS/NLOS condition
    * \param o2i whether if it is an outdoor to indoor transmission
-   * \param sAntenna the s node antenna array
-   * \param uAntenna the u node antenna array
    * \param uAngle the u node angle
    * \param sAngle the s node angle
    * \param dis2D the 2D distance between tx and rx
    * \param hBS the height of the BS
    * \param hUT the height of the UT
-   * \return the channel realization
+   * \param rays used to return the parameters needed to compute the channel
+   *        coefficients
+   * \param rng the source of the random variables
+   * \return the channel realization, without the channel coefficients
    */
   Ptr<ThreeGppChannelMatrix> GetNewChannel (Vector locUT, bool los, bool o2i,
-                                            Ptr<const PhasedArrayModel> sAntenna,
-                                            Ptr<const PhasedArrayModel> uAntenna,
                                             Angles &uAngle, Angles &sAngle,
-                                            double dis2D, double hBS, double hUT) const;
+                                            double dis2D, double hBS, double hUT,
+                                            RayParams &rays, RandomSource &rng) const;
+
+  /**
+   * Compute the channel coefficients of a channel realization (Step 11 of
+   * the procedure described in 3GPP TR 38.901). This method does not draw
+   * any random variable, hence it can be called by multiple threads.
+   * \param rays the parameters of the clusters and rays
+   * \param sAntenna the s node antenna array
+   * \param uAntenna the u node antenna array
+   * \return the channel coefficients H[u][s][n]
+   */
+  Complex3DArray ComputeChannelCoefficients (const RayParams &rays,
+                                             const PhasedArrayModel &sAntenna,
+                                             const PhasedArrayModel &uAntenna) const;
+
+  /**
+   * Looks for the channel matrix associated to the aMob and bMob pair in
+   * m_channelMap. If not found or if it has to be updated, it generates a new
+   * channel realization using the method GetNewChannel and updates
+   * m_channelMap. The channel coefficients of the new realization have to be
+   * computed using ComputeChannelCoefficients.
+   * \param aMob mobility model of the a device
+   * \param bMob mobility model of the b device
+   * \param channelMatrix used to return the channel matrix
+   * \param rays used to return the parameters of the new realization
+   * \return true if a new realization was generated, false otherwise
+   */
+  bool LookupChannel (Ptr<const MobilityModel> aMob,
+                      Ptr<const MobilityModel> bMob,
+                      Ptr<ThreeGppChannelMatrix> &channelMatrix,
+                      RayParams &rays);
 
   /**
    * Applies the blockage model A described in 3GPP TR 38.901
    * \param params the channel matrix
    * \param clusterAOA vector containing the azimuth angle of arrival for each cluster
    * \param clusterZOA vector containing the zenith angle of arrival for each cluster
+   * \param rng the source of the random variables
    * \return vector containing the power attenuation for each cluster
    */
   DoubleVector CalcAttenuationOfBlockage (Ptr<ThreeGppChannelMatrix> params,
                                           const DoubleVector &clusterAOA,
-                                          const DoubleVector &clusterZOA) const;
+                                          const DoubleVector &clusterZOA,
+                                          RandomSource &rng) const;
 
   /**
    * Check if the channel matrix has to be updated
@@ -238,13 +386,66 @@ private:
    */
   bool ChannelMatrixNeedsUpdate (Ptr<const ThreeGppChannelMatrix> channelMatrix, bool isLos) const;
 
-  std::unordered_map<uint32_t, Ptr<ThreeGppChannelMatrix> > m_channelMap; //!< map containing the channel realizations
+  /**
+   * Set the memory budget of m_channelMap, evicting the least recently used
+   * channel realizations if needed
+   * \param maxSize the maximum size in bytes, 0 for an unbounded cache
+   */
+  void SetChannelCacheMaxSize (uint64_t maxSize);
+
+  /**
+   * Get the memory budget of m_channelMap
+   * \return the maximum size in bytes, 0 for an unbounded cache
+   */
+  uint64_t GetChannelCacheMaxSize (void) const;
+
+  /**
+   * Update the size of the entry of a channel realization in m_channelMap,
+   * once its channel coefficients have been computed, evicting the least
+   * recently used realizations if the memory budget is exceeded
+   * \param channelMatrix the channel realization
+   */
+  void UpdateChannelCacheEntry (Ptr<const ThreeGppChannelMatrix> channelMatrix);
+
+  /**
+   * Check if the channel coefficients of a realization hold for the antennas
+   * of a link, i.e., if the antennas have the same elements, at the same
+   * locations, as the ones used to compute them. This is not the case if
+   * the realization is shared with a link, e.g., of another component
+   * carrier, whose antennas have a different geometry
+   * \param channelMatrix the channel realization
+   * \param aId the ID of the node a of the link
+   * \param aAntenna the antenna of the node a
+   * \param bAntenna the antenna of the node b
+   * \return true if the channel coefficients hold for the antennas
+   */
+  static bool IsAntennaGeometryMatching (Ptr<const ThreeGppChannelMatrix> channelMatrix,
+                                         uint32_t aId,
+                                         Ptr<const PhasedArrayModel> aAntenna,
+                                         Ptr<const PhasedArrayModel> bAntenna);
+
+  /**
+   * Estimate the memory used by a channel realization
+   * \param channelMatrix the channel realization
+   * \return the size in bytes
+   */
+  static uint64_t GetChannelMatrixSize (const ThreeGppChannelMatrix &channelMatrix);
+
+  LruCache<uint64_t, Ptr<ThreeGppChannelMatrix> > m_channelMap; //!< cache containing the channel realizations
+  TracedValue<uint64_t> m_channelCacheHits; //!< number of times a valid channel realization was found in m_channelMap
+  TracedValue<uint64_t> m_channelCacheMisses; //!< number of times a channel realization had to be generated
+  TracedValue<uint64_t> m_channelCacheEvictions; //!< number of channel realizations evicted from m_channelMap
+  TracedValue<uint64_t> m_channelCacheSize; //!< estimated size of m_channelMap in bytes
   Time m_updatePeriod; //!< the channel update period
   double m_frequency; //!< the operating frequency
   std::string m_scenario; //!< the 3GPP scenario
   Ptr<ChannelConditionModel> m_channelConditionModel; //!< the channel condition model
   Ptr<UniformRandomVariable> m_uniformRv; //!< uniform random variable
   Ptr<NormalRandomVariable> m_normalRv; //!< normal random variable
+  uint32_t m_numWorkerThreads; //!< the number of threads computing the channel coefficients in GetChannels
+  bool m_counterBasedRng; //!< if true, the random variables of each link are drawn from a counter-based generator
+  mutable uint64_t m_rngKey; //!< the key of the counter-based generators, drawn from m_uniformRv
+  mutable bool m_rngKeyDrawn; //!< true if m_rngKey was drawn
 
   // parameters for the blockage model
   bool m_blockage; //!< enables the blockage model A
@@ -28,8 +28,12 @@
 #include "ns3/channel-condition-model.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/trace-source-accessor.h"
+#include "complex-vector-kernels.h"
+#include <algorithm>
 #include <map>
 
 namespace ns3 {
@@ -39,6 +43,12 @@ NS_LOG_COMPONENT_DEFINE ("ThreeGppSpectrumPropagationLossModel");
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppSpectrumPropagationLossModel);
 
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel ()
+  : m_longTermCacheHits (0),
+    m_longTermCacheMisses (0),
+    m_longTermCacheEvictions (0),
+    m_longTermCacheSize (0),
+    m_frequency (-1.0),
+    m_carrierFrequency (0.0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -52,7 +62,7 @@ void
 ThreeGppSpectrumPropagationLossModel::DoDispose ()
 {
   m_deviceAntennaMap.clear ();
-  m_longTermMap.clear ();
+  m_longTermMap.Clear ();
   m_channelModel->Dispose ();
   m_channelModel = nullptr;
 }
@@ -70,6 +80,38 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId (void)
                   MakePointerAccessor (&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                        &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
       MakePointerChecker<MatrixBasedChannelModel> ())
+    .AddAttribute ("Frequency",
+                   "The operating frequency in Hz, used to compute the Doppler term. "
+                   "If 0, the frequency of the channel model is used. A different value "
+                   "allows instances operating at different frequencies to share the "
+                   "realizations of the same channel model",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&ThreeGppSpectrumPropagationLossModel::m_carrierFrequency),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("LongTermCacheMaxSize",
+                   "The memory budget in bytes of the cache of the long term components. "
+                   "When the estimated size of the cache exceeds it, the least recently "
+                   "used components are evicted. 0 means unbounded",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxSize,
+                                         &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxSize),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddTraceSource ("LongTermCacheHits",
+                     "The number of times a valid long term component was found in the cache",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("LongTermCacheMisses",
+                     "The number of times the long term component had to be computed",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("LongTermCacheEvictions",
+                     "The number of long term components evicted from the cache",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheEvictions),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("LongTermCacheSize",
+                     "The estimated size in bytes of the cache of the long term components",
+                     MakeTraceSourceAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheSize),
+                     "ns3::TracedValueCallback::Uint64")
     ;
   return tid;
 }
@@ -78,6 +120,7 @@ void
 ThreeGppSpectrumPropagationLossModel::SetChannelModel (Ptr<MatrixBasedChannelModel> channel)
 {
   m_channelModel = channel;
+  m_frequency = -1.0;
 }
 
 Ptr<MatrixBasedChannelModel>
@@ -86,6 +129,20 @@ ThreeGppSpectrumPropagationLossModel::GetChannelModel () const
   return m_channelModel;
 }
 
+void
+ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxSize (uint64_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_longTermCacheEvictions += m_longTermMap.SetMaxSize (maxSize);
+  m_longTermCacheSize = m_longTermMap.GetSize ();
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxSize (void) const
+{
+  return m_longTermMap.GetMaxSize ();
+}
+
 void
 ThreeGppSpectrumPropagationLossModel::AddDevice (Ptr<NetDevice> n, Ptr<const PhasedArrayModel> a)
 {
@@ -96,15 +153,24 @@ ThreeGppSpectrumPropagationLossModel::AddDevice (Ptr<NetDevice> n, Ptr<const Pha
 double
 ThreeGppSpectrumPropagationLossModel::GetFrequency () const
 {
-  DoubleValue freq;
-  m_channelModel->GetAttribute ("Frequency", freq);
-  return freq.Get ();
+  if (m_carrierFrequency > 0)
+    {
+      return m_carrierFrequency;
+    }
+  if (m_frequency < 0)
+    {
+      DoubleValue freq;
+      m_channelModel->GetAttribute ("Frequency", freq);
+      m_frequency = freq.Get ();
+    }
+  return m_frequency;
 }
 
 void
 ThreeGppSpectrumPropagationLossModel::SetChannelModelAttribute (const std::string &name, const AttributeValue &value)
 {
   m_channelModel->SetAttribute (name, value);
+  m_frequency = -1.0;
 }
 
 void
@@ -126,43 +192,53 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm (Ptr<const MatrixBasedChannel
   NS_LOG_DEBUG ("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
   //store the long term part to reduce computation load
   //only the small scale fading needs to be updated if the large scale parameters and antenna weights remain unchanged.
-  PhasedArrayModel::ComplexVector longTerm;
-  uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
-
-  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+  const Complex3DArray &channel = params->m_channel;
+  uint8_t numCluster = static_cast<uint8_t> (channel.GetNumClusters ());
+  NS_ASSERT (channel.GetNumRxElements () == uAntenna && channel.GetNumTxElements () == sAntenna);
+  PhasedArrayModel::ComplexVector longTerm (numCluster);
+
+  // weight of each antenna pair, in the same order used to store the
+  // channel coefficients
+  PhasedArrayModel::ComplexVector weights (uAntenna * sAntenna);
+  for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
     {
-      std::complex<double> txSum (0,0);
       for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
         {
-          std::complex<double> rxSum (0,0);
-          for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
-            {
-              rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
-            }
-          txSum = txSum + sW[sIndex] * rxSum;
+          weights[uIndex * sAntenna + sIndex] = uW[uIndex] * sW[sIndex];
+        }
+    }
+
+  if (channel.GetLayout () == Complex3DArray::ANTENNA_MAJOR)
+    {
+      // each antenna pair is a row of clusters
+      ComplexVectorKernels::WeightedSum (weights.size (), numCluster, weights.data (), channel.GetData (), longTerm.data ());
+    }
+  else
+    {
+      // each cluster is a contiguous block of antenna pairs
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          longTerm[cIndex] = ComplexVectorKernels::Dot (weights.size (), weights.data (),
+                                                        channel.GetData () + cIndex * channel.GetClusterStride ());
         }
-      longTerm.push_back (txSum);
     }
   return longTerm;
 }
 
-Ptr<SpectrumValue>
-ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                                           PhasedArrayModel::ComplexVector longTerm,
-                                                           Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
-                                                           const ns3::Vector &sSpeed, const ns3::Vector &uSpeed) const
+PhasedArrayModel::ComplexVector
+ThreeGppSpectrumPropagationLossModel::CalcDopplerTerm (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                       const ns3::Vector &sSpeed, const ns3::Vector &uSpeed) const
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue> (txPsd);
-
   //channel[rx][tx][cluster]
-  uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
+  uint8_t numCluster = static_cast<uint8_t> (params->m_channel.GetNumClusters ());
 
   // compute the doppler term
   // NOTE the update of Doppler is simplified by only taking the center angle of
   // each cluster in to consideration.
   double slotTime = Simulator::Now ().GetSeconds ();
+  double frequency = GetFrequency ();
   PhasedArrayModel::ComplexVector doppler;
   for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
@@ -174,100 +250,199 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> tx
                                          + (sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * cos (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.x
                                          + sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sin (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.y
                                          + cos (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sSpeed.z))
-        * slotTime * GetFrequency () / 3e8;
+        * slotTime * frequency / 3e8;
       doppler.push_back (exp (std::complex<double> (0, temp_doppler)));
     }
+  return doppler;
+}
+
+Ptr<SpectrumValue>
+ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
+                                                           const PhasedArrayModel::ComplexVector &longTerm,
+                                                           Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                           const ns3::Vector &sSpeed, const ns3::Vector &uSpeed) const
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue> (txPsd);
+
+  //channel[rx][tx][cluster]
+  uint8_t numCluster = static_cast<uint8_t> (params->m_channel.GetNumClusters ());
+
+  // compute the doppler term
+  PhasedArrayModel::ComplexVector doppler = CalcDopplerTerm (params, sSpeed, uSpeed);
 
   // apply the doppler term and the propagation delay to the long term component
-  // to obtain the beamforming gain
-  auto vit = tempPsd->ValuesBegin (); // psd iterator
-  auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-  while (vit != tempPsd->ValuesEnd ())
+  // to obtain the beamforming gain. The gain of the sub-band f is
+  // |sum_c longTerm[c] doppler[c] exp(-j 2 pi f delay[c])|^2. When the
+  // sub-bands are equally spaced, the delay term of each cluster at a sub-band
+  // is obtained from the one at the previous sub-band through a multiplication
+  // by exp(-j 2 pi deltaF delay[c]). The recurrence is restarted every
+  // MAX_RECURRENCE_STEPS sub-bands to bound the accumulation of rounding errors.
+  static const std::size_t MAX_RECURRENCE_STEPS = 64;
+  Ptr<const SpectrumModel> sm = tempPsd->GetSpectrumModel ();
+  std::size_t numBands = sm->GetNumBands ();
+  if (numBands == 0 || numCluster == 0)
+    {
+      (*tempPsd) = 0.0;
+      return tempPsd;
+    }
+  double firstFc = sm->Begin ()->fc;
+  double deltaF = numBands > 1 ? ((sm->End () - 1)->fc - firstFc) / (numBands - 1) : 0.0;
+  bool equallySpaced = true;
+  std::size_t bIndex = 0;
+  for (auto sbit = sm->Begin (); sbit != sm->End () && equallySpaced; ++sbit, ++bIndex)
+    {
+      equallySpaced = std::abs (sbit->fc - (firstFc + bIndex * deltaF)) <= 1e-9 * std::abs (sbit->fc);
+    }
+  std::size_t blockSize = equallySpaced ? MAX_RECURRENCE_STEPS : 1;
+
+  // split real and imaginary parts of the phasors of each cluster
+  std::vector<double> phasorRe (numCluster), phasorIm (numCluster);
+  std::vector<double> stepRe (numCluster), stepIm (numCluster);
+  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      std::complex<double> step = std::polar (1.0, -2 * M_PI * deltaF * params->m_delay[cIndex]);
+      stepRe[cIndex] = step.real ();
+      stepIm[cIndex] = step.imag ();
+    }
+
+  std::vector<double> gain (numBands);
+  auto sbit = sm->Begin ();
+  for (std::size_t firstBand = 0; firstBand < numBands; firstBand += blockSize)
+    {
+      double fsb = (sbit + firstBand)->fc; // center frequency of the first sub-band of the block
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          std::complex<double> phasor = longTerm[cIndex] * doppler[cIndex] * std::polar (1.0, -2 * M_PI * fsb * params->m_delay[cIndex]);
+          phasorRe[cIndex] = phasor.real ();
+          phasorIm[cIndex] = phasor.imag ();
+        }
+      ComplexVectorKernels::PhasorSum (numCluster, std::min (blockSize, numBands - firstBand),
+                                       phasorRe.data (), phasorIm.data (), stepRe.data (), stepIm.data (),
+                                       gain.data () + firstBand);
+    }
+
+  auto git = gain.begin ();
+  for (auto vit = tempPsd->ValuesBegin (); vit != tempPsd->ValuesEnd (); ++vit, ++git)
+    {
+      *vit = (*vit) * (*git);
+    }
+  return tempPsd;
+}
+
+MatrixBasedChannelModel::Complex2DVector
+ThreeGppSpectrumPropagationLossModel::CalcLongTermCorrelation (Ptr<const SpectrumValue> txPsd,
+                                                               Ptr<const MobilityModel> a,
+                                                               Ptr<const MobilityModel> b,
+                                                               Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const
+{
+  NS_LOG_FUNCTION (this);
+
+  uint8_t numCluster = static_cast<uint8_t> (params->m_channel.GetNumClusters ());
+  PhasedArrayModel::ComplexVector doppler = CalcDopplerTerm (params, a->GetVelocity (), b->GetVelocity ());
+
+  // R[c1][c2] = 1/N sum_f psd(f) conj (g_c1(f)) g_c2(f), where g_c(f) is the
+  // product of the doppler and delay terms of the cluster c
+  MatrixBasedChannelModel::Complex2DVector correlation (numCluster, PhasedArrayModel::ComplexVector (numCluster));
+  PhasedArrayModel::ComplexVector clusterGain (numCluster);
+  auto vit = txPsd->ConstValuesBegin (); // psd iterator
+  auto sbit = txPsd->ConstBandsBegin (); // band iterator
+  while (vit != txPsd->ConstValuesEnd ())
     {
-      std::complex<double> subsbandGain (0.0,0.0);
       if ((*vit) != 0.00)
         {
           double fsb = (*sbit).fc; // center frequency of the sub-band
           for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
               double delay = -2 * M_PI * fsb * (params->m_delay[cIndex]);
-              subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] * exp (std::complex<double> (0, delay));
+              clusterGain[cIndex] = doppler[cIndex] * exp (std::complex<double> (0, delay));
+            }
+          for (uint8_t c1Index = 0; c1Index < numCluster; c1Index++)
+            {
+              for (uint8_t c2Index = 0; c2Index < numCluster; c2Index++)
+                {
+                  correlation[c1Index][c2Index] += (*vit) * std::conj (clusterGain[c1Index]) * clusterGain[c2Index];
+                }
             }
-          *vit = (*vit) * (norm (subsbandGain));
         }
       vit++;
       sbit++;
     }
-  return tempPsd;
+
+  double numBands = txPsd->GetSpectrumModel ()->GetNumBands ();
+  for (auto &row : correlation)
+    {
+      for (auto &value : row)
+        {
+          value /= numBands;
+        }
+    }
+  return correlation;
 }
 
-PhasedArrayModel::ComplexVector
+const PhasedArrayModel::ComplexVector&
 ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
                                                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-                                                   const PhasedArrayModel::ComplexVector &aW,
-                                                   const PhasedArrayModel::ComplexVector &bW) const
+                                                   Ptr<const PhasedArrayModel> aAntenna,
+                                                   Ptr<const PhasedArrayModel> bAntenna) const
 {
-  PhasedArrayModel::ComplexVector longTerm; // vector containing the long term component for each cluster
-
   // check if the channel matrix was generated considering a as the s-node and
   // b as the u-node or viceversa
-  PhasedArrayModel::ComplexVector sW, uW;
-  if (!channelMatrix->IsReverse (aId, bId))
-  {
-    sW = aW;
-    uW = bW;
-  }
-  else
-  {
-    sW = bW;
-    uW = aW;
-  }
+  Ptr<const PhasedArrayModel> sAntenna = aAntenna;
+  Ptr<const PhasedArrayModel> uAntenna = bAntenna;
+  if (channelMatrix->IsReverse (aId, bId))
+    {
+      std::swap (sAntenna, uAntenna);
+    }
 
   // compute the long term key, the key is unique for each tx-rx pair
   uint32_t x1 = std::min (aId, bId);
   uint32_t x2 = std::max (aId, bId);
-  uint32_t longTermId = MatrixBasedChannelModel::GetKey (x1, x2);
-
-  bool update = false; // indicates whether the long term has to be updated
-  bool notFound = false; // indicates if the long term has not been computed yet
-
-  // look for the long term in the map and check if it is valid
-  if (m_longTermMap.find (longTermId) != m_longTermMap.end ())
-  {
-    NS_LOG_DEBUG ("found the long term component in the map");
-    longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-    // check if the channel matrix has been updated
-    // or the s beam has been changed
-    // or the u beam has been changed
-    update = (m_longTermMap[longTermId]->m_channel->m_generatedTime != channelMatrix->m_generatedTime
-              || m_longTermMap[longTermId]->m_sW != sW
-              || m_longTermMap[longTermId]->m_uW != uW);
-
-  }
-  else
-  {
-    NS_LOG_DEBUG ("long term component NOT found");
-    notFound = true;
-  }
+  uint64_t longTermId = MatrixBasedChannelModel::GetKey (x1, x2);
+
+  // look for the long term in the map, inserting an empty entry if not found
+  Ptr<LongTerm> *mapItem = m_longTermMap.Find (longTermId);
+  Ptr<LongTerm> &longTermItem = mapItem != nullptr ? *mapItem : m_longTermMap.Insert (longTermId, nullptr);
+
+  // the long term is valid if the channel matrix has not been updated and
+  // neither the s beam nor the u beam have been changed since it was computed.
+  // The beams are compared through their generation, which changes every time
+  // a new beamforming vector is set.
+  if (longTermItem
+      && longTermItem->m_channel->m_generatedTime == channelMatrix->m_generatedTime
+      && longTermItem->m_sWGeneration == sAntenna->GetBeamformingVectorGeneration ()
+      && longTermItem->m_uWGeneration == uAntenna->GetBeamformingVectorGeneration ())
+    {
+      NS_LOG_DEBUG ("found a valid long term component in the map");
+      m_longTermCacheHits++;
+      return longTermItem->m_longTerm;
+    }
 
-  if (update || notFound)
+  NS_LOG_DEBUG ("compute the long term");
+  m_longTermCacheMisses++;
+  if (!longTermItem)
+    {
+      longTermItem = Create<LongTerm> ();
+    }
+  longTermItem->m_longTerm = CalcLongTerm (channelMatrix,
+                                           sAntenna->GetBeamformingVectorRef (),
+                                           uAntenna->GetBeamformingVectorRef ());
+  longTermItem->m_channel = channelMatrix;
+  longTermItem->m_sWGeneration = sAntenna->GetBeamformingVectorGeneration ();
+  longTermItem->m_uWGeneration = uAntenna->GetBeamformingVectorGeneration ();
+
+  // the entry is the most recently used one, hence it is not evicted
+  uint64_t size = sizeof (LongTerm) + longTermItem->m_longTerm.size () * sizeof (std::complex<double>);
+  uint32_t numEvicted = m_longTermMap.SetEntrySize (longTermId, size);
+  if (numEvicted > 0)
     {
-      NS_LOG_DEBUG ("compute the long term");
-      // compute the long term component
-      longTerm = CalcLongTerm (channelMatrix, sW, uW);
-
-      // store the long term
-      Ptr<LongTerm> longTermItem = Create<LongTerm> ();
-      longTermItem->m_longTerm = longTerm;
-      longTermItem->m_channel = channelMatrix;
-      longTermItem->m_sW = sW;
-      longTermItem->m_uW = uW;
-
-      m_longTermMap[longTermId] = longTermItem;
+      NS_LOG_DEBUG ("Evicted " << numEvicted << " long term components");
+      m_longTermCacheEvictions += numEvicted;
     }
+  m_longTermCacheSize = m_longTermMap.GetSize ();
 
-  return longTerm;
+  return longTermItem->m_longTerm;
 }
 
 Ptr<SpectrumValue>
@@ -296,12 +471,8 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const Sp
 
   Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix = m_channelModel->GetChannel (a, b, aAntenna, bAntenna);
 
-  // get the precoding and combining vectors
-  PhasedArrayModel::ComplexVector aW = aAntenna->GetBeamformingVector ();
-  PhasedArrayModel::ComplexVector bW = bAntenna->GetBeamformingVector ();
-
   // retrieve the long term component
-  PhasedArrayModel::ComplexVector longTerm = GetLongTerm (aId, bId, channelMatrix, aW, bW);
+  const PhasedArrayModel::ComplexVector &longTerm = GetLongTerm (aId, bId, channelMatrix, aAntenna, bAntenna);
 
   // apply the beamforming gain
   rxPsd = CalcBeamformingGain (rxPsd, longTerm, channelMatrix, a->GetVelocity (), b->GetVelocity ());
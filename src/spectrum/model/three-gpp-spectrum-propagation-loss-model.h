@@ -27,6 +27,8 @@
 #include <map>
 #include <unordered_map>
 #include "ns3/matrix-based-channel-model.h"
+#include "ns3/traced-value.h"
+#include "ns3/lru-cache.h"
 
 namespace ns3 {
 
@@ -117,7 +119,8 @@ public:
    * the propagation delay.
    * To reduce the computational load, the long term component associated with
    * a certain channel is cached and recomputed only when the channel realization
-   * is updated, or when the beamforming vectors change.
+   * is updated, or when the beamforming vectors change. The memory used by the
+   * cache can be bounded with the attribute LongTermCacheMaxSize.
    *
    * \param txPsd tx PSD
    * \param a first node mobility model
@@ -129,6 +132,28 @@ public:
                                                            Ptr<const MobilityModel> a,
                                                            Ptr<const MobilityModel> b) const override;
 
+  /**
+   * \brief Computes the matrix R such that the average received power
+   *        obtained with the long term component l is l^H R l.
+   *
+   * R accounts for the Doppler and delay terms of each cluster, and for the
+   * tx PSD. Since it does not depend on the beamforming vectors, it can be
+   * used to evaluate many beamforming configurations without computing the
+   * received PSD for each of them.
+   * The average received power is equal to the mean over the sub-bands of the
+   * PSD returned by DoCalcRxPowerSpectralDensity (txPsd, a, b).
+   *
+   * \param txPsd tx PSD
+   * \param a first node mobility model
+   * \param b second node mobility model
+   * \param params the channel matrix between a and b
+   * \return the matrix R, of size numClusters x numClusters
+   */
+  MatrixBasedChannelModel::Complex2DVector CalcLongTermCorrelation (Ptr<const SpectrumValue> txPsd,
+                                                                    Ptr<const MobilityModel> a,
+                                                                    Ptr<const MobilityModel> b,
+                                                                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> params) const;
+
 private:
   /**
    * Data structure that stores the long term component for a tx-rx pair
@@ -137,31 +162,35 @@ private:
   {
     PhasedArrayModel::ComplexVector m_longTerm; //!< vector containing the long term component for each cluster
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the long term
-    PhasedArrayModel::ComplexVector m_sW; //!< the beamforming vector for the node s used to compute the long term
-    PhasedArrayModel::ComplexVector m_uW; //!< the beamforming vector for the node u used to compute the long term
+    uint64_t m_sWGeneration; //!< the generation of the beamforming vector for the node s used to compute the long term
+    uint64_t m_uWGeneration; //!< the generation of the beamforming vector for the node u used to compute the long term
   };
 
   /**
-   * Get the operating frequency
+   * Get the operating frequency. If the attribute Frequency is not set, the
+   * value is read from the channel model the first time and then cached,
+   * therefore the frequency of the channel model should be changed through
+   * SetChannelModelAttribute.
    * \return the operating frequency in Hz
   */
   double GetFrequency () const;
 
   /**
    * Looks for the long term component in m_longTermMap. If found, checks
-   * whether it has to be updated. If not found or if it has to be updated,
-   * calls the method CalcLongTerm to compute it.
+   * whether it has to be updated, i.e., if the channel matrix or the
+   * generation of one of the beamforming vectors changed. If not found or if
+   * it has to be updated, calls the method CalcLongTerm to compute it.
    * \param aId id of the first node
    * \param bId id of the second node
    * \param channelMatrix the channel matrix
-   * \param aW the beamforming vector of the first device
-   * \param bW the beamforming vector of the second device
+   * \param aAntenna the antenna of the first device
+   * \param bAntenna the antenna of the second device
    * \return vector containing the long term compoenent for each cluster
    */
-  PhasedArrayModel::ComplexVector GetLongTerm (uint32_t aId, uint32_t bId,
-                                                        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-                                                        const PhasedArrayModel::ComplexVector &aW,
-                                                        const PhasedArrayModel::ComplexVector &bW) const;
+  const PhasedArrayModel::ComplexVector& GetLongTerm (uint32_t aId, uint32_t bId,
+                                                      Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                      Ptr<const PhasedArrayModel> aAntenna,
+                                                      Ptr<const PhasedArrayModel> bAntenna) const;
   /**
    * Computes the long term component
    * \param channelMatrix the channel matrix H
@@ -173,6 +202,16 @@ private:
                                                          const PhasedArrayModel::ComplexVector &sW,
                                                          const PhasedArrayModel::ComplexVector &uW) const;
 
+  /**
+   * Computes the Doppler term of each cluster
+   * \param params The channel matrix
+   * \param sSpeed speed of the first node
+   * \param uSpeed speed of the second node
+   * \return the Doppler term of each cluster
+   */
+  PhasedArrayModel::ComplexVector CalcDopplerTerm (Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                   const Vector &sSpeed, const Vector &uSpeed) const;
+
   /**
    * Computes the beamforming gain and applies it to the tx PSD
    * \param txPsd the tx PSD
@@ -183,13 +222,32 @@ private:
    * \return the rx PSD
    */
   Ptr<SpectrumValue> CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                          PhasedArrayModel::ComplexVector longTerm,
+                                          const PhasedArrayModel::ComplexVector &longTerm,
                                           Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
                                           const Vector &sSpeed, const Vector &uSpeed) const;
 
+  /**
+   * Set the memory budget of m_longTermMap, evicting the least recently used
+   * long term components if needed
+   * \param maxSize the maximum size in bytes, 0 for an unbounded cache
+   */
+  void SetLongTermCacheMaxSize (uint64_t maxSize);
+
+  /**
+   * Get the memory budget of m_longTermMap
+   * \return the maximum size in bytes, 0 for an unbounded cache
+   */
+  uint64_t GetLongTermCacheMaxSize (void) const;
+
   std::unordered_map <uint32_t, Ptr<const PhasedArrayModel> > m_deviceAntennaMap; //!< map containig the <node, antenna> associations
-  mutable std::unordered_map < uint32_t, Ptr<const LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable LruCache<uint64_t, Ptr<LongTerm> > m_longTermMap; //!< cache containing the long term components
+  mutable TracedValue<uint64_t> m_longTermCacheHits; //!< number of times the long term component was found in the cache
+  mutable TracedValue<uint64_t> m_longTermCacheMisses; //!< number of times the long term component had to be computed
+  mutable TracedValue<uint64_t> m_longTermCacheEvictions; //!< number of long term components evicted from the cache
+  mutable TracedValue<uint64_t> m_longTermCacheSize; //!< estimated size of m_longTermMap in bytes
   Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
+  mutable double m_frequency; //!< the operating frequency of the channel model in Hz, negative if not cached yet
+  double m_carrierFrequency; //!< the operating frequency in Hz, if 0 the frequency of the channel model is used
 };
 } // namespace ns3
 
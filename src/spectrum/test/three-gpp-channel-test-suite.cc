@@ -21,6 +21,7 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/uinteger.h"
 #include "ns3/string.h"
 #include "ns3/angles.h"
@@ -36,6 +37,7 @@
 #include "ns3/channel-condition-model.h"
 #include "ns3/three-gpp-spectrum-propagation-loss-model.h"
 #include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/complex-vector-kernels.h"
 
 using namespace ns3;
 
@@ -353,6 +355,7 @@ ThreeGppChannelMatrixUpdateTest::DoRun (void)
  * 2) checks if the long term component is updated when changing the beamforming
  *    vectors
  * 3) checks if the long term is updated when changing the channel matrix
+ * The number of hits and misses of the long term cache is checked as well.
  */
 class ThreeGppSpectrumPropagationLossModelTest : public TestCase
 {
@@ -401,6 +404,14 @@ private:
    * \return true if first and second are equal, false otherwise
    */
   static bool ArePsdEqual (Ptr<SpectrumValue> first, Ptr<SpectrumValue> second);
+
+  /**
+   * Stores the new value of a traced counter
+   * \param counter pointer to the variable where the value is stored
+   * \param oldValue the old value of the counter
+   * \param newValue the new value of the counter
+   */
+  static void UpdateCounter (uint64_t *counter, uint64_t oldValue, uint64_t newValue);
 };
 
 ThreeGppSpectrumPropagationLossModelTest::ThreeGppSpectrumPropagationLossModelTest ()
@@ -408,6 +419,12 @@ ThreeGppSpectrumPropagationLossModelTest::ThreeGppSpectrumPropagationLossModelTe
 {
 }
 
+void
+ThreeGppSpectrumPropagationLossModelTest::UpdateCounter (uint64_t *counter, uint64_t oldValue, uint64_t newValue)
+{
+  *counter = newValue;
+}
+
 ThreeGppSpectrumPropagationLossModelTest::~ThreeGppSpectrumPropagationLossModelTest ()
 {
 }
@@ -503,6 +520,12 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   lossModel->AddDevice (txDev, txAntenna);
   lossModel->AddDevice (rxDev, rxAntenna);
 
+  // count the hits and misses of the long term cache
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  lossModel->TraceConnectWithoutContext ("LongTermCacheHits", MakeBoundCallback (&UpdateCounter, &hits));
+  lossModel->TraceConnectWithoutContext ("LongTermCacheMisses", MakeBoundCallback (&UpdateCounter, &misses));
+
   // set the beamforming vectors
   DoBeamforming (txDev, txAntenna, rxDev, rxAntenna);
   DoBeamforming (rxDev, rxAntenna, txDev, txAntenna);
@@ -519,6 +542,15 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   // 1) check that the rx PSD is equal for both the direct and the reverse channel
   Ptr<SpectrumValue> rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob);
   NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdNew),  true, "The long term for the direct and the reverse channel are different");
+  NS_TEST_ASSERT_MSG_EQ (misses, 1, "The long term should be computed only once for the direct and the reverse channel");
+  NS_TEST_ASSERT_MSG_EQ (hits, 1, "The long term of the reverse channel should be retrieved from the cache");
+
+  // setting a beamforming vector invalidates the long term, even if the
+  // vector did not change
+  txAntenna->SetBeamformingVector (txAntenna->GetBeamformingVector ());
+  rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, txMob, rxMob);
+  NS_TEST_ASSERT_MSG_EQ (misses, 2, "The long term is not updated when a new BF vector is set");
+  NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdNew),  true, "The long term changed without changing the BF vectors");
 
   // 2) check if the long term is updated when changing the BF vector
   // change the position of the rx device and recompute the beamforming vectors
@@ -529,6 +561,8 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
 
   rxPsdNew = lossModel->DoCalcRxPowerSpectralDensity (txPsd, rxMob, txMob);
   NS_TEST_ASSERT_MSG_EQ (ArePsdEqual (rxPsdOld, rxPsdNew),  false, "Changing the BF vectors the rx PSD does not change");
+  NS_TEST_ASSERT_MSG_EQ (misses, 3, "The long term is not updated when changing the BF vector");
+  NS_TEST_ASSERT_MSG_EQ (hits, 1, "Unexpected hit of the long term cache");
 
   // update rxPsdOld
   rxPsdOld = rxPsdNew;
@@ -541,6 +575,807 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * Test case for the kernels used by the ThreeGppSpectrumPropagationLossModel
+ * class. For each instruction set supported by the CPU:
+ * 1) check if the kernels return the same results as a scalar implementation
+ * 2) check if the rx PSD is equal to the one obtained applying the formulas
+ *    of the 3GPP model directly, for both equally spaced and unequally spaced
+ *    sub-bands
+ */
+class ThreeGppSpectrumKernelsTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppSpectrumKernelsTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppSpectrumKernelsTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Check the kernels against a scalar implementation
+   */
+  void CheckKernels (void);
+
+  /**
+   * Compute the rx PSD applying the formulas of the 3GPP model, for static
+   * nodes
+   * \param txPsd the tx PSD
+   * \param params the channel matrix
+   * \param sW the beamforming vector of the s node
+   * \param uW the beamforming vector of the u node
+   * \return the rx PSD
+   */
+  static Ptr<SpectrumValue> CalcReferenceRxPsd (Ptr<const SpectrumValue> txPsd,
+                                                Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                const PhasedArrayModel::ComplexVector &sW,
+                                                const PhasedArrayModel::ComplexVector &uW);
+
+  /**
+   * \param antenna the antenna
+   * \return a random beamforming vector for the antenna
+   */
+  PhasedArrayModel::ComplexVector GetRandomBeam (Ptr<PhasedArrayModel> antenna);
+
+  Ptr<UniformRandomVariable> m_random; //!< random variable used to generate the test vectors
+};
+
+ThreeGppSpectrumKernelsTest::ThreeGppSpectrumKernelsTest ()
+  : TestCase ("Check the kernels used to compute the long term component and the beamforming gain")
+{
+}
+
+ThreeGppSpectrumKernelsTest::~ThreeGppSpectrumKernelsTest ()
+{
+}
+
+PhasedArrayModel::ComplexVector
+ThreeGppSpectrumKernelsTest::GetRandomBeam (Ptr<PhasedArrayModel> antenna)
+{
+  PhasedArrayModel::ComplexVector beam (antenna->GetNumberOfElements ());
+  for (auto &w : beam)
+    {
+      w = std::polar (1.0 / std::sqrt (beam.size ()), m_random->GetValue (-M_PI, M_PI));
+    }
+  return beam;
+}
+
+void
+ThreeGppSpectrumKernelsTest::CheckKernels (void)
+{
+  for (std::size_t n = 1; n < 20; n++)
+    {
+      std::size_t numRows = 3;
+      PhasedArrayModel::ComplexVector x (numRows * n), y (n), w (std::max (numRows, n)), yRef (n);
+      std::vector<double> aRe (n), aIm (n), sRe (n), sIm (n), aRefRe (n), aRefIm (n);
+      for (std::size_t i = 0; i < n; i++)
+        {
+          for (std::size_t r = 0; r < numRows; r++)
+            {
+              x[r * n + i] = std::complex<double> (m_random->GetValue (-1, 1), m_random->GetValue (-1, 1));
+            }
+          y[i] = std::complex<double> (m_random->GetValue (-1, 1), m_random->GetValue (-1, 1));
+          aRe[i] = aRefRe[i] = m_random->GetValue (-1, 1);
+          aIm[i] = aRefIm[i] = m_random->GetValue (-1, 1);
+          std::complex<double> step = std::polar (1.0, m_random->GetValue (-M_PI, M_PI));
+          sRe[i] = step.real ();
+          sIm[i] = step.imag ();
+        }
+
+      for (auto &weight : w)
+        {
+          weight = std::complex<double> (m_random->GetValue (-1, 1), m_random->GetValue (-1, 1));
+        }
+
+      // scalar implementation
+      std::complex<double> dotRef (0.0, 0.0);
+      for (std::size_t i = 0; i < n; i++)
+        {
+          yRef[i] = y[i];
+          for (std::size_t r = 0; r < numRows; r++)
+            {
+              yRef[i] += w[r] * x[r * n + i];
+            }
+          dotRef += w[i] * x[i];
+        }
+      std::size_t numSteps = 5;
+      std::vector<double> gainRef (numSteps), gain (numSteps);
+      for (std::size_t k = 0; k < numSteps; k++)
+        {
+          std::complex<double> sum (0.0, 0.0);
+          for (std::size_t i = 0; i < n; i++)
+            {
+              sum += std::complex<double> (aRefRe[i], aRefIm[i]) * std::pow (std::complex<double> (sRe[i], sIm[i]), static_cast<int> (k));
+            }
+          gainRef[k] = std::norm (sum);
+        }
+
+      ComplexVectorKernels::WeightedSum (numRows, n, w.data (), x.data (), y.data ());
+      std::complex<double> dot = ComplexVectorKernels::Dot (n, w.data (), x.data ());
+      ComplexVectorKernels::PhasorSum (n, numSteps, aRe.data (), aIm.data (), sRe.data (), sIm.data (), gain.data ());
+
+      for (std::size_t i = 0; i < n; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (y[i].real (), yRef[i].real (), 1e-12, "Wrong WeightedSum result for n=" << n);
+          NS_TEST_ASSERT_MSG_EQ_TOL (y[i].imag (), yRef[i].imag (), 1e-12, "Wrong WeightedSum result for n=" << n);
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL (dot.real (), dotRef.real (), 1e-12, "Wrong Dot result for n=" << n);
+      NS_TEST_ASSERT_MSG_EQ_TOL (dot.imag (), dotRef.imag (), 1e-12, "Wrong Dot result for n=" << n);
+      for (std::size_t k = 0; k < numSteps; k++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (gain[k], gainRef[k], 1e-12 * std::max (1.0, gainRef[k]), "Wrong PhasorSum result for n=" << n << " k=" << k);
+        }
+    }
+}
+
+Ptr<SpectrumValue>
+ThreeGppSpectrumKernelsTest::CalcReferenceRxPsd (Ptr<const SpectrumValue> txPsd,
+                                                 Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
+                                                 const PhasedArrayModel::ComplexVector &sW,
+                                                 const PhasedArrayModel::ComplexVector &uW)
+{
+  const Complex3DArray &channel = params->m_channel;
+  PhasedArrayModel::ComplexVector longTerm (channel.GetNumClusters ());
+  for (std::size_t c = 0; c < channel.GetNumClusters (); c++)
+    {
+      for (std::size_t s = 0; s < channel.GetNumTxElements (); s++)
+        {
+          for (std::size_t u = 0; u < channel.GetNumRxElements (); u++)
+            {
+              longTerm[c] += sW[s] * uW[u] * channel (u, s, c);
+            }
+        }
+    }
+
+  // the nodes are static, hence the Doppler term is equal to 1
+  Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (txPsd);
+  auto sbit = rxPsd->ConstBandsBegin ();
+  for (auto vit = rxPsd->ValuesBegin (); vit != rxPsd->ValuesEnd (); ++vit, ++sbit)
+    {
+      std::complex<double> gain (0.0, 0.0);
+      for (std::size_t c = 0; c < longTerm.size (); c++)
+        {
+          gain += longTerm[c] * exp (std::complex<double> (0, -2 * M_PI * sbit->fc * params->m_delay[c]));
+        }
+      *vit *= std::norm (gain);
+    }
+  return rxPsd;
+}
+
+void
+ThreeGppSpectrumKernelsTest::DoRun ()
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+
+  // create the ThreeGppSpectrumPropagationLossModel object, set frequency,
+  // scenario and channel condition model to be used
+  Ptr<ThreeGppSpectrumPropagationLossModel> lossModel = CreateObject<ThreeGppSpectrumPropagationLossModel> ();
+  lossModel->SetChannelModelAttribute ("Frequency", DoubleValue (28e9));
+  lossModel->SetChannelModelAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  lossModel->SetChannelModelAttribute ("ChannelConditionModel", PointerValue (CreateObject<NeverLosChannelConditionModel> ()));
+
+  // create the tx and rx nodes and devices
+  NodeContainer nodes;
+  nodes.Create (2);
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  nodes.Get (0)->AddDevice (txDev);
+  txDev->SetNode (nodes.Get (0));
+  nodes.Get (1)->AddDevice (rxDev);
+  rxDev->SetNode (nodes.Get (1));
+
+  Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel> ();
+  txMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel> ();
+  rxMob->SetPosition (Vector (50.0, 20.0, 1.5));
+  nodes.Get (0)->AggregateObject (txMob);
+  nodes.Get (1)->AggregateObject (rxMob);
+
+  Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (4),
+                                                                                    "NumRows", UintegerValue (4));
+  Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2),
+                                                                                    "NumRows", UintegerValue (3));
+  lossModel->AddDevice (txDev, txAntenna);
+  lossModel->AddDevice (rxDev, rxAntenna);
+
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> params = lossModel->GetChannelModel ()->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
+  bool reverse = params->IsReverse (nodes.Get (0)->GetId (), nodes.Get (1)->GetId ());
+
+  // create a PSD with equally spaced sub-bands, and one with unequally
+  // spaced sub-bands
+  std::vector<BandInfo> equalBands, unequalBands;
+  double fc = 28e9 - 100e6;
+  for (uint32_t i = 0; i < 300; i++)
+    {
+      BandInfo band;
+      band.fc = 28e9 - 100e6 + i * 720e3;
+      band.fl = band.fc - 360e3;
+      band.fh = band.fc + 360e3;
+      equalBands.push_back (band);
+
+      band.fc = fc;
+      band.fl = fc - 100e3;
+      band.fh = fc + 100e3;
+      fc += m_random->GetValue (200e3, 1e6);
+      unequalBands.push_back (band);
+    }
+  std::vector<Ptr<SpectrumValue> > txPsds;
+  for (const auto &bands : {equalBands, unequalBands})
+    {
+      Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (Create<SpectrumModel> (bands));
+      for (auto vit = txPsd->ValuesBegin (); vit != txPsd->ValuesEnd (); ++vit)
+        {
+          // leave some sub-bands empty
+          *vit = m_random->GetValue () < 0.1 ? 0.0 : m_random->GetValue (1e-9, 1e-8);
+        }
+      txPsds.push_back (txPsd);
+    }
+
+  for (auto isa : {ComplexVectorKernels::PORTABLE, ComplexVectorKernels::AVX2, ComplexVectorKernels::AVX512})
+    {
+      if (!ComplexVectorKernels::IsSupported (isa))
+        {
+          NS_LOG_INFO ("Skipping the " << ComplexVectorKernels::GetName (isa) << " kernels");
+          continue;
+        }
+      ComplexVectorKernels::SetInstructionSet (isa);
+      NS_LOG_INFO ("Checking the " << ComplexVectorKernels::GetName (isa) << " kernels");
+
+      CheckKernels ();
+
+      for (auto txPsd : txPsds)
+        {
+          // use new beamforming vectors to force the computation of the long term
+          PhasedArrayModel::ComplexVector txBeam = GetRandomBeam (txAntenna);
+          PhasedArrayModel::ComplexVector rxBeam = GetRandomBeam (rxAntenna);
+          txAntenna->SetBeamformingVector (txBeam);
+          rxAntenna->SetBeamformingVector (rxBeam);
+
+          Ptr<SpectrumValue> rxPsd = lossModel->DoCalcRxPowerSpectralDensity (txPsd, txMob, rxMob);
+          Ptr<SpectrumValue> refPsd = reverse ? CalcReferenceRxPsd (txPsd, params, rxBeam, txBeam)
+                                              : CalcReferenceRxPsd (txPsd, params, txBeam, rxBeam);
+          for (uint32_t i = 0; i < rxPsd->GetSpectrumModel ()->GetNumBands (); i++)
+            {
+              NS_TEST_ASSERT_MSG_EQ_TOL ((*rxPsd)[i], (*refPsd)[i], 1e-9 * (*refPsd)[i],
+                                         "Wrong rx PSD at sub-band " << i << " with the " << ComplexVectorKernels::GetName (isa) << " kernels");
+            }
+        }
+    }
+
+  // restore the default kernels
+  ComplexVectorKernels::SetInstructionSet (ComplexVectorKernels::IsSupported (ComplexVectorKernels::AVX512) ? ComplexVectorKernels::AVX512
+                                           : ComplexVectorKernels::IsSupported (ComplexVectorKernels::AVX2) ? ComplexVectorKernels::AVX2
+                                           : ComplexVectorKernels::PORTABLE);
+  Simulator::Destroy ();
+}
+
+/**
+ * Test case for the Complex3DArray class used to store the channel matrix.
+ * 1) check if the elements are stored according to the selected layout
+ * 2) check if the conversion from and to nested vectors preserves the elements
+ * 3) check if the storage is aligned
+ */
+class Complex3DArrayTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  Complex3DArrayTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~Complex3DArrayTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+};
+
+Complex3DArrayTest::Complex3DArrayTest ()
+  : TestCase ("Check the storage of the channel matrix in the Complex3DArray class")
+{
+}
+
+Complex3DArrayTest::~Complex3DArrayTest ()
+{
+}
+
+void
+Complex3DArrayTest::DoRun ()
+{
+  uint32_t uSize = 4;
+  uint32_t sSize = 3;
+  uint32_t numClusters = 5;
+
+  MatrixBasedChannelModel::Complex3DVector nested (uSize, MatrixBasedChannelModel::Complex2DVector (sSize, PhasedArrayModel::ComplexVector (numClusters)));
+  for (uint32_t u = 0; u < uSize; u++)
+    {
+      for (uint32_t s = 0; s < sSize; s++)
+        {
+          for (uint32_t n = 0; n < numClusters; n++)
+            {
+              nested[u][s][n] = std::complex<double> (u * 100 + s * 10 + n, n);
+            }
+        }
+    }
+
+  Complex3DArray antennaMajor (nested);
+  Complex3DArray clusterMajor (antennaMajor, Complex3DArray::CLUSTER_MAJOR);
+
+  NS_TEST_ASSERT_MSG_EQ (antennaMajor.GetNumRxElements (), uSize, "Wrong number of rx elements");
+  NS_TEST_ASSERT_MSG_EQ (antennaMajor.GetNumTxElements (), sSize, "Wrong number of tx elements");
+  NS_TEST_ASSERT_MSG_EQ (antennaMajor.GetNumClusters (), numClusters, "Wrong number of clusters");
+  NS_TEST_ASSERT_MSG_EQ (antennaMajor.GetNumElements (), uSize * sSize * numClusters, "Wrong number of elements");
+
+  for (uint32_t u = 0; u < uSize; u++)
+    {
+      for (uint32_t s = 0; s < sSize; s++)
+        {
+          for (uint32_t n = 0; n < numClusters; n++)
+            {
+              std::complex<double> expected = nested[u][s][n];
+              NS_TEST_ASSERT_MSG_EQ (antennaMajor (u, s, n), expected, "Wrong element");
+              NS_TEST_ASSERT_MSG_EQ (clusterMajor (u, s, n), expected, "Wrong element");
+              NS_TEST_ASSERT_MSG_EQ (antennaMajor.GetData ()[(u * sSize + s) * numClusters + n], expected, "Wrong antenna-major layout");
+              NS_TEST_ASSERT_MSG_EQ (clusterMajor.GetData ()[(n * uSize + u) * sSize + s], expected, "Wrong cluster-major layout");
+              NS_TEST_ASSERT_MSG_EQ (clusterMajor.at (u).at (s).at (n), expected, "Wrong element through the nested vector adapter");
+            }
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ ((antennaMajor.ToNestedVector () == nested), true, "The conversion to nested vector changed the elements");
+  NS_TEST_ASSERT_MSG_EQ ((clusterMajor.ToNestedVector () == nested), true, "The conversion to nested vector changed the elements");
+
+  uintptr_t address = reinterpret_cast<uintptr_t> (clusterMajor.GetData ());
+  NS_TEST_ASSERT_MSG_EQ (address % Complex3DArray::ALIGNMENT, 0, "The storage is not aligned");
+
+  // a copy must be aligned and independent from the original array
+  Complex3DArray copy = clusterMajor;
+  copy (0, 0, 0) = 0.0;
+  address = reinterpret_cast<uintptr_t> (copy.GetData ());
+  NS_TEST_ASSERT_MSG_EQ (address % Complex3DArray::ALIGNMENT, 0, "The storage of the copy is not aligned");
+  NS_TEST_ASSERT_MSG_EQ (clusterMajor (0, 0, 0), nested[0][0][0], "The copy is not independent from the original array");
+}
+
+/**
+ * Test case for the generation of the channel matrices of multiple links in
+ * a single batch.
+ * 1) check if the result does not depend on the number of worker threads
+ * 2) check if the result does not depend on the order of the links
+ * 3) check if the generated channel matrices are stored and returned by
+ *    GetChannel
+ */
+class ThreeGppChannelBatchGenerationTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppChannelBatchGenerationTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppChannelBatchGenerationTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Create a channel model which uses the given number of worker threads
+   * \param numWorkerThreads the number of worker threads
+   * \return the channel model
+   */
+  Ptr<ThreeGppChannelModel> CreateChannelModel (uint32_t numWorkerThreads) const;
+};
+
+ThreeGppChannelBatchGenerationTest::ThreeGppChannelBatchGenerationTest ()
+  : TestCase ("Check the generation of the channel matrices of multiple links in a single batch")
+{
+}
+
+ThreeGppChannelBatchGenerationTest::~ThreeGppChannelBatchGenerationTest ()
+{
+}
+
+Ptr<ThreeGppChannelModel>
+ThreeGppChannelBatchGenerationTest::CreateChannelModel (uint32_t numWorkerThreads) const
+{
+  Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel> ();
+  channelModel->SetAttribute ("Frequency", DoubleValue (28.0e9));
+  channelModel->SetAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  channelModel->SetAttribute ("ChannelConditionModel", PointerValue (CreateObject<NeverLosChannelConditionModel> ()));
+  channelModel->SetAttribute ("NumWorkerThreads", UintegerValue (numWorkerThreads));
+  channelModel->AssignStreams (1);
+  return channelModel;
+}
+
+void
+ThreeGppChannelBatchGenerationTest::DoRun ()
+{
+  // create a BS node and some UE nodes around it
+  uint32_t numUes = 6;
+  NodeContainer nodes;
+  nodes.Create (numUes + 1);
+
+  Ptr<MobilityModel> bsMob = CreateObject<ConstantPositionMobilityModel> ();
+  bsMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  nodes.Get (0)->AggregateObject (bsMob);
+  Ptr<PhasedArrayModel> bsAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (4),
+                                                                                    "NumRows", UintegerValue (4),
+                                                                                    "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  std::vector<MatrixBasedChannelModel::Link> links;
+  for (uint32_t i = 1; i <= numUes; i++)
+    {
+      Ptr<MobilityModel> ueMob = CreateObject<ConstantPositionMobilityModel> ();
+      ueMob->SetPosition (Vector (20.0 * i, 10.0 * (i % 3), 1.5));
+      nodes.Get (i)->AggregateObject (ueMob);
+      Ptr<PhasedArrayModel> ueAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2),
+                                                                                        "NumRows", UintegerValue (2),
+                                                                                        "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+      links.push_back (MatrixBasedChannelModel::Link (bsMob, ueMob, bsAntenna, ueAntenna));
+    }
+
+  // generate the channel matrices with a single thread
+  Ptr<ThreeGppChannelModel> serialModel = CreateChannelModel (1);
+  std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > expected = serialModel->GetChannels (links);
+  NS_TEST_ASSERT_MSG_EQ (expected.size (), links.size (), "One channel matrix per link should be returned");
+
+  // generate the channel matrices with multiple threads, passing the links
+  // in the reverse order and one of them twice
+  std::vector<MatrixBasedChannelModel::Link> reversedLinks (links.rbegin (), links.rend ());
+  reversedLinks.push_back (links.front ());
+  Ptr<ThreeGppChannelModel> parallelModel = CreateChannelModel (4);
+  std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > actual = parallelModel->GetChannels (reversedLinks);
+  NS_TEST_ASSERT_MSG_EQ (actual.size (), reversedLinks.size (), "One channel matrix per link should be returned");
+  NS_TEST_ASSERT_MSG_EQ (actual.back (), actual[numUes - 1], "A link passed twice should have a single channel matrix");
+
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      Ptr<const MatrixBasedChannelModel::ChannelMatrix> e = expected[i];
+      Ptr<const MatrixBasedChannelModel::ChannelMatrix> a = actual[numUes - 1 - i];
+      NS_TEST_ASSERT_MSG_EQ (a->m_channel.GetNumRxElements (), e->m_channel.GetNumRxElements (), "The channel matrices have different sizes");
+      NS_TEST_ASSERT_MSG_EQ (a->m_channel.GetNumTxElements (), e->m_channel.GetNumTxElements (), "The channel matrices have different sizes");
+      NS_TEST_ASSERT_MSG_EQ (a->m_channel.GetNumClusters (), e->m_channel.GetNumClusters (), "The channel matrices have different sizes");
+      NS_TEST_ASSERT_MSG_EQ ((a->m_delay == e->m_delay), true, "The cluster delays are different");
+      for (std::size_t j = 0; j < e->m_channel.GetNumElements (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (a->m_channel.GetData ()[j], e->m_channel.GetData ()[j], "The channel matrices are different");
+        }
+
+      // the channel matrices must be available through GetChannel
+      Ptr<const MatrixBasedChannelModel::ChannelMatrix> stored = parallelModel->GetChannel (links[i].m_bMob, links[i].m_aMob,
+                                                                                             links[i].m_bAntenna, links[i].m_aAntenna);
+      NS_TEST_ASSERT_MSG_EQ (stored, a, "The channel matrix should be stored");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test case for the counter-based generation of the random variables of the
+ * ThreeGppChannelModel and of the ThreeGppChannelConditionModel.
+ * It evaluates the same links in different orders with two instances of the
+ * models using the same streams, and checks if the channel conditions and
+ * the channel matrices are the same with CounterBasedRng, and different
+ * without it.
+ */
+class ThreeGppChannelOrderIndependenceTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppChannelOrderIndependenceTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppChannelOrderIndependenceTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Evaluate the links of the scenario
+   * \param counterBased whether the models use CounterBasedRng
+   * \param reverse if true, evaluate the links in the reverse order
+   * \return the channel matrices, in the order of the links
+   */
+  std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > EvaluateLinks (bool counterBased, bool reverse) const;
+
+  std::vector<Ptr<MobilityModel> > m_ueMobs; //!< the mobility models of the UEs
+  std::vector<Ptr<PhasedArrayModel> > m_ueAntennas; //!< the antennas of the UEs
+  Ptr<MobilityModel> m_bsMob; //!< the mobility model of the BS
+  Ptr<PhasedArrayModel> m_bsAntenna; //!< the antenna of the BS
+};
+
+ThreeGppChannelOrderIndependenceTest::ThreeGppChannelOrderIndependenceTest ()
+  : TestCase ("Check if the channel realizations do not depend on the order of the links with CounterBasedRng")
+{
+}
+
+ThreeGppChannelOrderIndependenceTest::~ThreeGppChannelOrderIndependenceTest ()
+{
+}
+
+std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> >
+ThreeGppChannelOrderIndependenceTest::EvaluateLinks (bool counterBased, bool reverse) const
+{
+  Ptr<ChannelConditionModel> conditionModel = CreateObjectWithAttributes<ThreeGppUmiStreetCanyonChannelConditionModel> ("CounterBasedRng", BooleanValue (counterBased));
+  conditionModel->AssignStreams (10);
+  Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel> ();
+  channelModel->SetAttribute ("Frequency", DoubleValue (28.0e9));
+  channelModel->SetAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+  channelModel->SetAttribute ("ChannelConditionModel", PointerValue (conditionModel));
+  channelModel->SetAttribute ("Blockage", BooleanValue (true));
+  channelModel->SetAttribute ("CounterBasedRng", BooleanValue (counterBased));
+  channelModel->AssignStreams (1);
+
+  uint32_t numUes = m_ueMobs.size ();
+  std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > channels (numUes);
+  for (uint32_t j = 0; j < numUes; j++)
+    {
+      uint32_t i = reverse ? numUes - 1 - j : j;
+      channels[i] = channelModel->GetChannel (m_bsMob, m_ueMobs[i], m_bsAntenna, m_ueAntennas[i]);
+    }
+  return channels;
+}
+
+void
+ThreeGppChannelOrderIndependenceTest::DoRun ()
+{
+  // create a BS node and some UE nodes at different distances from it
+  uint32_t numUes = 8;
+  NodeContainer nodes;
+  nodes.Create (numUes + 1);
+
+  m_bsMob = CreateObject<ConstantPositionMobilityModel> ();
+  m_bsMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  nodes.Get (0)->AggregateObject (m_bsMob);
+  m_bsAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (4),
+                                                                "NumRows", UintegerValue (4),
+                                                                "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  for (uint32_t i = 1; i <= numUes; i++)
+    {
+      Ptr<MobilityModel> ueMob = CreateObject<ConstantPositionMobilityModel> ();
+      ueMob->SetPosition (Vector (30.0 * i, 15.0 * (i % 4), 1.5));
+      nodes.Get (i)->AggregateObject (ueMob);
+      m_ueMobs.push_back (ueMob);
+      m_ueAntennas.push_back (CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2),
+                                                                              "NumRows", UintegerValue (2),
+                                                                              "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ())));
+    }
+
+  for (bool counterBased : {true, false})
+    {
+      std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > forward = EvaluateLinks (counterBased, false);
+      std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix> > backward = EvaluateLinks (counterBased, true);
+
+      uint32_t numEqual = 0;
+      for (uint32_t i = 0; i < numUes; i++)
+        {
+          bool equal = forward[i]->m_channel.GetNumElements () == backward[i]->m_channel.GetNumElements ()
+            && forward[i]->m_delay == backward[i]->m_delay;
+          for (std::size_t j = 0; equal && j < forward[i]->m_channel.GetNumElements (); j++)
+            {
+              equal = forward[i]->m_channel.GetData ()[j] == backward[i]->m_channel.GetData ()[j];
+            }
+          numEqual += equal;
+        }
+
+      if (counterBased)
+        {
+          NS_TEST_ASSERT_MSG_EQ (numEqual, numUes, "The channel realizations should not depend on the order of the links");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_LT (numEqual, numUes, "Without CounterBasedRng the channel realizations should depend on the order of the links");
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test case for the bounded caches of the ThreeGppChannelModel and of the
+ * ThreeGppChannelConditionModel. It sets a memory budget which does not fit
+ * all the channel realizations, or more than one channel condition, and
+ * checks the cache counters and the least recently used eviction. It also checks that, with
+ * CounterBasedRng, an evicted link gets the same realization when it is
+ * evaluated again in the same update period.
+ */
+class ThreeGppChannelCacheTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppChannelCacheTest ();
+
+  /**
+   * Destructor
+   */
+  virtual ~ThreeGppChannelCacheTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Stores the size of the cache of the channel realizations
+   * \param oldValue the old size
+   * \param newValue the new size
+   */
+  void ChannelCacheSizeChanged (uint64_t oldValue, uint64_t newValue);
+
+  /**
+   * Stores the value of a cache counter
+   * \param counter the counter
+   * \param oldValue the old value
+   * \param newValue the new value
+   */
+  static void UpdateCounter (uint64_t *counter, uint64_t oldValue, uint64_t newValue);
+
+  uint64_t m_channelCacheSize; //!< the size of the cache of the channel realizations
+};
+
+ThreeGppChannelCacheTest::ThreeGppChannelCacheTest ()
+  : TestCase ("Check the bounded caches of the channel realizations and of the channel conditions"),
+    m_channelCacheSize (0)
+{
+}
+
+ThreeGppChannelCacheTest::~ThreeGppChannelCacheTest ()
+{
+}
+
+void
+ThreeGppChannelCacheTest::ChannelCacheSizeChanged (uint64_t oldValue, uint64_t newValue)
+{
+  m_channelCacheSize = newValue;
+}
+
+void
+ThreeGppChannelCacheTest::UpdateCounter (uint64_t *counter, uint64_t oldValue, uint64_t newValue)
+{
+  *counter = newValue;
+}
+
+void
+ThreeGppChannelCacheTest::DoRun ()
+{
+  // the keys are different even if the node ids do not fit in 16 bits
+  NS_TEST_ASSERT_MSG_NE (MatrixBasedChannelModel::GetKey (70000, 70001), MatrixBasedChannelModel::GetKey (70001, 70000), "The keys should be different");
+  NS_TEST_ASSERT_MSG_EQ ((MatrixBasedChannelModel::GetKey (70000, 70001) >> 32), 70000, "The key should contain the first id");
+
+  // create a BS node and some UE nodes
+  uint32_t numUes = 4;
+  NodeContainer nodes;
+  nodes.Create (numUes + 1);
+
+  Ptr<MobilityModel> bsMob = CreateObject<ConstantPositionMobilityModel> ();
+  bsMob->SetPosition (Vector (0.0, 0.0, 10.0));
+  nodes.Get (0)->AggregateObject (bsMob);
+  Ptr<PhasedArrayModel> bsAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2),
+                                                                                   "NumRows", UintegerValue (2),
+                                                                                   "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  std::vector<Ptr<MobilityModel> > ueMobs;
+  std::vector<Ptr<PhasedArrayModel> > ueAntennas;
+  for (uint32_t i = 1; i <= numUes; i++)
+    {
+      Ptr<MobilityModel> ueMob = CreateObject<ConstantPositionMobilityModel> ();
+      ueMob->SetPosition (Vector (20.0 * i, 10.0, 1.5));
+      nodes.Get (i)->AggregateObject (ueMob);
+      ueMobs.push_back (ueMob);
+      ueAntennas.push_back (CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (2),
+                                                                            "NumRows", UintegerValue (1),
+                                                                            "AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ())));
+    }
+
+  // evaluate all the links with an unbounded cache to get its size
+  std::vector<Ptr<ThreeGppChannelModel> > channelModels;
+  for (uint32_t m = 0; m < 2; m++)
+    {
+      Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel> ();
+      channelModel->SetAttribute ("Frequency", DoubleValue (28.0e9));
+      channelModel->SetAttribute ("Scenario", StringValue ("UMi-StreetCanyon"));
+      channelModel->SetAttribute ("ChannelConditionModel", PointerValue (CreateObject<AlwaysLosChannelConditionModel> ()));
+      channelModel->SetAttribute ("CounterBasedRng", BooleanValue (true));
+      channelModel->TraceConnectWithoutContext ("ChannelCacheSize", MakeCallback (&ThreeGppChannelCacheTest::ChannelCacheSizeChanged, this));
+      channelModels.push_back (channelModel);
+    }
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      channelModels[0]->GetChannel (bsMob, ueMobs[i], bsAntenna, ueAntennas[i]);
+    }
+  uint64_t totalSize = m_channelCacheSize;
+
+  // the second model cannot store all the links
+  Ptr<ThreeGppChannelModel> channelModel = channelModels[1];
+  uint64_t channelHits = 0;
+  uint64_t channelMisses = 0;
+  uint64_t channelEvictions = 0;
+  channelModel->TraceConnectWithoutContext ("ChannelCacheHits", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &channelHits));
+  channelModel->TraceConnectWithoutContext ("ChannelCacheMisses", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &channelMisses));
+  channelModel->TraceConnectWithoutContext ("ChannelCacheEvictions", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &channelEvictions));
+  channelModel->SetAttribute ("ChannelCacheMaxSize", UintegerValue (totalSize - 1));
+
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> first = channelModel->GetChannel (bsMob, ueMobs[0], bsAntenna, ueAntennas[0]);
+  NS_TEST_ASSERT_MSG_GT (m_channelCacheSize, first->m_channel.GetNumElements () * sizeof (std::complex<double>), "The size should account for the channel coefficients");
+  for (uint32_t i = 0; i < numUes; i++)
+    {
+      channelModel->GetChannel (bsMob, ueMobs[i], bsAntenna, ueAntennas[i]);
+      NS_TEST_ASSERT_MSG_LT (m_channelCacheSize, totalSize, "The cache should not exceed its budget");
+    }
+
+  // the first link was evicted when the last one was added, while the last
+  // one is still in the cache
+  channelModel->GetChannel (bsMob, ueMobs[numUes - 1], bsAntenna, ueAntennas[numUes - 1]);
+  Ptr<const MatrixBasedChannelModel::ChannelMatrix> again = channelModel->GetChannel (bsMob, ueMobs[0], bsAntenna, ueAntennas[0]);
+  NS_TEST_ASSERT_MSG_NE (again, first, "The first realization should have been evicted");
+  NS_TEST_ASSERT_MSG_EQ (again->m_channel.GetNumElements (), first->m_channel.GetNumElements (), "The realization should be the same");
+  for (std::size_t j = 0; j < first->m_channel.GetNumElements (); j++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (again->m_channel.GetData ()[j], first->m_channel.GetData ()[j], "The realization should be the same");
+    }
+
+  // the first link in the loop and the last link were hits, while the first
+  // link evicted the second one when it was evaluated again
+  NS_TEST_ASSERT_MSG_EQ (channelHits, 2, "Wrong number of hits");
+  NS_TEST_ASSERT_MSG_EQ (channelMisses, 5, "Wrong number of misses");
+  NS_TEST_ASSERT_MSG_EQ (channelEvictions, 2, "Wrong number of evictions");
+
+  // the condition cache fits a single condition
+  Ptr<ThreeGppChannelConditionModel> conditionModel = CreateObjectWithAttributes<ThreeGppUmiStreetCanyonChannelConditionModel> ("CounterBasedRng", BooleanValue (true),
+                                                                                                                                  "CacheMaxSize", UintegerValue (1));
+  ChannelCondition::LosConditionValue cond0 = conditionModel->GetChannelCondition (bsMob, ueMobs[0])->GetLosCondition ();
+  conditionModel->GetChannelCondition (bsMob, ueMobs[1]);
+  conditionModel->GetChannelCondition (bsMob, ueMobs[1]);
+  ChannelCondition::LosConditionValue again0 = conditionModel->GetChannelCondition (bsMob, ueMobs[0])->GetLosCondition ();
+  NS_TEST_ASSERT_MSG_EQ (again0, cond0, "The condition should be the same");
+
+  uint64_t conditionHits = 0;
+  uint64_t conditionMisses = 0;
+  uint64_t conditionEvictions = 0;
+  Ptr<ThreeGppChannelConditionModel> counters = CreateObjectWithAttributes<ThreeGppUmiStreetCanyonChannelConditionModel> ("CacheMaxSize", UintegerValue (1));
+  counters->TraceConnectWithoutContext ("CacheHits", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &conditionHits));
+  counters->TraceConnectWithoutContext ("CacheMisses", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &conditionMisses));
+  counters->TraceConnectWithoutContext ("CacheEvictions", MakeBoundCallback (&ThreeGppChannelCacheTest::UpdateCounter, &conditionEvictions));
+  counters->GetChannelCondition (bsMob, ueMobs[0]);
+  counters->GetChannelCondition (bsMob, ueMobs[1]);
+  counters->GetChannelCondition (bsMob, ueMobs[1]);
+  counters->GetChannelCondition (bsMob, ueMobs[0]);
+  NS_TEST_ASSERT_MSG_EQ (conditionHits, 1, "Wrong number of hits");
+  NS_TEST_ASSERT_MSG_EQ (conditionMisses, 3, "Wrong number of misses");
+  NS_TEST_ASSERT_MSG_EQ (conditionEvictions, 2, "Wrong number of evictions");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup spectrum
  *
@@ -561,6 +1396,11 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite ()
   AddTestCase (new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
   AddTestCase (new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
   AddTestCase (new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
+  AddTestCase (new Complex3DArrayTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppSpectrumKernelsTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppChannelBatchGenerationTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppChannelOrderIndependenceTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppChannelCacheTest, TestCase::QUICK);
 }
 
 static ThreeGppChannelTestSuite myTestSuite;
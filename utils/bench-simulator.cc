@@ -145,6 +145,57 @@ Bench::Cb (void)
 }
 
 
+/**
+ * Create a stream of event intervals like those of a slotted mmWave
+ * PHY and MAC, in ns.  Most events fall on symbol boundaries: the next
+ * symbol or TTI, the end of a transmission a few symbols later, the next
+ * slot, or 1 ns later, as the data channels after the control ones.
+ * Some events fall at the same time, and a few are timers of some ms.
+ *
+ * \param symbol The symbol period, in ns.
+ * \returns The stream of event intervals.
+ */
+Ptr<RandomVariableStream>
+GetMmWaveStream (double symbol)
+{
+  LOGME ("using mmWave-like event distribution, with symbol period " << symbol << " ns");
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  std::vector<double> nsValues;
+  for (uint32_t i = 0; i < 100000; i++)
+    {
+      double type = uniform->GetValue ();
+      double ns;
+      if (type < 0.30)
+        {
+          ns = symbol;                                           // next symbol or TTI
+        }
+      else if (type < 0.50)
+        {
+          ns = 1;                                                // data channels after the control
+        }
+      else if (type < 0.70)
+        {
+          ns = symbol * uniform->GetInteger (1, 12);             // end of a transmission
+        }
+      else if (type < 0.85)
+        {
+          ns = symbol * 14;                                      // next slot
+        }
+      else if (type < 0.95)
+        {
+          ns = 0;                                                // same time
+        }
+      else
+        {
+          ns = uniform->GetInteger (1, 10) * 1000000.0;          // timers
+        }
+      nsValues.push_back (std::floor (ns));
+    }
+  Ptr<DeterministicRandomVariable> drv = CreateObject<DeterministicRandomVariable> ();
+  drv->SetValueArray (&nsValues[0], nsValues.size ());
+  return drv;
+}
+
 Ptr<RandomVariableStream>
 GetRandomStream (std::string filename)
 {
@@ -207,6 +258,12 @@ int main (int argc, char *argv[])
   bool schedHeap = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedPri  = false;
+  bool schedWheel = false;
+  double granularity = 0;
+  bool mmwave = false;
+  double symbol = 8928;
+  bool pool = true;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -221,11 +278,19 @@ int main (int argc, char *argv[])
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "With --mmwave, the event intervals are instead multiples of the\n"
+             "--symbol period, as in a slotted mmWave PHY and MAC.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("pri",   "use PriorityQueueScheduler",    schedPri);
+  cmd.AddValue ("wheel", "use TimingWheelScheduler",      schedWheel);
+  cmd.AddValue ("granularity", "bucket duration of the TimingWheelScheduler in ns (default the --symbol period with --mmwave)", granularity);
+  cmd.AddValue ("mmwave", "use mmWave-like event intervals", mmwave);
+  cmd.AddValue ("symbol", "symbol period of the mmWave-like event intervals in ns (default 8928)", symbol);
+  cmd.AddValue ("pool", "allocate the events from the EventImpl pools (default true)", pool);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -249,7 +314,25 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::ListScheduler");
     }
+  if (schedPri)
+    {
+      factory.SetTypeId ("ns3::PriorityQueueScheduler");
+    }
+  if (schedWheel)
+    {
+      factory.SetTypeId ("ns3::TimingWheelScheduler");
+      if (granularity == 0 && mmwave)
+        {
+          granularity = symbol;
+        }
+      if (granularity > 0)
+        {
+          factory.Set ("Granularity", TimeValue (NanoSeconds (granularity)));
+        }
+    }
   Simulator::SetScheduler (factory);
+  // before the first event is allocated
+  GlobalValue::Bind ("EventImplPoolEnabled", BooleanValue (pool));
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
@@ -258,9 +341,10 @@ int main (int argc, char *argv[])
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
+  LOGME ("event pools: " << (EventImpl::IsPoolEnabled () ? "enabled" : "disabled"));
 
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
+  bench->SetRandomStream (mmwave ? GetMmWaveStream (symbol) : GetRandomStream (filename));
 
   // table header
   LOG ("");
@@ -302,5 +386,12 @@ int main (int argc, char *argv[])
   LOG ("");
   Simulator::Destroy ();
   delete bench;
+
+  EventImpl::AllocatorStats stats = EventImpl::GetAllocatorStats ();
+  LOGME ("event allocations: " << stats.allocations <<
+         ", reused: " << stats.reused <<
+         ", unpooled: " << stats.unpooled <<
+         ", chunks: " << stats.chunks <<
+         " (" << stats.bytes << " bytes)");
   return 0;
 }